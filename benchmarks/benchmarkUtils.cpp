@@ -0,0 +1,323 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#if defined(_MSC_VER)
+#define _CRT_SECURE_NO_WARNINGS 1
+#endif // _MSC_VER
+
+#include "benchmarkUtils.h"
+#include <string.h>
+#include <stdlib.h>
+#include <new>
+
+#if defined(_MSC_VER)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+using namespace irr;
+
+// Count all allocations of the program, Irrlicht containers use operator new as well
+static u64 AllocationCount = 0;
+
+#if __cplusplus >= 201103L
+#define ALLOCATION_THROW
+#define DEALLOCATION_NOTHROW noexcept
+#else
+#define ALLOCATION_THROW throw(std::bad_alloc)
+#define DEALLOCATION_NOTHROW throw()
+#endif
+
+void* operator new(size_t size) ALLOCATION_THROW
+{
+#if defined(_MSC_VER)
+	InterlockedIncrement64(reinterpret_cast<volatile LONGLONG*>(&AllocationCount));
+#else
+	__atomic_fetch_add(&AllocationCount, 1, __ATOMIC_RELAXED);
+#endif
+	void* p = malloc(size ? size : 1);
+	if (!p)
+		abort();
+	return p;
+}
+
+void operator delete(void* p) DEALLOCATION_NOTHROW
+{
+	free(p);
+}
+
+u64 getAllocationCount()
+{
+#if defined(_MSC_VER)
+	return (u64)InterlockedCompareExchange64(reinterpret_cast<volatile LONGLONG*>(&AllocationCount), 0, 0);
+#else
+	return __atomic_load_n(&AllocationCount, __ATOMIC_RELAXED);
+#endif
+}
+
+namespace
+{
+
+core::stringc u64ToString(u64 value)
+{
+	c8 buffer[24];
+	u32 pos = sizeof(buffer) - 1;
+	buffer[pos] = 0;
+	do
+	{
+		buffer[--pos] = (c8)('0' + value % 10);
+		value /= 10;
+	} while (value);
+	return core::stringc(buffer + pos);
+}
+
+// value of "key": "text" in a line written by writeBenchmarkJson
+core::stringc getJsonString(const c8* line, const c8* key)
+{
+	const c8* p = strstr(line, key);
+	if (!p)
+		return core::stringc();
+	p = strchr(p + strlen(key), '"');
+	if (!p)
+		return core::stringc();
+	const c8* end = strchr(p + 1, '"');
+	if (!end)
+		return core::stringc();
+	return core::stringc(p + 1, (u32)(end - p - 1));
+}
+
+// value of "key": number in a line written by writeBenchmarkJson
+f64 getJsonNumber(const c8* line, const c8* key)
+{
+	const c8* p = strstr(line, key);
+	if (!p)
+		return 0.0;
+	return strtod(p + strlen(key), 0);
+}
+
+// the whole counters object in a line written by writeBenchmarkJson
+core::stringc getJsonCounters(const c8* line)
+{
+	const c8* p = strstr(line, "\"counters\": {");
+	if (!p)
+		return core::stringc();
+	p += 13;
+	const c8* end = strchr(p, '}');
+	if (!end)
+		return core::stringc();
+	return core::stringc(p, (u32)(end - p));
+}
+
+} // end anonymous namespace
+
+
+CBenchmark::CBenchmark(IrrlichtDevice* device, u32 repetitions)
+	: Device(device), StartTime(0), Runs(0), Frame(0),
+	Repetitions(repetitions > 0 ? repetitions : 1), Iterations(1),
+	DrawCalls(0), PrimitivesDrawn(0), NodesVisible(0), SkinnedVertices(0), ParticlesSimulated(0)
+{
+	// all animations only depend on the frame number
+	Device->getTimer()->stop();
+	Device->getTimer()->setTime(0);
+
+	// particle emitters use the engine randomizer
+	Device->getRandomizer()->reset(0x0816);
+}
+
+
+bool CBenchmark::keepRunning()
+{
+	const u64 now = Device->getTimer()->getRealTimeNanoseconds();
+
+	// the first run warms up caches and is not measured
+	if (Runs > 1)
+		Samples.push_back(now - StartTime);
+
+	if (Runs > Repetitions)
+		return false;
+
+	++Runs;
+	StartTime = Device->getTimer()->getRealTimeNanoseconds();
+	return true;
+}
+
+
+void CBenchmark::nextFrame()
+{
+	// never go back in time, particle emitters and animators would jump
+	Device->getTimer()->setTime(Frame * BenchmarkFrameTime);
+	++Frame;
+}
+
+
+void CBenchmark::drawFrame()
+{
+	video::IVideoDriver* driver = Device->getVideoDriver();
+
+	nextFrame();
+	Device->run();
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,100,101,140));
+	Device->getSceneManager()->drawAll();
+	driver->endScene();
+
+	// only the warm up run is counted, that one is identical on every run
+	if (Runs == 1)
+	{
+		const video::SFrameStats& d = driver->getFrameStats();
+		const scene::SSceneStats& s = Device->getSceneManager()->getFrameStats();
+		DrawCalls += d.DrawCalls;
+		PrimitivesDrawn += d.PrimitivesDrawn;
+		NodesVisible += s.NodesVisible;
+		SkinnedVertices += s.SkinnedVertices;
+		ParticlesSimulated += s.ParticlesSimulated;
+	}
+}
+
+
+bool CBenchmark::isCounting() const
+{
+	return Runs == 1;
+}
+
+
+void CBenchmark::addCounter(const char* name, u64 value)
+{
+	if (Counters.size())
+		Counters += ", ";
+	Counters += "\"";
+	Counters += name;
+	Counters += "\": ";
+	Counters += u64ToString(value);
+}
+
+
+void CBenchmark::addFrameStatsCounters()
+{
+	addCounter("draw_calls", DrawCalls);
+	addCounter("primitives", PrimitivesDrawn);
+	addCounter("nodes_visible", NodesVisible);
+	addCounter("skinned_vertices", SkinnedVertices);
+	addCounter("particles", ParticlesSimulated);
+}
+
+
+void CBenchmark::getResult(SBenchmarkResult& result) const
+{
+	result.Iterations = Iterations;
+	result.Counters = Counters;
+	result.MinNs = result.MedianNs = result.MeanNs = 0.0;
+	if (Samples.empty())
+		return;
+
+	core::array<u64> sorted(Samples);
+	sorted.sort();
+
+	f64 sum = 0.0;
+	for (u32 i=0; i<sorted.size(); ++i)
+		sum += (f64)sorted[i];
+
+	const f64 iterations = (f64)(Iterations > 0 ? Iterations : 1);
+	result.MinNs = (f64)sorted[0] / iterations;
+	result.MedianNs = (f64)sorted[sorted.size() / 2] / iterations;
+	result.MeanNs = sum / sorted.size() / iterations;
+}
+
+
+bool writeBenchmarkJson(const core::array<SBenchmarkResult>& results, const char* fileName)
+{
+	FILE* out = fopen(fileName, "w");
+	if (!out)
+		return false;
+
+	fprintf(out, "{\n\"version\": \"%s\",\n\"benchmarks\": [\n", IRRLICHT_SDK_VERSION);
+	for (u32 i=0; i<results.size(); ++i)
+	{
+		const SBenchmarkResult& r = results[i];
+		fprintf(out, "{\"name\": \"%s\", \"driver\": \"%s\", \"iterations\": %u, "
+			"\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"counters\": {%s}}%s\n",
+			r.Name.c_str(), r.Driver.c_str(), r.Iterations,
+			r.MinNs, r.MedianNs, r.MeanNs, r.Counters.c_str(),
+			i + 1 < results.size() ? "," : "");
+	}
+	fprintf(out, "]\n}\n");
+	fclose(out);
+	return true;
+}
+
+
+bool readBenchmarkJson(core::array<SBenchmarkResult>& results, const char* fileName)
+{
+	FILE* in = fopen(fileName, "r");
+	if (!in)
+		return false;
+
+	c8 line[4096];
+	while (fgets(line, sizeof(line), in))
+	{
+		if (!strstr(line, "\"name\":"))
+			continue;
+
+		SBenchmarkResult r;
+		r.Name = getJsonString(line, "\"name\":");
+		r.Driver = getJsonString(line, "\"driver\":");
+		r.Iterations = (u32)getJsonNumber(line, "\"iterations\":");
+		r.MinNs = getJsonNumber(line, "\"min_ns\":");
+		r.MedianNs = getJsonNumber(line, "\"median_ns\":");
+		r.MeanNs = getJsonNumber(line, "\"mean_ns\":");
+		r.Counters = getJsonCounters(line);
+		results.push_back(r);
+	}
+	fclose(in);
+	return true;
+}
+
+
+u32 compareBenchmarkJson(const char* baselineFile, const char* currentFile, f32 thresholdPercent)
+{
+	core::array<SBenchmarkResult> baseline;
+	core::array<SBenchmarkResult> current;
+	if (!readBenchmarkJson(baseline, baselineFile))
+	{
+		fprintf(stderr, "Could not read %s\n", baselineFile);
+		return 1;
+	}
+	if (!readBenchmarkJson(current, currentFile))
+	{
+		fprintf(stderr, "Could not read %s\n", currentFile);
+		return 1;
+	}
+
+	u32 problems = 0;
+	printf("%-24s %-9s %14s %14s %9s\n", "benchmark", "driver", "baseline ns", "current ns", "change");
+	for (u32 i=0; i<current.size(); ++i)
+	{
+		const SBenchmarkResult& c = current[i];
+		const SBenchmarkResult* b = 0;
+		for (u32 j=0; j<baseline.size(); ++j)
+		{
+			if (baseline[j].Name == c.Name && baseline[j].Driver == c.Driver)
+			{
+				b = &baseline[j];
+				break;
+			}
+		}
+
+		if (!b)
+		{
+			printf("%-24s %-9s %14s %14.1f %9s  new\n", c.Name.c_str(), c.Driver.c_str(), "-", c.MedianNs, "-");
+			continue;
+		}
+
+		const f64 change = b->MedianNs > 0.0 ? (c.MedianNs - b->MedianNs) * 100.0 / b->MedianNs : 0.0;
+		const bool regression = change > thresholdPercent;
+		const bool countersDiffer = b->Counters != c.Counters;
+		printf("%-24s %-9s %14.1f %14.1f %+8.1f%%%s%s\n", c.Name.c_str(), c.Driver.c_str(),
+			b->MedianNs, c.MedianNs, change,
+			regression ? "  REGRESSION" : "",
+			countersDiffer ? "  COUNTERS DIFFER" : "");
+		if (regression || countersDiffer)
+			++problems;
+	}
+
+	return problems;
+}
@@ -0,0 +1,119 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef _BENCHMARK_UTILS_H_
+#define _BENCHMARK_UTILS_H_ 1
+
+#include "irrlicht.h"
+#include <stdio.h>
+
+//! Virtual milliseconds between two frames of the scripted scenes
+const irr::u32 BenchmarkFrameTime = 16;
+
+//! Measurements of one benchmark with one driver
+struct SBenchmarkResult
+{
+	SBenchmarkResult() : Iterations(0), MinNs(0), MedianNs(0), MeanNs(0) {}
+
+	irr::core::stringc Name;
+	irr::core::stringc Driver;
+
+	//! Iterations of the measured work in one repetition
+	irr::u32 Iterations;
+
+	//! Nanoseconds per iteration over all repetitions
+	irr::f64 MinNs;
+	irr::f64 MedianNs;
+	irr::f64 MeanNs;
+
+	//! Values which only depend on the work done, "name": value pairs
+	/** They have to be identical between two runs of the same engine
+	version, otherwise the benchmark is not deterministic. */
+	irr::core::stringc Counters;
+};
+
+//! Passed to each benchmark function
+/** A benchmark sets up its scene, then repeats the measured work with
+\code
+while (bench.keepRunning())
+{
+	for (u32 i=0; i<Iterations; ++i)
+		work();
+}
+bench.setIterations(Iterations);
+\endcode
+The first repetition is a warm up and not measured. Counters are added
+for that repetition only. */
+class CBenchmark
+{
+public:
+	CBenchmark(irr::IrrlichtDevice* device, irr::u32 repetitions);
+
+	irr::IrrlichtDevice* getDevice() const { return Device; }
+
+	//! Returns true as long as another repetition of the measured work is needed
+	/** Each call ends the timing of the previous repetition. */
+	bool keepRunning();
+
+	//! Number of iterations of the measured work done in each repetition
+	void setIterations(irr::u32 iterations) { Iterations = iterations; }
+
+	//! Advance the virtual timer to the next frame
+	/** The timer of the device is stopped, so animations only depend on
+	the frame number and not on the speed of the machine. Frames continue
+	over all repetitions, the time never goes back. */
+	void nextFrame();
+
+	//! Advance to the next frame and render the scene
+	void drawFrame();
+
+	//! True during the warm up repetition, which is the one to add counters in
+	bool isCounting() const;
+
+	//! Add a value which is expected to be identical on every run
+	void addCounter(const char* name, irr::u64 value);
+
+	//! Add the frame stats summed over the warm up repetition as counters
+	void addFrameStatsCounters();
+
+	//! Fill result with the measurements
+	void getResult(SBenchmarkResult& result) const;
+
+private:
+	irr::IrrlichtDevice* Device;
+	irr::core::array<irr::u64> Samples;
+	irr::core::stringc Counters;
+	irr::u64 StartTime;
+	irr::u32 Runs;
+	irr::u32 Frame;
+	irr::u32 Repetitions;
+	irr::u32 Iterations;
+
+	irr::u64 DrawCalls;
+	irr::u64 PrimitivesDrawn;
+	irr::u64 NodesVisible;
+	irr::u64 SkinnedVertices;
+	irr::u64 ParticlesSimulated;
+};
+
+//! Number of memory allocations with operator new since the program started
+/** Add the difference as counter to see when code allocates more often. */
+extern irr::u64 getAllocationCount();
+
+//! Builds the scene used by the frame stats CSV and the scene benchmarks
+/** Camera, a grid of cubes, software skinned meshes and a particle system. */
+extern void addBenchmarkScene(irr::IrrlichtDevice* device);
+
+//! Write the results as JSON, one benchmark per line
+extern bool writeBenchmarkJson(const irr::core::array<SBenchmarkResult>& results, const char* fileName);
+
+//! Read results written by writeBenchmarkJson
+extern bool readBenchmarkJson(irr::core::array<SBenchmarkResult>& results, const char* fileName);
+
+//! Compare two JSON reports
+/** Prints a table of both median times. A benchmark is a regression if
+it got slower by more than thresholdPercent.
+\return Number of regressions and benchmarks with different counters. */
+extern irr::u32 compareBenchmarkJson(const char* baselineFile, const char* currentFile, irr::f32 thresholdPercent);
+
+#endif // _BENCHMARK_UTILS_H_
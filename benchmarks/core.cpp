@@ -0,0 +1,82 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+// Benchmarks of core engine mechanisms.
+
+#include "benchmarkUtils.h"
+
+using namespace irr;
+
+//! grab() and drop() pairs on many objects, from a single thread
+/** Compare reports of builds with and without _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+to see what the atomic reference counter costs. */
+bool referenceCounting(CBenchmark& bench)
+{
+	scene::IMesh* mesh = bench.getDevice()->getSceneManager()->getGeometryCreator()->createCubeMesh();
+	const u32 objectCount = 1024;
+	const u32 rounds = 100;
+	core::array<const IReferenceCounted*> objects(objectCount);
+	for (u32 i=0; i<objectCount; ++i)
+		objects.push_back(i & 1 ? (const IReferenceCounted*)mesh : mesh->getMeshBuffer(0));
+
+	while (bench.keepRunning())
+	{
+		// all grabs before the drops, so the compiler can't pair them up
+		for (u32 r=0; r<rounds; ++r)
+		{
+			for (u32 i=0; i<objectCount; ++i)
+				objects[i]->grab();
+			for (u32 i=0; i<objectCount; ++i)
+				objects[i]->drop();
+		}
+	}
+
+	const bool balanced = mesh->getReferenceCount() == 1;
+	mesh->drop();
+
+	bench.setIterations(objectCount * rounds);
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+	bench.addCounter("atomic", 1);
+#else
+	bench.addCounter("atomic", 0);
+#endif
+	return balanced;
+}
+
+
+//! Inserting, finding and removing path keys in a core::hash_map
+/** The keys look like the texture and mesh names the engine caches. */
+bool hashMap(CBenchmark& bench)
+{
+	const u32 keyCount = 4096;
+	const u32 lookups = 4;
+	core::array<io::path> keys(keyCount);
+	for (u32 i=0; i<keyCount; ++i)
+	{
+		c8 name[64];
+		snprintf_irr(name, 64, "../media/textures/level%u/texture_%u.png", i % 16, i);
+		keys.push_back(name);
+	}
+
+	u32 found = 0;
+	while (bench.keepRunning())
+	{
+		found = 0;
+		core::hash_map<io::path, u32> map;
+		for (u32 i=0; i<keyCount; ++i)
+			map.insert(keys[i], i);
+		for (u32 l=0; l<lookups; ++l)
+		{
+			for (u32 i=0; i<keyCount; ++i)
+				found += (map.find(keys[i]) != 0);
+		}
+		for (u32 i=0; i<keyCount; i+=2)
+			map.remove(keys[i]);
+		for (u32 i=0; i<keyCount; ++i)
+			found += (map.find(keys[i]) != 0);
+	}
+
+	bench.setIterations(keyCount * (lookups + 3));
+	bench.addCounter("found", found);
+	return found == keyCount * lookups + keyCount / 2;
+}
@@ -0,0 +1,227 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+// Benchmarks of file access, mesh loading and attribute serialization.
+
+#include "benchmarkUtils.h"
+
+using namespace irr;
+
+//! Reading all files of a zip archive
+bool archiveReading(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+	io::IFileArchive* archive = 0;
+	if (!fs->addFileArchive("../media/map-20kdm2.pk3", true, true, io::EFAT_UNKNOWN, "", &archive) || !archive)
+		return false;
+
+	const io::IFileList* list = archive->getFileList();
+	core::array<c8> buffer;
+	u64 bytes = 0;
+	u32 files = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<list->getFileCount(); ++i)
+		{
+			if (list->isDirectory(i))
+				continue;
+
+			io::IReadFile* file = archive->createAndOpenFile(i);
+			if (!file)
+				continue;
+
+			const u32 size = (u32)file->getSize();
+			buffer.set_used(size + 1);
+			file->read(buffer.pointer(), size);
+			file->drop();
+
+			if (bench.isCounting())
+			{
+				bytes += size;
+				++files;
+			}
+		}
+	}
+
+	fs->removeFileArchive(archive);
+
+	bench.setIterations(files);
+	bench.addCounter("files", files);
+	bench.addCounter("bytes", bytes);
+	return true;
+}
+
+
+//! Loading meshes of several formats, without the mesh cache
+bool meshLoading(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+
+	const c8* const files[] = {
+		"../media/ninja.b3d",
+		"../media/sydney.md2",
+		"../media/room.3ds",
+		"../media/dwarf.x",
+		"../media/earth.x",
+		"../media/faerie.md2"
+	};
+	const u32 fileCount = sizeof(files) / sizeof(files[0]);
+
+	u64 vertices = 0;
+	u64 allocations = 0;
+	bool allLoaded = true;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<fileCount; ++i)
+		{
+			const u64 allocationsBefore = getAllocationCount();
+			scene::IAnimatedMesh* mesh = smgr->getMesh(files[i]);
+			if (!mesh)
+			{
+				allLoaded = false;
+				continue;
+			}
+
+			if (bench.isCounting())
+			{
+				allocations += getAllocationCount() - allocationsBefore;
+				scene::IMesh* frame = mesh->getMesh(0);
+				for (u32 b=0; b<frame->getMeshBufferCount(); ++b)
+					vertices += frame->getMeshBuffer(b)->getVertexCount();
+			}
+			smgr->getMeshCache()->removeMesh(mesh);
+		}
+	}
+
+	bench.setIterations(fileCount);
+	bench.addCounter("vertices", vertices);
+	bench.addCounter("allocations", allocations);
+	return allLoaded;
+}
+
+
+//! Loading the Quake 3 level, which builds big vertex and index arrays
+bool levelLoading(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	io::IFileArchive* archive = 0;
+	if (!fs->addFileArchive("../media/map-20kdm2.pk3", true, true, io::EFAT_UNKNOWN, "", &archive) || !archive)
+		return false;
+
+	u64 vertices = 0;
+	u64 allocations = 0;
+	bool loaded = true;
+	while (bench.keepRunning())
+	{
+		const u64 allocationsBefore = getAllocationCount();
+		scene::IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+		if (!mesh)
+		{
+			loaded = false;
+			break;
+		}
+
+		if (bench.isCounting())
+		{
+			allocations += getAllocationCount() - allocationsBefore;
+			scene::IMesh* frame = mesh->getMesh(0);
+			for (u32 b=0; b<frame->getMeshBufferCount(); ++b)
+				vertices += frame->getMeshBuffer(b)->getVertexCount();
+		}
+		smgr->getMeshCache()->removeMesh(mesh);
+	}
+
+	fs->removeFileArchive(archive);
+
+	bench.setIterations(1);
+	bench.addCounter("vertices", vertices);
+	bench.addCounter("allocations", allocations);
+	return loaded;
+}
+
+
+//! Path handling of the file system on short, typical relative file names
+bool pathHandling(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+
+	const c8* const files[] = {
+		"../media/ninja.b3d",
+		"media/./textures/../wall.bmp",
+		"data\\models\\dwarf.x",
+		"a/b/c/../../d.png",
+		"scene.irr",
+		"levels/level01/../level02/map.bsp"
+	};
+	const u32 fileCount = sizeof(files) / sizeof(files[0]);
+	const u32 rounds = 1000;
+
+	u64 characters = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 r=0; r<rounds; ++r)
+		{
+			for (u32 i=0; i<fileCount; ++i)
+			{
+				io::path name(files[i]);
+				io::path absolute = fs->getAbsolutePath(name);
+				io::path flat = fs->getFileDir(name);
+				fs->flattenFilename(flat);
+				const io::path base = fs->getFileBasename(name, false);
+
+				if (bench.isCounting() && r == 0)
+					characters += flat.size() + base.size() + (absolute.size() >= name.size() ? 1 : 0);
+			}
+		}
+	}
+
+	bench.setIterations(rounds * fileCount);
+	bench.addCounter("characters", characters);
+	return true;
+}
+
+
+//! Writing and reading the attributes of a scene node and its material, like scene files do
+bool attributeSerialization(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+	video::IVideoDriver* driver = bench.getDevice()->getVideoDriver();
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+
+	scene::ISceneNode* source = smgr->addCubeSceneNode(10.f, 0, 1, core::vector3df(1,2,3), core::vector3df(0,45,0));
+	source->setName("box");
+	source->getMaterial(0).Shininess = 20.f;
+	scene::ISceneNode* target = smgr->addCubeSceneNode();
+	const u32 rounds = 100;
+
+	io::IAttributes* attributes = fs->createEmptyAttributes(driver);
+	u32 attributeCount = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 r=0; r<rounds; ++r)
+		{
+			attributes->clear();
+			source->serializeAttributes(attributes);
+			target->deserializeAttributes(attributes);
+
+			io::IAttributes* material = driver->createAttributesFromMaterial(source->getMaterial(0));
+			driver->fillMaterialStructureFromAttributes(target->getMaterial(0), material);
+
+			if (bench.isCounting() && r == 0)
+				attributeCount += attributes->getAttributeCount() + material->getAttributeCount();
+			material->drop();
+		}
+	}
+	attributes->drop();
+
+	const bool copied = target->getPosition() == source->getPosition()
+		&& core::stringc("box") == target->getName()
+		&& target->getMaterial(0).Shininess == 20.f;
+	source->remove();
+	target->remove();
+
+	bench.setIterations(rounds);
+	bench.addCounter("attributes", attributeCount);
+	return copied;
+}
@@ -0,0 +1,273 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+// This is the entry point for the Irrlicht benchmark suite.
+// Each benchmark renders a scripted scene or repeats some work headless,
+// with the virtual timer advancing in fixed steps. Results are written as
+// JSON, two reports can be compared to find regressions.
+//
+// usage:
+//   benchmarks [-driver null|burnings|all] [-filter text] [-repetitions count] [-json file]
+//   benchmarks -compare baseline.json current.json [-threshold percent]
+//   benchmarks -csv file [-driver null|burnings] [-frames count]
+// Run it from the benchmarks folder, media is loaded from ../media
+
+// This is an MSVC pragma to link against the Irrlicht library.
+// Other builds must link against it in the project files.
+#if defined(_MSC_VER)
+#pragma comment(lib, "Irrlicht.lib")
+#define _CRT_SECURE_NO_WARNINGS 1
+#endif // _MSC_VER
+
+#include "benchmarkUtils.h"
+#include <string.h>
+#include <stdlib.h>
+
+using namespace irr;
+
+struct SBenchmarkDefinition
+{
+	//! The benchmark entry point function, returns false when it could not run
+	bool(*benchmarkSignature)(CBenchmark& bench);
+
+	//! A descriptive name for the benchmark
+	const char * benchmarkName;
+};
+
+namespace
+{
+
+IrrlichtDevice* createBenchmarkDevice(video::E_DRIVER_TYPE driverType)
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = driverType;
+	params.WindowSize = core::dimension2d<u32>(640, 480);
+	params.LoggingLevel = ELL_ERROR;
+	// the engine runs some work in jobs, measure it with all processors
+	params.JobWorkerCount = -1;
+	return createDeviceEx(params);
+}
+
+const char* getDriverName(video::E_DRIVER_TYPE driverType)
+{
+	return driverType == video::EDT_BURNINGSVIDEO ? "burnings" : "null";
+}
+
+// Writes the frame stats of the scripted scene for every frame as CSV
+int writeFrameStatsCsv(video::E_DRIVER_TYPE driverType, u32 frames, const char* csvName)
+{
+	IrrlichtDevice* device = createBenchmarkDevice(driverType);
+	if (!device)
+	{
+		fprintf(stderr, "Could not create the device, the driver might be disabled\n");
+		return 1;
+	}
+
+	FILE* out = fopen(csvName, "w");
+	if (!out)
+	{
+		fprintf(stderr, "Could not open %s\n", csvName);
+		device->drop();
+		return 1;
+	}
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	// with a stopped timer all animations depend only on the frame number
+	ITimer* timer = device->getTimer();
+	timer->stop();
+	timer->setTime(0);
+
+	addBenchmarkScene(device);
+
+	fprintf(out, "frame,draw_calls,primitives,material_changes,texture_changes,"
+		"buffer_uploads,buffer_upload_bytes,textures_created,frame_arena_bytes,"
+		"nodes_visible,culled_box,culled_frustum_box,culled_frustum_sphere,culled_occlusion_query,"
+		"drawn_solid,drawn_transparent,drawn_transparent_effect,skinned_vertices,particles\n");
+	for (u32 frame = 0; frame < frames && device->run(); ++frame)
+	{
+		timer->setTime(frame * BenchmarkFrameTime);
+
+		driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,100,101,140));
+		smgr->drawAll();
+		driver->endScene();
+
+		const video::SFrameStats& d = driver->getFrameStats();
+		const scene::SSceneStats& s = smgr->getFrameStats();
+		fprintf(out, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", frame,
+			d.DrawCalls, d.PrimitivesDrawn, d.MaterialChanges, d.TextureChanges,
+			d.HardwareBufferUploads, d.HardwareBufferUploadBytes, d.TexturesCreated, d.FrameArenaBytes,
+			s.NodesVisible, s.NodesCulledByBox, s.NodesCulledByFrustumBox, s.NodesCulledByFrustumSphere,
+			s.NodesCulledByOcclusionQuery, s.NodesDrawnSolid, s.NodesDrawnTransparent,
+			s.NodesDrawnTransparentEffect, s.SkinnedVertices, s.ParticlesSimulated);
+	}
+
+	fclose(out);
+	device->drop();
+	return 0;
+}
+
+void printUsage(const char* name)
+{
+	fprintf(stderr, "usage:\n"
+		"  %s [-driver null|burnings|all] [-filter text] [-repetitions count] [-json file]\n"
+		"  %s -compare baseline.json current.json [-threshold percent]\n"
+		"  %s -csv file [-driver null|burnings] [-frames count]\n", name, name, name);
+}
+
+} // end anonymous namespace
+
+//! This is the main entry point for the Irrlicht benchmark suite.
+/** \return 0 on success. With -compare the number of regressions. */
+int main(int argumentCount, char * arguments[])
+{
+	#define BENCHMARK(x)\
+	{\
+		extern bool x(CBenchmark& bench);\
+		SBenchmarkDefinition newBenchmark;\
+		newBenchmark.benchmarkSignature = x;\
+		newBenchmark.benchmarkName = #x;\
+		benchmarks.push_back(newBenchmark);\
+	}
+
+	core::array<SBenchmarkDefinition> benchmarks;
+
+	BENCHMARK(sceneCulling);
+	BENCHMARK(skinning);
+	BENCHMARK(particles);
+	BENCHMARK(collision);
+	BENCHMARK(meshNormals);
+	BENCHMARK(meshWelding);
+	BENCHMARK(meshSimplification);
+	BENCHMARK(terrain);
+	BENCHMARK(levelVisibility);
+	BENCHMARK(octreeDrawing);
+	BENCHMARK(sceneChurn);
+	BENCHMARK(blit2D);
+	BENCHMARK(textDrawing);
+	BENCHMARK(guiRetainedDrawing);
+	BENCHMARK(largeListDrawing);
+	BENCHMARK(largeListEditing);
+	BENCHMARK(imageDecoding);
+	BENCHMARK(archiveReading);
+	BENCHMARK(meshLoading);
+	BENCHMARK(levelLoading);
+	BENCHMARK(pathHandling);
+	BENCHMARK(attributeSerialization);
+	BENCHMARK(referenceCounting);
+	BENCHMARK(hashMap);
+
+	core::array<video::E_DRIVER_TYPE> drivers;
+	const char* filter = 0;
+	const char* jsonName = "benchmarks.json";
+	const char* csvName = 0;
+	const char* compareBaseline = 0;
+	const char* compareCurrent = 0;
+	f32 threshold = 10.f;
+	u32 repetitions = 5;
+	u32 frames = 300;
+
+	for (int i = 1; i < argumentCount; ++i)
+	{
+		const bool hasValue = i + 1 < argumentCount;
+		if (!strcmp(arguments[i], "-driver") && hasValue)
+		{
+			++i;
+			if (!strcmp(arguments[i], "null") || !strcmp(arguments[i], "all"))
+				drivers.push_back(video::EDT_NULL);
+			if (!strcmp(arguments[i], "burnings") || !strcmp(arguments[i], "all"))
+				drivers.push_back(video::EDT_BURNINGSVIDEO);
+			if (drivers.empty())
+			{
+				fprintf(stderr, "Unknown driver %s\n", arguments[i]);
+				return 1;
+			}
+		}
+		else if (!strcmp(arguments[i], "-filter") && hasValue)
+			filter = arguments[++i];
+		else if (!strcmp(arguments[i], "-repetitions") && hasValue)
+			repetitions = (u32)atoi(arguments[++i]);
+		else if (!strcmp(arguments[i], "-json") && hasValue)
+			jsonName = arguments[++i];
+		else if (!strcmp(arguments[i], "-csv") && hasValue)
+			csvName = arguments[++i];
+		else if (!strcmp(arguments[i], "-frames") && hasValue)
+			frames = (u32)atoi(arguments[++i]);
+		else if (!strcmp(arguments[i], "-threshold") && hasValue)
+			threshold = (f32)atof(arguments[++i]);
+		else if (!strcmp(arguments[i], "-compare") && i + 2 < argumentCount)
+		{
+			compareBaseline = arguments[++i];
+			compareCurrent = arguments[++i];
+		}
+		else
+		{
+			printUsage(arguments[0]);
+			return 1;
+		}
+	}
+
+	if (compareBaseline)
+		return (int)compareBenchmarkJson(compareBaseline, compareCurrent, threshold);
+
+	if (drivers.empty())
+		drivers.push_back(video::EDT_NULL);
+
+	if (csvName)
+		return writeFrameStatsCsv(drivers[0], frames, csvName);
+
+	core::array<SBenchmarkResult> results;
+	u32 failed = 0;
+	for (u32 d = 0; d < drivers.size(); ++d)
+	{
+		if (!IrrlichtDevice::isDriverSupported(drivers[d]))
+		{
+			printf("Driver %s is not compiled in, skipped\n", getDriverName(drivers[d]));
+			continue;
+		}
+
+		for (u32 b = 0; b < benchmarks.size(); ++b)
+		{
+			if (filter && !strstr(benchmarks[b].benchmarkName, filter))
+				continue;
+
+			// a new device for each benchmark, so caches of one don't help the next
+			IrrlichtDevice* device = createBenchmarkDevice(drivers[d]);
+			if (!device)
+			{
+				printf("Could not create the %s device\n", getDriverName(drivers[d]));
+				++failed;
+				break;
+			}
+
+			CBenchmark bench(device, repetitions);
+			SBenchmarkResult result;
+			result.Name = benchmarks[b].benchmarkName;
+			result.Driver = getDriverName(drivers[d]);
+			if (benchmarks[b].benchmarkSignature(bench))
+			{
+				bench.getResult(result);
+				results.push_back(result);
+				printf("%-24s %-9s %14.1f ns\n", result.Name.c_str(), result.Driver.c_str(), result.MedianNs);
+			}
+			else
+			{
+				printf("%-24s %-9s failed\n", result.Name.c_str(), result.Driver.c_str());
+				++failed;
+			}
+
+			device->closeDevice();
+			device->run();
+			device->drop();
+		}
+	}
+
+	if (!writeBenchmarkJson(results, jsonName))
+	{
+		fprintf(stderr, "Could not write %s\n", jsonName);
+		return 1;
+	}
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,448 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+// Benchmarks of scene management: registration and culling, skinning,
+// particle systems, collision queries, normal recalculation, terrain LOD,
+// quake3 level visibility, octree drawing and adding and removing many nodes.
+
+#include "benchmarkUtils.h"
+#include <math.h>
+
+using namespace irr;
+
+namespace
+{
+
+// Frames rendered in each repetition of the scene benchmarks
+const u32 SceneFrames = 100;
+
+void addCubeGrid(scene::ISceneManager* smgr, s32 halfSize)
+{
+	video::IVideoDriver* driver = smgr->getVideoDriver();
+	video::ITexture* tiles = driver->getTexture("../media/t351sml.jpg");
+	video::ITexture* stones = driver->getTexture("../media/stones.jpg");
+	for (s32 x = -halfSize; x < halfSize; ++x)
+	{
+		for (s32 z = -halfSize; z < halfSize; ++z)
+		{
+			scene::ISceneNode* cube = smgr->addCubeSceneNode(10.f, 0, -1, core::vector3df(x * 40.f, 0, z * 40.f));
+			cube->setMaterialFlag(video::EMF_LIGHTING, false);
+			cube->setMaterialTexture(0, (x + z) & 1 ? tiles : stones);
+			cube->setAutomaticCulling((x & 1) ? scene::EAC_FRUSTUM_BOX : scene::EAC_BOX);
+		}
+	}
+}
+
+bool addNinjas(scene::ISceneManager* smgr, u32 count)
+{
+	scene::IAnimatedMesh* ninja = smgr->getMesh("../media/ninja.b3d");
+	if (!ninja)
+		return false;
+
+	for (u32 i = 0; i < count; ++i)
+	{
+		const core::vector3df pos((f32)(i % 4) * 30.f - 45.f, 0, (f32)(i / 4) * 30.f);
+		scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(ninja, 0, -1, pos);
+		node->setScale(core::vector3df(5.f, 5.f, 5.f));
+		node->setMaterialFlag(video::EMF_LIGHTING, false);
+		node->setAnimationSpeed(15.f + i);
+	}
+	return true;
+}
+
+void addParticles(scene::ISceneManager* smgr, const core::vector3df& pos, u32 particlesPerSecond)
+{
+	scene::IParticleSystemSceneNode* ps = smgr->addParticleSystemSceneNode(false, 0, -1, pos);
+	scene::IParticleEmitter* em = ps->createBoxEmitter(
+		core::aabbox3d<f32>(-10, 0, -10, 10, 2, 10), core::vector3df(0.0f, 0.05f, 0.0f),
+		particlesPerSecond, particlesPerSecond * 2, video::SColor(0,255,255,255), video::SColor(0,255,255,255), 800, 1600);
+	ps->setEmitter(em);
+	em->drop();
+	scene::IParticleAffector* paf = ps->createFadeOutParticleAffector();
+	ps->addAffector(paf);
+	paf->drop();
+	ps->setMaterialFlag(video::EMF_LIGHTING, false);
+	ps->setMaterialTexture(0, smgr->getVideoDriver()->getTexture("../media/particlegreen.jpg"));
+	ps->setMaterialType(video::EMT_TRANSPARENT_ADD_COLOR);
+}
+
+// camera circling around the center in the scene, one step per frame
+class CCircleCamera
+{
+public:
+	CCircleCamera(scene::ISceneManager* smgr, f32 radius, f32 height)
+		: Radius(radius), Height(height), Step(0)
+	{
+		Camera = smgr->addCameraSceneNode();
+		Camera->setFarValue(radius * 4.f);
+	}
+
+	void next()
+	{
+		const f32 angle = Step * 0.02f;
+		Camera->setPosition(core::vector3df(sinf(angle) * Radius, Height, cosf(angle) * Radius));
+		Camera->setTarget(core::vector3df(0, 0, 0));
+		++Step;
+	}
+
+private:
+	scene::ICameraSceneNode* Camera;
+	f32 Radius;
+	f32 Height;
+	u32 Step;
+};
+
+// the scene benchmarks all measure whole frames
+void runFrames(CBenchmark& bench, CCircleCamera* camera)
+{
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<SceneFrames; ++i)
+		{
+			if (camera)
+				camera->next();
+			bench.drawFrame();
+		}
+	}
+	bench.setIterations(SceneFrames);
+	bench.addFrameStatsCounters();
+}
+
+} // end anonymous namespace
+
+
+void addBenchmarkScene(IrrlichtDevice* device)
+{
+	scene::ISceneManager* smgr = device->getSceneManager();
+	smgr->addCameraSceneNode(0, core::vector3df(0, 60, -200), core::vector3df(0, 0, 0));
+	addCubeGrid(smgr, 10);
+	addNinjas(smgr, 4);
+	addParticles(smgr, core::vector3df(0, 20, 50), 200);
+}
+
+
+//! Registration and culling of many nodes with a moving camera
+bool sceneCulling(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	CCircleCamera camera(smgr, 400.f, 50.f);
+	addCubeGrid(smgr, 25);
+
+	runFrames(bench, &camera);
+	return true;
+}
+
+
+//! Software skinning of animated b3d meshes
+bool skinning(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	smgr->addCameraSceneNode(0, core::vector3df(0, 60, -150), core::vector3df(0, 0, 30));
+	if (!addNinjas(smgr, 16))
+		return false;
+
+	runFrames(bench, 0);
+	return true;
+}
+
+
+//! Emitting and moving particles
+bool particles(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	smgr->addCameraSceneNode(0, core::vector3df(0, 60, -150), core::vector3df(0, 0, 0));
+	for (u32 i=0; i<8; ++i)
+		addParticles(smgr, core::vector3df(i * 20.f - 80.f, 0, 0), 2000);
+
+	runFrames(bench, 0);
+	return true;
+}
+
+
+//! Ray queries against an octree triangle selector
+bool collision(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	scene::IAnimatedMesh* mesh = smgr->getMesh("../media/room.3ds");
+	if (!mesh)
+		return false;
+
+	scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh->getMesh(0));
+	scene::ITriangleSelector* selector = smgr->createOctreeTriangleSelector(node->getMesh(), node, 128);
+	node->setTriangleSelector(selector);
+
+	// rays from the center of the room in all directions
+	const core::aabbox3df& box = mesh->getBoundingBox();
+	const core::vector3df center = box.getCenter();
+	const f32 length = box.getExtent().getLength();
+	const u32 raysPerAxis = 64;
+	core::array<core::line3df> rays;
+	for (u32 i=0; i<raysPerAxis; ++i)
+	{
+		for (u32 j=0; j<raysPerAxis; ++j)
+		{
+			core::vector3df dir(0, 0, 1);
+			dir.rotateYZBy(i * 360.0 / raysPerAxis);
+			dir.rotateXZBy(j * 360.0 / raysPerAxis);
+			rays.push_back(core::line3df(center, center + dir * length));
+		}
+	}
+
+	scene::ISceneCollisionManager* collMan = smgr->getSceneCollisionManager();
+	u32 hits = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<rays.size(); ++i)
+		{
+			scene::SCollisionHit hit;
+			if (collMan->getCollisionPoint(hit, rays[i], selector) && bench.isCounting())
+				++hits;
+		}
+	}
+	selector->drop();
+
+	bench.setIterations(rays.size());
+	bench.addCounter("hits", hits);
+	return true;
+}
+
+
+//! Recalculating smooth normals and tangents of a large mesh, as done for deformed meshes
+bool meshNormals(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	scene::IMeshManipulator* manipulator = smgr->getMeshManipulator();
+	scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(10.f, 250, 250);
+	if (!sphere)
+		return false;
+	scene::IMesh* mesh = manipulator->createMeshWithTangents(sphere);
+	sphere->drop();
+
+	const u32 iterations = 10;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<iterations; ++i)
+		{
+			manipulator->recalculateNormals(mesh, true, true);
+			manipulator->recalculateTangents(mesh, true, true, false);
+		}
+	}
+
+	bench.setIterations(iterations);
+	bench.addCounter("vertices", mesh->getMeshBuffer(0)->getVertexCount());
+	mesh->drop();
+	return true;
+}
+
+
+//! Welding the vertices of a mesh where each triangle has its own vertices
+bool meshWelding(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	scene::IMeshManipulator* manipulator = smgr->getMeshManipulator();
+	scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(10.f, 48, 48);
+	if (!sphere)
+		return false;
+	scene::IMesh* mesh = manipulator->createMeshUniquePrimitives(sphere);
+	sphere->drop();
+
+	u32 vertices = 0;
+	while (bench.keepRunning())
+	{
+		scene::IMesh* welded = manipulator->createMeshWelded(mesh);
+		vertices = welded->getMeshBuffer(0)->getVertexCount();
+		welded->drop();
+	}
+
+	bench.addCounter("vertices", mesh->getMeshBuffer(0)->getVertexCount());
+	bench.addCounter("welded", vertices);
+	mesh->drop();
+	return true;
+}
+
+
+//! Creating levels of detail for a sphere, as done when loading far away props
+bool meshSimplification(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	scene::IMeshManipulator* manipulator = smgr->getMeshManipulator();
+	scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(10.f, 128, 128);
+	if (!sphere)
+		return false;
+
+	u32 triangles = 0;
+	while (bench.keepRunning())
+	{
+		scene::IAnimatedMesh* lodMesh = manipulator->createLodMesh(sphere, 4);
+		scene::IMesh* lowest = lodMesh->getMesh(0, 0);
+		triangles = lowest->getMeshBuffer(0)->getIndexCount() / 3;
+		lodMesh->drop();
+	}
+
+	bench.addCounter("triangles", sphere->getMeshBuffer(0)->getIndexCount() / 3);
+	bench.addCounter("lowest_triangles", triangles);
+	sphere->drop();
+	return true;
+}
+
+
+//! Terrain LOD updates while flying around
+bool terrain(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	// generate the heightmap, so it does not depend on enabled image loaders
+	const u32 size = 257;
+	video::IImage* heightmap = driver->createImage(video::ECF_R8G8B8, core::dimension2d<u32>(size, size));
+	for (u32 y=0; y<size; ++y)
+	{
+		for (u32 x=0; x<size; ++x)
+		{
+			const u32 h = (u32)(127.f + 60.f * sinf(x * 0.05f) + 60.f * cosf(y * 0.07f));
+			heightmap->setPixel(x, y, video::SColor(255, h, h, h));
+		}
+	}
+
+	core::array<c8> buffer(size * size * 4 + 1024);
+	buffer.set_used(buffer.allocated_size());
+	io::IWriteFile* writeFile = device->getFileSystem()->createMemoryWriteFile(buffer.pointer(), buffer.size(), "heightmap.png");
+	const bool written = driver->writeImageToFile(heightmap, writeFile);
+	const long fileSize = writeFile->getPos();
+	writeFile->drop();
+	heightmap->drop();
+	if (!written)
+		return false;
+
+	// centered around the origin, where the camera looks at
+	const f32 halfExtent = (size - 1) * 20.f;
+	io::IReadFile* readFile = device->getFileSystem()->createMemoryReadFile(buffer.const_pointer(), fileSize, "heightmap.png");
+	scene::ITerrainSceneNode* node = smgr->addTerrainSceneNode(readFile, 0, -1,
+		core::vector3df(-halfExtent, -200.f, -halfExtent), core::vector3df(0, 0, 0), core::vector3df(40.f, 2.f, 40.f));
+	readFile->drop();
+	if (!node)
+		return false;
+	node->setMaterialFlag(video::EMF_LIGHTING, false);
+
+	CCircleCamera camera(smgr, size * 10.f, 300.f);
+	runFrames(bench, &camera);
+	return true;
+}
+
+
+//! Drawing the potentially visible faces of a quake3 level while walking through it
+bool levelVisibility(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	io::IFileArchive* archive = 0;
+	if (!fs->addFileArchive("../media/map-20kdm2.pk3", true, true, io::EFAT_UNKNOWN, "", &archive) || !archive)
+		return false;
+
+	scene::IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+	fs->removeFileArchive(archive);
+	if (!mesh || mesh->getMeshType() != scene::EAMT_BSP)
+		return false;
+
+	scene::IQ3LevelMesh* level = (scene::IQ3LevelMesh*)mesh;
+	smgr->addQuake3LevelSceneNode(level);
+
+	// the camera looks around in the centers of the leafs
+	core::array<core::vector3df> path;
+	for (u32 i=0; i<level->getLeafCount(); ++i)
+	{
+		const scene::quake3::SBSPLeaf& leaf = level->getLeaf(i);
+		if (leaf.Cluster >= 0 && leaf.LeafFaceCount)
+			path.push_back(leaf.BoundingBox.getCenter());
+	}
+	if (path.empty())
+		return false;
+
+	scene::ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	u32 step = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<SceneFrames; ++i)
+		{
+			const core::vector3df& pos = path[(step / 10) % path.size()];
+			const f32 angle = step * 0.3f;
+			camera->setPosition(pos);
+			camera->setTarget(pos + core::vector3df(sinf(angle), 0, cosf(angle)));
+			++step;
+			bench.drawFrame();
+		}
+	}
+
+	bench.setIterations(SceneFrames);
+	bench.addFrameStatsCounters();
+	return true;
+}
+
+
+//! Drawing the visible parts of an octree node of a quake3 level
+bool octreeDrawing(CBenchmark& bench)
+{
+	io::IFileSystem* fs = bench.getDevice()->getFileSystem();
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	io::IFileArchive* archive = 0;
+	if (!fs->addFileArchive("../media/map-20kdm2.pk3", true, true, io::EFAT_UNKNOWN, "", &archive) || !archive)
+		return false;
+
+	scene::IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+	fs->removeFileArchive(archive);
+	if (!mesh)
+		return false;
+
+	scene::IOctreeSceneNode* node = smgr->addOctreeSceneNode(mesh->getMesh(0), 0, -1, 256);
+	const core::aabbox3df& box = node->getBoundingBox();
+
+	// the camera stands still for some frames and then turns or moves on
+	scene::ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	u32 step = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<SceneFrames; ++i)
+		{
+			const u32 view = step / 4;
+			const core::vector3df pos = box.getCenter() +
+				core::vector3df(sinf((view / 8) * 1.3f), 0.1f, cosf((view / 8) * 1.7f)) * box.getExtent() * 0.3f;
+			const f32 angle = view * 0.4f;
+			camera->setPosition(pos);
+			camera->setTarget(pos + core::vector3df(sinf(angle), -0.2f, cosf(angle)));
+			++step;
+			bench.drawFrame();
+		}
+	}
+
+	bench.setIterations(SceneFrames);
+	bench.addFrameStatsCounters();
+	return true;
+}
+
+
+//! Adding and removing many scene nodes with animators and children
+bool sceneChurn(CBenchmark& bench)
+{
+	scene::ISceneManager* smgr = bench.getDevice()->getSceneManager();
+	scene::ISceneNode* root = smgr->addEmptySceneNode();
+	const u32 nodeCount = 10000;
+	u32 added = 0;
+
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<nodeCount; ++i)
+		{
+			scene::ISceneNode* node = smgr->addEmptySceneNode(root);
+			smgr->addEmptySceneNode(node);
+			scene::ISceneNodeAnimator* anim = smgr->createRotationAnimator(core::vector3df(0, 1.f, 0));
+			node->addAnimator(anim);
+			anim->drop();
+		}
+		added = root->getChildren().size();
+		root->removeAll();
+	}
+
+	bench.setIterations(nodeCount);
+	return added == nodeCount;
+}
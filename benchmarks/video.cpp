@@ -0,0 +1,316 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+// Benchmarks of 2d drawing and image decoding.
+
+#include "benchmarkUtils.h"
+
+using namespace irr;
+
+//! Drawing many sprites from one texture
+bool blit2D(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	video::ITexture* images = driver->getTexture("../media/2ddemo.png");
+	if (!images)
+		return false;
+
+	const u32 frames = 50;
+	const u32 spritesPerFrame = 1000;
+	const core::rect<s32> source(349, 15, 385, 78);
+	while (bench.keepRunning())
+	{
+		for (u32 frame=0; frame<frames; ++frame)
+		{
+			bench.nextFrame();
+			driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,0,0,0));
+			for (u32 i=0; i<spritesPerFrame; ++i)
+			{
+				const core::position2d<s32> pos((i * 37 + frame) % 600, (i * 11) % 420);
+				driver->draw2DImage(images, pos, source, 0, video::SColor(255,255,255,255), true);
+			}
+			driver->endScene();
+		}
+	}
+
+	bench.setIterations(frames * spritesPerFrame);
+	return true;
+}
+
+
+//! Drawing many static labels and a list box with the built-in font
+bool textDrawing(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	gui::IGUIEnvironment* env = device->getGUIEnvironment();
+
+	const u32 labels = 1000;
+	for (u32 i=0; i<labels; ++i)
+	{
+		const core::rect<s32> rect((i % 8) * 80, (i / 8) * 4, (i % 8) * 80 + 78, (i / 8) * 4 + 12);
+		gui::IGUIStaticText* text = env->addStaticText((core::stringw(L"Label ") + core::stringw(i)).c_str(), rect);
+		if (i & 1)
+			text->setTextAlignment(gui::EGUIA_CENTER, gui::EGUIA_CENTER);
+	}
+	gui::IGUIListBox* list = env->addListBox(core::rect<s32>(0, 0, 300, 480));
+	for (u32 i=0; i<200; ++i)
+		list->addItem((core::stringw(L"Item number ") + core::stringw(i)).c_str());
+
+	const u32 frames = 50;
+	while (bench.keepRunning())
+	{
+		for (u32 frame=0; frame<frames; ++frame)
+		{
+			bench.nextFrame();
+			driver->beginScene(video::ECBF_COLOR, video::SColor(255,0,0,0));
+			env->drawAll();
+			driver->endScene();
+		}
+	}
+
+	env->clear();
+
+	bench.setIterations(frames);
+	bench.addCounter("labels", labels);
+	return true;
+}
+
+
+//! Drawing a gui in retained mode where one label changes every few frames
+/** Frames without changes are skipped, the software drivers also only
+redraw the changed area. */
+bool guiRetainedDrawing(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	gui::IGUIEnvironment* env = device->getGUIEnvironment();
+
+	const u32 windows = 12;
+	gui::IGUIStaticText* counter = 0;
+	for (u32 i=0; i<windows; ++i)
+	{
+		const s32 x = (i % 4) * 160;
+		const s32 y = (i / 4) * 160;
+		gui::IGUIWindow* window = env->addWindow(core::rect<s32>(x, y, x + 150, y + 150), false, L"Window");
+		for (u32 b=0; b<3; ++b)
+			env->addButton(core::rect<s32>(10, 30 + b * 30, 140, 55 + b * 30), window, -1, L"Button");
+		counter = env->addStaticText(L"0", core::rect<s32>(10, 120, 140, 140), true, false, window);
+	}
+
+	env->setRetainedMode(true);
+	driver->beginScene(video::ECBF_COLOR, video::SColor(255,0,0,0));
+	env->drawAll();
+	driver->endScene();
+
+	const u32 frames = 50;
+	u32 drawnFrames = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 frame=0; frame<frames; ++frame)
+		{
+			bench.nextFrame();
+			if (frame % 5 == 0)
+				counter->setText(core::stringw(frame).c_str());
+			if (!env->needsRedraw())
+				continue;
+
+			driver->beginScene(0);
+			env->drawAll();
+			driver->endScene();
+			if (bench.isCounting())
+				++drawnFrames;
+		}
+	}
+
+	env->setRetainedMode(false);
+	env->clear();
+
+	bench.setIterations(frames);
+	bench.addCounter("drawnFrames", drawnFrames);
+	return true;
+}
+
+
+namespace
+{
+
+//! A list box, a table and a tree view with a million rows each
+struct SLargeLists
+{
+	SLargeLists(gui::IGUIEnvironment* env)
+	{
+		List = env->addListBox(core::rect<s32>(0, 0, 210, 480));
+		Table = env->addTable(core::rect<s32>(215, 0, 425, 480));
+		Table->addColumn(L"Name");
+		Tree = env->addTreeView(core::rect<s32>(430, 0, 640, 480));
+
+		const u32 rows = 1000000;
+		for (u32 i=0; i<rows; ++i)
+		{
+			const core::stringw text = core::stringw(L"Row ") + core::stringw(i);
+			List->addItem(text.c_str());
+			Table->addRow(i);
+			Table->setCellText(i, 0, text);
+		}
+
+		// 1000 expanded folders with 999 files each
+		for (u32 i=0; i<1000; ++i)
+		{
+			gui::IGUITreeViewNode* folder = Tree->getRoot()->addChildBack(L"Folder");
+			for (u32 f=0; f<999; ++f)
+				folder->addChildBack(L"File");
+			folder->setExpanded(true);
+		}
+	}
+
+	//! Scrolls all three to the same part of their rows
+	void scrollTo(u32 permille)
+	{
+		gui::IGUIScrollBar* bars[] = { List->getVerticalScrollBar(), Table->getVerticalScrollBar(), Tree->getVerticalScrollBar() };
+		for (u32 i=0; i<3; ++i)
+			bars[i]->setPos((s32)((f64)bars[i]->getMax() * permille / 1000));
+	}
+
+	gui::IGUIListBox* List;
+	gui::IGUITable* Table;
+	gui::IGUITreeView* Tree;
+};
+
+} // end anonymous namespace
+
+
+//! Drawing a list box, a table and a tree view with a million rows each
+/** Jumps to another place every 10 frames and scrolls a bit in between. */
+bool largeListDrawing(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	gui::IGUIEnvironment* env = device->getGUIEnvironment();
+
+	SLargeLists lists(env);
+
+	const u32 frames = 50;
+	u32 place = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 frame=0; frame<frames; ++frame)
+		{
+			bench.nextFrame();
+			if (frame % 10 == 0)
+				place = (place + 379) % 997;
+			lists.scrollTo(place + frame % 10);
+
+			driver->beginScene(video::ECBF_COLOR, video::SColor(255,0,0,0));
+			env->drawAll();
+			driver->endScene();
+		}
+	}
+
+	env->clear();
+
+	bench.setIterations(frames);
+	return true;
+}
+
+
+//! Inserting and removing rows in the middle of a list box, a table and a tree view with a million rows each
+bool largeListEditing(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	gui::IGUIEnvironment* env = device->getGUIEnvironment();
+
+	SLargeLists lists(env);
+	lists.scrollTo(500);
+	env->drawAll();
+
+	gui::IGUITreeViewNode* folder = lists.Tree->getRoot()->getFirstChild();
+	for (u32 i=0; i<500; ++i)
+		folder = folder->getNextSibling();
+	gui::IGUITreeViewNode* file = folder->getFirstChild();
+	for (u32 i=0; i<500; ++i)
+		file = file->getNextSibling();
+
+	const u32 edits = 20;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<edits; ++i)
+		{
+			lists.List->insertItem(500000, L"Inserted");
+			lists.Table->addRow(500000);
+			gui::IGUITreeViewNode* inserted = folder->insertChildAfter(file, L"Inserted");
+			env->drawAll();
+
+			lists.List->removeItem(500000);
+			lists.Table->removeRow(500000);
+			folder->deleteChild(inserted);
+			env->drawAll();
+		}
+	}
+
+	env->clear();
+
+	bench.setIterations(edits);
+	return true;
+}
+
+
+//! Decoding jpg and png files
+bool imageDecoding(CBenchmark& bench)
+{
+	IrrlichtDevice* device = bench.getDevice();
+	video::IVideoDriver* driver = device->getVideoDriver();
+
+	const c8* const files[] = {
+		"../media/t351sml.jpg",
+		"../media/stones.jpg",
+		"../media/wall.jpg",
+		"../media/2ddemo.png",
+		"../media/irrlichtlogo2.png",
+		"../media/lightFalloff.png"
+	};
+	const u32 fileCount = sizeof(files) / sizeof(files[0]);
+
+	// keep the files in memory, only the decoding is measured
+	core::array<io::IReadFile*> memoryFiles;
+	for (u32 i=0; i<fileCount; ++i)
+	{
+		io::IReadFile* file = device->getFileSystem()->createAndOpenFile(files[i]);
+		if (!file)
+			continue;
+		c8* data = new c8[file->getSize()];
+		file->read(data, file->getSize());
+		memoryFiles.push_back(device->getFileSystem()->createMemoryReadFile(data, file->getSize(), files[i], true));
+		file->drop();
+	}
+	if (memoryFiles.size() != fileCount)
+	{
+		for (u32 i=0; i<memoryFiles.size(); ++i)
+			memoryFiles[i]->drop();
+		return false;
+	}
+
+	u64 pixels = 0;
+	while (bench.keepRunning())
+	{
+		for (u32 i=0; i<memoryFiles.size(); ++i)
+		{
+			memoryFiles[i]->seek(0);
+			video::IImage* image = driver->createImageFromFile(memoryFiles[i]);
+			if (image)
+			{
+				if (bench.isCounting())
+					pixels += image->getDimension().getArea();
+				image->drop();
+			}
+		}
+	}
+
+	for (u32 i=0; i<memoryFiles.size(); ++i)
+		memoryFiles[i]->drop();
+
+	bench.setIterations(fileCount);
+	bench.addCounter("pixels", pixels);
+	return true;
+}
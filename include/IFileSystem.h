@@ -37,9 +37,36 @@ public:
 	/** \param filename: Name of file to open.
 	\return Pointer to the created file interface.
 	The returned pointer should be dropped when no longer needed.
-	See IReferenceCounted::drop() for more information. */
+	See IReferenceCounted::drop() for more information.
+
+	This method may be called from several threads at once, for example
+	from jobs of IJobSystem, as long as no archives are added or removed
+	meanwhile. Archives on disk or in memory are read without touching
+	their read position, so the returned files can be read concurrently.
+	The files grab the file of their archive, so dropping them from
+	several threads needs _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_.
+	Each returned file must only be used by one thread at a time.
+	Encrypted zip entries and archives opened from other kinds of files
+	always have to be accessed from a single thread. */
 	virtual IReadFile* createAndOpenFile(const path& filename) =0;
 
+	//! Opens a file for read access, mapping files on disk into memory.
+	/** Like createAndOpenFile(), but files on disk are returned as
+	IMemoryReadFile when the engine is compiled with
+	_IRR_COMPILE_WITH_MAPPED_READ_FILE_ and mapping works. Loaders can
+	then parse the content in place, see getMemoryReadFile(). Otherwise
+	the result is the same as from createAndOpenFile().
+	Mapping only pays off for large files which are read completely or
+	randomly, like archives. It also has drawbacks: On POSIX systems
+	accessing the content of a file which got truncated by another
+	process meanwhile crashes with SIGBUS, and on Windows the file can't
+	be deleted or replaced while it's mapped.
+	\param filename: Name of file to open.
+	\return Pointer to the created file interface.
+	The returned pointer should be dropped when no longer needed.
+	See IReferenceCounted::drop() for more information. */
+	virtual IReadFile* createAndOpenMappedFile(const path& filename) =0;
+
 	//! Creates an IReadFile interface for accessing memory like a file.
 	/** This allows you to use a pointer to memory where an IReadFile is requested.
 	\param memory: A pointer to the start of the file in memory
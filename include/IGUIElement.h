@@ -43,6 +43,7 @@ public:
 		{
 			parent->addChildToEnd(this);
 			recalculateAbsolutePosition(true);
+			invalidate();
 		}
 	}
 
@@ -95,6 +96,7 @@ public:
 
 		DesiredRect = r;
 		updateAbsolutePosition();
+		invalidate();
 	}
 
 	//! Sets the relative rectangle of this element, maintaining its current width and height
@@ -129,6 +131,7 @@ public:
 		ScaleRect = r;
 
 		updateAbsolutePosition();
+		invalidate();
 	}
 
 
@@ -152,6 +155,7 @@ public:
 	{
 		NoClip = noClip;
 		updateAbsolutePosition();
+		invalidate();
 	}
 
 
@@ -169,6 +173,7 @@ public:
 	{
 		MaxSize = size;
 		updateAbsolutePosition();
+		invalidate();
 	}
 
 
@@ -181,6 +186,7 @@ public:
 		if (MinSize.Height < 1)
 			MinSize.Height = 1;
 		updateAbsolutePosition();
+		invalidate();
 	}
 
 
@@ -301,6 +307,7 @@ public:
 		{
 			addChildToEnd(child);
 			child->updateAbsolutePosition();
+			child->invalidate();
 		}
 	}
 
@@ -311,6 +318,7 @@ public:
 		for (; it != Children.end(); ++it)
 			if ((*it) == child)
 			{
+				child->invalidate();
 				(*it)->Parent = 0;
 				(*it)->drop();
 				Children.erase(it);
@@ -339,6 +347,17 @@ public:
 	}
 
 
+	//! Tells the gui environment that the look of this element changed.
+	/** Only needed in retained mode, see IGUIEnvironment::setRetainedMode().
+	The elements call it themselves when they are changed, applications only
+	when changing something an element can't know about. */
+	void invalidate()
+	{
+		if (Environment)
+			Environment->invalidate(this);
+	}
+
+
 	//! animate the element and its children.
 	virtual void OnPostRender(u32 timeMs)
 	{
@@ -381,7 +400,11 @@ public:
 	//! Sets the visible state of this element.
 	virtual void setVisible(bool visible)
 	{
-		IsVisible = visible;
+		if (IsVisible != visible)
+		{
+			IsVisible = visible;
+			invalidate();
+		}
 	}
 
 
@@ -500,6 +523,7 @@ public:
 	virtual void setEnabled(bool enabled)
 	{
 		IsEnabled = enabled;
+		invalidate();
 	}
 
 
@@ -507,6 +531,7 @@ public:
 	virtual void setText(const wchar_t* text)
 	{
 		Text = text;
+		invalidate();
 	}
 
 
@@ -561,8 +586,12 @@ public:
 		{
 			if (element == (*it))
 			{
+				if (element == *Children.getLast())
+					return true;
+
 				Children.erase(it);
 				Children.push_back(element);
+				element->invalidate();
 				return true;
 			}
 		}
@@ -584,6 +613,7 @@ public:
 			{
 				Children.erase(it);
 				Children.push_front(child);
+				child->invalidate();
 				return true;
 			}
 		}
@@ -78,6 +78,49 @@ public:
 	            Can be set to false to control that size yourself, p.E when not the full size should be used for UI. */
 	virtual void drawAll(bool useScreenSize=true) = 0;
 
+	//! Enables or disables the retained mode.
+	/** In retained mode the environment remembers which top level elements
+	changed since the last drawAll() call. With drivers which keep the back
+	buffer between frames (EDT_SOFTWARE and EDT_BURNINGSVIDEO) drawAll() then
+	only draws the area of the changed elements and of all elements
+	overlapping it. The application has to stop clearing the back buffer for
+	that, e.g. by calling beginScene(0). With the other drivers drawAll()
+	still draws everything, but needsRedraw() allows skipping whole frames
+	while nothing changed.
+	Drivers which support IVideoDriver::beginRecording2D() (EDT_OPENGL,
+	EDT_DIRECT3D9 and EDT_BURNINGSVIDEO) record the drawing of each changed
+	element once and draw the recorded quads of all elements with a few
+	calls, merged by texture. Elements whose drawing can't be recorded, like
+	the 3d view of a mesh viewer, are drawn as usual.
+	Elements notice the changes done with their own methods and by user input.
+	When changing something an element can't know about, like the content of
+	a texture it shows, call IGUIElement::invalidate(). Animated sprites of
+	buttons, list boxes and menus only move on when their element is drawn
+	again.
+	\param retained True to enable the retained mode, false to draw
+	everything on each drawAll() call, which is the default.
+	\param background Color which fills the redrawn area behind the
+	elements with the drivers which only redraw changed areas. */
+	virtual void setRetainedMode(bool retained, video::SColor background=video::SColor(255,0,0,0)) = 0;
+
+	//! Returns if the retained mode is enabled.
+	virtual bool isRetainedMode() const = 0;
+
+	//! Marks an element as changed, so the retained mode draws it again.
+	/** Usually called by IGUIElement::invalidate(). The whole top level
+	element containing it is drawn again, passing the root element draws
+	everything again. Does nothing when the retained mode is disabled.
+	\param element Changed element. */
+	virtual void invalidate(IGUIElement* element) = 0;
+
+	//! Checks if the gui has to be drawn again.
+	/** Runs the time based updates of the elements, like launching tooltips
+	and blinking cursors, so call it once per frame instead of drawAll() when
+	skipping frames.
+	\return True when something changed since the last drawAll() call, or
+	always when the retained mode is disabled. */
+	virtual bool needsRedraw() = 0;
+
 	//! Sets the focus to an element.
 	/** Causes a EGET_ELEMENT_FOCUS_LOST event followed by a
 	EGET_ELEMENT_FOCUSED event. If someone absorbed either of the events,
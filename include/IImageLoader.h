@@ -46,6 +46,18 @@ public:
 	\return Pointer to newly created image, or 0 upon error. */
 	virtual IImage* loadImage(io::IReadFile* file) const = 0;
 
+	//! Creates a surface from the file, decoded into a given color format
+	/** Loaders which can write the requested format directly while
+	decoding avoid a conversion of the image afterwards. Others return
+	the format of the file, so callers still have to check it.
+	\param file File handle to check.
+	\param format Wanted color format, ECF_UNKNOWN for the format of the file.
+	\return Pointer to newly created image, or 0 upon error. */
+	virtual IImage* loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format) const
+	{
+		return loadImage(file);
+	}
+
 	//! Creates a multiple surfaces from the file eg. whole cube map.
 	/** \param file File handle to check.
 	\param type Pointer to E_TEXTURE_TYPE where a recommended type of the texture will be stored.
@@ -0,0 +1,87 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_I_JOB_SYSTEM_H_INCLUDED
+#define IRR_I_JOB_SYSTEM_H_INCLUDED
+
+#include "IReferenceCounted.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Function run as a job by the job system.
+/** \param data The pointer passed to IJobSystem::addJob */
+typedef void (*JobFunction)(void* data);
+
+//! Function run by IJobSystem::parallelFor for a range of indices.
+/** It's called with several sub ranges, usually from several threads at once.
+\param data The pointer passed to IJobSystem::parallelFor
+\param begin First index of the range.
+\param end One behind the last index of the range. */
+typedef void (*ParallelForFunction)(void* data, u32 begin, u32 end);
+
+//! Counts unfinished jobs.
+/** Pass it to IJobSystem::addJob to wait for those jobs with IJobSystem::wait()
+or to start other jobs only once they are finished. It has to stay alive
+until all jobs added with it are finished. */
+struct SJobCounter
+{
+	SJobCounter() : Pending(0) {}
+
+	//! Number of unfinished jobs. Only changed by the job system.
+	s32 Pending;
+};
+
+//! Runs jobs on a pool of worker threads.
+/** IrrlichtDevice::getJobSystem() returns the pool of the device, so the
+engine and the application can share the threads instead of each starting
+their own. Each worker has its own queue of jobs. Jobs added from a worker
+go into its queue, idle workers steal jobs from the queues of the others.
+Jobs added from other threads are shared by all workers.
+With 0 worker threads all jobs run inside wait() and parallelFor() on the
+thread calling those. That is the case on targets without thread support
+and when SIrrlichtCreationParameters::JobWorkerCount is 0.
+Jobs should not block on anything but the job system, the workers can't
+run other jobs meanwhile. */
+class IJobSystem : public virtual IReferenceCounted
+{
+public:
+
+	//! Get the number of worker threads.
+	/** \return Number of threads of the pool, 0 when jobs only run on
+	threads waiting for them. */
+	virtual u32 getWorkerCount() const = 0;
+
+	//! Add a job.
+	/** \param function Function to run.
+	\param data Passed to the function.
+	\param counter When not 0 it is increased now and decreased once the job is finished.
+	\param dependency When not 0 the job only starts once all jobs of this counter are finished. */
+	virtual void addJob(JobFunction function, void* data, SJobCounter* counter=0, const SJobCounter* dependency=0) = 0;
+
+	//! Check if all jobs of a counter are finished.
+	virtual bool isDone(const SJobCounter& counter) const = 0;
+
+	//! Wait until all jobs of a counter are finished.
+	/** The calling thread runs jobs meanwhile, so this can also be called
+	inside of jobs. */
+	virtual void wait(const SJobCounter& counter) = 0;
+
+	//! Call a function for all indices of a range, spread over all threads.
+	/** Returns once the whole range is done. The calling thread works
+	on the range as well.
+	\param begin First index.
+	\param end One behind the last index.
+	\param function Called for sub ranges of [begin, end).
+	\param data Passed to the function.
+	\param grainSize Smallest number of indices passed to one call of the
+	function. With 0 the range is split into a few parts per thread. */
+	virtual void parallelFor(u32 begin, u32 end, ParallelForFunction function, void* data, u32 grainSize=0) = 0;
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -24,6 +24,17 @@ namespace io
 		*/
 		virtual const void *getBuffer() const = 0;
 	};
+
+	//! Returns the file as IMemoryReadFile if it's one of the types implementing that interface.
+	/** Loaders can use this to parse file content in place. Note that the
+	buffer always starts at the begin of the file, not at the current position.
+	\return 0 if the content is not available in memory. */
+	inline IMemoryReadFile* getMemoryReadFile(IReadFile* file)
+	{
+		if (file && (file->getType() == ERFT_MEMORY_READ_FILE || file->getType() == ERFT_MAPPED_READ_FILE))
+			return static_cast<IMemoryReadFile*>(file);
+		return 0;
+	}
 } // end namespace io
 } // end namespace irr
 
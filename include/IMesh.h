@@ -57,7 +57,10 @@ namespace scene
 		EAMT_SKINNED,
 
 		//! generic non-animated mesh
-		EAMT_STATIC
+		EAMT_STATIC,
+
+		//! mesh with several levels of detail, see SLodMesh
+		EAMT_LOD
 	};
 
 
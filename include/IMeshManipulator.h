@@ -76,7 +76,9 @@ namespace scene
 				bool angleWeighted = false) const=0;
 
 		//! Recalculates all normals of the mesh buffer.
-		/** \param buffer: Mesh buffer on which the operation is performed.
+		/** Large meshbuffers are calculated with the job system of the
+		device.
+		\param buffer: Mesh buffer on which the operation is performed.
 		\param smooth: If the normals shall be smoothed.
 		\param angleWeighted: If the normals shall be smoothed in relation to their angles. More expensive, but also higher precision. */
 		virtual void recalculateNormals(IMeshBuffer* buffer,
@@ -93,7 +95,9 @@ namespace scene
 				bool angleWeighted=false) const=0;
 
 		//! Recalculates tangents, requires a tangent mesh buffer
-		/** \param buffer Meshbuffer on which the operation is performed.
+		/** Large meshbuffers are calculated with the job system of the
+		device.
+		\param buffer Meshbuffer on which the operation is performed.
 		\param recalculateNormals If the normals shall be recalculated, otherwise original normals of the buffer are used unchanged.
 		\param smooth If the normals shall be smoothed.
 		\param angleWeighted If the normals shall be smoothed in relation to their angles. More expensive, but also higher precision.
@@ -303,7 +307,9 @@ namespace scene
 		virtual IMesh* createMeshUniquePrimitives(IMesh* mesh) const = 0;
 
 		//! Creates a copy of a mesh with vertices welded 
-		/** Note: Only 16-bit meshbuffers supported so far, 32-bit buffer are cloned
+		/** Vertices are only compared with vertices close to them, so this takes
+		linear time. Buffers with 16-bit and 32-bit indices are supported, the
+		welded buffers get 32-bit indices when more than 65535 vertices remain.
 		\param mesh Input mesh
 		\param tolerance The threshold for vertex comparisons.
 		\return Mesh without redundant vertices. If you no longer need
@@ -311,6 +317,44 @@ namespace scene
 		IReferenceCounted::drop() for more information. */
 		virtual IMesh* createMeshWelded(IMesh* mesh, f32 tolerance=core::ROUNDING_ERROR_f32) const = 0;
 
+		//! Creates a copy of a mesh with less triangles
+		/** Edges are collapsed into one of their vertices in the order of the
+		smallest quadric error, until only the wanted part of the triangles of
+		each meshbuffer is left. All meshbuffers and materials are kept and the
+		remaining vertices are not moved. Vertices on seams, where vertices with
+		the same position have different normals, texture coordinates or colors,
+		are only collapsed along the seam, together with the vertices on the
+		other side, so the seam stays closed. Vertices which are shared with
+		other meshbuffers are never removed, so there are no holes between them.
+		Vertices on open borders are only removed where the border is straight.
+		Vertices with the same position and attributes are welded before.
+		\param mesh Input mesh
+		\param ratio The part of the triangles to keep, from 0 to 1. Less might
+		be kept when triangles get degenerated, more when the edges which are
+		left can't be collapsed without flipping triangles, which is logged.
+		\return Mesh with less triangles. If you no longer need the mesh, you
+		should call IMesh::drop(). See IReferenceCounted::drop() for more
+		information. */
+		virtual IMesh* createMeshSimplified(IMesh* mesh, f32 ratio) const = 0;
+
+		//! Creates a mesh with several levels of detail
+		/** The first level is the mesh itself. Level i is simplified from the
+		original mesh with createMeshSimplified() and a ratio of ratio^i, so
+		each level has about ratio times the triangles of the level before it.
+		A mesh scene node showing the returned mesh draws the level which fits
+		its size on the screen.
+		\param mesh Input mesh
+		\param lodCount Number of levels, including the mesh itself.
+		\param ratio The part of the triangles of a level which is kept for
+		the next level.
+		\param screenSize Part of the screen height which the bounding sphere
+		of the mesh needs to cover for the first level to be drawn. The size
+		for each following level is multiplied by ratio.
+		\return Mesh of type EAMT_LOD, which can be casted to SLodMesh. If you
+		no longer need the mesh, you should call IMesh::drop(). See
+		IReferenceCounted::drop() for more information. */
+		virtual IAnimatedMesh* createLodMesh(IMesh* mesh, u32 lodCount=4, f32 ratio=0.5f, f32 screenSize=0.25f) const = 0;
+
 		//! Get amount of polygons in mesh.
 		/** \param mesh Input mesh
 		\return Number of polygons in mesh. */
@@ -11,6 +11,10 @@
 #include "ITimer.h"
 #include <limits.h>	// for INT_MAX (we should have a S32_MAX...)
 
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
 namespace irr
 {
 
@@ -54,17 +58,64 @@ struct SProfileData
 	}
 
 	//! Longest time a profile call for this id took from start until it was stopped again.
+	/** In milliseconds, use getLongestTimeNanoseconds() for short calls. */
 	u32 getLongestTime() const
 	{
-		return LongestTime;
+		return (u32)(LongestTime / 1000000);
 	}
 
 	//! Time spend between start/stop
+	/** In milliseconds, use getTimeSumNanoseconds() for short calls. */
 	u32 getTimeSum() const
+	{
+		return (u32)(TimeSum / 1000000);
+	}
+
+	//! Longest time a profile call for this id took in nanoseconds.
+	u64 getLongestTimeNanoseconds() const
+	{
+		return LongestTime;
+	}
+
+	//! Time spend between start/stop in nanoseconds.
+	u64 getTimeSumNanoseconds() const
 	{
 		return TimeSum;
 	}
 
+	//! Time in nanoseconds which the given percentage of the calls didn't exceed.
+	/** The times of all calls since the last reset are counted in a histogram
+	with 8 buckets for each power of two, so the result is the middle of a
+	bucket and off by about 6% at most. For example getPercentileTime(0.95f)
+	returns the time 95% of the calls were faster than.
+	\param percentile Value between 0 and 1, 0.5 for the median.
+	\return Time in nanoseconds or 0 when the data was never stopped. */
+	u64 getPercentileTime(f32 percentile) const
+	{
+		u32 total = 0;
+		for ( u32 i=0; i<HistogramSize; ++i )
+			total += Histogram[i];
+		if ( !total )
+			return 0;
+		// the call with this rank, counting from 1
+		u32 rank = (u32)core::ceil32(core::clamp(percentile, 0.f, 1.f) * total);
+		if ( rank == 0 )
+			rank = 1;
+		u32 calls = 0;
+		for ( u32 i=0; i<HistogramSize; ++i )
+		{
+			calls += Histogram[i];
+			if ( calls >= rank )
+				return core::min_(getBucketTime(i), LongestTime);
+		}
+		return LongestTime;
+	}
+
+	//! Number of buckets in the histogram of the call times
+	/** Times up to 8 nanoseconds each have their own bucket, longer times
+	have 8 buckets for each power of two up to 2^40 nanoseconds. */
+	enum { HistogramSize = 8 + 37*8 };
+
 private:
 
 	// just to be used for searching as it does no initialization besides id
@@ -77,6 +128,41 @@ private:
 		TimeSum = 0;
 		LastTimeStarted = 0;
 		StartStopCounter = 0;
+		for ( u32 i=0; i<HistogramSize; ++i )
+			Histogram[i] = 0;
+	}
+
+	// count the time of a call for the percentiles
+	void addSample(u64 time)
+	{
+		++Histogram[getBucket(time)];
+	}
+
+	// bucket index of a time, the 3 bits below the highest one select the bucket of its power of two
+	static u32 getBucket(u64 time)
+	{
+		if ( time < 8 )
+			return (u32)time;
+		if ( time >> 40 )
+			return HistogramSize-1;
+		u32 bit = 3;
+		for ( u32 step=32; step>0; step >>= 1 )
+		{
+			if ( (time >> (bit + step)) != 0 )
+				bit += step;
+		}
+		const u32 bucket = (bit - 2) * 8 + (u32)(time >> (bit - 3)) - 8;
+		return bucket < HistogramSize ? bucket : HistogramSize-1;
+	}
+
+	// time in the middle of a bucket
+	static u64 getBucketTime(u32 bucket)
+	{
+		if ( bucket < 8 )
+			return bucket;
+		const u32 shift = bucket / 8 - 1;
+		const u64 first = (u64)(8 + bucket % 8) << shift;
+		return first + (((u64)1 << shift) >> 1);
 	}
 
 	s32 Id;
@@ -85,10 +171,12 @@ private:
 
 	s32 StartStopCounter; // 0 means stopped > 0 means it runs.
     u32 CountCalls;
-    u32 LongestTime;
-    u32 TimeSum;
+    u64 LongestTime;	// all times in nanoseconds
+    u64 TimeSum;
 
-    u32 LastTimeStarted;
+    u64 LastTimeStarted;
+
+	u32 Histogram[HistogramSize];	// number of calls for each range of times
 };
 
 //! Code-profiler. Please check the example in the Irrlicht examples folder about how to use it.
@@ -98,11 +186,13 @@ private:
 // And also why it works with id's instead of strings in the start/stop functions even if it makes using
 // the class slightly harder.
 // The class comes without reference-counting because the profiler instance is never released (TBD).
+// The profile data is only changed by one thread, so start/stop need no locks. Other threads only add
+// trace events, which claim their slots with atomic operations.
 class IProfiler
 {
 public:
 	//! Constructor. You could use this to create a new profiler, but usually getProfiler() is used to access the global instance.
-    IProfiler()	: Timer(0), NextAutoId(INT_MAX)
+    IProfiler()	: Timer(0), NextTraceEvent(0), TraceEventsWrapped(0), Tracing(false), ProfilingThread(1), NextAutoId(INT_MAX)
 	{}
 
 	virtual ~IProfiler()
@@ -145,7 +235,7 @@ public:
 	//! Get the profile data
 	/** \param id Same value as used in ::add
 	\return Profile data for the given id or 0 when it does not exist.	*/
-    inline const SProfileData* getProfileDataById(u32 id);
+    inline const SProfileData* getProfileDataById(u32 id) const;
 
 	//! Get the number of profile groups. Will be at least 1.
 	/** NOTE: The first groups is always L"overview" which is an overview for all existing groups */
@@ -171,6 +261,9 @@ public:
 	//! Start profile-timing for the given id
 	/** This increases an internal run-counter for the given id. It will profile as long as that counter is > 0.
 	NOTE: you have to add the id first with one of the ::add functions
+	NOTE: The profile data is only collected on the thread which created the profiler,
+	that's the first one calling getProfiler(), usually the main thread. On other threads
+	start and stop only record events while tracing (see startTrace()).
 	*/
 	inline void start(s32 id);
 
@@ -205,16 +298,79 @@ public:
 	\param groupIndex_	*/
     virtual void printGroup(core::stringw &result, u32 groupIndex, bool suppressUncalled) const = 0;
 
+	//! Start recording each start and stop with its time
+	/** The events can be written with printTrace() to look at single frames
+	and the nesting of the profiled scopes. Events of all threads go into
+	the same buffer, each slot is claimed with an atomic operation.
+	\param maxEvents Size of the event buffer. When it's full the oldest events
+	are overwritten, so it holds the last frames at any time. */
+	inline void startTrace(u32 maxEvents=65536);
+
+	//! Stop recording events, the recorded events are kept until the next startTrace.
+	void stopTrace()
+	{
+		Tracing = false;
+	}
+
+	//! Check if start and stop events are currently recorded.
+	bool isTracing() const
+	{
+		return Tracing;
+	}
+
+	//! Write the recorded events in the Chrome trace event format (JSON)
+	/** The result can be loaded in chrome://tracing or other tools
+	supporting that format. Each thread gets its own track. Call it after
+	stopTrace() when other threads might still add events.
+	\param result Receives the result string. */
+	virtual void printTrace(core::stringc &result) const = 0;
+
 protected:
 
+	//! A start or stop recorded while tracing
+	struct SProfileEvent
+	{
+		s32 Id;
+		u32 Thread;
+		bool Start;
+		u64 Time;
+	};
+
     inline u32 addGroup(const core::stringw &name);
 
+	inline void addTraceEvent(s32 id, bool start, u64 time);
+
+	//! Id of the calling thread for the trace events
+	virtual u32 getTraceThreadId() const
+	{
+		return 1;
+	}
+
+	//! Check if the calling thread is the one collecting profile data
+	bool isProfilingThread() const
+	{
+		return getTraceThreadId() == ProfilingThread;
+	}
+
+	//! Get the number of events in the trace buffer and the index of the oldest one
+	inline u32 getTraceEventCount(u32& firstEvent) const;
+
 	// I would prefer using os::Timer, but os.h is not in the public interface so far.
 	// Timer must be initialized by the implementation.
     ITimer * Timer;
 	core::array<SProfileData> ProfileDatas;
     core::array<SProfileData> ProfileGroups;
 
+	// ring buffer of events while tracing, oldest event at NextTraceEvent once full.
+	// Both counters are only changed with atomic operations.
+	core::array<SProfileEvent> TraceEvents;
+	u32 NextTraceEvent;
+	u32 TraceEventsWrapped;
+	bool Tracing;
+
+	// thread which may change the profile data, set by the implementation
+	u32 ProfilingThread;
+
 private:
     s32 NextAutoId;	// for giving out id's automatically
 };
@@ -280,12 +436,23 @@ protected:
 
 void IProfiler::start(s32 id)
 {
+	if ( !isProfilingThread() )
+	{
+		if ( Tracing && Timer )
+			addTraceEvent(id, true, Timer->getRealTimeNanoseconds());
+		return;
+	}
+
 	s32 idx = ProfileDatas.binary_search(SProfileData(id));
 	if ( idx >= 0 && Timer )
 	{
 		++ProfileDatas[idx].StartStopCounter;
 		if (ProfileDatas[idx].StartStopCounter == 1 )
-			ProfileDatas[idx].LastTimeStarted = Timer->getRealTime();
+		{
+			ProfileDatas[idx].LastTimeStarted = Timer->getRealTimeNanoseconds();
+			if ( Tracing )
+				addTraceEvent(id, true, ProfileDatas[idx].LastTimeStarted);
+		}
 	}
 }
 
@@ -293,7 +460,14 @@ void IProfiler::stop(s32 id)
 {
 	if ( Timer )
 	{
-		const u32 timeNow = Timer->getRealTime();
+		const u64 timeNow = Timer->getRealTimeNanoseconds();
+		if ( !isProfilingThread() )
+		{
+			if ( Tracing )
+				addTraceEvent(id, false, timeNow);
+			return;
+		}
+
 		const s32 idx = ProfileDatas.binary_search(SProfileData(id));
 		if ( idx >= 0 )
 		{
@@ -303,11 +477,14 @@ void IProfiler::stop(s32 id)
 			{
 				// update data for this id
 				++data.CountCalls;
-				const u32 diffTime = timeNow - data.LastTimeStarted;
+				const u64 diffTime = timeNow - data.LastTimeStarted;
 				data.TimeSum += diffTime;
 				if ( diffTime > data.LongestTime )
 					data.LongestTime = diffTime;
 				data.LastTimeStarted = 0;
+				data.addSample(diffTime);
+				if ( Tracing )
+					addTraceEvent(id, false, timeNow);
 
 				// update data of it's group
 				SProfileData & group = ProfileGroups[data.GroupIndex];
@@ -316,6 +493,7 @@ void IProfiler::stop(s32 id)
 				if ( diffTime > group.LongestTime )
 					group.LongestTime = diffTime;
 				group.LastTimeStarted = 0;
+				group.addSample(diffTime);
 			}
 			else if ( ProfileDatas[idx].StartStopCounter < 0 )
 			{
@@ -383,6 +561,62 @@ u32 IProfiler::addGroup(const core::stringw &name)
     return ProfileGroups.size()-1;
 }
 
+void IProfiler::startTrace(u32 maxEvents)
+{
+	TraceEvents.set_used(maxEvents > 0 ? maxEvents : 1);
+	NextTraceEvent = 0;
+	TraceEventsWrapped = 0;
+	Tracing = true;
+}
+
+void IProfiler::addTraceEvent(s32 id, bool start, u64 time)
+{
+	// several threads can add events, so each one claims its slot first
+	const u32 size = TraceEvents.size();
+	u32 slot;
+	u32 next;
+#if defined(_MSC_VER)
+	do
+	{
+		slot = (u32)_InterlockedCompareExchange(reinterpret_cast<volatile long*>(&NextTraceEvent), 0, 0);
+		next = slot + 1 < size ? slot + 1 : 0;
+	} while ( (u32)_InterlockedCompareExchange(reinterpret_cast<volatile long*>(&NextTraceEvent), (long)next, (long)slot) != slot );
+	if ( !next )
+		_InterlockedExchange(reinterpret_cast<volatile long*>(&TraceEventsWrapped), 1);
+#elif defined(__GNUC__)
+	slot = __atomic_load_n(&NextTraceEvent, __ATOMIC_RELAXED);
+	do
+	{
+		next = slot + 1 < size ? slot + 1 : 0;
+	} while ( !__atomic_compare_exchange_n(&NextTraceEvent, &slot, next, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) );
+	if ( !next )
+		__atomic_store_n(&TraceEventsWrapped, 1, __ATOMIC_RELAXED);
+#else
+	slot = NextTraceEvent;
+	next = slot + 1 < size ? slot + 1 : 0;
+	NextTraceEvent = next;
+	if ( !next )
+		TraceEventsWrapped = 1;
+#endif
+
+	SProfileEvent& e = TraceEvents[slot];
+	e.Id = id;
+	e.Thread = getTraceThreadId();
+	e.Start = start;
+	e.Time = time;
+}
+
+u32 IProfiler::getTraceEventCount(u32& firstEvent) const
+{
+	if ( TraceEventsWrapped )
+	{
+		firstEvent = NextTraceEvent;
+		return TraceEvents.size();
+	}
+	firstEvent = 0;
+	return NextTraceEvent;
+}
+
 bool IProfiler::findDataIndex(u32 & result, const core::stringw &name) const
 {
 	for ( u32 i=0; i < ProfileDatas.size(); ++i )
@@ -397,7 +631,7 @@ bool IProfiler::findDataIndex(u32 & result, const core::stringw &name) const
 	return false;
 }
 
-const SProfileData* IProfiler::getProfileDataById(u32 id)
+const SProfileData* IProfiler::getProfileDataById(u32 id) const
 {
 	SProfileData data(id);
     const s32 idx = ProfileDatas.binary_search(data);
@@ -12,6 +12,39 @@ namespace irr
 {
 namespace scene
 {
+namespace quake3
+{
+	//! A leaf of the bsp tree of a quake3 level
+	struct SBSPLeaf
+	{
+		//! Visibility cluster of the leaf, -1 for leafs inside of walls
+		s32 Cluster;
+
+		//! Box around the leaf, in the coordinate system of the level mesh
+		core::aabbox3df BoundingBox;
+
+		//! First entry of the leaf in the leaf face list, see IQ3LevelMesh::getLeafFace()
+		u32 FirstLeafFace;
+
+		//! Number of faces in the leaf
+		u32 LeafFaceCount;
+	};
+
+	//! Indices of a face of a quake3 level in the geometry mesh
+	struct SBSPFace
+	{
+		//! Index of the meshbuffer in the E_Q3_MESH_GEOMETRY mesh, -1 if the face has no geometry there
+		s32 MeshBuffer;
+
+		//! First index of the face in the meshbuffer
+		u32 FirstIndex;
+
+		//! Number of indices of the face
+		u32 IndexCount;
+	};
+
+} // end namespace quake3
+
 	//! Interface for a Mesh which can be loaded directly from a Quake3 .bsp-file.
 	/** The Mesh tries to load all textures of the map.*/
 	class IQ3LevelMesh : public IAnimatedMesh
@@ -37,6 +70,35 @@ namespace scene
 
 		//! returns the requested brush entity
 		virtual IMesh* getBrushEntityMesh(quake3::IEntity &ent) const = 0;
+
+		//! Returns the leaf of the bsp tree which contains a position
+		/** \param pos Position in the coordinate system of the level mesh.
+		\return Index of the leaf for getLeaf() or -1 if the level has no bsp tree. */
+		virtual s32 findLeaf(const core::vector3df& pos) const = 0;
+
+		//! Returns the number of leafs of the bsp tree
+		virtual u32 getLeafCount() const = 0;
+
+		//! Returns a leaf of the bsp tree
+		virtual const quake3::SBSPLeaf& getLeaf(u32 index) const = 0;
+
+		//! Returns the face for an entry of the leaf face list
+		/** \return Index of the face for getFace(). */
+		virtual u32 getLeafFace(u32 index) const = 0;
+
+		//! Returns the number of faces of the level
+		virtual u32 getFaceCount() const = 0;
+
+		//! Returns where the indices of a face are in the E_Q3_MESH_GEOMETRY mesh
+		virtual const quake3::SBSPFace& getFace(u32 index) const = 0;
+
+		//! Checks the potentially visible set of a cluster
+		/** \param from Cluster of the viewer.
+		\param to Cluster to check.
+		\return False if nothing in cluster to can be seen from cluster from.
+		Always true if the level has no visibility data or the viewer is
+		outside of all clusters. */
+		virtual bool isClusterVisible(s32 from, s32 to) const = 0;
 	};
 
 } // end namespace scene
@@ -11,6 +11,10 @@
 	#include "leakHunter.h"
 #endif
 
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
 namespace irr
 {
 
@@ -93,7 +97,19 @@ namespace irr
 		You will not have to drop the pointer to the loaded texture,
 		because the name of the method does not start with 'create'.
 		The texture is stored somewhere by the driver. */
-		void grab() const { ++ReferenceCounter; }
+		void grab() const
+		{
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+			// whoever hands the object to us still holds a reference, so no ordering is needed
+	#if defined(_MSC_VER)
+			_InterlockedIncrement(reinterpret_cast<volatile long*>(&ReferenceCounter));
+	#else
+			__atomic_fetch_add(&ReferenceCounter, 1, __ATOMIC_RELAXED);
+	#endif
+#else
+			++ReferenceCounter;
+#endif
+		}
 
 		//! Drops the object. Decrements the reference counter by one.
 		/** The IReferenceCounted class provides a basic reference
@@ -126,10 +142,19 @@ namespace irr
 		bool drop() const
 		{
 			// someone is doing bad reference counting.
-			IRR_DEBUG_BREAK_IF(ReferenceCounter <= 0)
-
-			--ReferenceCounter;
-			if (!ReferenceCounter)
+			IRR_DEBUG_BREAK_IF(getReferenceCount() <= 0)
+
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+			// release our writes to the object and acquire those of other threads before deleting it
+	#if defined(_MSC_VER)
+			const s32 count = _InterlockedDecrement(reinterpret_cast<volatile long*>(&ReferenceCounter));
+	#else
+			const s32 count = __atomic_sub_fetch(&ReferenceCounter, 1, __ATOMIC_ACQ_REL);
+	#endif
+#else
+			const s32 count = --ReferenceCounter;
+#endif
+			if (!count)
 			{
 				delete this;
 				return true;
@@ -142,7 +167,11 @@ namespace irr
 		/** \return Current value of the reference counter. */
 		s32 getReferenceCount() const
 		{
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_) && !defined(_MSC_VER)
+			return __atomic_load_n(&ReferenceCounter, __ATOMIC_RELAXED);
+#else
 			return ReferenceCounter;
+#endif
 		}
 
 		//! Returns the debug name of the object.
@@ -171,7 +200,12 @@ namespace irr
 		const c8* DebugName;
 
 		//! The reference counter. Mutable to do reference counting on const objects.
+		/** Only accessed with atomic operations when _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_ is defined. */
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_) && defined(_MSC_VER)
+		mutable volatile s32 ReferenceCounter;
+#else
 		mutable s32 ReferenceCounter;
+#endif
 	};
 
 } // end namespace irr
@@ -17,6 +17,7 @@
 #include "EMeshWriterEnums.h"
 #include "SceneParameters.h"
 #include "IGeometryCreator.h"
+#include "SSceneStats.h"
 #include "ISkinnedMesh.h"
 #include "IXMLWriter.h"
 
@@ -25,6 +26,11 @@ namespace irr
 	struct SKeyMap;
 	struct SEvent;
 
+namespace core
+{
+	class IJobSystem;
+} // end namespace core
+
 namespace io
 {
 	class IReadFile;
@@ -117,6 +123,7 @@ namespace scene
 	class IMeshWriter;
 	class IMetaTriangleSelector;
 	class IOctreeSceneNode;
+	class IQ3LevelMesh;
 	class IParticleSystemSceneNode;
 	class ISceneCollisionManager;
 	class ISceneLoader;
@@ -422,6 +429,12 @@ namespace scene
 		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
 		virtual io::IFileSystem* getFileSystem() = 0;
 
+		//! Get the job system used by the scene nodes
+		/** Shadow volume scene nodes create their shadow volumes in jobs of it.
+		\return Pointer to the job system of the device, 0 if there is none.
+		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
+		virtual core::IJobSystem* getJobSystem() = 0;
+
 		//! adds Volume Lighting Scene Node.
 		/** Example Usage:
 			scene::IVolumeLightSceneNode * n = smgr->addVolumeLightSceneNode(0, -1,
@@ -906,6 +919,20 @@ namespace scene
 												ISceneNode* parent=0, s32 id=-1
 												) = 0;
 
+		//! Adds a scene node for rendering the geometry of a quake3 level to the scene graph.
+		/** The node finds the leaf of the bsp tree the camera is in and
+		only draws the faces of the leafs in the potentially visible set
+		of that leaf which are inside the view frustum. It draws the
+		E_Q3_MESH_GEOMETRY mesh of the level, shader and fog meshes still
+		need their own nodes.
+		\param level The loaded level, for example returned by getMesh("level.bsp").
+		\param parent Parent of the scene node. Can be NULL if no parent.
+		\param id Id of the node. This id can be used to identify the scene node.
+		\return Pointer to the scene node if successful, otherwise NULL.
+		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
+		virtual IMeshSceneNode* addQuake3LevelSceneNode(IQ3LevelMesh* level,
+			ISceneNode* parent=0, s32 id=-1) = 0;
+
 
 		//! Adds an empty scene node to the scene graph.
 		/** Can be used for doing advanced transformations
@@ -1691,6 +1718,22 @@ namespace scene
 		\return True if node is not visible in the current scene, else
 		false. */
 		virtual bool isCulled(const ISceneNode* node) const =0;
+
+		//! Returns counters of a finished frame
+		/** The scene manager keeps the counters of the last frames. A
+		frame ends with drawAll().
+		\param framesAgo 0 for the last finished frame, 1 for the one
+		before and so on. Frames which are no longer stored return
+		zeroed counters.
+		\return Counters of the frame. */
+		virtual const SSceneStats& getFrameStats(u32 framesAgo=0) const =0;
+
+		//! Returns how many finished frames are stored for getFrameStats()
+		virtual u32 getFrameStatsCount() const =0;
+
+		//! Returns the counters of the frame which is currently drawn
+		/** Scene nodes use this to add their own counts. */
+		virtual SSceneStats& getCurrentFrameStats() =0;
 	};
 
 
@@ -77,6 +77,42 @@ namespace scene
 		}
 
 
+		//! Scene nodes are allocated from the pools of core::allocateSmallObject
+		static void* operator new(size_t size)
+		{
+			return core::allocateSmallObject(size);
+		}
+
+		//! Frees memory of scene nodes, size is the one of the derived class
+		static void operator delete(void* ptr, size_t size)
+		{
+			core::deallocateSmallObject(ptr, size);
+		}
+
+		//! Placement new, constructs in memory owned by the caller
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		//! Matches placement new, the memory stays with the caller
+		static void operator delete(void*, void*)
+		{
+		}
+
+		//! Like operator new(size_t), as the pools only fail when the heap does
+		static void* operator new(size_t size, const std::nothrow_t&)
+		{
+			return core::allocateSmallObject(size);
+		}
+
+		//! Matches the nothrow new, only called when a constructor threw
+		static void operator delete(void* ptr, const std::nothrow_t&)
+		{
+			core::deallocateSmallObject(ptr);
+		}
+
+
 		//! This method is called just before the rendering process of the whole scene.
 		/** Nodes may register themselves in the render pipeline during this call,
 		pre-calculate the geometry which should be rendered, and prevent their
@@ -9,6 +9,7 @@
 #include "IAttributeExchangingObject.h"
 #include "IAttributes.h"
 #include "IEventReceiver.h"
+#include "irrPool.h"
 
 namespace irr
 {
@@ -33,6 +34,41 @@ namespace scene
 		{
 		}
 
+		//! Animators are allocated from the pools of core::allocateSmallObject
+		static void* operator new(size_t size)
+		{
+			return core::allocateSmallObject(size);
+		}
+
+		//! Frees memory of animators, size is the one of the derived class
+		static void operator delete(void* ptr, size_t size)
+		{
+			core::deallocateSmallObject(ptr, size);
+		}
+
+		//! Placement new, constructs in memory owned by the caller
+		static void* operator new(size_t, void* place)
+		{
+			return place;
+		}
+
+		//! Matches placement new, the memory stays with the caller
+		static void operator delete(void*, void*)
+		{
+		}
+
+		//! Like operator new(size_t), as the pools only fail when the heap does
+		static void* operator new(size_t size, const std::nothrow_t&)
+		{
+			return core::allocateSmallObject(size);
+		}
+
+		//! Matches the nothrow new, only called when a constructor threw
+		static void operator delete(void* ptr, const std::nothrow_t&)
+		{
+			core::deallocateSmallObject(ptr);
+		}
+
 		//! Animates a scene node.
 		/** \param node Node to animate.
 		\param timeMs Current time in milliseconds. */
@@ -56,6 +56,18 @@ namespace scene
 
 		//! Get currently active optimization used to create shadow volumes
 		virtual ESHADOWVOLUME_OPTIMIZATION getOptimization() const = 0;
+
+		//! Set if the shadow mesh never changes
+		/** The mesh of a static shadow is only copied once and its
+		adjacency only calculated once. The shadow volume of each light
+		is kept and only created again when the light moves relative to
+		the mesh, so when the light or the parent node moves.
+		After changing the vertices of a static mesh call setStatic(true)
+		again to copy it again. Default is false. */
+		virtual void setStatic(bool isStatic) = 0;
+
+		//! Check if the shadow mesh is static, see setStatic.
+		virtual bool isStatic() const = 0;
 	};
 
 } // end namespace scene
@@ -21,6 +21,12 @@ public:
 	*/
 	virtual u32 getRealTime() const = 0;
 
+	//! Returns current real time in nanoseconds of the system.
+	/** Uses the most precise monotonic clock of the system, so
+	differences between two values can be used to time short code
+	sections. Like getRealTime() the value doesn't start with 0. */
+	virtual u64 getRealTimeNanoseconds() const = 0;
+
 	enum EWeekday
 	{
 		EWD_SUNDAY=0,
@@ -18,11 +18,18 @@
 #include "EDriverFeatures.h"
 #include "EPrimitiveTypes.h"
 #include "SExposedVideoData.h"
+#include "SFrameStats.h"
+#include "S2DVertexBatch.h"
 #include "S3DVertex.h"
 #include "SVertexIndex.h"
+#include "irrArena.h"
 
 namespace irr
 {
+namespace core
+{
+	class IJobSystem;
+} // end namespace core
 namespace io
 {
 	class IAttributes;
@@ -291,6 +298,20 @@ namespace video
 		IReferenceCounted::drop() for more information. */
 		virtual ITexture* getTexture(io::IReadFile* file) =0;
 
+		//! Get access to several named textures at once.
+		/** Works like calling getTexture() for each filename, but the
+		files which are not loaded yet are decoded in parallel on the
+		threads of the job system of the device
+		(IrrlichtDevice::getJobSystem()). Only the textures are
+		created on the calling thread. The image loaders may log their
+		messages from the other threads.
+		\param filenames Filenames of the textures to be loaded.
+		\return Array with one texture for each filename, in the same
+		order, 0 for textures which could not be loaded. The pointers
+		should not be dropped. See IReferenceCounted::drop() for more
+		information. */
+		virtual core::array<ITexture*> getTextures(const core::array<io::path>& filenames) =0;
+
 		//! Returns a texture by index
 		/** \param index: Index of the texture, must be smaller than
 		getTextureCount() Please note that this index might change when
@@ -960,6 +981,33 @@ namespace video
 				video::SColor color=SColor(100,255,255,255),
 				s32 vertexCount=10) =0;
 
+		//! Starts recording the 2d drawing into a batch instead of drawing it.
+		/** While recording, draw2DRectangle(), draw2DImage() and
+		draw2DImageBatch() add their clipped quads to the batch. All other
+		drawing is skipped and makes endRecording2D() fail. Only the
+		OpenGL, Direct3D 9 and Burning's Video drivers can record.
+		\param batch Batch receiving the quads, it is cleared first and
+		must stay alive until endRecording2D().
+		\return True when recording started, false if the driver can't
+		record. Then everything is drawn as usual. */
+		virtual bool beginRecording2D(S2DVertexBatch* batch) =0;
+
+		//! Stops recording the 2d drawing.
+		/** \return True when all drawing since beginRecording2D() was
+		recorded, false when something had to be skipped, then the batch
+		is incomplete. */
+		virtual bool endRecording2D() =0;
+
+		//! Draws recorded 2d batches.
+		/** Quads are drawn in the order of the batches. Quads with the
+		same texture and blending are drawn with a single
+		draw2DVertexPrimitiveList() call, as long as no other quad
+		overlapping them comes in between. The material set before is
+		changed.
+		\param batches Array of pointers to the batches.
+		\param count Number of batches. */
+		virtual void draw2DVertexBatches(const S2DVertexBatch* const* batches, u32 count) =0;
+
 		//! Draws a shadow volume into the stencil buffer.
 		/** To draw a stencil shadow, do this: First, draw all geometry.
 		Then use this method, to draw the shadow volume. Then, use
@@ -1070,6 +1118,30 @@ namespace video
 		\return Amount of primitives drawn in the last frame. */
 		virtual u32 getPrimitiveCountDrawn( u32 mode =0 ) const =0;
 
+		//! Returns counters of a finished frame
+		/** The driver keeps the counters of the last frames. A frame
+		ends with endScene().
+		\param framesAgo 0 for the last finished frame, 1 for the one
+		before and so on. Frames which are no longer stored return
+		zeroed counters.
+		\return Counters of the frame. */
+		virtual const SFrameStats& getFrameStats(u32 framesAgo=0) const =0;
+
+		//! Returns how many finished frames are stored for getFrameStats()
+		virtual u32 getFrameStatsCount() const =0;
+
+		//! Returns the counters of the frame which is currently drawn
+		/** Can be used to add counts for work which is done outside of the driver. */
+		virtual SFrameStats& getCurrentFrameStats() =0;
+
+		//! Returns an arena for temporary memory which is only needed during one frame
+		/** All memory of it is given back in beginScene(), so containers
+		using it must not live longer than that. Allocating from it is much
+		cheaper than using the heap, use it with core::irrArenaAllocator.
+		It must only be used from the thread drawing the scene.
+		\return Arena of the driver. */
+		virtual core::irrArena* getFrameArena() =0;
+
 		//! Deletes all dynamic lights which were previously added with addDynamicLight().
 		virtual void deleteAllDynamicLights() =0;
 
@@ -1203,6 +1275,31 @@ namespace video
 			return (imageArray.size() > 0) ? imageArray[0] : 0;
 		}
 
+		//! Creates software images from several files at once.
+		/** Loads one image per file and decodes it directly into the
+		given color format where the image loader supports it, so it
+		doesn't need another conversion. Use the format of the
+		textures you are going to create, usually ECF_A8R8G8B8.
+		Compressed images keep their format. The files are loaded in
+		parallel on the threads of the job system of the device
+		(IrrlichtDevice::getJobSystem()), so the image loaders may log
+		their messages from those threads.
+		\param filenames Names of the files from which the images are created.
+		\param format Color format for the images, ECF_UNKNOWN keeps
+		the format each image has in its file.
+		\return Array with one image for each filename, in the same
+		order. Files which couldn't be loaded give 0 pointers.
+		If you no longer need the images, you should call IImage::drop() on each of them.
+		See IReferenceCounted::drop() for more information. */
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::path>& filenames, ECOLOR_FORMAT format = ECF_UNKNOWN) = 0;
+
+		//! Set the job system used to load several images or textures at once.
+		/** The device sets its own job system when it creates the driver,
+		also for the mesh manipulator.
+		\param jobSystem Job system to use, 0 loads everything on the
+		calling thread. */
+		virtual void setJobSystem(core::IJobSystem* jobSystem) = 0;
+
 		//! Writes the provided image to a file.
 		/** Requires that there is a suitable image writer registered
 		for writing the image.
@@ -186,6 +186,17 @@
 #undef _IRR_COMPILE_WITH_LEAK_HUNTER_
 #endif
 
+//! Use atomic operations for the reference counter of IReferenceCounted
+/** Allows to grab() and drop() objects like meshes, textures or images from several
+threads, for example to hand them over to a loading thread. Only the reference counting
+becomes thread safe, not the objects themselves. Every grab() and drop() gets a little
+slower, the referenceCounting benchmark measures how much.
+NOTE: The library and the application have to be compiled with the same setting. */
+//#define _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+#ifdef NO_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+#undef _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+#endif
+
 //! Enable profiling information in the engine
 /** NOTE: The profiler itself always exists and can be used by applications.
 This define is about the engine creating profile data
@@ -837,6 +848,32 @@ ones. */
 #undef __IRR_COMPILE_WITH_WAD_ARCHIVE_LOADER_
 #endif
 
+//! Define _IRR_COMPILE_WITH_MAPPED_READ_FILE_ to allow reading files from disk by mapping them into memory
+/** IFileSystem::createAndOpenMappedFile() returns such files, other files are
+still read with stdio. They implement IMemoryReadFile, so loaders which check
+for that can parse the content in place instead of copying it into their own
+buffers first. */
+#if defined(_IRR_POSIX_API_) || (defined(_IRR_WINDOWS_API_) && !defined(_WIN32_WCE))
+#define _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+#endif
+#ifdef NO_IRR_COMPILE_WITH_MAPPED_READ_FILE_
+#undef _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+#endif
+
+//! Define _IRR_COMPILE_WITH_JOB_THREADS_ to run the jobs of IJobSystem on worker threads
+/** Without it there are no worker threads and all jobs run on the threads waiting for them.
+That's meant for targets without thread support. On Linux applications have to link with -lpthread. */
+#if defined(_IRR_WINDOWS_API_) && !defined(_WIN32_WCE)
+#define _IRR_COMPILE_WITH_JOB_THREADS_
+#elif defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_) || defined(_IRR_IOS_PLATFORM_) || defined(_IRR_ANDROID_PLATFORM_)
+#define _IRR_COMPILE_WITH_JOB_THREADS_
+#elif defined(_IRR_EMSCRIPTEN_PLATFORM_) && defined(__EMSCRIPTEN_PTHREADS__)
+#define _IRR_COMPILE_WITH_JOB_THREADS_
+#endif
+#ifdef NO_IRR_COMPILE_WITH_JOB_THREADS_
+#undef _IRR_COMPILE_WITH_JOB_THREADS_
+#endif
+
 //! Set FPU settings
 /** Irrlicht should use approximate float and integer fpu techniques
 precision will be lower but speed higher. currently X86 only
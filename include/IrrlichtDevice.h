@@ -38,6 +38,10 @@ namespace irr
 		class IContextManager;
 	} // end namespace video
 
+	namespace core {
+		class IJobSystem;
+	} // end namespace core
+
 	//! The Irrlicht device. You can create it with createDevice() or createDeviceEx().
 	/** This is the most important class of the Irrlicht Engine. You can
 	access everything in the engine if you have a pointer to an instance of
@@ -144,6 +148,13 @@ namespace irr
 		/** \return Pointer to the IRandomizer object. */
 		virtual IRandomizer* getRandomizer() const =0;
 
+		//! Provides access to the engine's job system.
+		/** It runs jobs on a pool of worker threads, which the engine and
+		the application can share. The number of threads is set with
+		SIrrlichtCreationParameters::JobWorkerCount.
+		\return Pointer to the job system. */
+		virtual core::IJobSystem* getJobSystem() = 0;
+
 		//! Sets a new randomizer.
 		/** \param r Pointer to the new IRandomizer object. This object is
 		grab()'ed by the engine and will be released upon the next setRandomizer
@@ -0,0 +1,111 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef S_2D_VERTEX_BATCH_H_INCLUDED
+#define S_2D_VERTEX_BATCH_H_INCLUDED
+
+#include "irrArray.h"
+#include "rect.h"
+#include "S3DVertex.h"
+#include "ITexture.h"
+
+namespace irr
+{
+namespace video
+{
+
+	//! 2d drawing recorded by IVideoDriver::beginRecording2D()
+	/** Holds the already clipped quads of the recorded draw2DRectangle(),
+	draw2DImage() and draw2DImageBatch() calls, so they can be drawn again
+	with IVideoDriver::draw2DVertexBatches() as long as nothing changes.
+	The textures used by the quads are grabbed until the batch is cleared. */
+	struct S2DVertexBatch
+	{
+		//! Following quads which share texture and blending
+		struct SPart
+		{
+			//! Texture of the quads, 0 for rectangles
+			ITexture* Texture;
+
+			//! Where the alpha of the quads comes from, a combination of E_ALPHA_SOURCE flags
+			u32 AlphaSource;
+
+			//! Screen area covered by the quads
+			core::rect<s32> Area;
+
+			//! First vertex of the quads in Vertices
+			u32 FirstVertex;
+
+			//! Number of vertices, 4 per quad
+			u32 VertexCount;
+		};
+
+		S2DVertexBatch()
+		{
+		}
+
+		~S2DVertexBatch()
+		{
+			clear();
+		}
+
+		//! Removes all quads and drops their textures
+		void clear()
+		{
+			for (u32 i=0; i<Parts.size(); ++i)
+			{
+				if (Parts[i].Texture)
+					Parts[i].Texture->drop();
+			}
+			Parts.set_used(0);
+			Vertices.set_used(0);
+		}
+
+		//! Adds a quad, the corners are given clockwise starting with the upper left one
+		void addQuad(ITexture* texture, u32 alphaSource, const core::rect<s32>& area,
+			const S3DVertex& upperLeft, const S3DVertex& upperRight,
+			const S3DVertex& lowerRight, const S3DVertex& lowerLeft)
+		{
+			if (Parts.empty() || Parts.getLast().Texture != texture ||
+				Parts.getLast().AlphaSource != alphaSource)
+			{
+				SPart part;
+				part.Texture = texture;
+				part.AlphaSource = alphaSource;
+				part.Area = area;
+				part.FirstVertex = Vertices.size();
+				part.VertexCount = 0;
+				Parts.push_back(part);
+				if (texture)
+					texture->grab();
+			}
+			else
+			{
+				Parts.getLast().Area.addInternalPoint(area.UpperLeftCorner);
+				Parts.getLast().Area.addInternalPoint(area.LowerRightCorner);
+			}
+
+			Vertices.push_back(upperLeft);
+			Vertices.push_back(upperRight);
+			Vertices.push_back(lowerRight);
+			Vertices.push_back(lowerLeft);
+			Parts.getLast().VertexCount += 4;
+		}
+
+		//! Vertices of all quads
+		core::array<S3DVertex> Vertices;
+
+		//! Quads in drawing order
+		core::array<SPart> Parts;
+
+	private:
+
+		// textures are grabbed per part, so batches are not copied
+		S2DVertexBatch(const S2DVertexBatch&);
+		S2DVertexBatch& operator=(const S2DVertexBatch&);
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
@@ -0,0 +1,54 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef S_FRAME_STATS_H_INCLUDED
+#define S_FRAME_STATS_H_INCLUDED
+
+#include "irrTypes.h"
+
+namespace irr
+{
+namespace video
+{
+
+	//! Counters collected by the video driver for one frame
+	/** See IVideoDriver::getFrameStats(). A frame ends with
+	IVideoDriver::endScene(). */
+	struct SFrameStats
+	{
+		SFrameStats()
+			: DrawCalls(0), PrimitivesDrawn(0), MaterialChanges(0), TextureChanges(0),
+			HardwareBufferUploads(0), HardwareBufferUploadBytes(0), TexturesCreated(0),
+			FrameArenaBytes(0)
+		{
+		}
+
+		//! Number of draw calls for vertex primitive lists and mesh buffers
+		u32 DrawCalls;
+
+		//! Number of primitives drawn, same as IVideoDriver::getPrimitiveCountDrawn()
+		u32 PrimitivesDrawn;
+
+		//! How often setMaterial was called with a material different to the last one
+		u32 MaterialChanges;
+
+		//! How often a texture layer got another texture by setMaterial
+		u32 TextureChanges;
+
+		//! Number of vertex and index buffers copied to hardware buffers
+		u32 HardwareBufferUploads;
+
+		//! Bytes copied to hardware buffers
+		u32 HardwareBufferUploadBytes;
+
+		//! Number of textures added to the texture cache
+		u32 TexturesCreated;
+
+		//! Most bytes used at once in the frame arena, see IVideoDriver::getFrameArena()
+		u32 FrameArenaBytes;
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
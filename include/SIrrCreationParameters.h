@@ -50,6 +50,7 @@ namespace irr
 			DisplayAdapter(0),
 			DriverMultithreaded(false),
 			UsePerformanceTimer(true),
+			JobWorkerCount(0),
 			SDK_version_do_not_use(IRRLICHT_SDK_VERSION),
 			PrivateData(0),
 #if defined(_IRR_COMPILE_WITH_IOS_DEVICE_) || defined(_IRR_ANDROID_PLATFORM_) || defined(_IRR_EMSCRIPTEN_PLATFORM_)
@@ -89,6 +90,7 @@ namespace irr
 			DisplayAdapter = other.DisplayAdapter;
 			DriverMultithreaded = other.DriverMultithreaded;
 			UsePerformanceTimer = other.UsePerformanceTimer;
+			JobWorkerCount = other.JobWorkerCount;
 			PrivateData = other.PrivateData;
 			OGLES2ShaderPath = other.OGLES2ShaderPath;
 			return *this;
@@ -307,6 +309,19 @@ namespace irr
 		*/
 		bool UsePerformanceTimer;
 
+		//! Number of worker threads of the job system.
+		/** See IrrlichtDevice::getJobSystem(). With 0 there are no worker threads
+		and jobs run on the threads waiting for them. With -1 there is one
+		worker less than the number of processors, which is the value to use
+		for parallel image, texture and mesh loading, smooth normals and
+		shadow volumes.
+		Default: 0, so parallelism is opt-in. With workers the image loaders
+		and the file archives which files are read from are used by several
+		threads at once. That includes loaders and archives added by the
+		application, which might not be thread safe. Their log messages
+		also come from the worker threads then. */
+		s32 JobWorkerCount;
+
 		//! Don't use or change this parameter.
 		/** Always set it to IRRLICHT_SDK_VERSION, which is done by default.
 		This is needed for sdk version checks. */
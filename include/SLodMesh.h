@@ -0,0 +1,185 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef S_LOD_MESH_H_INCLUDED
+#define S_LOD_MESH_H_INCLUDED
+
+#include "IAnimatedMesh.h"
+#include "IMesh.h"
+#include "aabbox3d.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! Mesh with several levels of detail.
+	/** Each level is a mesh with the same meshbuffers and materials, but with
+	less triangles than the level before it. A mesh scene node showing this mesh
+	draws the level which fits the size of the node on the screen. The levels
+	can be created with IMeshManipulator::createLodMesh(). */
+	struct SLodMesh : public IAnimatedMesh
+	{
+		//! constructor
+		SLodMesh() : IAnimatedMesh()
+		{
+			#ifdef _DEBUG
+			setDebugName("SLodMesh");
+			#endif
+		}
+
+		//! destructor
+		virtual ~SLodMesh()
+		{
+			for (u32 i=0; i<Meshes.size(); ++i)
+				Meshes[i]->drop();
+		}
+
+		//! Adds a level with less detail than the levels before.
+		/** \param mesh Mesh of the level. It must have the same meshbuffers
+		and materials as the first level.
+		\param screenSize The smallest part of the screen height covered by
+		the mesh at which this level is still used. */
+		void addMesh(IMesh* mesh, f32 screenSize)
+		{
+			if (mesh)
+			{
+				mesh->grab();
+				Meshes.push_back(mesh);
+				ScreenSizes.push_back(screenSize);
+				if (Meshes.size() == 1)
+					Box = mesh->getBoundingBox();
+			}
+		}
+
+		//! Returns the index of the level used at a size on the screen.
+		/** \param screenSize Part of the screen height covered by the
+		bounding sphere of the mesh, 1 fills the screen height. */
+		u32 getLodIndex(f32 screenSize) const
+		{
+			for (u32 i=0; i+1<Meshes.size(); ++i)
+			{
+				if (screenSize >= ScreenSizes[i])
+					return i;
+			}
+			return Meshes.empty() ? 0 : Meshes.size()-1;
+		}
+
+		//! Returns the level used at a size on the screen.
+		IMesh* getLod(f32 screenSize) const
+		{
+			if (Meshes.empty())
+				return 0;
+
+			return Meshes[getLodIndex(screenSize)];
+		}
+
+		//! A mesh with levels of detail is not animated.
+		virtual u32 getFrameCount() const IRR_OVERRIDE
+		{
+			return 1;
+		}
+
+		//! A mesh with levels of detail is not animated.
+		virtual f32 getAnimationSpeed() const IRR_OVERRIDE
+		{
+			return 0.f;
+		}
+
+		//! A mesh with levels of detail is not animated.
+		virtual void setAnimationSpeed(f32 fps) IRR_OVERRIDE
+		{
+		}
+
+		//! Returns the level of detail.
+		/** \param frame Ignored.
+		\param detailLevel 255 is used for a mesh filling the screen height,
+		lower values for a part of that.
+		\return The level of detail used for that size on the screen. */
+		virtual IMesh* getMesh(s32 frame, s32 detailLevel=255, s32 startFrameLoop=-1, s32 endFrameLoop=-1) IRR_OVERRIDE
+		{
+			return getLod(detailLevel / 255.f);
+		}
+
+		//! Returns the axis aligned bounding box of the first level.
+		virtual const core::aabbox3d<f32>& getBoundingBox() const IRR_OVERRIDE
+		{
+			return Box;
+		}
+
+		//! set user axis aligned bounding box
+		virtual void setBoundingBox(const core::aabbox3df& box) IRR_OVERRIDE
+		{
+			Box = box;
+		}
+
+		//! Returns the type of the mesh.
+		virtual E_ANIMATED_MESH_TYPE getMeshType() const IRR_OVERRIDE
+		{
+			return EAMT_LOD;
+		}
+
+		//! returns amount of mesh buffers of the first level.
+		virtual u32 getMeshBufferCount() const IRR_OVERRIDE
+		{
+			if (Meshes.empty())
+				return 0;
+
+			return Meshes[0]->getMeshBufferCount();
+		}
+
+		//! returns pointer to a mesh buffer of the first level.
+		virtual IMeshBuffer* getMeshBuffer(u32 nr) const IRR_OVERRIDE
+		{
+			if (Meshes.empty())
+				return 0;
+
+			return Meshes[0]->getMeshBuffer(nr);
+		}
+
+		//! Returns pointer to a mesh buffer of the first level which fits a material
+		virtual IMeshBuffer* getMeshBuffer( const video::SMaterial &material) const IRR_OVERRIDE
+		{
+			if (Meshes.empty())
+				return 0;
+
+			return Meshes[0]->getMeshBuffer(material);
+		}
+
+		//! Set a material flag for all meshbuffers of all levels.
+		virtual void setMaterialFlag(video::E_MATERIAL_FLAG flag, bool newvalue) IRR_OVERRIDE
+		{
+			for (u32 i=0; i<Meshes.size(); ++i)
+				Meshes[i]->setMaterialFlag(flag, newvalue);
+		}
+
+		//! set the hardware mapping hint, for driver
+		virtual void setHardwareMappingHint( E_HARDWARE_MAPPING newMappingHint, E_BUFFER_TYPE buffer=EBT_VERTEX_AND_INDEX ) IRR_OVERRIDE
+		{
+			for (u32 i=0; i<Meshes.size(); ++i)
+				Meshes[i]->setHardwareMappingHint(newMappingHint, buffer);
+		}
+
+		//! flags the meshbuffers as changed, reloads hardware buffers
+		virtual void setDirty(E_BUFFER_TYPE buffer=EBT_VERTEX_AND_INDEX) IRR_OVERRIDE
+		{
+			for (u32 i=0; i<Meshes.size(); ++i)
+				Meshes[i]->setDirty(buffer);
+		}
+
+		//! The levels of detail, starting with the most detailed one
+		core::array<IMesh*> Meshes;
+
+		//! For each level the smallest part of the screen height it is used for
+		core::array<f32> ScreenSizes;
+
+		//! The bounding box of this mesh
+		core::aabbox3d<f32> Box;
+	};
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
@@ -0,0 +1,61 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef S_SCENE_STATS_H_INCLUDED
+#define S_SCENE_STATS_H_INCLUDED
+
+#include "irrTypes.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! Counters collected by the scene manager for one frame
+	/** See ISceneManager::getFrameStats(). A frame ends with
+	ISceneManager::drawAll(). */
+	struct SSceneStats
+	{
+		SSceneStats()
+			: NodesVisible(0), NodesCulledByBox(0), NodesCulledByFrustumBox(0),
+			NodesCulledByFrustumSphere(0), NodesCulledByOcclusionQuery(0),
+			NodesDrawnSolid(0), NodesDrawnTransparent(0), NodesDrawnTransparentEffect(0),
+			SkinnedVertices(0), ParticlesSimulated(0)
+		{
+		}
+
+		//! Nodes registered for rendering which passed their culling tests
+		u32 NodesVisible;
+
+		//! Nodes culled by EAC_BOX
+		u32 NodesCulledByBox;
+
+		//! Nodes culled by EAC_FRUSTUM_BOX
+		u32 NodesCulledByFrustumBox;
+
+		//! Nodes culled by EAC_FRUSTUM_SPHERE
+		u32 NodesCulledByFrustumSphere;
+
+		//! Nodes culled by EAC_OCC_QUERY
+		u32 NodesCulledByOcclusionQuery;
+
+		//! Nodes rendered in the solid pass
+		u32 NodesDrawnSolid;
+
+		//! Nodes rendered in the transparent pass
+		u32 NodesDrawnTransparent;
+
+		//! Nodes rendered in the transparent effect pass
+		u32 NodesDrawnTransparentEffect;
+
+		//! Vertices of skinned meshes transformed in software
+		u32 SkinnedVertices;
+
+		//! Particles moved by particle systems
+		u32 ParticlesSimulated;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
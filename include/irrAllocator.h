@@ -113,7 +113,7 @@ enum eAllocStrategy
 {
 	ALLOC_STRATEGY_SAFE    = 0,	// increase size by 1
 	ALLOC_STRATEGY_DOUBLE  = 1,	// double size when under 500 elements, beyond that increase by 1/4th size. Plus a small constant.
-	ALLOC_STRATEGY_SQRT    = 2	// not implemented
+	ALLOC_STRATEGY_SQRT    = 2	// increase by the square root of the size. Plus a small constant. Wastes less memory for big arrays, but reallocates more often.
 };
 
 
@@ -0,0 +1,252 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_ARENA_H_INCLUDED
+#define IRR_ARENA_H_INCLUDED
+
+#include "irrTypes.h"
+#include "irrAllocator.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Linear memory arena for short living allocations.
+/** Allocating just moves a pointer forward, freeing memory does nothing
+unless it was the last allocation, so memory used inside of a function is
+given back when it returns. reset() gives back everything at once.
+When a block is full a new one is allocated, reset() then replaces all
+blocks by a single one big enough for everything used before. So after a
+few frames an arena which is reset once per frame does no heap
+allocations anymore.
+The arena is not thread safe, use one per thread. */
+class irrArena
+{
+public:
+
+	//! Constructor
+	/** \param blockSize Size of the first memory block, allocated on first use. */
+	explicit irrArena(size_t blockSize=64*1024)
+		: Blocks(0), Top(0), End(0), Last(0), BlockSize(blockSize),
+		UsedBytes(0), PeakBytes(0), Capacity(0)
+	{
+	}
+
+	//! Destructor, frees all memory blocks
+	~irrArena()
+	{
+		freeBlocks();
+	}
+
+	//! Allocate memory aligned to 16 bytes.
+	void* allocate(size_t bytes)
+	{
+		const size_t size = alignSize(bytes) + HeaderSize;
+		if (!Top || (size_t)(End - Top) < size)
+			addBlock(size);
+
+		SHeader* header = (SHeader*)Top;
+		header->PreviousTop = Top;
+		header->PreviousLast = Last;
+		Last = Top + HeaderSize;
+		Top += size;
+		UsedBytes += size;
+		if (UsedBytes > PeakBytes)
+			PeakBytes = UsedBytes;
+		return Last;
+	}
+
+	//! Free memory
+	/** Only has an effect when it's the last allocation which is not yet
+	freed, otherwise the memory stays in use until reset(). */
+	void deallocate(void* ptr)
+	{
+		if (!ptr || ptr != Last)
+			return;
+
+		const SHeader* header = (const SHeader*)(Last - HeaderSize);
+		UsedBytes -= Top - header->PreviousTop;
+		Top = header->PreviousTop;
+		Last = header->PreviousLast;
+	}
+
+	//! Give back all memory at once.
+	/** Memory allocated before must no longer be used. */
+	void reset()
+	{
+		if (Blocks && Blocks->Next)
+		{
+			// merge all blocks into one which fits everything
+			const size_t size = Capacity;
+			freeBlocks();
+			addBlock(size);
+		}
+		else if (Blocks)
+		{
+			Top = Blocks->memory();
+		}
+		Last = 0;
+		UsedBytes = 0;
+	}
+
+	//! Get the number of bytes in use, including some bookkeeping and alignment.
+	size_t getUsedBytes() const
+	{
+		return UsedBytes;
+	}
+
+	//! Get the highest number of bytes in use since the last call to resetPeakBytes()
+	size_t getPeakBytes() const
+	{
+		return PeakBytes;
+	}
+
+	//! Set the peak usage to the current usage
+	void resetPeakBytes()
+	{
+		PeakBytes = UsedBytes;
+	}
+
+	//! Get the size of all memory blocks of the arena
+	size_t getCapacity() const
+	{
+		return Capacity;
+	}
+
+private:
+
+	// not copyable
+	irrArena(const irrArena&);
+	irrArena& operator=(const irrArena&);
+
+	// Block and allocation headers take 16 bytes to keep the memory
+	// behind them aligned
+	enum { HeaderSize = 16 };
+
+	struct SBlock
+	{
+		SBlock* Next;
+
+		u8* memory()
+		{
+			return (u8*)this + HeaderSize;
+		}
+	};
+
+	//! Stored before each allocation to allow freeing the last one
+	struct SHeader
+	{
+		u8* PreviousTop;
+		u8* PreviousLast;
+	};
+
+	static size_t alignSize(size_t bytes)
+	{
+		return (bytes + 15) & ~(size_t)15;
+	}
+
+	void addBlock(size_t size)
+	{
+		if (size < BlockSize)
+			size = BlockSize;
+		// operator new returns memory aligned for all types, which is
+		// 16 bytes on all targets with SIMD. Keep the remainder aligned.
+		SBlock* block = (SBlock*)operator new(HeaderSize + size);
+		block->Next = Blocks;
+		Blocks = block;
+		Top = block->memory();
+		End = Top + size;
+		// allocations in older blocks can't be freed anymore
+		Last = 0;
+		Capacity += size;
+		// bytes left in the old block count as used until reset
+		UsedBytes = Capacity - size;
+	}
+
+	void freeBlocks()
+	{
+		while (Blocks)
+		{
+			SBlock* next = Blocks->Next;
+			operator delete(Blocks);
+			Blocks = next;
+		}
+		Top = End = Last = 0;
+		Capacity = 0;
+	}
+
+	SBlock* Blocks;
+	u8* Top;
+	u8* End;
+	u8* Last;
+	size_t BlockSize;
+	size_t UsedBytes;
+	size_t PeakBytes;
+	size_t Capacity;
+};
+
+
+//! Allocator for containers taking their memory from an irrArena
+/** Pass it to the constructor of core::array, for example
+\code
+typedef core::irrArenaAllocator<u32> TArenaAlloc;
+core::array<u32, TArenaAlloc> indices(TArenaAlloc(driver->getFrameArena()), count);
+\endcode
+Without arena it uses the heap. Containers using an arena must not live
+longer than the memory of the arena, for the arena of the video driver
+that's until the next IVideoDriver::beginScene(). */
+template<typename T>
+class irrArenaAllocator
+{
+public:
+
+	//! Constructor
+	/** \param arena Arena to allocate from, 0 to use the heap. */
+	explicit irrArenaAllocator(irrArena* arena=0) : Arena(arena) {}
+
+	//! Allocate memory for an array of objects
+	T* allocate(size_t cnt)
+	{
+		if (Arena)
+			return (T*)Arena->allocate(cnt* sizeof(T));
+		return (T*)operator new(cnt* sizeof(T));
+	}
+
+	//! Deallocate memory for an array of objects
+	void deallocate(T* ptr)
+	{
+		if (Arena)
+			Arena->deallocate(ptr);
+		else
+			operator delete(ptr);
+	}
+
+	//! Construct an element
+	void construct(T* ptr, const T&e)
+	{
+		new ((void*)ptr) T(e);
+	}
+
+	//! Destruct an element
+	void destruct(T* ptr)
+	{
+		ptr->~T();
+	}
+
+	//! Get the arena, 0 when using the heap
+	irrArena* getArena() const
+	{
+		return Arena;
+	}
+
+private:
+
+	irrArena* Arena;
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -15,6 +15,34 @@ namespace irr
 namespace core
 {
 
+#if defined(__clang__)
+	#if __has_feature(is_trivially_copyable)
+		#define IRR_IS_TRIVIALLY_COPYABLE(T) __is_trivially_copyable(T)
+	#else
+		#define IRR_IS_TRIVIALLY_COPYABLE(T) (__has_trivial_copy(T) && __has_trivial_destructor(T))
+	#endif
+#elif (__GNUC__ >= 5) || (_MSC_VER >= 1900)
+	#define IRR_IS_TRIVIALLY_COPYABLE(T) __is_trivially_copyable(T)
+#elif ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3)) || (_MSC_VER >= 1400)
+	#define IRR_IS_TRIVIALLY_COPYABLE(T) (__has_trivial_copy(T) && __has_trivial_destructor(T))
+#else
+	#define IRR_IS_TRIVIALLY_COPYABLE(T) false
+#endif
+
+//! Tells if objects of a type can be moved to another address with memcpy
+/** core::array uses it when moving elements around. By default it's true
+for types with a trivial copy constructor and destructor, like numbers,
+pointers, vectors, colors and vertices. Other types are moved with their
+move constructor when there is one, otherwise copied. Specialize it for
+types which can be moved with memcpy despite a copy constructor. Types
+pointing into themselves, like core::string, can't. */
+template <class T>
+struct is_trivially_relocatable
+{
+	enum { value = IRR_IS_TRIVIALLY_COPYABLE(T) };
+};
+
+
 //! Self reallocating template array (like stl vector) with additional features.
 /** Some features are: Heap sorting, binary search methods, easier debugging.
 */
@@ -41,12 +69,40 @@ public:
 	}
 
 
+	//! Constructs an array using a given allocator.
+	/** Needed for allocators with a state, like irrArenaAllocator.
+	\param alloc Allocator which is copied into the array.
+	\param start_count Amount of elements to pre-allocate. */
+	explicit array(const TAlloc& alloc, u32 start_count=0) : data(0), allocated(0), used(0),
+			allocator(alloc), strategy(ALLOC_STRATEGY_DOUBLE),
+			free_when_destroyed(true), is_sorted(true)
+	{
+		if (start_count)
+			reallocate(start_count);
+	}
+
+
 	//! Copy constructor
 	array(const array<T, TAlloc>& other) : data(0)
 	{
 		*this = other;
 	}
 
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Move constructor
+	/** Takes the memory of the other array, which is empty afterwards. */
+	array(array<T, TAlloc>&& other) : data(other.data), allocated(other.allocated), used(other.used),
+			allocator(other.allocator), strategy(other.strategy),
+			free_when_destroyed(other.free_when_destroyed), is_sorted(other.is_sorted)
+	{
+		other.data = 0;
+		other.allocated = 0;
+		other.used = 0;
+		other.free_when_destroyed = true;
+		other.is_sorted = true;
+	}
+#endif
+
 
 	//! Destructor.
 	/** Frees allocated memory, if set_free_when_destroyed was not set to
@@ -75,17 +131,12 @@ public:
 		data = allocator.allocate(new_size); //new T[new_size];
 		allocated = new_size;
 
-		// copy old data
-		const s32 end = used < new_size ? used : new_size;
+		// move old data
+		const u32 end = used < new_size ? used : new_size;
+		relocate(data, old_data, end);
 
-		for (s32 i=0; i<end; ++i)
-		{
-			// data[i] = old_data[i];
-			allocator.construct(&data[i], old_data[i]);
-		}
-
-		// destruct old data
-		for (u32 j=0; j<used; ++j)
+		// destruct the old data which doesn't fit
+		for (u32 j=end; j<used; ++j)
 			allocator.destruct(&old_data[j]);
 
 		if (allocated < used)
@@ -107,12 +158,49 @@ public:
 
 	//! Adds an element at back of array.
 	/** If the array is too small to add this new element it is made bigger.
-	\param element: Element to add at the back of the array. */
+	\param element: Element to add at the back of the array. It can be an
+	element of this array. */
 	void push_back(const T& element)
 	{
-		insert(element, used);
+		T* old_data = grow_for_back();
+		allocator.construct(&data[used], element); // data[used] = element;
+		finish_back(old_data);
 	}
 
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Adds an element at back of array by moving it.
+	/** \param element: Element to move to the back of the array. */
+	void push_back(T&& element)
+	{
+		T* old_data = grow_for_back();
+		new ((void*)&data[used]) T(static_cast<T&&>(element));
+		finish_back(old_data);
+	}
+
+	//! Constructs an element at the back of the array.
+	/** \param args Arguments for the constructor of the element.
+	\return Reference to the new element. */
+	template <class... Args>
+	T& emplace_back(Args&&... args)
+	{
+		T* old_data = grow_for_back();
+		new ((void*)&data[used]) T(static_cast<Args&&>(args)...);
+		finish_back(old_data);
+		return data[used-1];
+	}
+#else
+	//! Constructs an element with its default constructor at the back of the array.
+	/** Avoids creating a temporary element just to copy it in.
+	\return Reference to the new element. */
+	T& emplace_back()
+	{
+		T* old_data = grow_for_back();
+		new ((void*)&data[used]) T();
+		finish_back(old_data);
+		return data[used-1];
+	}
+#endif
+
 
 	//! Adds an element at the front of the array.
 	/** If the array is to small to add this new element, the array is
@@ -133,68 +221,79 @@ public:
 	{
 		IRR_DEBUG_BREAK_IF(index>used) // access violation
 
-		if (used + 1 > allocated)
+		if (index == used)
 		{
-			// this doesn't work if the element is in the same
-			// array. So we'll copy the element first to be sure
-			// we'll get no data corruption
-			const T e(element);
-
-			// increase data block
-			u32 newAlloc;
-			switch ( strategy )
-			{
-				case ALLOC_STRATEGY_DOUBLE:
-					newAlloc = used + 5 + (allocated < 500 ? used : used >> 2);
-					break;
-				default:
-				case ALLOC_STRATEGY_SAFE:
-					newAlloc = used + 1;
-					break;
-			}
-			reallocate( newAlloc);
-
-			// move array content and construct new element
-			// first move end one up
-			for (u32 i=used; i>index; --i)
-			{
-				if (i<used)
-					allocator.destruct(&data[i]);
-				allocator.construct(&data[i], data[i-1]); // data[i] = data[i-1];
-			}
-			// then add new element
-			if (used > index)
-				allocator.destruct(&data[index]);
-			allocator.construct(&data[index], e); // data[index] = e;
+			push_back(element);
+			return;
 		}
-		else
+
+		// this doesn't work if the element is in the same
+		// array. So we'll copy the element first to be sure
+		// we'll get no data corruption
+		if (&element >= data && &element < data + used)
 		{
-			// element inserted not at end
-			if ( used > index )
-			{
-				// create one new element at the end
-				allocator.construct(&data[used], data[used-1]);
-
-				// move the rest of the array content
-				for (u32 i=used-1; i>index; --i)
-				{
-					data[i] = data[i-1];
-				}
-				// insert the new element
-				data[index] = element;
-			}
-			else
-			{
-				// insert the new element to the end
-				allocator.construct(&data[index], element);
-			}
+			const T e(element);
+			insert(e, index);
+			return;
 		}
+
+		if (used + 1 > allocated)
+			reallocate(grown_size(used + 1));
+
+		// move array content one up and construct new element
+		move_up(index, 1);
+		allocator.construct(&data[index], element); // data[index] = element;
+
 		// set to false as we don't know if we have the comparison operators
 		is_sorted = false;
 		++used;
 	}
 
 
+	//! Insert several elements into the array at specified position.
+	/** Makes room for all of them at once, so it's faster than inserting
+	them one by one. Use size() as index to append them.
+	\param elements: Elements to be inserted, they can be in this array.
+	\param count: Number of elements.
+	\param index: Where position to insert the new elements. */
+	void insert_range(const T* elements, u32 count, u32 index)
+	{
+		IRR_DEBUG_BREAK_IF(index>used) // access violation
+
+		if (!count)
+			return;
+
+		// elements of this array move while making room, so copy them first
+		if (elements + count > data && elements < data + used)
+		{
+			array<T, TAlloc> copy(allocator, count);
+			copy.insert_range(elements, count, 0);
+			insert_range(copy.data, count, index);
+			return;
+		}
+
+		if (used + count > allocated)
+		{
+			// move the old content directly to its new place
+			T* old_data = data;
+			const u32 newAlloc = grown_size(used + count);
+			data = allocator.allocate(newAlloc); //new T[newAlloc];
+			allocated = newAlloc;
+			relocate(data, old_data, index);
+			relocate(data + index + count, old_data + index, used - index);
+			allocator.deallocate(old_data); //delete [] old_data;
+		}
+		else
+			move_up(index, count);
+
+		for (u32 i=0; i<count; ++i)
+			allocator.construct(&data[index+i], elements[i]); // data[index+i] = elements[i];
+
+		is_sorted = false;
+		used += count;
+	}
+
+
 	//! Clears the array and deletes all allocated memory.
 	void clear()
 	{
@@ -293,6 +392,20 @@ public:
 		used = usedNow;
 	}
 
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Move assignment operator
+	/** Takes the memory of the other array, which is empty afterwards. */
+	array<T, TAlloc>& operator=(array<T, TAlloc>&& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			swap(other);
+		}
+		return *this;
+	}
+#endif
+
 	//! Assignment operator
 	const array<T, TAlloc>& operator=(const array<T, TAlloc>& other)
 	{
@@ -562,19 +675,14 @@ public:
 
 	//! Erases an element from the array.
 	/** May be slow, because all elements following after the erased
-	element have to be copied.
+	element have to be moved.
 	\param index: Index of element to be erased. */
 	void erase(u32 index)
 	{
 		IRR_DEBUG_BREAK_IF(index>=used) // access violation
 
-		for (u32 i=index+1; i<used; ++i)
-		{
-			allocator.destruct(&data[i-1]);
-			allocator.construct(&data[i-1], data[i]); // data[i-1] = data[i];
-		}
-
-		allocator.destruct(&data[used-1]);
+		allocator.destruct(&data[index]);
+		move_down(index, 1);
 
 		--used;
 	}
@@ -582,7 +690,7 @@ public:
 
 	//! Erases some elements from the array.
 	/** May be slow, because all elements following after the erased
-	element have to be copied.
+	element have to be moved.
 	\param index: Index of the first element to be erased.
 	\param count: Amount of elements to be erased. */
 	void erase(u32 index, s32 count)
@@ -592,20 +700,10 @@ public:
 		if (index+count>used)
 			count = used-index;
 
-		u32 i;
-		for (i=index; i<index+count; ++i)
+		for (u32 i=index; i<index+count; ++i)
 			allocator.destruct(&data[i]);
 
-		for (i=index+count; i<used; ++i)
-		{
-			if (i-count >= index+count) // not already destructed before loop
-				allocator.destruct(&data[i-count]);
-
-			allocator.construct(&data[i-count], data[i]); // data[i-count] = data[i];
-
-			if (i >= used-count) // those which are not overwritten
-				allocator.destruct(&data[i]);
-		}
+		move_down(index, count);
 
 		used-= count;
 	}
@@ -644,6 +742,105 @@ public:
 	typedef u32 size_type;
 
 private:
+
+	//! New size of the memory block when it's too small, depends on the strategy
+	u32 grown_size(u32 needed) const
+	{
+		u32 newAlloc;
+		switch ( strategy )
+		{
+			case ALLOC_STRATEGY_DOUBLE:
+				newAlloc = used + 5 + (allocated < 500 ? used : used >> 2);
+				break;
+			case ALLOC_STRATEGY_SQRT:
+				newAlloc = used + 5 + (u32)squareroot((f32)used);
+				break;
+			default:
+			case ALLOC_STRATEGY_SAFE:
+				newAlloc = needed;
+				break;
+		}
+		return newAlloc < needed ? needed : newAlloc;
+	}
+
+	//! Move elements to memory without elements, the old ones are destructed
+	void relocate(T* target, T* source, u32 count)
+	{
+		if (is_trivially_relocatable<T>::value)
+		{
+			if (count)
+				memcpy((void*)target, (const void*)source, count*sizeof(T));
+			return;
+		}
+
+		for (u32 i=0; i<count; ++i)
+		{
+#ifdef IRR_HAS_MOVE_SEMANTICS
+			new ((void*)&target[i]) T(static_cast<T&&>(source[i]));
+#else
+			allocator.construct(&target[i], source[i]);
+#endif
+			allocator.destruct(&source[i]);
+		}
+	}
+
+	//! Move the elements starting at index count places up, there must be space for them
+	void move_up(u32 index, u32 count)
+	{
+		if (is_trivially_relocatable<T>::value)
+		{
+			memmove((void*)&data[index+count], (const void*)&data[index], (used-index)*sizeof(T));
+			return;
+		}
+
+		// start with the last, its target is behind the used elements
+		for (u32 i=used; i>index; --i)
+			relocate(&data[i-1+count], &data[i-1], 1);
+	}
+
+	//! Move the elements behind index+count down to index, the elements in between are destructed already
+	void move_down(u32 index, u32 count)
+	{
+		if (is_trivially_relocatable<T>::value)
+		{
+			memmove((void*)&data[index], (const void*)&data[index+count], (used-index-count)*sizeof(T));
+			return;
+		}
+
+		for (u32 i=index+count; i<used; ++i)
+			relocate(&data[i-count], &data[i], 1);
+	}
+
+	//! Make room for one more element at the back
+	/** The old memory block is kept until finish_back, as the new element
+	could be copied from it.
+	\return The old memory block when a new one was allocated, otherwise 0. */
+	T* grow_for_back()
+	{
+		if (used + 1 <= allocated)
+			return 0;
+
+		T* old_data = data;
+		const u32 newAlloc = grown_size(used + 1);
+		data = allocator.allocate(newAlloc); //new T[newAlloc];
+		allocated = newAlloc;
+		return old_data;
+	}
+
+	//! Finish adding an element at the back after grow_for_back
+	void finish_back(T* old_data)
+	{
+		if (old_data)
+		{
+			relocate(data, old_data, used);
+			allocator.deallocate(old_data); //delete [] old_data;
+		}
+
+		// set to false as we don't know if we have the comparison operators
+		is_sorted = false;
+		++used;
+	}
+
 	T* data;
 	u32 allocated;
 	u32 used;
@@ -0,0 +1,322 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_HASH_H_INCLUDED
+#define IRR_HASH_H_INCLUDED
+
+#include "irrTypes.h"
+#include "irrAllocator.h"
+#include "irrString.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Mixes the bits of a number, so all of them change the lowest bits.
+/** Hash tables only use the lowest bits of hashes. Integers and pointers
+often differ only in their higher bits or all have the same lowest bits. */
+inline u32 hashMix(u32 h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return h;
+}
+
+//! Mixes the bits of a 64 bit number into a 32 bit hash.
+inline u32 hashMix(u64 h)
+{
+	return hashMix((u32)h ^ hashMix((u32)(h >> 32)));
+}
+
+
+//! Function object calculating hashes for hash_map and hash_set.
+/** It exists for integers, pointers and core::string, which includes
+io::path. Specialize it for other key types or pass another function
+object with a u32 operator()(const KeyType&) const to the containers. */
+template <class T>
+struct hash;
+
+#define IRR_DEFINE_INTEGER_HASH(T, MixType) \
+	template <> \
+	struct hash<T> \
+	{ \
+		u32 operator()(T value) const { return hashMix((MixType)value); } \
+	};
+
+IRR_DEFINE_INTEGER_HASH(c8, u32)
+IRR_DEFINE_INTEGER_HASH(s8, u32)
+IRR_DEFINE_INTEGER_HASH(u8, u32)
+IRR_DEFINE_INTEGER_HASH(s16, u32)
+IRR_DEFINE_INTEGER_HASH(u16, u32)
+IRR_DEFINE_INTEGER_HASH(s32, u32)
+IRR_DEFINE_INTEGER_HASH(u32, u32)
+IRR_DEFINE_INTEGER_HASH(s64, u64)
+IRR_DEFINE_INTEGER_HASH(u64, u64)
+#if !defined(_MSC_VER) || defined(_NATIVE_WCHAR_T_DEFINED)	// VS compiling without native wchar_t has it as u16
+IRR_DEFINE_INTEGER_HASH(wchar_t, u32)
+#endif
+
+#undef IRR_DEFINE_INTEGER_HASH
+
+//! Hashes the address, not the object pointed to.
+template <class T>
+struct hash<T*>
+{
+	u32 operator()(const T* value) const
+	{
+		return hashMix((u64)(size_t)value);
+	}
+};
+
+//! Uses the hash of the characters of strings, see string::getHash().
+template <class T, typename TAlloc>
+struct hash<string<T, TAlloc> >
+{
+	u32 operator()(const string<T, TAlloc>& value) const
+	{
+		return value.getHash();
+	}
+};
+
+
+//! Open addressing hash table with Robin Hood probing, base of hash_map and hash_set.
+/** All nodes are in one array. A node which is further away from the
+slot its hash wants than the node in its way takes that slot, the other
+node moves on. That keeps all probe sequences short, also at high load.
+Removing shifts the following nodes back instead of leaving markers.
+The hashes are kept in an array of their own, 0 marks free slots, so
+nodes only exist in used slots.
+\param TNode Node type, needs a getKey() function.
+\param KeyType Type of the keys.
+\param THash Function object hashing keys.
+\param TAlloc Allocator for the nodes. */
+template <class TNode, class KeyType, class THash, typename TAlloc>
+class hash_table
+{
+public:
+
+	//! Constructor
+	/** \param count Number of elements which fit in without growing. */
+	explicit hash_table(u32 count=0) : Nodes(0), Hashes(0), Capacity(0), Size(0)
+	{
+		if (count)
+			reallocate(count);
+	}
+
+	//! Copy constructor
+	hash_table(const hash_table& other) : Nodes(0), Hashes(0), Capacity(0), Size(0)
+	{
+		*this = other;
+	}
+
+	//! Destructor
+	~hash_table()
+	{
+		clear();
+	}
+
+	//! Assignment operator
+	hash_table& operator=(const hash_table& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		reallocate(other.Size);
+		for (u32 i=0; i<other.Capacity; ++i)
+		{
+			if (other.Hashes[i])
+				insertNode(other.Nodes[i], other.Hashes[i]);
+		}
+		return *this;
+	}
+
+	//! Get the number of elements
+	u32 size() const
+	{
+		return Size;
+	}
+
+	//! Check if there are no elements
+	bool empty() const
+	{
+		return Size == 0;
+	}
+
+	//! Get the number of slots of the table
+	/** There are always some free slots, the table grows when 7/8 are used. */
+	u32 allocated_size() const
+	{
+		return Capacity;
+	}
+
+	//! Removes all elements and frees the memory
+	void clear()
+	{
+		for (u32 i=0; i<Capacity; ++i)
+		{
+			if (Hashes[i])
+				allocator.destruct(&Nodes[i]);
+		}
+		allocator.deallocate(Nodes);
+		hashAllocator.deallocate(Hashes);
+		Nodes = 0;
+		Hashes = 0;
+		Capacity = 0;
+		Size = 0;
+	}
+
+	//! Make sure a number of elements fits in without growing the table
+	/** The table never shrinks below the number of elements it holds. */
+	void reallocate(u32 count)
+	{
+		u32 capacity = 8;
+		while (capacity - (capacity >> 3) < count)
+			capacity <<= 1;
+		if (capacity <= Capacity)
+			return;
+
+		TNode* old = Nodes;
+		u32* oldHashes = Hashes;
+		const u32 oldCapacity = Capacity;
+		Nodes = allocator.allocate(capacity);
+		Hashes = hashAllocator.allocate(capacity);
+		Capacity = capacity;
+		Size = 0;
+		for (u32 i=0; i<capacity; ++i)
+			Hashes[i] = 0;
+
+		for (u32 i=0; i<oldCapacity; ++i)
+		{
+			if (oldHashes[i])
+			{
+				insertNode(old[i], oldHashes[i]);
+				allocator.destruct(&old[i]);
+			}
+		}
+		allocator.deallocate(old);
+		hashAllocator.deallocate(oldHashes);
+	}
+
+	//! Swap the content with another table
+	void swap(hash_table& other)
+	{
+		core::swap(Nodes, other.Nodes);
+		core::swap(Hashes, other.Hashes);
+		core::swap(Capacity, other.Capacity);
+		core::swap(Size, other.Size);
+		core::swap(allocator, other.allocator); // memory is still released by the same allocator used for allocation
+	}
+
+protected:
+
+	//! Get the hash of a key, 0 is used for free slots
+	u32 hashKey(const KeyType& key) const
+	{
+		const u32 h = hasher(key);
+		return h ? h : 1;
+	}
+
+	//! Check if a slot holds a node
+	bool isUsed(u32 slot) const
+	{
+		return Hashes[slot] != 0;
+	}
+
+	//! How far a node in a slot is away from the slot its hash wants
+	u32 probeDistance(u32 slot, u32 h) const
+	{
+		return (slot - h) & (Capacity - 1);
+	}
+
+	//! Find the slot of a key
+	/** \return Slot index or -1 when the key is not in the table. */
+	s32 findSlot(const KeyType& key) const
+	{
+		if (!Size)
+			return -1;
+
+		const u32 h = hashKey(key);
+		const u32 mask = Capacity - 1;
+		for (u32 slot=h & mask, distance=0; ; slot=(slot+1) & mask, ++distance)
+		{
+			const u32 slotHash = Hashes[slot];
+			// a node closer to its wanted slot would have been moved for the key
+			if (!slotHash || probeDistance(slot, slotHash) < distance)
+				return -1;
+			if (slotHash == h && Nodes[slot].getKey() == key)
+				return (s32)slot;
+		}
+	}
+
+	//! Insert a node whose key is not in the table yet
+	/** \param newNode The node.
+	\param newHash Hash of its key from hashKey().
+	\return The slot where the node ended up. */
+	u32 insertNode(const TNode& newNode, u32 newHash)
+	{
+		if (Size + 1 > Capacity - (Capacity >> 3))
+			reallocate(Size + 1);
+
+		TNode node(newNode);
+		u32 h = newHash;
+		const u32 mask = Capacity - 1;
+		s32 result = -1;
+		for (u32 slot=h & mask, distance=0; ; slot=(slot+1) & mask, ++distance)
+		{
+			if (!Hashes[slot])
+			{
+				allocator.construct(&Nodes[slot], node);
+				Hashes[slot] = h;
+				++Size;
+				return result >= 0 ? (u32)result : slot;
+			}
+
+			// take the slot from nodes which are closer to their wanted slot
+			const u32 currentDistance = probeDistance(slot, Hashes[slot]);
+			if (currentDistance < distance)
+			{
+				core::swap(node, Nodes[slot]);
+				core::swap(h, Hashes[slot]);
+				distance = currentDistance;
+				if (result < 0)
+					result = (s32)slot;
+			}
+		}
+	}
+
+	//! Remove the node in a slot and move the following ones back
+	void eraseSlot(u32 slot)
+	{
+		const u32 mask = Capacity - 1;
+		allocator.destruct(&Nodes[slot]);
+		for (u32 next=(slot+1) & mask;
+			Hashes[next] && probeDistance(next, Hashes[next]) != 0;
+			slot=next, next=(next+1) & mask)
+		{
+			allocator.construct(&Nodes[slot], Nodes[next]);
+			allocator.destruct(&Nodes[next]);
+			Hashes[slot] = Hashes[next];
+		}
+		Hashes[slot] = 0;
+		--Size;
+	}
+
+	TNode* Nodes;
+	u32* Hashes;
+	u32 Capacity;
+	u32 Size;
+	TAlloc allocator;
+	irrAllocator<u32> hashAllocator;
+	THash hasher;
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
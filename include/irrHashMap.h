@@ -0,0 +1,266 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_HASH_MAP_H_INCLUDED
+#define IRR_HASH_MAP_H_INCLUDED
+
+#include "irrHash.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Element of a hash_map
+template <class KeyType, class ValueType>
+class hash_map_node
+{
+public:
+
+	hash_map_node(const KeyType& key, const ValueType& value)
+		: Key(key), Value(value) {}
+
+	const KeyType& getKey() const
+	{
+		return Key;
+	}
+
+	const ValueType& getValue() const
+	{
+		return Value;
+	}
+
+	ValueType& getValue()
+	{
+		return Value;
+	}
+
+	void setValue(const ValueType& value)
+	{
+		Value = value;
+	}
+
+private:
+
+	KeyType Key;
+	ValueType Value;
+};
+
+
+//! Associative array using a hash table
+/** Faster than core::map for finding, inserting and removing elements.
+Elements are in no particular order. Adding and removing elements moves
+other elements, so pointers to nodes and iterators are only valid until
+the map is changed.
+\param KeyType Type of the keys, needs an operator== and a hash.
+\param ValueType Type of the values.
+\param THash Function object for hashing keys, see core::hash.
+\param TAlloc Allocator for the nodes. */
+template <class KeyType, class ValueType, class THash = hash<KeyType>,
+	typename TAlloc = irrAllocator<hash_map_node<KeyType, ValueType> > >
+class hash_map : public hash_table<hash_map_node<KeyType, ValueType>, KeyType, THash, TAlloc>
+{
+	typedef hash_table<hash_map_node<KeyType, ValueType>, KeyType, THash, TAlloc> Table;
+
+public:
+
+	typedef hash_map_node<KeyType, ValueType> Node;
+
+	//! Iterator over all elements
+	class Iterator
+	{
+	public:
+
+		Iterator() : Map(0), Slot(0) {}
+
+		explicit Iterator(hash_map* map) : Map(map), Slot(0)
+		{
+			skipFree();
+		}
+
+		bool atEnd() const
+		{
+			return !Map || Slot >= Map->Capacity;
+		}
+
+		Iterator& operator++()
+		{
+			++Slot;
+			skipFree();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		Node& operator*()
+		{
+			return Map->Nodes[Slot];
+		}
+
+		Node* operator->()
+		{
+			return &Map->Nodes[Slot];
+		}
+
+		Node* getNode()
+		{
+			return atEnd() ? 0 : &Map->Nodes[Slot];
+		}
+
+	private:
+
+		void skipFree()
+		{
+			while (!atEnd() && !Map->isUsed(Slot))
+				++Slot;
+		}
+
+		hash_map* Map;
+		u32 Slot;
+	};
+
+	//! Const iterator over all elements
+	class ConstIterator
+	{
+	public:
+
+		ConstIterator() : Map(0), Slot(0) {}
+
+		explicit ConstIterator(const hash_map* map) : Map(map), Slot(0)
+		{
+			skipFree();
+		}
+
+		bool atEnd() const
+		{
+			return !Map || Slot >= Map->Capacity;
+		}
+
+		ConstIterator& operator++()
+		{
+			++Slot;
+			skipFree();
+			return *this;
+		}
+
+		ConstIterator operator++(int)
+		{
+			ConstIterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		const Node& operator*() const
+		{
+			return Map->Nodes[Slot];
+		}
+
+		const Node* operator->() const
+		{
+			return &Map->Nodes[Slot];
+		}
+
+		const Node* getNode() const
+		{
+			return atEnd() ? 0 : &Map->Nodes[Slot];
+		}
+
+	private:
+
+		void skipFree()
+		{
+			while (!atEnd() && !Map->isUsed(Slot))
+				++Slot;
+		}
+
+		const hash_map* Map;
+		u32 Slot;
+	};
+
+	//! Constructor
+	/** \param count Number of elements which fit in without growing. */
+	explicit hash_map(u32 count=0) : Table(count) {}
+
+	//! Inserts an element, unless the key is already used
+	/** \param key Key of the element.
+	\param value Value of the element.
+	\return True when inserted, false when the key was used already. */
+	bool insert(const KeyType& key, const ValueType& value)
+	{
+		if (this->findSlot(key) >= 0)
+			return false;
+
+		this->insertNode(Node(key, value), this->hashKey(key));
+		return true;
+	}
+
+	//! Replaces the value if the key already exists, otherwise inserts a new element.
+	void set(const KeyType& key, const ValueType& value)
+	{
+		const s32 slot = this->findSlot(key);
+		if (slot >= 0)
+			this->Nodes[slot].setValue(value);
+		else
+			this->insertNode(Node(key, value), this->hashKey(key));
+	}
+
+	//! Find the element of a key
+	/** \return Pointer to the node or 0 when the key is not used. */
+	Node* find(const KeyType& key)
+	{
+		const s32 slot = this->findSlot(key);
+		return slot >= 0 ? &this->Nodes[slot] : 0;
+	}
+
+	//! Find the element of a key
+	/** \return Pointer to the node or 0 when the key is not used. */
+	const Node* find(const KeyType& key) const
+	{
+		const s32 slot = this->findSlot(key);
+		return slot >= 0 ? &this->Nodes[slot] : 0;
+	}
+
+	//! Removes the element of a key
+	/** \return True when the key was found. */
+	bool remove(const KeyType& key)
+	{
+		const s32 slot = this->findSlot(key);
+		if (slot < 0)
+			return false;
+
+		this->eraseSlot((u32)slot);
+		return true;
+	}
+
+	//! Access the value of a key, inserts a default value when the key is not used yet.
+	ValueType& operator[](const KeyType& key)
+	{
+		s32 slot = this->findSlot(key);
+		if (slot < 0)
+			slot = (s32)this->insertNode(Node(key, ValueType()), this->hashKey(key));
+		return this->Nodes[slot].getValue();
+	}
+
+	//! Get an iterator over all elements
+	Iterator getIterator()
+	{
+		return Iterator(this);
+	}
+
+	//! Get a const iterator over all elements
+	ConstIterator getConstIterator() const
+	{
+		return ConstIterator(this);
+	}
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
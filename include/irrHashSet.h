@@ -0,0 +1,145 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_HASH_SET_H_INCLUDED
+#define IRR_HASH_SET_H_INCLUDED
+
+#include "irrHash.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Element of a hash_set
+template <class KeyType>
+class hash_set_node
+{
+public:
+
+	explicit hash_set_node(const KeyType& key) : Key(key) {}
+
+	const KeyType& getKey() const
+	{
+		return Key;
+	}
+
+private:
+
+	KeyType Key;
+};
+
+
+//! Set of unique keys using a hash table
+/** Keys are in no particular order. Adding and removing keys moves other
+keys, so iterators are only valid until the set is changed.
+\param KeyType Type of the keys, needs an operator== and a hash.
+\param THash Function object for hashing keys, see core::hash.
+\param TAlloc Allocator for the nodes. */
+template <class KeyType, class THash = hash<KeyType>,
+	typename TAlloc = irrAllocator<hash_set_node<KeyType> > >
+class hash_set : public hash_table<hash_set_node<KeyType>, KeyType, THash, TAlloc>
+{
+	typedef hash_table<hash_set_node<KeyType>, KeyType, THash, TAlloc> Table;
+	typedef hash_set_node<KeyType> Node;
+
+public:
+
+	//! Iterator over all keys
+	class ConstIterator
+	{
+	public:
+
+		ConstIterator() : Set(0), Slot(0) {}
+
+		explicit ConstIterator(const hash_set* set) : Set(set), Slot(0)
+		{
+			skipFree();
+		}
+
+		bool atEnd() const
+		{
+			return !Set || Slot >= Set->Capacity;
+		}
+
+		ConstIterator& operator++()
+		{
+			++Slot;
+			skipFree();
+			return *this;
+		}
+
+		ConstIterator operator++(int)
+		{
+			ConstIterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		const KeyType& operator*() const
+		{
+			return Set->Nodes[Slot].getKey();
+		}
+
+		const KeyType* operator->() const
+		{
+			return &Set->Nodes[Slot].getKey();
+		}
+
+	private:
+
+		void skipFree()
+		{
+			while (!atEnd() && !Set->isUsed(Slot))
+				++Slot;
+		}
+
+		const hash_set* Set;
+		u32 Slot;
+	};
+
+	//! Constructor
+	/** \param count Number of keys which fit in without growing. */
+	explicit hash_set(u32 count=0) : Table(count) {}
+
+	//! Inserts a key
+	/** \return True when inserted, false when it was in the set already. */
+	bool insert(const KeyType& key)
+	{
+		if (this->findSlot(key) >= 0)
+			return false;
+
+		this->insertNode(Node(key), this->hashKey(key));
+		return true;
+	}
+
+	//! Check if a key is in the set
+	bool contains(const KeyType& key) const
+	{
+		return this->findSlot(key) >= 0;
+	}
+
+	//! Removes a key
+	/** \return True when the key was in the set. */
+	bool remove(const KeyType& key)
+	{
+		const s32 slot = this->findSlot(key);
+		if (slot < 0)
+			return false;
+
+		this->eraseSlot((u32)slot);
+		return true;
+	}
+
+	//! Get an iterator over all keys
+	ConstIterator getConstIterator() const
+	{
+		return ConstIterator(this);
+	}
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
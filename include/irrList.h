@@ -7,6 +7,7 @@
 
 #include "irrTypes.h"
 #include "irrAllocator.h"
+#include "irrPool.h"
 #include "irrMath.h"
 
 namespace irr
@@ -402,7 +403,7 @@ private:
 	SKListNode* First;
 	SKListNode* Last;
 	u32 Size;
-	irrAllocator<SKListNode> allocator;
+	irrSmallObjectAllocator<SKListNode> allocator;
 
 };
 
@@ -0,0 +1,222 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_POOL_H_INCLUDED
+#define IRR_POOL_H_INCLUDED
+
+#include "irrTypes.h"
+#include <new>
+
+namespace irr
+{
+namespace core
+{
+
+//! Pool of memory blocks which all have the same size.
+/** Blocks are taken from chunks allocated from the heap and given back to
+a free list, so allocating and freeing them is just a few pointer changes
+and objects of the same kind end up next to each other in memory.
+Chunks are only freed when the pool is destroyed.
+The pool is not thread safe, for that use allocateSmallObject(). */
+class irrPool
+{
+public:
+
+	//! Constructor
+	/** \param blockSize Size of each block. It's rounded up to a multiple
+	of 16 bytes, all blocks are aligned to 16 bytes.
+	\param chunkSize Bytes allocated at once when the pool is empty. At
+	least 8 blocks are allocated. */
+	explicit irrPool(size_t blockSize, size_t chunkSize=16*1024)
+		: Chunks(0), FreeBlocks(0), BlockSize(alignSize(blockSize)),
+		BlocksPerChunk((u32)(chunkSize / BlockSize)), UsedBlocks(0), Capacity(0)
+	{
+		if (BlocksPerChunk < 8)
+			BlocksPerChunk = 8;
+	}
+
+	//! Destructor, frees all memory, also of blocks still in use
+	~irrPool()
+	{
+		while (Chunks)
+		{
+			SChunk* next = Chunks->Next;
+			operator delete(Chunks);
+			Chunks = next;
+		}
+	}
+
+	//! Allocate one block
+	void* allocate()
+	{
+		if (!FreeBlocks)
+			addChunk();
+
+		SFreeBlock* block = FreeBlocks;
+		FreeBlocks = block->Next;
+		++UsedBlocks;
+		return block;
+	}
+
+	//! Give a block back to the pool
+	/** \param ptr Block allocated by this pool or 0. */
+	void deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		SFreeBlock* block = static_cast<SFreeBlock*>(ptr);
+		block->Next = FreeBlocks;
+		FreeBlocks = block;
+		--UsedBlocks;
+	}
+
+	//! Check if a block was allocated by this pool
+	/** Goes through all chunks, so it's slow for big pools.
+	\param ptr Any pointer.
+	\return True if ptr points into a chunk of this pool. */
+	bool owns(const void* ptr) const
+	{
+		for (const SChunk* chunk = Chunks; chunk; chunk = chunk->Next)
+		{
+			const u8* blocks = (const u8*)chunk + HeaderSize;
+			if ((const u8*)ptr >= blocks && (const u8*)ptr < blocks + BlocksPerChunk * BlockSize)
+				return true;
+		}
+		return false;
+	}
+
+	//! Get the size of the blocks
+	size_t getBlockSize() const
+	{
+		return BlockSize;
+	}
+
+	//! Get the number of allocated blocks which were not given back yet
+	u32 getUsedBlocks() const
+	{
+		return UsedBlocks;
+	}
+
+	//! Get the number of blocks in all chunks
+	u32 getCapacity() const
+	{
+		return Capacity;
+	}
+
+private:
+
+	// not copyable
+	irrPool(const irrPool&);
+	irrPool& operator=(const irrPool&);
+
+	// Chunk headers take 16 bytes to keep the blocks behind them aligned
+	enum { HeaderSize = 16 };
+
+	struct SChunk
+	{
+		SChunk* Next;
+	};
+
+	struct SFreeBlock
+	{
+		SFreeBlock* Next;
+	};
+
+	static size_t alignSize(size_t bytes)
+	{
+		if (bytes < sizeof(SFreeBlock))
+			bytes = sizeof(SFreeBlock);
+		return (bytes + 15) & ~(size_t)15;
+	}
+
+	void addChunk()
+	{
+		SChunk* chunk = (SChunk*)operator new(HeaderSize + BlocksPerChunk * BlockSize);
+		chunk->Next = Chunks;
+		Chunks = chunk;
+
+		// link the blocks in memory order, so they are handed out that way
+		u8* blocks = (u8*)chunk + HeaderSize;
+		for (u32 i=0; i<BlocksPerChunk; ++i)
+		{
+			SFreeBlock* block = (SFreeBlock*)(blocks + i*BlockSize);
+			block->Next = (i+1 < BlocksPerChunk) ? (SFreeBlock*)(blocks + (i+1)*BlockSize) : FreeBlocks;
+		}
+		FreeBlocks = (SFreeBlock*)blocks;
+		Capacity += BlocksPerChunk;
+	}
+
+	SChunk* Chunks;
+	SFreeBlock* FreeBlocks;
+	size_t BlockSize;
+	u32 BlocksPerChunk;
+	u32 UsedBlocks;
+	u32 Capacity;
+};
+
+
+//! Biggest size in bytes allocated by allocateSmallObject() from pools
+const size_t SMALL_OBJECT_MAX_SIZE = 512;
+
+//! Allocate memory for a small object.
+/** The engine keeps one irrPool for each multiple of 16 bytes up to
+SMALL_OBJECT_MAX_SIZE, bigger objects use the heap. Those pools are shared
+by all threads and protected by a lock for each pool. They are used for
+scene nodes, animators and the nodes of core::list.
+\param size Size of the object in bytes.
+\return Memory aligned to 16 bytes. */
+IRRLICHT_API void* IRRCALLCONV allocateSmallObject(size_t size);
+
+//! Free memory allocated by allocateSmallObject()
+/** \param ptr Memory to free or 0.
+\param size Same size which was passed to allocateSmallObject(). */
+IRRLICHT_API void IRRCALLCONV deallocateSmallObject(void* ptr, size_t size);
+
+//! Free memory allocated by allocateSmallObject() when the size is unknown
+/** Searches all pools for the memory, so it's much slower than passing
+the size. Only meant for rare cases, like freeing an object whose
+constructor threw after a placement operator new without size.
+\param ptr Memory to free or 0. */
+IRRLICHT_API void IRRCALLCONV deallocateSmallObject(void* ptr);
+
+
+//! Allocator for containers which allocate single elements, like core::list
+/** Elements come from the pools of allocateSmallObject(). It must not be
+used by containers allocating several elements at once, like core::array. */
+template<typename T>
+class irrSmallObjectAllocator
+{
+public:
+
+	//! Allocate memory for an array of objects
+	T* allocate(size_t cnt)
+	{
+		IRR_DEBUG_BREAK_IF(cnt != 1)
+		return (T*)allocateSmallObject(cnt* sizeof(T));
+	}
+
+	//! Deallocate memory for an array of objects
+	void deallocate(T* ptr)
+	{
+		deallocateSmallObject(ptr, sizeof(T));
+	}
+
+	//! Construct an element
+	void construct(T* ptr, const T&e)
+	{
+		new ((void*)ptr) T(e);
+	}
+
+	//! Destruct an element
+	void destruct(T* ptr)
+	{
+		ptr->~T();
+	}
+};
+
+
+} // end namespace core
+} // end namespace irr
+
+#endif
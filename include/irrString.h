@@ -97,33 +97,35 @@ public:
 
 	//! Default constructor
 	string()
-	: array(0), allocated(1), used(1)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
-		array = allocator.allocate(1); // new T[1];
-		array[0] = 0;
+		localBuffer[0] = 0;
 	}
 
 
 	//! Constructor
 	string(const string<T,TAlloc>& other)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		*this = other;
 	}
 
 	//! Constructor from other string types
 	template <class B, class A>
 	string(const string<B, A>& other)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		*this = other;
 	}
 
 
 	//! Constructs a string from a float
 	explicit string(const double number)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		c8 tmpbuf[255];
 		snprintf_irr(tmpbuf, 255, "%0.6f", number);
 		*this = tmpbuf;
@@ -132,8 +134,9 @@ public:
 
 	//! Constructs a string from an int
 	explicit string(int number)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		// store if negative and make positive
 
 		bool negative = false;
@@ -180,8 +183,9 @@ public:
 
 	//! Constructs a string from an unsigned int
 	explicit string(unsigned int number)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		// temporary buffer for 16 numbers
 
 		c8 tmpbuf[16]={0};
@@ -211,8 +215,9 @@ public:
 
 	//! Constructs a string from a long
 	explicit string(long number)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		// store if negative and make positive
 
 		bool negative = false;
@@ -259,8 +264,9 @@ public:
 
 	//! Constructs a string from an unsigned long
 	explicit string(unsigned long number)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		// temporary buffer for 16 numbers
 
 		c8 tmpbuf[16]={0};
@@ -291,17 +297,18 @@ public:
 	//! Constructor for copying a string from a pointer with a given length
 	template <class B>
 	string(const B* const c, u32 length)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		if (!c)
-		{
-			// correctly init the string to an empty one
-			*this="";
 			return;
-		}
 
-		allocated = used = length+1;
-		array = allocator.allocate(used); // new T[used];
+		used = length+1;
+		if (used > allocated)
+		{
+			allocated = used;
+			array = allocator.allocate(used); // new T[used];
+		}
 
 		for (u32 l = 0; l<length; ++l)
 			array[l] = (T)c[l];
@@ -313,16 +320,29 @@ public:
 	//! Constructor for Unicode and ASCII strings
 	template <class B>
 	string(const B* const c)
-	: array(0), allocated(0), used(0)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
 	{
+		localBuffer[0] = 0;
 		*this = c;
 	}
 
 
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Move constructor
+	/** Takes the memory of the other string, which is empty afterwards. */
+	string(string<T,TAlloc>&& other)
+	: array(localBuffer), allocated(LOCAL_CAPACITY), used(1)
+	{
+		localBuffer[0] = 0;
+		takeContent(other);
+	}
+#endif
+
+
 	//! Destructor
 	~string()
 	{
-		allocator.deallocate(array); // delete [] array;
+		freeArray();
 	}
 
 
@@ -335,7 +355,7 @@ public:
 		used = other.size()+1;
 		if (used>allocated)
 		{
-			allocator.deallocate(array); // delete [] array;
+			freeArray();
 			allocated = used;
 			array = allocator.allocate(used); //new T[used];
 		}
@@ -347,6 +367,22 @@ public:
 		return *this;
 	}
 
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Move assignment operator
+	/** Takes the memory of the other string, which is empty afterwards. */
+	string<T,TAlloc>& operator=(string<T,TAlloc>&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		freeArray();
+		array = localBuffer;
+		allocated = LOCAL_CAPACITY;
+		takeContent(other);
+		return *this;
+	}
+#endif
+
 	//! Assignment operator for other string types
 	template <class B, class A>
 	string<T,TAlloc>& operator=(const string<B,A>& other)
@@ -362,11 +398,6 @@ public:
 	{
 		if (!c)
 		{
-			if (!array)
-			{
-				array = allocator.allocate(1); //new T[1];
-				allocated = 1;
-			}
 			used = 1;
 			array[0] = 0x0;
 			return *this;
@@ -396,7 +427,7 @@ public:
 		for (u32 l = 0; l<len; ++l)
 			array[l] = (T)c[l];
 
-		if (oldArray != array)
+		if (oldArray != array && oldArray != localBuffer)
 			allocator.deallocate(oldArray); // delete [] oldArray;
 
 		return *this;
@@ -526,6 +557,22 @@ public:
 		return array;
 	}
 
+	//! Get a hash of the characters
+	/** FNV-1a hash, calculated on each call, so strings shared between
+	threads can be hashed at the same time. Used by core::hash for
+	hash_map and hash_set keys.
+	\return Hash value. */
+	u32 getHash() const
+	{
+		u32 h = 2166136261u;
+		for (u32 i=0; i<used-1; ++i)
+		{
+			h ^= (u32)array[i];
+			h *= 16777619u;
+		}
+		return h;
+	}
+
 
 	//! Makes the string lower case.
 	string<T,TAlloc>& make_lower()
@@ -1425,30 +1472,78 @@ public:
 
 private:
 
+	//! Characters which fit into the string object itself, including the 0 at the end
+	enum { LOCAL_CAPACITY = 24 / sizeof(T) };
+
 	//! Reallocate the array, make it bigger or smaller
+	/** Sizes up to LOCAL_CAPACITY use the buffer inside the string. */
 	void reallocate(u32 new_size)
 	{
 		T* old_array = array;
 
-		array = allocator.allocate(new_size); //new T[new_size];
-		allocated = new_size;
+		if (new_size <= LOCAL_CAPACITY)
+		{
+			array = localBuffer;
+			allocated = LOCAL_CAPACITY;
+		}
+		else
+		{
+			array = allocator.allocate(new_size); //new T[new_size];
+			allocated = new_size;
+		}
 
-		const u32 amount = used < new_size ? used : new_size;
-		for (u32 i=0; i<amount; ++i)
-			array[i] = old_array[i];
+		if (new_size < used)
+			used = new_size;
 
-		if (allocated < used)
-			used = allocated;
+		if (array != old_array)
+		{
+			for (u32 i=0; i<used; ++i)
+				array[i] = old_array[i];
 
-		allocator.deallocate(old_array); // delete [] old_array;
+			if (old_array != localBuffer)
+				allocator.deallocate(old_array); // delete [] old_array;
+		}
 	}
 
+	//! Free the array unless it's the local buffer
+	void freeArray()
+	{
+		if (array != localBuffer)
+			allocator.deallocate(array); // delete [] array;
+	}
+
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	//! Take the content of another string, this string must use the local buffer
+	void takeContent(string<T,TAlloc>& other)
+	{
+		if (other.array == other.localBuffer)
+		{
+			for (u32 i=0; i<other.used; ++i)
+				localBuffer[i] = other.localBuffer[i];
+		}
+		else
+		{
+			// memory has to be released by the allocator which allocated it
+			allocator = other.allocator;
+			array = other.array;
+			allocated = other.allocated;
+			other.array = other.localBuffer;
+			other.allocated = LOCAL_CAPACITY;
+		}
+		used = other.used;
+
+		other.used = 1;
+		other.array[0] = 0;
+	}
+#endif
+
 	//--- member variables
 
 	T* array;
 	u32 allocated;
 	u32 used;
 	TAlloc allocator;
+	T localBuffer[LOCAL_CAPACITY];
 };
 
 
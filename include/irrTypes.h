@@ -218,6 +218,12 @@ virtual void somefunc() IRR_OVERRIDE;
 #define IRR_OVERRIDE
 #endif
 
+//! Defined when the compiler supports rvalue references and variadic templates
+/** Classes like core::string and core::array get move constructors then. */
+#if (__cplusplus >= 201103L) || defined(__GXX_EXPERIMENTAL_CXX0X__) || (_MSC_VER >= 1800)
+#define IRR_HAS_MOVE_SEMANTICS
+#endif
+
 // memory debugging
 #if defined(_DEBUG) && defined(IRRLICHT_EXPORTS) && defined(_MSC_VER) && \
 	(_MSC_VER > 1299) && !defined(IRR_DONT_DO_MEMORY_DEBUGGING_HERE) && !defined(_WIN32_WCE)
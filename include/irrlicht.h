@@ -104,6 +104,7 @@
 #include "IImageLoader.h"
 #include "IImageWriter.h"
 #include "IIndexBuffer.h"
+#include "IJobSystem.h"
 #include "ILightSceneNode.h"
 #include "ILogger.h"
 #include "IMaterialRenderer.h"
@@ -115,6 +116,7 @@
 #include "IMeshManipulator.h"
 #include "IMeshSceneNode.h"
 #include "IMeshWriter.h"
+#include "IMemoryReadFile.h"
 #include "IOctreeSceneNode.h"
 #include "IColladaMeshWriter.h"
 #include "IMetaTriangleSelector.h"
@@ -124,13 +126,18 @@
 #include "IQ3Shader.h"
 #include "IReadFile.h"
 #include "IReferenceCounted.h"
+#include "irrArena.h"
 #include "irrArray.h"
 #include "IRandomizer.h"
 #include "IRenderTarget.h"
 #include "IrrlichtDevice.h"
+#include "irrHash.h"
+#include "irrHashMap.h"
+#include "irrHashSet.h"
 #include "irrList.h"
 #include "irrMap.h"
 #include "irrMath.h"
+#include "irrPool.h"
 #include "irrString.h"
 #include "irrTypes.h"
 #include "path.h"
@@ -170,14 +177,17 @@
 #include "position2d.h"
 #include "quaternion.h"
 #include "rect.h"
+#include "S2DVertexBatch.h"
 #include "S3DVertex.h"
 #include "SAnimatedMesh.h"
 #include "SceneParameters.h"
 #include "SColor.h"
 #include "SExposedVideoData.h"
+#include "SFrameStats.h"
 #include "SIrrCreationParameters.h"
 #include "SKeyMap.h"
 #include "SLight.h"
+#include "SLodMesh.h"
 #include "SMaterial.h"
 #include "SOverrideMaterial.h"
 #include "SMesh.h"
@@ -185,6 +195,7 @@
 #include "SMeshBufferLightMap.h"
 #include "SMeshBufferTangents.h"
 #include "SParticle.h"
+#include "SSceneStats.h"
 #include "SSharedMeshBuffer.h"
 #include "SSkinMeshBuffer.h"
 #include "SVertexIndex.h"
@@ -62,6 +62,7 @@ LOCAL_SRC_FILES := \
 					CFileSystem.cpp \
 					CFPSCounter.cpp \
 					leakHunter.cpp \
+					irrPool.cpp \
 					CGeometryCreator.cpp \
 					CGUIButton.cpp \
 					CGUICheckBox.cpp \
@@ -112,6 +113,7 @@ LOCAL_SRC_FILES := \
 					CImageLoaderPVR.cpp \
 					CIrrDeviceSDL.cpp \
 					CIrrDeviceStub.cpp \
+					CJobSystem.cpp \
 					CIrrMeshFileLoader.cpp \
 					CIrrMeshWriter.cpp \
 					CLightSceneNode.cpp \
@@ -174,7 +176,9 @@ LOCAL_SRC_FILES := \
 					CProfiler.cpp \
 					CQ3LevelMesh.cpp \
 					CQuake3ShaderSceneNode.cpp \
+					CQ3LevelSceneNode.cpp \
 					CReadFile.cpp \
+					CMappedReadFile.cpp \
 					CSceneCollisionManager.cpp \
 					CSceneLoaderIrr.cpp \
 					CSceneManager.cpp \
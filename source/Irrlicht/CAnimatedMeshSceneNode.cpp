@@ -212,6 +212,7 @@ IMesh * CAnimatedMeshSceneNode::getMeshForCurrentFrame()
 			skinnedMesh->animateMesh(getFrameNr(), 1.0f);
 
 		// Update the skinned mesh for the current joint transforms.
+		SceneManager->getCurrentFrameStats().SkinnedVertices += skinnedMesh->getVerticesToSkin();
 		skinnedMesh->skinMesh();
 
 		if (JointMode == EJUOR_READ)//read from mesh
@@ -1930,6 +1930,12 @@ public:
 			else
 				setTexture(0);
 		}
+		else if (getString() != text)
+		{
+			// keep the name, so the texture can still be loaded later
+			setTexture(0);
+			OverrideName = text;
+		}
 	}
 
 	virtual void setTexture(video::ITexture* texture, const path& filename) IRR_OVERRIDE
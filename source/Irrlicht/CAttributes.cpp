@@ -17,7 +17,7 @@ namespace irr
 namespace io
 {
 
-CAttributes::CAttributes(video::IVideoDriver* driver)
+CAttributes::CAttributes(video::IVideoDriver* driver, u32 expectedCount)
 : Driver(driver)
 {
 	#ifdef _DEBUG
@@ -26,6 +26,12 @@ CAttributes::CAttributes(video::IVideoDriver* driver)
 
 	if (Driver)
 		Driver->grab();
+
+	if (expectedCount)
+	{
+		Attributes.reallocate(expectedCount);
+		NameIndex.reallocate(expectedCount);
+	}
 }
 
 CAttributes::~CAttributes()
@@ -44,6 +50,7 @@ void CAttributes::clear()
 		Attributes[i]->drop();
 
 	Attributes.clear();
+	NameIndex.clear();
 }
 
 
@@ -52,23 +59,20 @@ void CAttributes::clear()
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const c8* value)
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-		{
-			if (!value)
-			{
-				Attributes[i]->drop();
-				Attributes.erase(i);
-			}
-			else
-				Attributes[i]->setString(value);
+	const s32 i = findAttribute(attributeName);
+	if (i >= 0)
+	{
+		if (!value)
+			removeAttributeP(i);
+		else
+			Attributes[i]->setString(value);
 
-			return;
-		}
+		return;
+	}
 
 	if (value)
 	{
-		Attributes.push_back(new CStringAttribute(attributeName, value));
+		addAttributeP(new CStringAttribute(attributeName, value));
 	}
 }
 
@@ -118,25 +122,20 @@ core::stringc CAttributes::getAttributeAsString(s32 index) const
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const wchar_t* value)
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
+	const s32 i = findAttribute(attributeName);
+	if (i >= 0)
 	{
-		if (Attributes[i]->Name == attributeName)
-		{
-			if (!value)
-			{
-				Attributes[i]->drop();
-				Attributes.erase(i);
-			}
-			else
-				Attributes[i]->setString(value);
+		if (!value)
+			removeAttributeP(i);
+		else
+			Attributes[i]->setString(value);
 
-			return;
-		}
+		return;
 	}
 
 	if (value)
 	{
-		Attributes.push_back(new CStringAttribute(attributeName, value));
+		addAttributeP(new CStringAttribute(attributeName, value));
 	}
 }
 
@@ -183,7 +182,7 @@ core::stringw CAttributes::getAttributeAsStringW(s32 index) const
 //! Adds an attribute as an array of wide strings
 void CAttributes::addArray(const c8* attributeName, const core::array<core::stringw>& value)
 {
-	Attributes.push_back(new CStringWArrayAttribute(attributeName, value));
+	addAttributeP(new CStringWArrayAttribute(attributeName, value));
 }
 
 //! Sets an attribute value as an array of wide strings.
@@ -194,7 +193,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::array<core::
 		att->setArray(value);
 	else
 	{
-		Attributes.push_back(new CStringWArrayAttribute(attributeName, value));
+		addAttributeP(new CStringWArrayAttribute(attributeName, value));
 	}
 }
 
@@ -232,21 +231,49 @@ void CAttributes::setAttribute(s32 index, const core::array<core::stringw>& valu
 //! Returns attribute index from name, -1 if not found
 s32 CAttributes::findAttribute(const c8* attributeName) const
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-			return i;
+	if (!attributeName)
+		return -1;
 
-	return -1;
+	const core::hash_map<core::stringc, u32>::Node* node = NameIndex.find(attributeName);
+	return node ? (s32)node->getValue() : -1;
 }
 
 
 IAttribute* CAttributes::getAttributeP(const c8* attributeName) const
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-			return Attributes[i];
+	const s32 i = findAttribute(attributeName);
+	return i >= 0 ? Attributes[i] : 0;
+}
+
+
+//! Appends an attribute and registers its name in the lookup index.
+/** Names added twice (possible with the add functions) keep resolving to
+the first attribute, same as the old linear search did. */
+void CAttributes::addAttributeP(IAttribute* attribute)
+{
+	Attributes.push_back(attribute);
+	NameIndex.insert(attribute->Name, Attributes.size()-1);
+}
 
-	return 0;
+
+//! Drops the attribute at index and updates the lookup index
+void CAttributes::removeAttributeP(u32 index)
+{
+	Attributes[index]->drop();
+	Attributes.erase(index);
+
+	// indices behind the removed one shifted, so the index has to be rebuilt.
+	rebuildIndex();
+}
+
+
+//! Recreates the name index from the attributes.
+void CAttributes::rebuildIndex()
+{
+	NameIndex.clear();
+	NameIndex.reallocate(Attributes.size());
+	for (u32 i=0; i<Attributes.size(); ++i)
+		NameIndex.insert(Attributes[i]->Name, i);
 }
 
 
@@ -258,7 +285,7 @@ void CAttributes::setAttribute(const c8* attributeName, bool value)
 		att->setBool(value);
 	else
 	{
-		Attributes.push_back(new CBoolAttribute(attributeName, value));
+		addAttributeP(new CBoolAttribute(attributeName, value));
 	}
 }
 
@@ -283,7 +310,7 @@ void CAttributes::setAttribute(const c8* attributeName, s32 value)
 		att->setInt(value);
 	else
 	{
-		Attributes.push_back(new CIntAttribute(attributeName, value));
+		addAttributeP(new CIntAttribute(attributeName, value));
 	}
 }
 
@@ -307,7 +334,7 @@ void CAttributes::setAttribute(const c8* attributeName, f32 value)
 	if (att)
 		att->setFloat(value);
 	else
-		Attributes.push_back(new CFloatAttribute(attributeName, value));
+		addAttributeP(new CFloatAttribute(attributeName, value));
 }
 
 //! Gets a attribute as integer value
@@ -330,7 +357,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::SColor value)
 	if (att)
 		att->setColor(value);
 	else
-		Attributes.push_back(new CColorAttribute(attributeName, value));
+		addAttributeP(new CColorAttribute(attributeName, value));
 }
 
 //! Gets an attribute as color
@@ -352,7 +379,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::SColorf value)
 	if (att)
 		att->setColor(value);
 	else
-		Attributes.push_back(new CColorfAttribute(attributeName, value));
+		addAttributeP(new CColorfAttribute(attributeName, value));
 }
 
 //! Gets an attribute as floating point color
@@ -374,7 +401,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::position2di&
 	if (att)
 		att->setPosition(value);
 	else
-		Attributes.push_back(new CPosition2DAttribute(attributeName, value));
+		addAttributeP(new CPosition2DAttribute(attributeName, value));
 }
 
 //! Gets an attribute as 2d position
@@ -396,7 +423,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::rect<s32>& v
 	if (att)
 		att->setRect(value);
 	else
-		Attributes.push_back(new CRectAttribute(attributeName, value));
+		addAttributeP(new CRectAttribute(attributeName, value));
 }
 
 //! Gets an attribute as rectangle
@@ -418,7 +445,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::dimension2d<
 	if (att)
 		att->setDimension2d(value);
 	else
-		Attributes.push_back(new CDimension2dAttribute(attributeName, value));
+		addAttributeP(new CDimension2dAttribute(attributeName, value));
 }
 
 //! Gets an attribute as dimension2d
@@ -440,7 +467,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::vector3df& v
 	if (att)
 		att->setVector(value);
 	else
-		Attributes.push_back(new CVector3DAttribute(attributeName, value));
+		addAttributeP(new CVector3DAttribute(attributeName, value));
 }
 
 //! Sets a attribute as vector
@@ -450,7 +477,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::vector2df& v
 	if (att)
 		att->setVector2d(value);
 	else
-		Attributes.push_back(new CVector2DAttribute(attributeName, value));
+		addAttributeP(new CVector2DAttribute(attributeName, value));
 }
 
 //! Gets an attribute as vector
@@ -482,7 +509,7 @@ void CAttributes::setAttribute(const c8* attributeName, void* data, s32 dataSize
 	if (att)
 		att->setBinary(data, dataSizeInBytes);
 	else
-		Attributes.push_back(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
+		addAttributeP(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
 }
 
 //! Gets an attribute as binary data
@@ -501,7 +528,7 @@ void CAttributes::setAttribute(const c8* attributeName, const char* enumValue, c
 	if (att)
 		att->setEnum(enumValue, enumerationLiterals);
 	else
-		Attributes.push_back(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
+		addAttributeP(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
 }
 
 //! Gets an attribute as enumeration
@@ -552,7 +579,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::ITexture* value,
 	if (att)
 		att->setTexture(value, filename);
 	else
-		Attributes.push_back(new CTextureAttribute(attributeName, value, Driver, filename));
+		addAttributeP(new CTextureAttribute(attributeName, value, Driver, filename));
 }
 
 
@@ -796,37 +823,37 @@ void CAttributes::getAttributeEnumerationLiteralsOfEnumeration(s32 index, core::
 //! Adds an attribute as integer
 void CAttributes::addInt(const c8* attributeName, s32 value)
 {
-	Attributes.push_back(new CIntAttribute(attributeName, value));
+	addAttributeP(new CIntAttribute(attributeName, value));
 }
 
 //! Adds an attribute as float
 void CAttributes::addFloat(const c8* attributeName, f32 value)
 {
-	Attributes.push_back(new CFloatAttribute(attributeName, value));
+	addAttributeP(new CFloatAttribute(attributeName, value));
 }
 
 //! Adds an attribute as string
 void CAttributes::addString(const c8* attributeName, const char* value)
 {
-	Attributes.push_back(new CStringAttribute(attributeName, value));
+	addAttributeP(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as wchar string
 void CAttributes::addString(const c8* attributeName, const wchar_t* value)
 {
-	Attributes.push_back(new CStringAttribute(attributeName, value));
+	addAttributeP(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as bool
 void CAttributes::addBool(const c8* attributeName, bool value)
 {
-	Attributes.push_back(new CBoolAttribute(attributeName, value));
+	addAttributeP(new CBoolAttribute(attributeName, value));
 }
 
 //! Adds an attribute as enum
 void CAttributes::addEnum(const c8* attributeName, const char* enumValue, const char* const* enumerationLiterals)
 {
-	Attributes.push_back(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
+	addAttributeP(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
 }
 
 //! Adds an attribute as enum
@@ -839,56 +866,56 @@ void CAttributes::addEnum(const c8* attributeName, s32 enumValue, const char* co
 //! Adds an attribute as color
 void CAttributes::addColor(const c8* attributeName, video::SColor value)
 {
-	Attributes.push_back(new CColorAttribute(attributeName, value));
+	addAttributeP(new CColorAttribute(attributeName, value));
 }
 
 //! Adds an attribute as floating point color
 void CAttributes::addColorf(const c8* attributeName, video::SColorf value)
 {
-	Attributes.push_back(new CColorfAttribute(attributeName, value));
+	addAttributeP(new CColorfAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 3d vector
 void CAttributes::addVector3d(const c8* attributeName, const core::vector3df& value)
 {
-	Attributes.push_back(new CVector3DAttribute(attributeName, value));
+	addAttributeP(new CVector3DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 2d vector
 void CAttributes::addVector2d(const c8* attributeName, const core::vector2df& value)
 {
-	Attributes.push_back(new CVector2DAttribute(attributeName, value));
+	addAttributeP(new CVector2DAttribute(attributeName, value));
 }
 
 
 //! Adds an attribute as 2d position
 void CAttributes::addPosition2d(const c8* attributeName, const core::position2di& value)
 {
-	Attributes.push_back(new CPosition2DAttribute(attributeName, value));
+	addAttributeP(new CPosition2DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as rectangle
 void CAttributes::addRect(const c8* attributeName, const core::rect<s32>& value)
 {
-	Attributes.push_back(new CRectAttribute(attributeName, value));
+	addAttributeP(new CRectAttribute(attributeName, value));
 }
 
 //! Adds an attribute as dimension2d
 void CAttributes::addDimension2d(const c8* attributeName, const core::dimension2d<u32>& value)
 {
-	Attributes.push_back(new CDimension2dAttribute(attributeName, value));
+	addAttributeP(new CDimension2dAttribute(attributeName, value));
 }
 
 //! Adds an attribute as binary data
 void CAttributes::addBinary(const c8* attributeName, void* data, s32 dataSizeInBytes)
 {
-	Attributes.push_back(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
+	addAttributeP(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
 }
 
 //! Adds an attribute as texture reference
 void CAttributes::addTexture(const c8* attributeName, video::ITexture* texture, const io::path& filename)
 {
-	Attributes.push_back(new CTextureAttribute(attributeName, texture, Driver, filename));
+	addAttributeP(new CTextureAttribute(attributeName, texture, Driver, filename));
 }
 
 //! Returns if an attribute with a name exists
@@ -1010,7 +1037,7 @@ void CAttributes::setAttribute(s32 index, video::ITexture* texture, const io::pa
 //! Adds an attribute as matrix
 void CAttributes::addMatrix(const c8* attributeName, const core::matrix4& v)
 {
-	Attributes.push_back(new CMatrixAttribute(attributeName, v));
+	addAttributeP(new CMatrixAttribute(attributeName, v));
 }
 
 
@@ -1021,7 +1048,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::matrix4& v)
 	if (att)
 		att->setMatrix(v);
 	else
-		Attributes.push_back(new CMatrixAttribute(attributeName, v));
+		addAttributeP(new CMatrixAttribute(attributeName, v));
 }
 
 //! Gets an attribute as a matrix4
@@ -1055,7 +1082,7 @@ void CAttributes::setAttribute(s32 index, const core::matrix4& v)
 //! Adds an attribute as quaternion
 void CAttributes::addQuaternion(const c8* attributeName, const core::quaternion& v)
 {
-	Attributes.push_back(new CQuaternionAttribute(attributeName, v));
+	addAttributeP(new CQuaternionAttribute(attributeName, v));
 }
 
 
@@ -1067,7 +1094,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::quaternion&
 		att->setQuaternion(v);
 	else
 	{
-		Attributes.push_back(new CQuaternionAttribute(attributeName, v));
+		addAttributeP(new CQuaternionAttribute(attributeName, v));
 	}
 }
 
@@ -1102,7 +1129,7 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as axis aligned bounding box
 void CAttributes::addBox3d(const c8* attributeName, const core::aabbox3df& v)
 {
-	Attributes.push_back(new CBBoxAttribute(attributeName, v));
+	addAttributeP(new CBBoxAttribute(attributeName, v));
 }
 
 //! Sets an attribute as axis aligned bounding box
@@ -1113,7 +1140,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::aabbox3df& v
 		att->setBBox(v);
 	else
 	{
-		Attributes.push_back(new CBBoxAttribute(attributeName, v));
+		addAttributeP(new CBBoxAttribute(attributeName, v));
 	}
 }
 
@@ -1148,7 +1175,7 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as 3d plane
 void CAttributes::addPlane3d(const c8* attributeName, const core::plane3df& v)
 {
-	Attributes.push_back(new CPlaneAttribute(attributeName, v));
+	addAttributeP(new CPlaneAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d plane
@@ -1159,7 +1186,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::plane3df& v)
 		att->setPlane(v);
 	else
 	{
-		Attributes.push_back(new CPlaneAttribute(attributeName, v));
+		addAttributeP(new CPlaneAttribute(attributeName, v));
 	}
 }
 
@@ -1194,7 +1221,7 @@ void CAttributes::setAttribute(s32 index, const core::plane3df& v)
 //! Adds an attribute as 3d triangle
 void CAttributes::addTriangle3d(const c8* attributeName, const core::triangle3df& v)
 {
-	Attributes.push_back(new CTriangleAttribute(attributeName, v));
+	addAttributeP(new CTriangleAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d triangle
@@ -1205,7 +1232,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::triangle3df&
 		att->setTriangle(v);
 	else
 	{
-		Attributes.push_back(new CTriangleAttribute(attributeName, v));
+		addAttributeP(new CTriangleAttribute(attributeName, v));
 	}
 }
 
@@ -1241,7 +1268,7 @@ void CAttributes::setAttribute(s32 index, const core::triangle3df& v)
 //! Adds an attribute as a 2d line
 void CAttributes::addLine2d(const c8* attributeName, const core::line2df& v)
 {
-	Attributes.push_back(new CLine2dAttribute(attributeName, v));
+	addAttributeP(new CLine2dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 2d line
@@ -1252,7 +1279,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::line2df& v)
 		att->setLine2d(v);
 	else
 	{
-		Attributes.push_back(new CLine2dAttribute(attributeName, v));
+		addAttributeP(new CLine2dAttribute(attributeName, v));
 	}
 }
 
@@ -1287,7 +1314,7 @@ void CAttributes::setAttribute(s32 index, const core::line2df& v)
 //! Adds an attribute as a 3d line
 void CAttributes::addLine3d(const c8* attributeName, const core::line3df& v)
 {
-	Attributes.push_back(new CLine3dAttribute(attributeName, v));
+	addAttributeP(new CLine3dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 3d line
@@ -1298,7 +1325,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::line3df& v)
 		att->setLine3d(v);
 	else
 	{
-		Attributes.push_back(new CLine3dAttribute(attributeName, v));
+		addAttributeP(new CLine3dAttribute(attributeName, v));
 	}
 }
 
@@ -1335,7 +1362,7 @@ void CAttributes::setAttribute(s32 index, const core::line3df& v)
 //! Adds an attribute as user pointer
 void CAttributes::addUserPointer(const c8* attributeName, void* userPointer)
 {
-	Attributes.push_back(new CUserPointerAttribute(attributeName, userPointer));
+	addAttributeP(new CUserPointerAttribute(attributeName, userPointer));
 }
 
 //! Sets an attribute as user pointer
@@ -1346,7 +1373,7 @@ void CAttributes::setAttribute(const c8* attributeName, void* userPointer)
 		att->setUserPointer(userPointer);
 	else
 	{
-		Attributes.push_back(new CUserPointerAttribute(attributeName, userPointer));
+		addAttributeP(new CUserPointerAttribute(attributeName, userPointer));
 	}
 }
 
@@ -9,6 +9,7 @@
 
 #include "IAttributes.h"
 #include "IAttribute.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
@@ -26,7 +27,12 @@ class CAttributes : public IAttributes
 {
 public:
 
-	CAttributes(video::IVideoDriver* driver=0);
+	//! Constructor
+	/** \param driver Driver used to resolve texture attributes.
+	\param expectedCount Number of attributes to reserve memory for. Avoids
+	reallocations of the attribute list and the name index when the caller
+	knows how many attributes it will add. */
+	CAttributes(video::IVideoDriver* driver=0, u32 expectedCount=0);
 	~CAttributes();
 
 	//! Returns amount of attributes in this collection of attributes.
@@ -726,8 +732,17 @@ protected:
 
 	core::array<IAttribute*> Attributes;
 
+	//! Index of the first attribute of each name
+	core::hash_map<core::stringc, u32> NameIndex;
+
 	IAttribute* getAttributeP(const c8* attributeName) const;
 
+	//! Use these instead of modifying Attributes directly to keep the name index valid
+	void addAttributeP(IAttribute* attribute);
+	void removeAttributeP(u32 index);
+
+	void rebuildIndex();
+
 	video::IVideoDriver* Driver;
 };
 
@@ -34,6 +34,7 @@ public:
 		: ISceneNode(0, mgr)	// we don't want it in the scenegraph
 		, MeshNodeParent(parent)
 		, BufferIdx(bufferIdx)
+		, RenderMesh(0)
 		, RenderPass(ESNRP_NONE)
 		, ParentDoesRender(true)
 	{
@@ -45,8 +46,10 @@ public:
 		Parent = &MeshNodeParent;
 	}
 
-	u32 prepareRendering(E_SCENE_NODE_RENDER_PASS pass, bool parentDoesRender)
+	// mesh is the mesh drawn in this frame, the parent's mesh is used when it's 0
+	u32 prepareRendering(E_SCENE_NODE_RENDER_PASS pass, bool parentDoesRender, const IMesh* mesh=0)
 	{
+		RenderMesh = mesh;
 		RenderPass = pass;
 		ParentDoesRender = parentDoesRender;
 		if ( !ParentDoesRender )
@@ -69,7 +72,8 @@ public:
 	// It's assumed that this function is only called from within the correct render stage
 	void renderBuffer(video::IVideoDriver* driver)
 	{
-		const IMeshBuffer* mb = MeshNodeParent.getMesh()->getMeshBuffer(BufferIdx);
+		const IMesh* mesh = RenderMesh ? RenderMesh : MeshNodeParent.getMesh();
+		const IMeshBuffer* mb = mesh->getMeshBuffer(BufferIdx);
 		if (mb)
 		{
 			const video::SMaterial& material = MeshNodeParent.getMaterial(BufferIdx);
@@ -79,6 +83,7 @@ public:
 
 		// Resetting after each rendering so direct calls to render() for parent node continue to work
 		// Assuming each pass only runs once
+		RenderMesh = 0;
 		RenderPass = ESNRP_NONE;
 		ParentDoesRender = true;
 	}
@@ -178,6 +183,7 @@ public:
 private:
 	irr::scene::IMeshSceneNode& MeshNodeParent;
 	irr::u32 BufferIdx;	// Note: Not saving the meshbuffer pointer as meshes can add/remove buffers and we don't want to keep track of that
+	const IMesh* RenderMesh;	// level of detail of the parent's mesh drawn in this frame
 	E_SCENE_NODE_RENDER_PASS RenderPass;
 	bool ParentDoesRender;
 };
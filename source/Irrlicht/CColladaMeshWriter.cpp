@@ -128,6 +128,7 @@ IMesh* CColladaMeshWriterProperties::getMesh(irr::scene::ISceneNode * node)
 		||	node->getType() == ESNT_SPHERE
 		||	node->getType() == ESNT_WATER_SURFACE
 		||	node->getType() == ESNT_Q3SHADER_SCENE_NODE
+		||	node->getType() == ESNT_Q3LEVEL_SCENE_NODE
 		)
 		return static_cast<IMeshSceneNode*>(node)->getMesh();
 	if ( node->getType() == ESNT_TERRAIN )
@@ -146,7 +147,8 @@ bool CColladaMeshWriterProperties::useNodeMaterial(const scene::ISceneNode* node
 								node->getType() == ESNT_CUBE ||
 								node->getType() == ESNT_SPHERE ||
 								node->getType() == ESNT_WATER_SURFACE ||
-								node->getType() == ESNT_Q3SHADER_SCENE_NODE)
+								node->getType() == ESNT_Q3SHADER_SCENE_NODE ||
+								node->getType() == ESNT_Q3LEVEL_SCENE_NODE)
 								&& static_cast<const IMeshSceneNode*>(node)->isReadOnlyMaterials())
 
 							||	(node->getType() == ESNT_ANIMATED_MESH
@@ -45,6 +45,9 @@ CD3D9Driver::CD3D9Driver(const SIrrlichtCreationParameters& params, io::IFileSys
 	setDebugName("CD3D9Driver");
 	#endif
 
+	// the 2d drawing can be recorded into batches, see beginRecording2D
+	CanRecord2D = true;
+
 	printVersion();
 
 	for (u32 i=0; i<MATERIAL_MAX_TEXTURES; ++i)
@@ -728,6 +731,7 @@ void CD3D9Driver::setMaterial(const SMaterial& material)
 {
 	Material = material;
 	OverrideMaterial.apply(Material);
+	countMaterialChange(Material);
 
 	for (u32 i=0; i<MaxTextureUnits; ++i)
 	{
@@ -972,6 +976,8 @@ bool CD3D9Driver::updateVertexHardwareBuffer(SHWBufferLink_d3d9 *hwBuffer)
 		hwBuffer->vertexBuffer->Unlock();
 	}
 
+	countHardwareBufferUpload(bufSize);
+
 	return true;
 }
 
@@ -1041,6 +1047,8 @@ bool CD3D9Driver::updateIndexHardwareBuffer(SHWBufferLink_d3d9 *hwBuffer)
 		}
 	}
 
+	countHardwareBufferUpload(bufSize);
+
 	return true;
 }
 
@@ -1137,6 +1145,9 @@ void CD3D9Driver::deleteHardwareBuffer(SHWBufferLink *_HWBuffer)
 //! Draw hardware buffer
 void CD3D9Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 {
+	if (failRecording2D())
+		return;
+
 	if (!_HWBuffer)
 		return;
 
@@ -1276,6 +1287,9 @@ void CD3D9Driver::drawVertexPrimitiveList(const void* vertices,
 		E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType,
 		E_INDEX_TYPE iType)
 {
+	if (failRecording2D())
+		return;
+
 	if (!checkPrimitiveCount(primitiveCount))
 		return;
 
@@ -1295,6 +1309,9 @@ void CD3D9Driver::draw2DVertexPrimitiveList(const void* vertices,
 		E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType,
 		E_INDEX_TYPE iType)
 {
+	if (failRecording2D())
+		return;
+
 	if (!checkPrimitiveCount(primitiveCount))
 		return;
 
@@ -1455,6 +1472,9 @@ void CD3D9Driver::draw2DImage(const video::ITexture* texture,
 		const video::SColor* const colors,
 		bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destRect, sourceRect, clipRect, colors, useAlphaChannelOfTexture))
+		return;
+
 	if(!texture)
 		return;
 
@@ -1527,6 +1547,12 @@ void CD3D9Driver::draw2DImageBatch(const video::ITexture* texture,
 				SColor color,
 				bool useAlphaChannelOfTexture)
 {
+	if (Recording2D)
+	{
+		CNullDriver::draw2DImageBatch(texture, positions, sourceRects, clipRect, color, useAlphaChannelOfTexture);
+		return;
+	}
+
 	if (!texture)
 		return;
 
@@ -1674,6 +1700,9 @@ void CD3D9Driver::draw2DImage(const video::ITexture* texture,
 				const core::rect<s32>* clipRect, SColor color,
 				bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, pos, sourceRect, clipRect, color, useAlphaChannelOfTexture))
+		return;
+
 	if (!texture)
 		return;
 
@@ -1804,6 +1833,9 @@ void CD3D9Driver::draw2DRectangle(const core::rect<s32>& position,
 	SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
 	const core::rect<s32>* clip)
 {
+	if (record2DRectangle(position, colorLeftUp, colorRightUp, colorLeftDown, colorRightDown, clip))
+		return;
+
 	core::rect<s32> pos(position);
 
 	if (clip)
@@ -1844,6 +1876,9 @@ void CD3D9Driver::draw2DLine(const core::position2d<s32>& start,
 				const core::position2d<s32>& end,
 				SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	if (start==end)
 		drawPixel(start.X, start.Y, color);
 	else
@@ -1872,6 +1907,9 @@ void CD3D9Driver::draw2DLine(const core::position2d<s32>& start,
 //! Draws a pixel
 void CD3D9Driver::drawPixel(u32 x, u32 y, const SColor & color)
 {
+	if (failRecording2D())
+		return;
+
 	const core::dimension2d<u32>& renderTargetSize = getCurrentRenderTargetSize();
 	if(x > (u32)renderTargetSize.Width || y > (u32)renderTargetSize.Height)
 		return;
@@ -2704,6 +2742,9 @@ const wchar_t* CD3D9Driver::getName() const
 //! volume. Then, use IVideoDriver::drawStencilShadow() to visualize the shadow.
 void CD3D9Driver::drawStencilShadowVolume(const core::array<core::vector3df>& triangles, bool zfail, u32 debugDataVisible)
 {
+	if (failRecording2D())
+		return;
+
 	if (!Params.Stencilbuffer)
 		return;
 
@@ -2750,6 +2791,9 @@ void CD3D9Driver::drawStencilShadowVolume(const core::array<core::vector3df>& tr
 void CD3D9Driver::drawStencilShadow(bool clearStencilBuffer, video::SColor leftUpEdge,
 			video::SColor rightUpEdge, video::SColor leftDownEdge, video::SColor rightDownEdge)
 {
+	if (failRecording2D())
+		return;
+
 	if (!Params.Stencilbuffer)
 		return;
 
@@ -2820,6 +2864,9 @@ void CD3D9Driver::setFog(SColor color, E_FOG_TYPE fogType, f32 start,
 void CD3D9Driver::draw3DLine(const core::vector3df& start,
 	const core::vector3df& end, SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	setVertexShader(EVT_STANDARD);
 	setRenderStates3DMode();
 	video::S3DVertex v[2];
@@ -2833,6 +2880,9 @@ void CD3D9Driver::draw3DLine(const core::vector3df& start,
 
 void CD3D9Driver::draw3DBox( const core::aabbox3d<f32>& box, SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	core::vector3df edges[8];
 	box.getEdges(edges);
 
@@ -3279,6 +3329,9 @@ ITexture* CD3D9Driver::addRenderTargetTextureCubemap(const irr::u32 sideLen,
 
 void CD3D9Driver::clearBuffers(u16 flag, SColor color, f32 depth, u8 stencil)
 {
+	if (failRecording2D())
+		return;
+
 	DWORD internalFlag = 0;
 
 	if (flag & ECBF_COLOR)
@@ -20,6 +20,7 @@
 #include "os.h"
 #include "CAttributes.h"
 #include "CReadFile.h"
+#include "CMappedReadFile.h"
 #include "CMemoryFile.h"
 #include "CLimitReadFile.h"
 #include "CWriteFile.h"
@@ -130,6 +131,32 @@ IReadFile* CFileSystem::createAndOpenFile(const io::path& filename)
 }
 
 
+//! opens a file for read access, mapping files on disk into memory
+IReadFile* CFileSystem::createAndOpenMappedFile(const io::path& filename)
+{
+	if ( filename.empty() )
+		return 0;
+
+	IReadFile* file = 0;
+	u32 i;
+
+	for (i=0; i< FileArchives.size(); ++i)
+	{
+		file = FileArchives[i]->createAndOpenFile(filename);
+		if (file)
+			return file;
+	}
+
+	const io::path absolutePath = getAbsolutePath(filename);
+#ifdef _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+	file = CMappedReadFile::createMappedReadFile(absolutePath);
+	if (file)
+		return file;
+#endif
+	return CReadFile::createReadFile(absolutePath);
+}
+
+
 //! Creates an IReadFile interface for treating memory like a file.
 IReadFile* CFileSystem::createMemoryReadFile(const void* memory, s32 len,
 		const io::path& fileName, bool deleteMemoryWhenDropped)
@@ -33,6 +33,9 @@ public:
 	//! opens a file for read access
 	virtual IReadFile* createAndOpenFile(const io::path& filename) IRR_OVERRIDE;
 
+	//! opens a file for read access, mapping files on disk into memory
+	virtual IReadFile* createAndOpenMappedFile(const io::path& filename) IRR_OVERRIDE;
+
 	//! Creates an IReadFile interface for accessing memory like a file.
 	virtual IReadFile* createMemoryReadFile(const void* memory, s32 len, const io::path& fileName, bool deleteMemoryWhenDropped = false) IRR_OVERRIDE;
 
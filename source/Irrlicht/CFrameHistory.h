@@ -0,0 +1,68 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_C_FRAME_HISTORY_H_INCLUDED
+#define IRR_C_FRAME_HISTORY_H_INCLUDED
+
+#include "irrArray.h"
+
+namespace irr
+{
+
+//! Keeps per frame values of the last frames
+/** T is collected in current() while a frame runs. endFrame() stores it
+and starts the next frame with a default constructed T. */
+template <class T>
+class CFrameHistory
+{
+public:
+
+	CFrameHistory(u32 frameCount)
+		: Next(0), Count(0)
+	{
+		Frames.set_used(frameCount > 0 ? frameCount : 1);
+	}
+
+	//! Values of the frame which currently runs
+	T& current()
+	{
+		return Current;
+	}
+
+	//! Store the values of the current frame and start a new one
+	void endFrame()
+	{
+		Frames[Next] = Current;
+		Next = (Next + 1) % Frames.size();
+		if (Count < Frames.size())
+			++Count;
+		Current = T();
+	}
+
+	//! Values of a finished frame, 0 for the last one
+	/** Returns default constructed values for frames which aren't stored */
+	const T& get(u32 framesAgo) const
+	{
+		if (framesAgo >= Count)
+			return Empty;
+		return Frames[(Next + Frames.size() - 1 - framesAgo) % Frames.size()];
+	}
+
+	//! Number of stored frames
+	u32 size() const
+	{
+		return Count;
+	}
+
+private:
+
+	core::array<T> Frames;
+	T Current;
+	T Empty;
+	u32 Next;
+	u32 Count;
+};
+
+} // end namespace irr
+
+#endif
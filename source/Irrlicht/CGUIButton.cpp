@@ -53,6 +53,7 @@ CGUIButton::~CGUIButton()
 void CGUIButton::setScaleImage(bool scaleImage)
 {
 	ScaleImage = scaleImage;
+	invalidate();
 }
 
 
@@ -67,6 +68,7 @@ bool CGUIButton::isScalingImage() const
 void CGUIButton::setDrawBorder(bool border)
 {
 	DrawBorder = border;
+	invalidate();
 }
 
 
@@ -79,6 +81,7 @@ void CGUIButton::setSpriteBank(IGUISpriteBank* sprites)
 		SpriteBank->drop();
 
 	SpriteBank = sprites;
+	invalidate();
 }
 
 
@@ -88,6 +91,7 @@ void CGUIButton::setSprite(EGUI_BUTTON_STATE state, s32 index, video::SColor col
 	ButtonSprites[(u32)state].Color	= color;
 	ButtonSprites[(u32)state].Loop	= loop;
 	ButtonSprites[(u32)state].Scale = scale;
+	invalidate();
 }
 
 //! Get the sprite-index for the given state or -1 when no sprite is set
@@ -435,6 +439,8 @@ void CGUIButton::setOverrideFont(IGUIFont* font)
 
 	if (OverrideFont)
 		OverrideFont->grab();
+
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -459,6 +465,7 @@ void CGUIButton::setOverrideColor(video::SColor color)
 {
 	OverrideColor = color;
 	OverrideColorEnabled = true;
+	invalidate();
 }
 
 video::SColor CGUIButton::getOverrideColor() const
@@ -479,6 +486,7 @@ irr::video::SColor CGUIButton::getActiveColor() const
 void CGUIButton::enableOverrideColor(bool enable)
 {
 	OverrideColorEnabled = enable;
+	invalidate();
 }
 
 bool CGUIButton::isOverrideColorEnabled() const
@@ -500,6 +508,7 @@ void CGUIButton::setImage(EGUI_BUTTON_IMAGE_STATE state, video::ITexture* image,
 
 	ButtonImages[stateIdx].Texture = image;
 	ButtonImages[stateIdx].SourceRect = sourceRect;
+	invalidate();
 }
 
 //! Sets if the button should behave like a push button. Which means it
@@ -526,6 +535,8 @@ void CGUIButton::setPressed(bool pressed)
 		ClickTime = os::Timer::getTime();
 		Pressed = pressed;
 	}
+
+	invalidate();
 }
 
 
@@ -540,6 +551,7 @@ bool CGUIButton::isPushButton() const
 void CGUIButton::setUseAlphaChannel(bool useAlphaChannel)
 {
 	UseAlphaChannel = useAlphaChannel;
+	invalidate();
 }
 
 
@@ -191,6 +191,7 @@ void CGUICheckBox::draw()
 void CGUICheckBox::setChecked(bool checked)
 {
 	Checked = checked;
+	invalidate();
 }
 
 
@@ -204,6 +205,7 @@ bool CGUICheckBox::isChecked() const
 void CGUICheckBox::setDrawBackground(bool draw)
 {
 	Background = draw;
+	invalidate();
 }
 
 //! Checks if background drawing is enabled
@@ -216,6 +218,7 @@ bool CGUICheckBox::isDrawBackgroundEnabled() const
 void CGUICheckBox::setDrawBorder(bool draw)
 {
 	Border = draw;
+	invalidate();
 }
 
 //! Checks if border drawing is enabled
@@ -63,6 +63,7 @@ void CGUIComboBox::setTextAlignment(EGUI_ALIGNMENT horizontal, EGUI_ALIGNMENT ve
 	HAlign = horizontal;
 	VAlign = vertical;
 	SelectedText->setTextAlignment(horizontal, vertical);
+	invalidate();
 }
 
 
@@ -133,6 +134,7 @@ void CGUIComboBox::removeItem(u32 idx)
 		setSelected(-1);
 
 	Items.erase(idx);
+	invalidate();
 }
 
 
@@ -151,6 +153,7 @@ u32 CGUIComboBox::addItem(const wchar_t* text, u32 data)
 	if (Selected == -1)
 		setSelected(0);
 
+	invalidate();
 	return Items.size() - 1;
 }
 
@@ -160,6 +163,7 @@ void CGUIComboBox::clear()
 {
 	Items.clear();
 	setSelected(-1);
+	invalidate();
 }
 
 
@@ -181,6 +185,8 @@ void CGUIComboBox::setSelected(s32 idx)
 		SelectedText->setText(L"");
 	else
 		SelectedText->setText(Items[Selected].Name.c_str());
+
+	invalidate();
 }
 
 
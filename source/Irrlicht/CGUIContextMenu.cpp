@@ -108,6 +108,7 @@ u32 CGUIContextMenu::insertItem(u32 idx, const wchar_t* text, s32 commandId, boo
     }
 
 	recalculateSize();
+	invalidate();
 	return result;
 }
 
@@ -147,6 +148,7 @@ void CGUIContextMenu::setSubMenu(u32 index, CGUIContextMenu* menu)
 	}
 
 	recalculateSize();
+	invalidate();
 }
 
 
@@ -175,6 +177,7 @@ void CGUIContextMenu::setItemText(u32 idx, const wchar_t* text)
 
 	Items[idx].Text = text;
 	recalculateSize();
+	invalidate();
 }
 
 //! should the element change the checked status on clicking
@@ -227,6 +230,7 @@ void CGUIContextMenu::setItemEnabled(u32 idx, bool enabled)
 		return;
 
 	Items[idx].Enabled = enabled;
+	invalidate();
 }
 
 
@@ -237,6 +241,7 @@ void CGUIContextMenu::setItemChecked(u32 idx, bool checked )
 		return;
 
 	Items[idx].Checked = checked;
+	invalidate();
 }
 
 
@@ -254,6 +259,7 @@ void CGUIContextMenu::removeItem(u32 idx)
 
 	Items.erase(idx);
 	recalculateSize();
+	invalidate();
 }
 
 
@@ -266,6 +272,7 @@ void CGUIContextMenu::removeAllItems()
 
 	Items.clear();
 	recalculateSize();
+	invalidate();
 }
 
 
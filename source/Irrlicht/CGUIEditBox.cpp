@@ -38,7 +38,7 @@ CGUIEditBox::CGUIEditBox(const wchar_t* text, bool border,
 	: IGUIEditBox(environment, parent, id, rectangle), OverwriteMode(false), MouseMarking(false),
 	Border(border), Background(true), OverrideColorEnabled(false), MarkBegin(0), MarkEnd(0),
 	OverrideColor(video::SColor(101,255,255,255)), OverrideFont(0), LastBreakFont(0),
-	Operator(0), BlinkStartTime(0), CursorBlinkTime(350), CursorChar(L"_"), CursorPos(0), HScrollPos(0), VScrollPos(0), Max(0),
+	Operator(0), BlinkStartTime(0), CursorBlinkTime(350), BlinkPhase(0), CursorChar(L"_"), CursorPos(0), HScrollPos(0), VScrollPos(0), Max(0),
 	WordWrap(false), MultiLine(false), AutoScroll(true), PasswordBox(false),
 	PasswordChar(L'*'), HAlign(EGUIA_UPPERLEFT), VAlign(EGUIA_CENTER),
 	CurrentTextRect(0,0,1,1), FrameRect(rectangle), IsSDLDevice(false),
@@ -111,6 +111,7 @@ void CGUIEditBox::setOverrideFont(IGUIFont* font)
 		OverrideFont->grab();
 
 	breakText();
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -135,6 +136,7 @@ void CGUIEditBox::setOverrideColor(video::SColor color)
 {
 	OverrideColor = color;
 	OverrideColorEnabled = true;
+	invalidate();
 }
 
 
@@ -148,6 +150,7 @@ video::SColor CGUIEditBox::getOverrideColor() const
 void CGUIEditBox::setDrawBorder(bool border)
 {
 	Border = border;
+	invalidate();
 }
 
 //! Checks if border drawing is enabled
@@ -160,6 +163,7 @@ bool CGUIEditBox::isDrawBorderEnabled() const
 void CGUIEditBox::setDrawBackground(bool draw)
 {
 	Background = draw;
+	invalidate();
 }
 
 //! Checks if background drawing is enabled
@@ -172,6 +176,7 @@ bool CGUIEditBox::isDrawBackgroundEnabled() const
 void CGUIEditBox::enableOverrideColor(bool enable)
 {
 	OverrideColorEnabled = enable;
+	invalidate();
 }
 
 bool CGUIEditBox::isOverrideColorEnabled() const
@@ -184,6 +189,7 @@ void CGUIEditBox::setWordWrap(bool enable)
 {
 	WordWrap = enable;
 	breakText();
+	invalidate();
 }
 
 
@@ -212,6 +218,7 @@ void CGUIEditBox::setMultiLine(bool enable)
 {
 	MultiLine = enable;
 	breakText();
+	invalidate();
 }
 
 
@@ -232,6 +239,8 @@ void CGUIEditBox::setPasswordBox(bool passwordBox, wchar_t passwordChar)
 		setWordWrap(false);
 		BrokenText.clear();
 	}
+
+	invalidate();
 }
 
 
@@ -246,6 +255,7 @@ void CGUIEditBox::setTextAlignment(EGUI_ALIGNMENT horizontal, EGUI_ALIGNMENT ver
 {
 	HAlign = horizontal;
 	VAlign = vertical;
+	invalidate();
 }
 
 
@@ -1156,6 +1166,24 @@ void CGUIEditBox::draw()
 }
 
 
+//! animates the element and its children
+void CGUIEditBox::OnPostRender(u32 timeMs)
+{
+	// the cursor has to be drawn again each time it blinks
+	if (CursorBlinkTime && IsVisible && Environment->hasFocus(this))
+	{
+		const u32 phase = (timeMs - BlinkStartTime) / CursorBlinkTime;
+		if (phase != BlinkPhase)
+		{
+			BlinkPhase = phase;
+			invalidate();
+		}
+	}
+
+	IGUIElement::OnPostRender(timeMs);
+}
+
+
 //! Sets the new caption of this element.
 void CGUIEditBox::setText(const wchar_t* text)
 {
@@ -1164,6 +1192,7 @@ void CGUIEditBox::setText(const wchar_t* text)
 		CursorPos = Text.size();
 	HScrollPos = 0;
 	breakText();
+	invalidate();
 }
 
 
@@ -1226,6 +1255,7 @@ u32 CGUIEditBox::getMax() const
 void CGUIEditBox::setCursorChar(const wchar_t cursorChar)
 {
 	CursorChar[0] = cursorChar;
+	invalidate();
 }
 
 //! Get the character used for the cursor.
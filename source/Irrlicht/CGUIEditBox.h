@@ -102,6 +102,9 @@ namespace gui
 		//! draws the element and its children
 		virtual void draw() IRR_OVERRIDE;
 
+		//! animates the element and its children
+		virtual void OnPostRender(u32 timeMs) IRR_OVERRIDE;
+
 		//! Sets the new caption of this element.
 		virtual void setText(const wchar_t* text) IRR_OVERRIDE;
 
@@ -184,6 +187,7 @@ namespace gui
 
 		u32 BlinkStartTime;
 		irr::u32 CursorBlinkTime;
+		u32 BlinkPhase;
 		core::stringw CursorChar; // IGUIFont::draw needs stringw instead of wchar_t
 		s32 CursorPos;
 		s32 HScrollPos, VScrollPos; // scroll position in characters
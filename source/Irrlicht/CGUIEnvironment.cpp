@@ -59,7 +59,8 @@ const io::path CGUIEnvironment::DefaultFontName = "#DefaultFont";
 CGUIEnvironment::CGUIEnvironment(io::IFileSystem* fs, video::IVideoDriver* driver, IOSOperator* op)
 : IGUIElement(EGUIET_ROOT, 0, 0, 0, core::rect<s32>(driver ? core::dimension2d<s32>(driver->getScreenSize()) : core::dimension2d<s32>(0,0))),
 	Driver(driver), Hovered(0), HoveredNoSubelement(0), Focus(0), LastHoveredMousePos(0,0), CurrentSkin(0),
-	FileSystem(fs), UserReceiver(0), Operator(op), FocusFlags(EFF_SET_ON_LMOUSE_DOWN|EFF_SET_ON_TAB)
+	FileSystem(fs), UserReceiver(0), Operator(op), FocusFlags(EFF_SET_ON_LMOUSE_DOWN|EFF_SET_ON_TAB),
+	RetainedMode(false), RedrawAll(true), RetainedBackground(255,0,0,0)
 {
 	if (Driver)
 		Driver->grab();
@@ -101,6 +102,10 @@ CGUIEnvironment::CGUIEnvironment(io::IFileSystem* fs, video::IVideoDriver* drive
 //! destructor
 CGUIEnvironment::~CGUIEnvironment()
 {
+	// removing elements doesn't need to record changes anymore
+	RetainedMode = false;
+	clearBatches(0);
+
 	clearDeletionQueue();
 
 	if ( HoveredNoSubelement && HoveredNoSubelement != this )
@@ -212,13 +217,351 @@ void CGUIEnvironment::drawAll(bool useScreenSize)
 	if (ToolTip.Element)
 		bringToFront(ToolTip.Element);
 
-	draw();
+	// only the software drivers keep the back buffer between frames
+	if (RetainedMode && Driver &&
+		(Driver->getDriverType() == video::EDT_SOFTWARE || Driver->getDriverType() == video::EDT_BURNINGSVIDEO))
+		drawChangedArea();
+	else if (RetainedMode && Driver)
+	{
+		core::array<IGUIElement*> elements;
+		core::hash_set<IGUIElement*> visibleElements;
+		if (isVisible())
+		{
+			core::list<IGUIElement*>::Iterator it = Children.begin();
+			for (; it != Children.end(); ++it)
+			{
+				if ((*it)->isVisible())
+				{
+					elements.push_back(*it);
+					visibleElements.insert(*it);
+				}
+			}
+		}
+		drawElements(elements);
+		clearBatches(&visibleElements);
+	}
+	else
+		draw();
+	clearChanges();
+
 	OnPostRender ( os::Timer::getTime () );
 
 	clearDeletionQueue();
 }
 
 
+//! Enables or disables the retained mode.
+void CGUIEnvironment::setRetainedMode(bool retained, video::SColor background)
+{
+	RetainedMode = retained;
+	RetainedBackground = background;
+	RedrawAll = true;
+	ChangedElements.clear();
+	DrawnAreas.clear();
+	clearBatches(0);
+}
+
+
+//! Returns if the retained mode is enabled.
+bool CGUIEnvironment::isRetainedMode() const
+{
+	return RetainedMode;
+}
+
+
+//! Marks an element as changed, so the retained mode draws it again.
+void CGUIEnvironment::invalidate(IGUIElement* element)
+{
+	if (!RetainedMode || !element)
+		return;
+
+	if (element == this)
+	{
+		RedrawAll = true;
+		return;
+	}
+
+	// changes are tracked for whole top level elements
+	IGUIElement* parent = element->getParent();
+	while (parent && parent != this)
+	{
+		element = parent;
+		parent = element->getParent();
+	}
+
+	// elements which are not in the environment yet are added later
+	if (parent)
+		ChangedElements.insert(element);
+}
+
+
+//! Checks if the gui has to be drawn again.
+bool CGUIEnvironment::needsRedraw()
+{
+	if (!RetainedMode)
+		return true;
+
+	if (Driver && core::dimension2d<s32>(Driver->getScreenSize()) != AbsoluteRect.getSize())
+		return true;
+
+	OnPostRender(os::Timer::getTime());
+	clearDeletionQueue();
+
+	return RedrawAll || !ChangedElements.empty();
+}
+
+
+//! Adds a rectangle to an area
+static void addArea(const core::rect<s32>& rect, core::rect<s32>& area, bool& hasArea)
+{
+	if (rect.getWidth() <= 0 || rect.getHeight() <= 0)
+		return;
+
+	if (hasArea)
+	{
+		area.addInternalPoint(rect.UpperLeftCorner);
+		area.addInternalPoint(rect.LowerRightCorner);
+	}
+	else
+	{
+		area = rect;
+		hasArea = true;
+	}
+}
+
+
+//! Adds the area drawn by an element and its visible children
+static void addDrawnArea(const IGUIElement* element, core::rect<s32>& area, bool& hasArea)
+{
+	const core::list<IGUIElement*>& children = element->getChildren();
+	core::list<IGUIElement*>::ConstIterator it;
+
+	if (element->getType() == EGUIET_MODAL_SCREEN)
+	{
+		// modal screens cover everything, but only draw a frame around their children
+		for (it = children.begin(); it != children.end(); ++it)
+		{
+			if (!(*it)->isVisible())
+				continue;
+
+			core::rect<s32> frame((*it)->getAbsolutePosition());
+			frame.UpperLeftCorner -= core::position2d<s32>(1,1);
+			frame.LowerRightCorner += core::position2d<s32>(1,1);
+			frame.clipAgainst(element->getAbsoluteClippingRect());
+			addArea(frame, area, hasArea);
+		}
+	}
+	else
+		addArea(element->getAbsoluteClippingRect(), area, hasArea);
+
+	// not clipped children can be outside of the parent
+	for (it = children.begin(); it != children.end(); ++it)
+	{
+		if ((*it)->isVisible())
+			addDrawnArea(*it, area, hasArea);
+	}
+}
+
+
+//! draws only the changed area in retained mode
+void CGUIEnvironment::drawChangedArea()
+{
+	if (!RedrawAll && ChangedElements.empty())
+		return;
+
+	core::array<IGUIElement*> elements;
+	core::array<core::rect<s32> > areas;
+	core::hash_set<IGUIElement*> visibleElements;
+
+	if (isVisible())
+	{
+		core::list<IGUIElement*>::Iterator it = Children.begin();
+		for (; it != Children.end(); ++it)
+		{
+			if (!(*it)->isVisible())
+				continue;
+
+			core::rect<s32> area;
+			bool hasArea = false;
+			addDrawnArea(*it, area, hasArea);
+			if (!hasArea)
+				continue;
+
+			elements.push_back(*it);
+			areas.push_back(area);
+			visibleElements.insert(*it);
+		}
+	}
+
+	core::rect<s32> changed(AbsoluteRect);
+	bool hasChanged = RedrawAll;
+	if (!RedrawAll)
+	{
+		// old areas of changed, hidden and removed elements
+		core::hash_map<IGUIElement*, core::rect<s32> >::ConstIterator old = DrawnAreas.getConstIterator();
+		for (; !old.atEnd(); ++old)
+		{
+			if (!ChangedElements.contains(old->getKey()) && visibleElements.contains(old->getKey()))
+				continue;
+
+			if (hasChanged)
+			{
+				changed.addInternalPoint(old->getValue().UpperLeftCorner);
+				changed.addInternalPoint(old->getValue().LowerRightCorner);
+			}
+			else
+			{
+				changed = old->getValue();
+				hasChanged = true;
+			}
+		}
+
+		// new areas of changed elements
+		for (u32 i=0; i<elements.size(); ++i)
+		{
+			if (!ChangedElements.contains(elements[i]))
+				continue;
+
+			if (hasChanged)
+			{
+				changed.addInternalPoint(areas[i].UpperLeftCorner);
+				changed.addInternalPoint(areas[i].LowerRightCorner);
+			}
+			else
+			{
+				changed = areas[i];
+				hasChanged = true;
+			}
+		}
+
+		// elements overlapping the changed area are drawn completely,
+		// so it has to grow until it contains all of them
+		bool grown = hasChanged;
+		while (grown)
+		{
+			grown = false;
+			for (u32 i=0; i<elements.size(); ++i)
+			{
+				if (!changed.isRectCollided(areas[i]))
+					continue;
+
+				const core::rect<s32> before(changed);
+				changed.addInternalPoint(areas[i].UpperLeftCorner);
+				changed.addInternalPoint(areas[i].LowerRightCorner);
+				grown |= (changed != before);
+			}
+		}
+	}
+
+	if (hasChanged)
+	{
+		changed.clipAgainst(AbsoluteRect);
+		Driver->draw2DRectangle(RetainedBackground, changed);
+
+		core::array<IGUIElement*> drawn;
+		for (u32 i=0; i<elements.size(); ++i)
+		{
+			if (RedrawAll || changed.isRectCollided(areas[i]))
+				drawn.push_back(elements[i]);
+		}
+		drawElements(drawn);
+	}
+
+	DrawnAreas.clear();
+	for (u32 i=0; i<elements.size(); ++i)
+		DrawnAreas.insert(elements[i], areas[i]);
+
+	clearBatches(&visibleElements);
+}
+
+
+//! draws top level elements in retained mode
+void CGUIEnvironment::drawElements(const core::array<IGUIElement*>& elements)
+{
+	// Unchanged elements draw the quads recorded when they changed last
+	// time. The driver merges the quads of all elements by texture.
+	DrawnBatches.set_used(0);
+	for (u32 i=0; i<elements.size(); ++i)
+	{
+		IGUIElement* element = elements[i];
+		bool record = RedrawAll || ChangedElements.contains(element);
+
+		core::hash_map<IGUIElement*, video::S2DVertexBatch*>::Node* node = ElementBatches.find(element);
+		if (!node)
+		{
+			element->grab();
+			ElementBatches.insert(element, new video::S2DVertexBatch());
+			node = ElementBatches.find(element);
+			record = true;
+		}
+
+		video::S2DVertexBatch* batch = node->getValue();
+		if (batch && record)
+		{
+			bool recorded = false;
+			if (Driver->beginRecording2D(batch))
+			{
+				element->draw();
+				recorded = Driver->endRecording2D();
+			}
+
+			// drawing the driver can't record, like the 3d view of mesh viewers
+			if (!recorded)
+			{
+				delete batch;
+				batch = 0;
+				node->setValue(0);
+			}
+		}
+
+		if (batch)
+			DrawnBatches.push_back(batch);
+		else
+		{
+			if (!DrawnBatches.empty())
+				Driver->draw2DVertexBatches(DrawnBatches.const_pointer(), DrawnBatches.size());
+			DrawnBatches.set_used(0);
+			element->draw();
+		}
+	}
+
+	if (!DrawnBatches.empty())
+		Driver->draw2DVertexBatches(DrawnBatches.const_pointer(), DrawnBatches.size());
+	DrawnBatches.set_used(0);
+}
+
+
+//! deletes the batches of elements not drawn anymore
+void CGUIEnvironment::clearBatches(const core::hash_set<IGUIElement*>* keep)
+{
+	core::array<IGUIElement*> removed;
+	core::hash_map<IGUIElement*, video::S2DVertexBatch*>::Iterator it = ElementBatches.getIterator();
+	for (; !it.atEnd(); ++it)
+	{
+		if (!keep || !keep->contains(it->getKey()))
+		{
+			removed.push_back(it->getKey());
+			delete it->getValue();
+		}
+	}
+
+	for (u32 i=0; i<removed.size(); ++i)
+	{
+		ElementBatches.remove(removed[i]);
+		removed[i]->drop();
+	}
+}
+
+
+//! resets the changes of the retained mode
+void CGUIEnvironment::clearChanges()
+{
+	RedrawAll = false;
+	if (!ChangedElements.empty())
+		ChangedElements.clear();
+}
+
+
 //! sets the focus to an element
 bool CGUIEnvironment::setFocus(IGUIElement* element)
 {
@@ -282,6 +625,9 @@ bool CGUIEnvironment::setFocus(IGUIElement* element)
 	if (currentFocus)
 		currentFocus->drop();
 
+	invalidate(Focus);
+	invalidate(element);
+
 	if (Focus)
 		Focus->drop();
 
@@ -532,6 +878,11 @@ void CGUIEnvironment::updateHoveredElement(core::position2d<s32> mousePos)
 
 	if (Hovered != lastHovered)
 	{
+		if (lastHovered != this)
+			invalidate(lastHovered);
+		if (Hovered != this)
+			invalidate(Hovered);
+
 		SEvent event;
 		event.EventType = EET_GUI_EVENT;
 
@@ -591,6 +942,15 @@ void CGUIEnvironment::setUserEventReceiver(IEventReceiver* evr)
 //! posts an input event to the environment
 bool CGUIEnvironment::postEventFromUser(const SEvent& event)
 {
+	// the hovered and focused elements can change their look on any input
+	if (RetainedMode && (event.EventType == EET_MOUSE_INPUT_EVENT ||
+		event.EventType == EET_KEY_INPUT_EVENT || event.EventType == EET_SDL_TEXT_EVENT))
+	{
+		if (Hovered != this)
+			invalidate(Hovered);
+		invalidate(Focus);
+	}
+
 	switch(event.EventType)
 	{
 	case EET_GUI_EVENT:
@@ -691,6 +1051,8 @@ void CGUIEnvironment::setSkin(IGUISkin* skin)
 
 	if (CurrentSkin)
 		CurrentSkin->grab();
+
+	invalidate(this);
 }
 
 
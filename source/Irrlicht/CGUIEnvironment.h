@@ -11,6 +11,9 @@
 #include "IGUIEnvironment.h"
 #include "IGUIElement.h"
 #include "irrArray.h"
+#include "irrHashMap.h"
+#include "irrHashSet.h"
+#include "S2DVertexBatch.h"
 #include "IFileSystem.h"
 #include "IOSOperator.h"
 
@@ -33,6 +36,18 @@ public:
 	//! draws all gui elements
 	virtual void drawAll(bool useScreenSize) IRR_OVERRIDE;
 
+	//! Enables or disables the retained mode.
+	virtual void setRetainedMode(bool retained, video::SColor background) IRR_OVERRIDE;
+
+	//! Returns if the retained mode is enabled.
+	virtual bool isRetainedMode() const IRR_OVERRIDE;
+
+	//! Marks an element as changed, so the retained mode draws it again.
+	virtual void invalidate(IGUIElement* element) IRR_OVERRIDE;
+
+	//! Checks if the gui has to be drawn again.
+	virtual bool needsRedraw() IRR_OVERRIDE;
+
 	//! returns the current video driver
 	virtual video::IVideoDriver* getVideoDriver() const IRR_OVERRIDE;
 
@@ -285,6 +300,18 @@ private:
 
 	void loadBuiltInFont();
 
+	//! draws only the changed area in retained mode
+	void drawChangedArea();
+
+	//! draws top level elements in retained mode, recorded into batches when the driver can do that
+	void drawElements(const core::array<IGUIElement*>& elements);
+
+	//! deletes the batches of elements not drawn anymore, or all batches when 0
+	void clearBatches(const core::hash_set<IGUIElement*>* keep);
+
+	//! resets the changes of the retained mode
+	void clearChanges();
+
 	struct SFont
 	{
 		io::SNamedPath NamedPath;
@@ -334,6 +361,17 @@ private:
 	u32 FocusFlags;
 	core::array<IGUIElement*> DeletionQueue;
 
+	bool RetainedMode;
+	bool RedrawAll;
+	video::SColor RetainedBackground;
+	// top level elements changed since the last drawAll(), the pointers are only compared
+	core::hash_set<IGUIElement*> ChangedElements;
+	// area covered by each top level element when it was drawn last time
+	core::hash_map<IGUIElement*, core::rect<s32> > DrawnAreas;
+	// recorded drawing of each drawn top level element, 0 when it can't be recorded. The elements are grabbed.
+	core::hash_map<IGUIElement*, video::S2DVertexBatch*> ElementBatches;
+	core::array<const video::S2DVertexBatch*> DrawnBatches;
+
 	static const io::path DefaultFontName;
 };
 
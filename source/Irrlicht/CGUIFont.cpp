@@ -18,15 +18,25 @@ namespace irr
 namespace gui
 {
 
+namespace
+{
+	// Layouts kept for texts drawn again. The least recently drawn half is
+	// removed when there are more.
+	const u32 MAX_CACHED_LAYOUTS = 4096;
+}
+
 //! constructor
 CGUIFont::CGUIFont(IGUIEnvironment *env, const io::path& filename)
 : Driver(0), SpriteBank(0), Environment(env), WrongCharacter(0),
-	MaxHeight(0), GlobalKerningWidth(0), GlobalKerningHeight(0)
+	MaxHeight(0), GlobalKerningWidth(0), GlobalKerningHeight(0), LayoutClock(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CGUIFont");
 	#endif
 
+	for (u32 i=0; i<256; ++i)
+		GlyphPages[i] = -1;
+
 	if (Environment)
 	{
 		// don't grab environment, to avoid circular references
@@ -49,6 +59,8 @@ CGUIFont::CGUIFont(IGUIEnvironment *env, const io::path& filename)
 //! destructor
 CGUIFont::~CGUIFont()
 {
+	clearLayoutCache();
+
 	if (Driver)
 		Driver->drop();
 
@@ -188,6 +200,8 @@ bool CGUIFont::load(io::IXMLReader* xml, const io::path& directory)
 		}
 	}
 
+	updateGlyphTable();
+
 	// set bad character
 	WrongCharacter = getAreaFromCharacter(L' ');
 
@@ -285,6 +299,7 @@ bool CGUIFont::loadTexture(video::IImage* image, const io::path& name)
 	}
 	readPositions(tmpImage, lowerRightPositions);
 
+	updateGlyphTable();
 	WrongCharacter = getAreaFromCharacter(L' ');
 
 	// output warnings
@@ -388,6 +403,8 @@ void CGUIFont::readPositions(video::IImage* image, s32& lowerRightPositions)
 //! set an Pixel Offset on Drawing ( scale position on width )
 void CGUIFont::setKerningWidth(s32 kerning)
 {
+	if (kerning != GlobalKerningWidth)
+		clearLayoutCache();
 	GlobalKerningWidth = kerning;
 }
 
@@ -434,16 +451,58 @@ u32 CGUIFont::getSpriteNoFromChar(const wchar_t *c) const
 
 s32 CGUIFont::getAreaFromCharacter(const wchar_t c) const
 {
-	core::map<wchar_t, s32>::Node* n = CharacterMap.find(c);
+	const u32 code = (u32)c;
+	if (code < 0x10000)
+	{
+		const s32 page = GlyphPages[code >> 8];
+		if (page >= 0)
+		{
+			const s32 area = GlyphTable[page + (code & 0xff)];
+			if (area >= 0)
+				return area;
+		}
+		return WrongCharacter;
+	}
+
+	const core::hash_map<wchar_t, s32>::Node* n = CharacterMap.find(c);
 	if (n)
 		return n->getValue();
 	else
 		return WrongCharacter;
 }
 
+
+void CGUIFont::updateGlyphTable()
+{
+	for (u32 i=0; i<256; ++i)
+		GlyphPages[i] = -1;
+	GlyphTable.clear();
+
+	for (core::hash_map<wchar_t, s32>::ConstIterator it = CharacterMap.getConstIterator(); !it.atEnd(); ++it)
+	{
+		const u32 code = (u32)it->getKey();
+		if (code >= 0x10000)
+			continue;
+
+		s32& page = GlyphPages[code >> 8];
+		if (page < 0)
+		{
+			page = (s32)GlyphTable.size();
+			GlyphTable.reallocate(GlyphTable.size() + 256);
+			for (u32 i=0; i<256; ++i)
+				GlyphTable.push_back(-1);
+		}
+		GlyphTable[page + (code & 0xff)] = it->getValue();
+	}
+
+	clearLayoutCache();
+}
+
+
 void CGUIFont::setInvisibleCharacters( const wchar_t *s )
 {
 	Invisible = s;
+	clearLayoutCache();
 }
 
 
@@ -497,28 +556,112 @@ void CGUIFont::draw(const core::stringw& text, const core::rect<s32>& position,
 	if (!Driver || !SpriteBank)
 		return;
 
-	core::dimension2d<s32> textDimension;	// NOTE: don't make this u32 or the >> later on can fail when the dimension width is < position width
-	core::position2d<s32> offset = position.UpperLeftCorner;
-
-	if (hcenter || vcenter || clip)
-		textDimension = getDimension(text.c_str());
-
-	if (hcenter)
-		offset.X += (position.getWidth() - textDimension.Width) >> 1;
-
-	if (vcenter)
-		offset.Y += (position.getHeight() - textDimension.Height) >> 1;
+	const STextLayout& layout = getLayout(text, position, hcenter, vcenter);
 
 	if (clip)
 	{
-		core::rect<s32> clippedRect(offset, textDimension);
+		core::rect<s32> clippedRect(layout.TextRect + position.UpperLeftCorner);
 		clippedRect.clipAgainst(*clip);
 		if (!clippedRect.isValid())
 			return;
 	}
 
-	core::array<u32> indices(text.size());
-	core::array<core::position2di> offsets(text.size());
+	SpriteBank->draw2DSpriteBatch(layout.Indices, layout.Offsets, clip, color);
+}
+
+
+//! Get the cached layout of a text, calculates it when needed
+const CGUIFont::STextLayout& CGUIFont::getLayout(const core::stringw& text, const core::rect<s32>& position,
+		bool hcenter, bool vcenter)
+{
+	// the size only matters for centering
+	const core::dimension2d<s32> size(hcenter ? position.getWidth() : 0, vcenter ? position.getHeight() : 0);
+	const u32 key = text.getHash() ^ core::hashMix((u32)(size.Width * 4 + (hcenter ? 2 : 0) + (vcenter ? 1 : 0)))
+		^ core::hashMix((u32)size.Height + 0x9e3779b9u);
+
+	++LayoutClock;
+	core::hash_map<u32, STextLayout*>::Node* node = LayoutCache.find(key);
+	if (node)
+	{
+		STextLayout& layout = *node->getValue();
+		if (layout.Text == text && layout.Size == size && layout.HCenter == hcenter && layout.VCenter == vcenter)
+		{
+			layout.LastUsed = LayoutClock;
+
+			// texts which moved only need new offsets
+			const core::position2d<s32> move = position.UpperLeftCorner - layout.Position;
+			if (move.X || move.Y)
+			{
+				for (u32 i=0; i<layout.Offsets.size(); ++i)
+					layout.Offsets[i] += move;
+				layout.Position = position.UpperLeftCorner;
+			}
+			return layout;
+		}
+	}
+	else
+	{
+		if (LayoutCache.size() >= MAX_CACHED_LAYOUTS)
+		{
+			// remove the layouts not drawn for the longest time
+			core::array<u32> lastUsed(LayoutCache.size());
+			for (core::hash_map<u32, STextLayout*>::Iterator it = LayoutCache.getIterator(); !it.atEnd(); ++it)
+				lastUsed.push_back(it->getValue()->LastUsed);
+			lastUsed.sort();
+			const u32 oldest = lastUsed[lastUsed.size() / 2];
+
+			core::array<u32> unused(LayoutCache.size() / 2 + 1);
+			for (core::hash_map<u32, STextLayout*>::Iterator it = LayoutCache.getIterator(); !it.atEnd(); ++it)
+			{
+				if (it->getValue()->LastUsed < oldest)
+				{
+					delete it->getValue();
+					unused.push_back(it->getKey());
+				}
+			}
+			for (u32 i=0; i<unused.size(); ++i)
+				LayoutCache.remove(unused[i]);
+		}
+
+		LayoutCache.insert(key, new STextLayout());
+		node = LayoutCache.find(key);
+	}
+
+	// new text or another one with the same hash
+	STextLayout& layout = *node->getValue();
+	layout.Text = text;
+	layout.Size = size;
+	layout.HCenter = hcenter;
+	layout.VCenter = vcenter;
+	layout.LastUsed = LayoutClock;
+	layoutText(layout, position);
+	return layout;
+}
+
+
+//! Calculate the sprites of a text
+void CGUIFont::layoutText(STextLayout& layout, const core::rect<s32>& position) const
+{
+	const core::stringw& text = layout.Text;
+	core::dimension2d<s32> textDimension;	// NOTE: don't make this u32 or the >> later on can fail when the dimension width is < position width
+	textDimension = getDimension(text.c_str());
+	core::position2d<s32> offset = position.UpperLeftCorner;
+
+	if (layout.HCenter)
+		offset.X += (position.getWidth() - textDimension.Width) >> 1;
+
+	if (layout.VCenter)
+		offset.Y += (position.getHeight() - textDimension.Height) >> 1;
+
+	layout.Position = position.UpperLeftCorner;
+	layout.TextRect = core::rect<s32>(offset - position.UpperLeftCorner, textDimension);
+
+	core::array<u32>& indices = layout.Indices;
+	core::array<core::position2di>& offsets = layout.Offsets;
+	indices.set_used(0);
+	offsets.set_used(0);
+	indices.reallocate(text.size(), false);
+	offsets.reallocate(text.size(), false);
 
 	for(u32 i = 0;i < text.size();i++)
 	{
@@ -541,14 +684,14 @@ void CGUIFont::draw(const core::stringw& text, const core::rect<s32>& position,
 			offset.Y += MaxHeight;
 			offset.X = position.UpperLeftCorner.X;
 
-			if ( hcenter )
+			if ( layout.HCenter )
 			{
 				offset.X += (position.getWidth() - textDimension.Width) >> 1;
 			}
 			continue;
 		}
 
-		SFontArea& area = Areas[getAreaFromCharacter(c)];
+		const SFontArea& area = Areas[getAreaFromCharacter(c)];
 
 		offset.X += area.underhang;
 		if ( Invisible.findFirst ( c ) < 0 )
@@ -559,8 +702,14 @@ void CGUIFont::draw(const core::stringw& text, const core::rect<s32>& position,
 
 		offset.X += area.width + area.overhang + GlobalKerningWidth;
 	}
+}
 
-	SpriteBank->draw2DSpriteBatch(indices, offsets, clip, color);
+
+void CGUIFont::clearLayoutCache()
+{
+	for (core::hash_map<u32, STextLayout*>::Iterator it = LayoutCache.getIterator(); !it.atEnd(); ++it)
+		delete it->getValue();
+	LayoutCache.clear();
 }
 
 
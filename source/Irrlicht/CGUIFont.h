@@ -10,7 +10,7 @@
 
 #include "IGUIFontBitmap.h"
 #include "irrString.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 #include "IXMLReader.h"
 #include "IReadFile.h"
 #include "irrArray.h"
@@ -90,6 +90,25 @@ private:
 		u32				spriteno;
 	};
 
+	//! Positions of the sprites of a text, kept by draw() for texts drawn again
+	struct STextLayout
+	{
+		core::stringw Text;
+		core::dimension2d<s32> Size;
+		bool HCenter;
+		bool VCenter;
+		u32 LastUsed;
+
+		//! Upper left corner of the rectangle for which Offsets are calculated
+		core::position2d<s32> Position;
+
+		//! Area of the text relative to Position, for clipping
+		core::rect<s32> TextRect;
+
+		core::array<u32> Indices;
+		core::array<core::position2di> Offsets;
+	};
+
 	//! load & prepare font from ITexture
 	bool loadTexture(video::IImage * image, const io::path& name);
 
@@ -98,11 +117,26 @@ private:
 	s32 getAreaFromCharacter (const wchar_t c) const;
 	void setMaxHeight();
 
+	//! Fill the glyph table from CharacterMap
+	void updateGlyphTable();
+
+	//! Get the cached layout of a text, calculates it when needed
+	const STextLayout& getLayout(const core::stringw& text, const core::rect<s32>& position,
+			bool hcenter, bool vcenter);
+	void layoutText(STextLayout& layout, const core::rect<s32>& position) const;
+	void clearLayoutCache();
+
 	void pushTextureCreationFlags(bool(&flags)[3]);
 	void popTextureCreationFlags(const bool(&flags)[3]);
 
 	core::array<SFontArea>		Areas;
-	core::map<wchar_t, s32>		CharacterMap;
+	core::hash_map<wchar_t, s32>	CharacterMap;
+
+	// Areas of characters below 0x10000 for direct lookup, others are only in CharacterMap.
+	// Characters are in pages of 256, GlyphPages has the start of each page
+	// in GlyphTable or -1 for pages without any character of the font.
+	s32				GlyphPages[256];
+	core::array<s32>		GlyphTable;
 	video::IVideoDriver*		Driver;
 	IGUISpriteBank*			SpriteBank;
 	IGUIEnvironment*		Environment;
@@ -111,6 +145,10 @@ private:
 	s32				GlobalKerningWidth, GlobalKerningHeight;
 
 	core::stringw Invisible;
+
+	// layouts of texts drawn before, by hash of text, size and alignment
+	core::hash_map<u32, STextLayout*>	LayoutCache;
+	u32				LayoutClock;
 };
 
 } // end namespace gui
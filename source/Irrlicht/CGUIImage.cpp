@@ -47,6 +47,8 @@ void CGUIImage::setImage(video::ITexture* image)
 
 	if (Texture)
 		Texture->grab();
+
+	invalidate();
 }
 
 //! Gets the image texture
@@ -59,6 +61,7 @@ video::ITexture* CGUIImage::getImage() const
 void CGUIImage::setColor(video::SColor color)
 {
 	Color = color;
+	invalidate();
 }
 
 //! Gets the color of the image
@@ -120,6 +123,7 @@ void CGUIImage::draw()
 void CGUIImage::setUseAlphaChannel(bool use)
 {
 	UseAlphaChannel = use;
+	invalidate();
 }
 
 
@@ -127,6 +131,7 @@ void CGUIImage::setUseAlphaChannel(bool use)
 void CGUIImage::setScaleImage(bool scale)
 {
 	ScaleImage = scale;
+	invalidate();
 }
 
 
@@ -146,6 +151,7 @@ bool CGUIImage::isAlphaChannelUsed() const
 void CGUIImage::setSourceRect(const core::rect<s32>& sourceRect)
 {
 	SourceRect = sourceRect;
+	invalidate();
 }
 
 //! Returns the customized source rectangle of the image to be used.
@@ -166,6 +172,8 @@ void CGUIImage::setDrawBounds(const core::rect<f32>& drawBoundUVs)
 		DrawBounds.UpperLeftCorner.X = DrawBounds.LowerRightCorner.X;
 	if ( DrawBounds.UpperLeftCorner.Y > DrawBounds.LowerRightCorner.Y )
 		DrawBounds.UpperLeftCorner.Y = DrawBounds.LowerRightCorner.Y;
+
+	invalidate();
 }
 
 //! Get target drawing-area restrictions.
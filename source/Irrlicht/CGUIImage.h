@@ -68,6 +68,7 @@ namespace gui
 		virtual void setDrawBackground(bool draw) IRR_OVERRIDE
 		{
 			DrawBackground = draw;
+			invalidate();
 		}
 
 		//! Checks if a background is drawn when no texture is set
@@ -26,6 +26,7 @@ CGUIInOutFader::CGUIInOutFader(IGUIEnvironment* environment, IGUIElement* parent
 	Action = EFA_NOTHING;
 	StartTime = 0;
 	EndTime = 0;
+	DrawTime = 0;
 
 	setColor(video::SColor(0,0,0,0));
 }
@@ -38,6 +39,7 @@ void CGUIInOutFader::draw()
 		return;
 
 	u32 now = os::Timer::getTime();
+	DrawTime = now;
 	if (now > EndTime && Action == EFA_FADE_IN)
 	{
 		Action = EFA_NOTHING;
@@ -63,6 +65,17 @@ void CGUIInOutFader::draw()
 }
 
 
+//! animates the element and its children
+void CGUIInOutFader::OnPostRender(u32 timeMs)
+{
+	// the color changes until it was drawn once after the end time
+	if (IsVisible && Action != EFA_NOTHING && DrawTime <= EndTime)
+		invalidate();
+
+	IGUIElement::OnPostRender(timeMs);
+}
+
+
 //! Gets the color to fade out to or to fade in from.
 video::SColor CGUIInOutFader::getColor() const
 {
@@ -98,6 +111,7 @@ void CGUIInOutFader::setColor(video::SColor color)
 		TransColor.setAlpha(0);
 	}
 */
+	invalidate();
 }
 
 
@@ -118,6 +132,7 @@ void CGUIInOutFader::setColor(video::SColor source, video::SColor dest)
 		TransColor = Color[1];
 	}
 
+	invalidate();
 }
 
 
@@ -26,6 +26,9 @@ namespace gui
 		//! draws the element and its children
 		virtual void draw() IRR_OVERRIDE;
 
+		//! animates the element and its children
+		virtual void OnPostRender(u32 timeMs) IRR_OVERRIDE;
+
 		//! Gets the color to fade out to or to fade in from.
 		virtual video::SColor getColor() const IRR_OVERRIDE;
 
@@ -59,6 +62,7 @@ namespace gui
 
 		u32 StartTime;
 		u32 EndTime;
+		u32 DrawTime;
 		EFadeAction Action;
 
 		video::SColor Color[2];
@@ -115,6 +115,7 @@ void CGUIListBox::removeItem(u32 id)
 	Items.erase(id);
 
 	recalculateItemHeight();
+	invalidate();
 }
 
 
@@ -146,6 +147,7 @@ void CGUIListBox::clear()
 	ScrollBar->setPos(0);
 
 	recalculateItemHeight();
+	invalidate();
 }
 
 
@@ -202,6 +204,7 @@ void CGUIListBox::setSelected(s32 id)
 	SelectTime = os::Timer::getTime();
 
 	recalculateScrollPos();
+	invalidate();
 }
 
 //! sets the selected item. Set this to -1 if no item should be selected
@@ -218,6 +221,7 @@ void CGUIListBox::setSelected(const wchar_t *item)
 		}
 	}
 	setSelected ( index );
+	invalidate();
 }
 
 //! called if an event happened.
@@ -523,13 +527,18 @@ void CGUIListBox::draw()
 
 	frameRect.LowerRightCorner.Y = AbsoluteRect.UpperLeftCorner.Y + ItemHeight;
 
-	frameRect.UpperLeftCorner.Y -= ScrollBar->getPos();
-	frameRect.LowerRightCorner.Y -= ScrollBar->getPos();
+	// start with the first item reaching into the element
+	s32 firstItem = 0;
+	if (ItemHeight > 0 && ScrollBar->getPos() > 0)
+		firstItem = (ScrollBar->getPos() + ItemHeight - 1) / ItemHeight - 1;
+
+	frameRect.UpperLeftCorner.Y += firstItem * ItemHeight - ScrollBar->getPos();
+	frameRect.LowerRightCorner.Y += firstItem * ItemHeight - ScrollBar->getPos();
 
 	bool hl = (HighlightWhenNotFocused || Environment->hasFocus(this) || Environment->hasFocus(ScrollBar));
 	const irr::s32 selected = getSelected();
 
-	for (s32 i=0; i<(s32)Items.size(); ++i)
+	for (s32 i=firstItem; i<(s32)Items.size() && frameRect.UpperLeftCorner.Y <= AbsoluteRect.LowerRightCorner.Y; ++i)
 	{
 		if (frameRect.LowerRightCorner.Y >= AbsoluteRect.UpperLeftCorner.Y &&
 			frameRect.UpperLeftCorner.Y <= AbsoluteRect.LowerRightCorner.Y)
@@ -573,14 +582,14 @@ void CGUIListBox::draw()
 
 				if ( i==selected && hl )
 				{
-					Font->draw(Items[i].Text.c_str(), textRect,
+					Font->draw(Items[i].Text, textRect,
 						hasItemOverrideColor(i, EGUI_LBC_TEXT_HIGHLIGHT) ?
 						getItemOverrideColor(i, EGUI_LBC_TEXT_HIGHLIGHT) : getItemDefaultColor(EGUI_LBC_TEXT_HIGHLIGHT),
 						false, true, &clientClip);
 				}
 				else
 				{
-					Font->draw(Items[i].Text.c_str(), textRect,
+					Font->draw(Items[i].Text, textRect,
 						hasItemOverrideColor(i, EGUI_LBC_TEXT) ? getItemOverrideColor(i, EGUI_LBC_TEXT) : getItemDefaultColor(EGUI_LBC_TEXT),
 						false, true, &clientClip);
 				}
@@ -607,6 +616,7 @@ u32 CGUIListBox::addItem(const wchar_t* text, s32 icon)
 	Items.push_back(i);
 	recalculateItemHeight();
 	recalculateItemWidth(icon);
+	invalidate();
 
 	return Items.size() - 1;
 }
@@ -622,6 +632,8 @@ void CGUIListBox::setSpriteBank(IGUISpriteBank* bank)
 	IconBank = bank;
 	if (IconBank)
 		IconBank->grab();
+
+	invalidate();
 }
 
 
@@ -807,6 +819,7 @@ void CGUIListBox::setItem(u32 index, const wchar_t* text, s32 icon)
 
 	recalculateItemHeight();
 	recalculateItemWidth(icon);
+	invalidate();
 }
 
 
@@ -844,6 +857,8 @@ void CGUIListBox::setItemOverrideColor(u32 index, video::SColor color)
 		Items[index].OverrideColors[c].Use = true;
 		Items[index].OverrideColors[c].Color = color;
 	}
+
+	invalidate();
 }
 
 
@@ -854,6 +869,7 @@ void CGUIListBox::setItemOverrideColor(u32 index, EGUI_LISTBOX_COLOR colorType,
 
 	Items[index].OverrideColors[colorType].Use = true;
 	Items[index].OverrideColors[colorType].Color = color;
+	invalidate();
 }
 
 
@@ -863,6 +879,8 @@ void CGUIListBox::clearItemOverrideColor(u32 index)
 	{
 		Items[index].OverrideColors[c].Use = false;
 	}
+
+	invalidate();
 }
 
 
@@ -872,6 +890,7 @@ void CGUIListBox::clearItemOverrideColor(u32 index, EGUI_LISTBOX_COLOR colorType
 		return;
 
 	Items[index].OverrideColors[colorType].Use = false;
+	invalidate();
 }
 
 
@@ -923,6 +942,7 @@ void CGUIListBox::setItemHeight( s32 height )
 {
 	ItemHeight = height;
 	ItemHeightOverride = 1;
+	invalidate();
 }
 
 
@@ -930,6 +950,7 @@ void CGUIListBox::setItemHeight( s32 height )
 void CGUIListBox::setDrawBackground(bool draw)
 {
     DrawBack = draw;
+	invalidate();
 }
 
 //! Access the vertical scrollbar
@@ -55,6 +55,7 @@ void CGUIMeshViewer::setMesh(scene::IAnimatedMesh* mesh)
 	box = Mesh->getMesh(0)->getBoundingBox();
 	center = (box.MaxEdge + box.MinEdge) / 2;
 	*/
+	invalidate();
 }
 
 
@@ -69,6 +70,7 @@ scene::IAnimatedMesh* CGUIMeshViewer::getMesh() const
 void CGUIMeshViewer::setMaterial(const video::SMaterial& material)
 {
 	Material = material;
+	invalidate();
 }
 
 
@@ -165,6 +167,17 @@ void CGUIMeshViewer::draw()
 }
 
 
+//! animates the element and its children
+void CGUIMeshViewer::OnPostRender(u32 timeMs)
+{
+	// animated meshes show a new frame each time
+	if (IsVisible && Mesh && Mesh->getFrameCount() > 1)
+		invalidate();
+
+	IGUIElement::OnPostRender(timeMs);
+}
+
+
 } // end namespace gui
 } // end namespace irr
 
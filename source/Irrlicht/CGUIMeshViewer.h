@@ -45,6 +45,9 @@ namespace gui
 		//! draws the element and its children
 		virtual void draw() IRR_OVERRIDE;
 
+		//! animates the element and its children
+		virtual void OnPostRender(u32 timeMs) IRR_OVERRIDE;
+
 	private:
 
 		video::SMaterial Material;
@@ -193,6 +193,17 @@ void CGUIModalScreen::draw()
 }
 
 
+//! animates the element and its children
+void CGUIModalScreen::OnPostRender(u32 timeMs)
+{
+	// draw again until the blinking stopped
+	if (BlinkMode && timeMs - MouseDownTime < 400)
+		invalidate();
+
+	IGUIElement::OnPostRender(timeMs);
+}
+
+
 //! Removes a child.
 void CGUIModalScreen::removeChild(IGUIElement* child)
 {
@@ -35,6 +35,9 @@ namespace gui
 		//! draws the element and its children
 		virtual void draw() IRR_OVERRIDE;
 
+		//! animates the element and its children
+		virtual void OnPostRender(u32 timeMs) IRR_OVERRIDE;
+
 		//! Updates the absolute position.
 		virtual void updateAbsolutePosition() IRR_OVERRIDE;
 
@@ -36,6 +36,14 @@ CGUIProfiler::CGUIProfiler(IGUIEnvironment* environment, IGUIElement* parent, s3
 	rebuildColumns();
 }
 
+//! Profile times are in nanoseconds, but shown in milliseconds
+static core::stringw makeTimeString(f64 nanoseconds)
+{
+	c8 buf[32];
+	snprintf_irr(buf, 32, "%.3f", nanoseconds / 1000000.0);
+	return core::stringw(buf);
+}
+
 void CGUIProfiler::fillRow(u32 rowIndex, const SProfileData& data, bool overviewTitle, bool groupTitle)
 {
 	DisplayTable->setCellText(rowIndex, 0, data.getName());
@@ -44,9 +52,10 @@ void CGUIProfiler::fillRow(u32 rowIndex, const SProfileData& data, bool overview
 		DisplayTable->setCellText(rowIndex, 1, core::stringw(data.getCallsCounter()));
 	if ( data.getCallsCounter() > 0 )
 	{
-		DisplayTable->setCellText(rowIndex, 2, core::stringw(data.getTimeSum()));
-		DisplayTable->setCellText(rowIndex, 3, core::stringw((u32)((f32)data.getTimeSum()/(f32)data.getCallsCounter())));
-		DisplayTable->setCellText(rowIndex, 4, core::stringw(data.getLongestTime()));
+		DisplayTable->setCellText(rowIndex, 2, makeTimeString((f64)data.getTimeSumNanoseconds()));
+		DisplayTable->setCellText(rowIndex, 3, makeTimeString((f64)data.getTimeSumNanoseconds()/(f64)data.getCallsCounter()));
+		DisplayTable->setCellText(rowIndex, 4, makeTimeString((f64)data.getPercentileTime(0.95f)));
+		DisplayTable->setCellText(rowIndex, 5, makeTimeString((f64)data.getLongestTimeNanoseconds()));
 	}
 
 	if ( overviewTitle || groupTitle )
@@ -65,6 +74,7 @@ void CGUIProfiler::rebuildColumns()
 		DisplayTable->addColumn(L"count calls");
 		DisplayTable->addColumn(L"time(sum)");
 		DisplayTable->addColumn(L"time(avg)");
+		DisplayTable->addColumn(L"time(p95)");
 		DisplayTable->addColumn(L"time(max)      ");
 		DisplayTable->setActiveColumn(-1);
 	}
@@ -247,6 +257,7 @@ void CGUIProfiler::previousPage(bool includeOverview)
 void CGUIProfiler::setShowGroupsTogether(bool groupsTogether)
 {
 	ShowGroupsTogether = groupsTogether;
+	invalidate();
 }
 
 bool CGUIProfiler::getShowGroupsTogether() const
@@ -272,6 +283,8 @@ void CGUIProfiler::setOverrideFont(IGUIFont* font)
 		DisplayTable->setOverrideFont(font);
 		rebuildColumns();
 	}
+
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -296,6 +309,8 @@ void CGUIProfiler::setDrawBackground(bool draw)
 	DrawBackground = draw;
 	if ( DisplayTable )
 		DisplayTable->setDrawBackground(draw);
+
+	invalidate();
 }
 
 //! Checks if background drawing is enabled
@@ -322,6 +337,7 @@ void CGUIProfiler::setFilters(irr::u32 minCalls, irr::u32 minTimeSum, irr::f32 m
 	MinTimeSum = minTimeSum;
 	MinTimeAverage = minTimeAverage;
 	MinTimeMax = minTimeMax;
+	invalidate();
 }
 
 } // end namespace gui
@@ -360,6 +360,8 @@ void CGUIScrollBar::setPos(s32 pos)
 			DrawHeight = RelativeRect.getWidth();
 		}
 	}
+
+	invalidate();
 }
 
 
@@ -415,6 +417,7 @@ void CGUIScrollBar::setMax(s32 max)
 	UpButton->setEnabled(enable);
 	DownButton->setEnabled(enable);
 	setPos(Pos);
+	invalidate();
 }
 
 //! gets the minimum value of the scrollbar.
@@ -436,6 +439,7 @@ void CGUIScrollBar::setMin(s32 min)
 	UpButton->setEnabled(enable);
 	DownButton->setEnabled(enable);
 	setPos(Pos);
+	invalidate();
 }
 
 
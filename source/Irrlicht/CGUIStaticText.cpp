@@ -99,7 +99,7 @@ void CGUIStaticText::draw()
 						font->getDimension(Text.c_str()).Width;
 				}
 
-				font->draw(Text.c_str(), frameRect, 
+				font->draw(Text, frameRect,
 					getActiveColor(),
 					HAlign == EGUIA_CENTER, VAlign == EGUIA_CENTER, (RestrainTextInside ? &AbsoluteClippingRect : NULL));
 			}
@@ -128,7 +128,7 @@ void CGUIStaticText::draw()
 							font->getDimension(BrokenText[i].c_str()).Width;
 					}
 
-					font->draw(BrokenText[i].c_str(), r,
+					font->draw(BrokenText[i], r,
 						getActiveColor(),
 						HAlign == EGUIA_CENTER, false, (RestrainTextInside ? &AbsoluteClippingRect : NULL));
 
@@ -158,6 +158,7 @@ void CGUIStaticText::setOverrideFont(IGUIFont* font)
 		OverrideFont->grab();
 
 	breakText();
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -182,6 +183,7 @@ void CGUIStaticText::setOverrideColor(video::SColor color)
 {
 	OverrideColor = color;
 	OverrideColorEnabled = true;
+	invalidate();
 }
 
 
@@ -191,6 +193,7 @@ void CGUIStaticText::setBackgroundColor(video::SColor color)
 	BGColor = color;
 	OverrideBGColorEnabled = true;
 	Background = true;
+	invalidate();
 }
 
 
@@ -198,6 +201,7 @@ void CGUIStaticText::setBackgroundColor(video::SColor color)
 void CGUIStaticText::setDrawBackground(bool draw)
 {
 	Background = draw;
+	invalidate();
 }
 
 
@@ -219,6 +223,7 @@ bool CGUIStaticText::isDrawBackgroundEnabled() const
 void CGUIStaticText::setDrawBorder(bool draw)
 {
 	Border = draw;
+	invalidate();
 }
 
 
@@ -232,6 +237,7 @@ bool CGUIStaticText::isDrawBorderEnabled() const
 void CGUIStaticText::setTextRestrainedInside(bool restrainTextInside)
 {
 	RestrainTextInside = restrainTextInside;
+	invalidate();
 }
 
 
@@ -245,6 +251,7 @@ void CGUIStaticText::setTextAlignment(EGUI_ALIGNMENT horizontal, EGUI_ALIGNMENT
 {
 	HAlign = horizontal;
 	VAlign = vertical;
+	invalidate();
 }
 
 
@@ -269,6 +276,7 @@ irr::video::SColor CGUIStaticText::getActiveColor() const
 void CGUIStaticText::enableOverrideColor(bool enable)
 {
 	OverrideColorEnabled = enable;
+	invalidate();
 }
 
 
@@ -284,6 +292,7 @@ void CGUIStaticText::setWordWrap(bool enable)
 {
 	WordWrap = enable;
 	breakText();
+	invalidate();
 }
 
 
@@ -300,6 +309,8 @@ void CGUIStaticText::setRightToLeft(bool rtl)
 		RightToLeft = rtl;
 		breakText();
 	}
+
+	invalidate();
 }
 
 
@@ -531,6 +542,7 @@ void CGUIStaticText::setText(const wchar_t* text)
 {
 	IGUIElement::setText(text);
 	breakText();
+	invalidate();
 }
 
 
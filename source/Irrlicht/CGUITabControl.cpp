@@ -57,6 +57,7 @@ void CGUITab::draw()
 void CGUITab::setDrawBackground(bool draw)
 {
 	DrawBackground = draw;
+	invalidate();
 }
 
 
@@ -64,6 +65,7 @@ void CGUITab::setDrawBackground(bool draw)
 void CGUITab::setBackgroundColor(video::SColor c)
 {
 	BackColor = c;
+	invalidate();
 }
 
 
@@ -72,6 +74,7 @@ void CGUITab::setTextColor(video::SColor c)
 {
 	OverrideTextColorEnabled = true;
 	TextColor = c;
+	invalidate();
 }
 
 
@@ -362,6 +365,7 @@ void CGUITabControl::removeTab(s32 idx)
 		return;
 
 	removeChild(Tabs[(u32)idx]);
+	invalidate();
 }
 
 void CGUITabControl::removeTabButNotChild(s32 idx)
@@ -399,6 +403,7 @@ void CGUITabControl::clear()
 	Tabs.clear();
 
 	recalculateScrollBar();
+	invalidate();
 }
 
 //! Returns amount of tabs in the tabcontrol
@@ -797,6 +802,7 @@ void CGUITabControl::setTabHeight( s32 height )
 
 	recalculateScrollButtonPlacement();
 	recalculateScrollBar();
+	invalidate();
 }
 
 
@@ -810,6 +816,7 @@ s32 CGUITabControl::getTabHeight() const
 void CGUITabControl::setTabMaxWidth(s32 width )
 {
 	TabMaxWidth = width;
+	invalidate();
 }
 
 //! get the maximal width of a tab
@@ -828,6 +835,7 @@ void CGUITabControl::setTabExtraWidth( s32 extraWidth )
 	TabExtraWidth = extraWidth;
 
 	recalculateScrollBar();
+	invalidate();
 }
 
 
@@ -873,6 +881,8 @@ void CGUITabControl::setTabVerticalAlignment( EGUI_ALIGNMENT alignment )
 	{
 		Tabs[i]->setRelativePosition(r);
 	}
+
+	invalidate();
 }
 
 void CGUITabControl::recalculateScrollButtonPlacement()
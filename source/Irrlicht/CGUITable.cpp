@@ -102,6 +102,7 @@ void CGUITable::addColumn(const wchar_t* caption, s32 columnIndex)
 		ActiveTab = 0;
 
 	recalculateWidths();
+	invalidate();
 }
 
 
@@ -120,6 +121,7 @@ void CGUITable::removeColumn(u32 columnIndex)
 		ActiveTab = Columns.size() ? 0 : -1;
 
 	recalculateWidths();
+	invalidate();
 }
 
 
@@ -195,6 +197,7 @@ bool CGUITable::setActiveColumn(s32 idx, bool doOrder )
 		Parent->OnEvent(event);
 	}
 
+	invalidate();
 	return true;
 }
 
@@ -227,6 +230,7 @@ void CGUITable::setColumnWidth(u32 columnIndex, u32 width)
 		}
 	}
 	recalculateWidths();
+	invalidate();
 }
 
 //! Get the width of a column
@@ -271,6 +275,7 @@ u32 CGUITable::addRow(u32 rowIndex)
 	}
 
 	recalculateHeights();
+	invalidate();
 	return rowIndex;
 }
 
@@ -286,6 +291,7 @@ void CGUITable::removeRow(u32 rowIndex)
 		Selected = Rows.size() - 1;
 
 	recalculateHeights();
+	invalidate();
 }
 
 
@@ -301,6 +307,8 @@ void CGUITable::setCellText(u32 rowIndex, u32 columnIndex, const core::stringw&
 		if ( skin )
 			Rows[rowIndex].Items[columnIndex].Color = skin->getColor(EGDC_BUTTON_TEXT);
 	}
+
+	invalidate();
 }
 
 void CGUITable::setCellText(u32 rowIndex, u32 columnIndex, const core::stringw& text, video::SColor color)
@@ -312,6 +320,8 @@ void CGUITable::setCellText(u32 rowIndex, u32 columnIndex, const core::stringw&
 		Rows[rowIndex].Items[columnIndex].Color = color;
 		Rows[rowIndex].Items[columnIndex].IsOverrideColor = true;
 	}
+
+	invalidate();
 }
 
 
@@ -322,6 +332,8 @@ void CGUITable::setCellColor(u32 rowIndex, u32 columnIndex, video::SColor color)
 		Rows[rowIndex].Items[columnIndex].Color = color;
 		Rows[rowIndex].Items[columnIndex].IsOverrideColor = true;
 	}
+
+	invalidate();
 }
 
 
@@ -370,6 +382,7 @@ void CGUITable::clear()
 
 	recalculateHeights();
 	recalculateWidths();
+	invalidate();
 }
 
 
@@ -382,6 +395,7 @@ void CGUITable::clearRows()
 		VerticalScrollBar->setPos(0);
 
 	recalculateHeights();
+	invalidate();
 }
 
 
@@ -398,6 +412,8 @@ void CGUITable::setSelected( s32 index )
 	Selected = -1;
 	if ( index >= 0 && index < (s32) Rows.size() )
 		Selected = index;
+
+	invalidate();
 }
 
 
@@ -660,6 +676,8 @@ void CGUITable::setColumnOrdering(u32 columnIndex, EGUI_COLUMN_ORDERING mode)
 {
 	if ( columnIndex < Columns.size() )
 		Columns[columnIndex].OrderingMode = mode;
+
+	invalidate();
 }
 
 
@@ -904,12 +922,19 @@ void CGUITable::draw()
 		scrolledTableClient.LowerRightCorner.X -= HorizontalScrollBar->getPos();
 	}
 
+	// start with the first row reaching into the element
+	const s32 hiddenHeight = AbsoluteRect.UpperLeftCorner.Y - scrolledTableClient.UpperLeftCorner.Y;
+	u32 firstRow = 0;
+	if ( ItemHeight > 0 && hiddenHeight > 0 )
+		firstRow = (u32)((hiddenHeight + ItemHeight - 1) / ItemHeight - 1);
+
 	// rowRect is around the scrolled row
 	core::rect<s32> rowRect(scrolledTableClient);
+	rowRect.UpperLeftCorner.Y += (s32)firstRow * ItemHeight;
 	rowRect.LowerRightCorner.Y = rowRect.UpperLeftCorner.Y + ItemHeight;
 
 	u32 pos;
-	for ( u32 i = 0 ; i < Rows.size() ; ++i )
+	for ( u32 i = firstRow ; i < Rows.size() && rowRect.UpperLeftCorner.Y <= AbsoluteRect.LowerRightCorner.Y ; ++i )
 	{
 		if (rowRect.LowerRightCorner.Y >= AbsoluteRect.UpperLeftCorner.Y &&
 			rowRect.UpperLeftCorner.Y <= AbsoluteRect.LowerRightCorner.Y)
@@ -1060,6 +1085,7 @@ void CGUITable::breakText(const core::stringw& text, core::stringw& brokenText,
 void CGUITable::setDrawFlags(s32 flags)
 {
 	DrawFlags = flags;
+	invalidate();
 }
 
 
@@ -1084,6 +1110,7 @@ void CGUITable::setOverrideFont(IGUIFont* font)
 		OverrideFont->grab();
 
 	refreshControls();
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -1125,6 +1152,7 @@ IGUIScrollBar* CGUITable::getHorizontalScrollBar() const
 void CGUITable::setDrawBackground(bool draw)
 {
 	DrawBack = draw;
+	invalidate();
 }
 
 //! Checks if background drawing is enabled
@@ -21,11 +21,13 @@ namespace gui
 
 CGUITreeViewNode::CGUITreeViewNode( CGUITreeView* owner, CGUITreeViewNode* parent )
 	: Owner(owner), Parent(parent), ImageIndex(-1), SelectedImageIndex(-1),
-	Data(0), Data2(0), Expanded(false)
+	Data(0), Data2(0), Expanded(false), VisibleRows(0)
 {
 #ifdef _DEBUG
 	setDebugName( "CGUITreeView" );
 #endif
+
+	Owner->invalidate();
 }
 
 CGUITreeViewNode::~CGUITreeViewNode()
@@ -35,7 +37,13 @@ CGUITreeViewNode::~CGUITreeViewNode()
 		setSelected( false );
 	}
 
-	clearChildren();
+	// the rows don't need updating, this node is not in the tree anymore
+	core::list<CGUITreeViewNode*>::Iterator	it;
+	for( it = Children.begin(); it != Children.end(); it++ )
+	{
+		( *it )->Parent = 0;
+		( *it )->drop();
+	}
 
 	if( Data2 )
 	{
@@ -56,11 +64,13 @@ IGUITreeViewNode* CGUITreeViewNode::getParent() const
 void CGUITreeViewNode::setText( const wchar_t* text )
 {
 	Text = text;
+	Owner->invalidate();
 }
 
 void CGUITreeViewNode::setIcon( const wchar_t* icon )
 {
 	Icon = icon;
+	Owner->invalidate();
 }
 
 void CGUITreeViewNode::clearChildren()
@@ -69,9 +79,54 @@ void CGUITreeViewNode::clearChildren()
 
 	for( it = Children.begin(); it != Children.end(); it++ )
 	{
+		( *it )->Parent = 0;
 		( *it )->drop();
 	}
 	Children.clear();
+	addVisibleRows( -(s32)VisibleRows );
+	Owner->resetRowCache();
+	Owner->invalidate();
+}
+
+void CGUITreeViewNode::initChild( CGUITreeViewNode* child,
+	const core::list<CGUITreeViewNode*>::Iterator& position,
+	const wchar_t*		text,
+	const wchar_t*		icon,
+	s32					imageIndex,
+	s32					selectedImageIndex,
+	void*					data,
+	IReferenceCounted*			data2 )
+{
+	child->Position = position;
+	child->Text = text;
+	child->Icon = icon;
+	child->ImageIndex = imageIndex;
+	child->SelectedImageIndex = selectedImageIndex;
+	child->Data = data;
+	child->Data2 = data2;
+	if( data2 )
+	{
+		data2->grab();
+	}
+
+	addVisibleRows( 1 );
+	Owner->resetRowCache();
+}
+
+void CGUITreeViewNode::addVisibleRows( s32 rows )
+{
+	CGUITreeViewNode*	node = this;
+	while( node )
+	{
+		node->VisibleRows += rows;
+
+		// collapsed nodes hide the change from their parents
+		if( !node->Expanded )
+		{
+			break;
+		}
+		node = node->Parent;
+	}
 }
 
 IGUITreeViewNode* CGUITreeViewNode::addChildBack(
@@ -85,16 +140,7 @@ IGUITreeViewNode* CGUITreeViewNode::addChildBack(
 	CGUITreeViewNode*	newChild = new CGUITreeViewNode( Owner, this );
 
 	Children.push_back( newChild );
-	newChild->Text = text;
-	newChild->Icon = icon;
-	newChild->ImageIndex = imageIndex;
-	newChild->SelectedImageIndex = selectedImageIndex;
-	newChild->Data = data;
-	newChild->Data2 = data2;
-	if( data2 )
-	{
-		data2->grab();
-	}
+	initChild( newChild, Children.getLast(), text, icon, imageIndex, selectedImageIndex, data, data2 );
 	return newChild;
 }
 
@@ -109,16 +155,7 @@ IGUITreeViewNode* CGUITreeViewNode::addChildFront(
 	CGUITreeViewNode*	newChild = new CGUITreeViewNode( Owner, this );
 
 	Children.push_front( newChild );
-	newChild->Text = text;
-	newChild->Icon = icon;
-	newChild->ImageIndex = imageIndex;
-	newChild->SelectedImageIndex = selectedImageIndex;
-	newChild->Data = data;
-	newChild->Data2 = data2;
-	if( data2 )
-	{
-		data2->grab();
-	}
+	initChild( newChild, Children.begin(), text, icon, imageIndex, selectedImageIndex, data, data2 );
 	return newChild;
 }
 
@@ -131,28 +168,16 @@ IGUITreeViewNode* CGUITreeViewNode::insertChildAfter(
 	void*					data /*= 0*/,
 	IReferenceCounted*			data2/* = 0*/ )
 {
-	core::list<CGUITreeViewNode*>::Iterator	itOther;
-	CGUITreeViewNode*									newChild = 0;
-
-	for( itOther = Children.begin(); itOther != Children.end(); itOther++ )
+	if( !other || other->getParent() != this )
 	{
-		if( other == *itOther )
-		{
-			newChild = new CGUITreeViewNode( Owner, this );
-			newChild->Text = text;
-			newChild->Icon = icon;
-			newChild->ImageIndex = imageIndex;
-			newChild->SelectedImageIndex = selectedImageIndex;
-			newChild->Data = data;
-			newChild->Data2 = data2;
-			if( data2 )
-			{
-				data2->grab();
-			}
-			Children.insert_after( itOther, newChild );
-			break;
-		}
+		return 0;
 	}
+
+	core::list<CGUITreeViewNode*>::Iterator	position = static_cast<CGUITreeViewNode*>( other )->Position;
+	CGUITreeViewNode*	newChild = new CGUITreeViewNode( Owner, this );
+
+	Children.insert_after( position, newChild );
+	initChild( newChild, ++position, text, icon, imageIndex, selectedImageIndex, data, data2 );
 	return newChild;
 }
 
@@ -165,28 +190,16 @@ IGUITreeViewNode* CGUITreeViewNode::insertChildBefore(
 	void*					data /*= 0*/,
 	IReferenceCounted*			data2/* = 0*/ )
 {
-	core::list<CGUITreeViewNode*>::Iterator	itOther;
-	CGUITreeViewNode*									newChild = 0;
-
-	for( itOther = Children.begin(); itOther != Children.end(); itOther++ )
+	if( !other || other->getParent() != this )
 	{
-		if( other == *itOther )
-		{
-			newChild = new CGUITreeViewNode( Owner, this );
-			newChild->Text = text;
-			newChild->Icon = icon;
-			newChild->ImageIndex = imageIndex;
-			newChild->SelectedImageIndex = selectedImageIndex;
-			newChild->Data = data;
-			newChild->Data2 = data2;
-			if( data2 )
-			{
-				data2->grab();
-			}
-			Children.insert_before( itOther, newChild );
-			break;
-		}
+		return 0;
 	}
+
+	core::list<CGUITreeViewNode*>::Iterator	position = static_cast<CGUITreeViewNode*>( other )->Position;
+	CGUITreeViewNode*	newChild = new CGUITreeViewNode( Owner, this );
+
+	Children.insert_before( position, newChild );
+	initChild( newChild, --position, text, icon, imageIndex, selectedImageIndex, data, data2 );
 	return newChild;
 }
 
@@ -216,48 +229,28 @@ IGUITreeViewNode* CGUITreeViewNode::getLastChild() const
 
 IGUITreeViewNode* CGUITreeViewNode::getPrevSibling() const
 {
-	core::list<CGUITreeViewNode*>::Iterator	itThis;
-	core::list<CGUITreeViewNode*>::Iterator	itOther;
-	CGUITreeViewNode*									other = 0;
-
-	if( Parent )
+	if( !Parent || Position == Parent->Children.begin() )
 	{
-		for( itThis = Parent->Children.begin(); itThis != Parent->Children.end(); itThis++ )
-		{
-			if( this == *itThis )
-			{
-				if( itThis != Parent->Children.begin() )
-				{
-					other = *itOther;
-				}
-				break;
-			}
-			itOther = itThis;
-		}
+		return 0;
 	}
-	return other;
+
+	core::list<CGUITreeViewNode*>::Iterator	itOther = Position;
+	return *( --itOther );
 }
 
 IGUITreeViewNode* CGUITreeViewNode::getNextSibling() const
 {
-	core::list<CGUITreeViewNode*>::Iterator	itThis;
-	CGUITreeViewNode*									other = 0;
+	if( !Parent )
+	{
+		return 0;
+	}
 
-	if( Parent )
+	core::list<CGUITreeViewNode*>::Iterator	itOther = Position;
+	if( ++itOther == Parent->Children.end() )
 	{
-		for( itThis = Parent->Children.begin(); itThis != Parent->Children.end(); itThis++ )
-		{
-			if( this == *itThis )
-			{
-				if( itThis != Parent->Children.getLast() )
-				{
-					other = *( ++itThis );
-				}
-				break;
-			}
-		}
+		return 0;
 	}
-	return other;
+	return *itOther;
 }
 
 IGUITreeViewNode* CGUITreeViewNode::getNextVisible() const
@@ -287,76 +280,80 @@ IGUITreeViewNode* CGUITreeViewNode::getNextVisible() const
 
 bool CGUITreeViewNode::deleteChild( IGUITreeViewNode* child )
 {
-	core::list<CGUITreeViewNode*>::Iterator	itChild;
-	bool	deleted = false;
-
-	for( itChild = Children.begin(); itChild != Children.end(); itChild++ )
+	if( !child || child->getParent() != this )
 	{
-		if( child == *itChild )
-		{
-			child->drop();
-			Children.erase( itChild );
-			deleted = true;
-			break;
-		}
+		return false;
 	}
-	return deleted;
+
+	CGUITreeViewNode*	node = static_cast<CGUITreeViewNode*>( child );
+	addVisibleRows( -(s32)node->getRowCount() );
+	Children.erase( node->Position );
+	node->Parent = 0;
+	node->drop();
+
+	Owner->resetRowCache();
+	Owner->invalidate();
+	return true;
 }
 
 bool CGUITreeViewNode::moveChildUp( IGUITreeViewNode* child )
 {
-	core::list<CGUITreeViewNode*>::Iterator	itChild;
-	core::list<CGUITreeViewNode*>::Iterator	itOther;
-	CGUITreeViewNode*									nodeTmp;
-	bool													moved = false;
+	if( !child || child->getParent() != this )
+	{
+		return false;
+	}
 
-	for( itChild = Children.begin(); itChild != Children.end(); itChild++ )
+	CGUITreeViewNode*	node = static_cast<CGUITreeViewNode*>( child );
+	if( node->Position == Children.begin() )
 	{
-		if( child == *itChild )
-		{
-			if( itChild != Children.begin() )
-			{
-				nodeTmp = *itChild;
-				*itChild = *itOther;
-				*itOther = nodeTmp;
-				moved = true;
-			}
-			break;
-		}
-		itOther = itChild;
+		return false;
 	}
-	return moved;
+
+	core::list<CGUITreeViewNode*>::Iterator	itOther = node->Position;
+	--itOther;
+	CGUITreeViewNode*	other = *itOther;
+	*itOther = node;
+	*( node->Position ) = other;
+	other->Position = node->Position;
+	node->Position = itOther;
+
+	Owner->resetRowCache();
+	Owner->invalidate();
+	return true;
 }
 
 bool CGUITreeViewNode::moveChildDown( IGUITreeViewNode* child )
 {
-	core::list<CGUITreeViewNode*>::Iterator	itChild;
-	core::list<CGUITreeViewNode*>::Iterator	itOther;
-	CGUITreeViewNode*									nodeTmp;
-	bool													moved = false;
+	if( !child || child->getParent() != this )
+	{
+		return false;
+	}
 
-	for( itChild = Children.begin(); itChild != Children.end(); itChild++ )
+	CGUITreeViewNode*	node = static_cast<CGUITreeViewNode*>( child );
+	if( node->Position == Children.getLast() )
 	{
-		if( child == *itChild )
-		{
-			if( itChild != Children.getLast() )
-			{
-				itOther = itChild;
-				++itOther;
-				nodeTmp = *itChild;
-				*itChild = *itOther;
-				*itOther = nodeTmp;
-				moved = true;
-			}
-			break;
-		}
+		return false;
 	}
-	return moved;
+
+	core::list<CGUITreeViewNode*>::Iterator	itOther = node->Position;
+	++itOther;
+	return moveChildUp( *itOther );
 }
 
 void CGUITreeViewNode::setExpanded( bool expanded )
 {
+	if( Expanded == expanded )
+	{
+		return;
+	}
+
 	Expanded = expanded;
+	if( Parent )
+	{
+		Parent->addVisibleRows( expanded ? (s32)VisibleRows : -(s32)VisibleRows );
+	}
+	Owner->resetRowCache();
+	Owner->invalidate();
 }
 
 void CGUITreeViewNode::setSelected( bool selected )
@@ -375,6 +372,8 @@ void CGUITreeViewNode::setSelected( bool selected )
 			}
 		}
 	}
+
+	Owner->invalidate();
 }
 
 bool CGUITreeViewNode::getSelected() const
@@ -437,6 +436,8 @@ CGUITreeView::CGUITreeView(IGUIEnvironment* environment, IGUIElement* parent,
 	ScrollBarV( 0 ),
 	ImageList( 0 ),
 	LastEventNode( 0 ),
+	RowCacheNode( 0 ),
+	RowCacheRow( 0 ),
 	LinesVisible( true ),
 	Selecting( false ),
 	Clip( clip ),
@@ -536,6 +537,7 @@ void CGUITreeView::setOverrideFont(IGUIFont* font)
 		OverrideFont->grab();
 
 	recalculateItemHeight();
+	invalidate();
 }
 
 //! Gets the override font (if any)
@@ -607,14 +609,8 @@ void CGUITreeView::recalculateItemHeight()
 		}
 	}
 
-	TotalItemHeight = 0;
+	TotalItemHeight = ItemHeight * (s32)Root->VisibleRows;
 	TotalItemWidth = AbsoluteRect.getWidth() * 2;
-	IGUITreeViewNode* node = Root->getFirstChild();
-	while( node )
-	{
-		TotalItemHeight += ItemHeight;
-		node = node->getNextVisible();
-	}
 
 	if ( ScrollBarV )
 	{
@@ -770,19 +766,7 @@ void CGUITreeView::mouseAction( s32 xpos, s32 ypos, bool onlyHover /*= false*/ )
 		selIdx = ( ( ypos - 1 ) + scrollBarVPos ) / ItemHeight;
 	}
 
-	IGUITreeViewNode* hitNode = 0;
-	IGUITreeViewNode* node = Root->getFirstChild();
-	s32	n = 0;
-	while( node )
-	{
-		if( selIdx == n )
-		{
-			hitNode = node;
-			break;
-		}
-		node = node->getNextVisible();
-		++n;
-	}
+	IGUITreeViewNode* hitNode = getNodeAtRow( selIdx );
 
 	s32 scrollBarHPos = ScrollBarH ? ScrollBarH->getPos() : 0;
 	xpos += scrollBarHPos; // correction for shift
@@ -838,6 +822,70 @@ void CGUITreeView::mouseAction( s32 xpos, s32 ypos, bool onlyHover /*= false*/ )
 	}
 }
 
+//! Returns the node shown in the row above node, 0 for the first row
+static IGUITreeViewNode* getPrevVisible( const IGUITreeViewNode* node )
+{
+	IGUITreeViewNode* prev = node->getPrevSibling();
+	if( !prev )
+	{
+		prev = node->getParent();
+		return ( prev && !prev->isRoot() ) ? prev : 0;
+	}
+
+	while( prev->getExpanded() && prev->hasChildren() )
+	{
+		prev = prev->getLastChild();
+	}
+	return prev;
+}
+
+IGUITreeViewNode* CGUITreeView::getNodeAtRow( s32 row )
+{
+	if( row < 0 || row >= (s32)Root->VisibleRows )
+	{
+		return 0;
+	}
+
+	// scrolling mostly moves a few rows, walking there is cheapest
+	const s32 maxWalk = 256;
+	if( RowCacheNode && core::abs_( row - RowCacheRow ) <= maxWalk )
+	{
+		for( ; RowCacheRow < row; ++RowCacheRow )
+		{
+			RowCacheNode = RowCacheNode->getNextVisible();
+		}
+		for( ; RowCacheRow > row; --RowCacheRow )
+		{
+			RowCacheNode = getPrevVisible( RowCacheNode );
+		}
+		return RowCacheNode;
+	}
+
+	// skip the children ending above the row, then look inside the one containing it
+	CGUITreeViewNode* node = Root;
+	u32 remaining = (u32)row;
+	for(;;)
+	{
+		core::list<CGUITreeViewNode*>::Iterator it = node->Children.begin();
+		while( remaining >= ( *it )->getRowCount() )
+		{
+			remaining -= ( *it )->getRowCount();
+			++it;
+		}
+
+		node = *it;
+		if( remaining == 0 )
+		{
+			break;
+		}
+		--remaining;
+	}
+
+	RowCacheNode = node;
+	RowCacheRow = row;
+	return node;
+}
+
 //! draws the element and its children
 void CGUITreeView::draw()
 {
@@ -908,14 +956,19 @@ void CGUITreeView::draw()
 	frameRect.LowerRightCorner.X = AbsoluteRect.LowerRightCorner.X - ScrollBarSize;
 	frameRect.LowerRightCorner.Y = AbsoluteRect.UpperLeftCorner.Y + ItemHeight;
 
+	// start with the first row reaching into the element
+	s32 firstRow = 0;
+	if ( ScrollBarV && ItemHeight > 0 && ScrollBarV->getPos() > 0 )
+		firstRow = ( ScrollBarV->getPos() + ItemHeight - 1 ) / ItemHeight - 1;
+
 	if ( ScrollBarV )
 	{
-		frameRect.UpperLeftCorner.Y  -= ScrollBarV->getPos();
-		frameRect.LowerRightCorner.Y -= ScrollBarV->getPos();
+		frameRect.UpperLeftCorner.Y  += firstRow * ItemHeight - ScrollBarV->getPos();
+		frameRect.LowerRightCorner.Y += firstRow * ItemHeight - ScrollBarV->getPos();
 	}
 
-	IGUITreeViewNode* node = Root->getFirstChild();
-	while( node )
+	IGUITreeViewNode* node = getNodeAtRow( firstRow );
+	while( node && frameRect.UpperLeftCorner.Y <= AbsoluteRect.LowerRightCorner.Y )
 	{
 		frameRect.UpperLeftCorner.X = AbsoluteRect.UpperLeftCorner.X + 1 + node->getLevel() * IndentWidth;
 		if ( ScrollBarH )
@@ -1118,6 +1171,8 @@ void CGUITreeView::setIconFont( IGUIFont* font )
 			ItemHeight = height;
 		}
 	}
+
+	invalidate();
 }
 
 //! Sets the image list which should be used for the image and selected image of every node.
@@ -1139,6 +1194,8 @@ void CGUITreeView::setImageList( IGUIImageList* imageList )
 			ItemHeight = ImageList->getImageSize().Height + 1;
 		}
 	}
+
+	invalidate();
 }
 
 //! Access the vertical scrollbar
@@ -222,6 +222,18 @@ namespace gui
 
 	private:
 
+		//! Sets up a new child node after it was put into Children at position
+		void initChild( CGUITreeViewNode* child, const core::list<CGUITreeViewNode*>::Iterator& position,
+			const wchar_t* text, const wchar_t* icon, s32 imageIndex, s32 selectedImageIndex,
+			void* data, IReferenceCounted* data2 );
+
+		//! Adds rows to the visible rows below this node and to all parents showing them
+		void addVisibleRows( s32 rows );
+
+		//! Number of rows shown by this node itself and its visible children
+		u32 getRowCount() const
+		{ return 1 + ( Expanded ? VisibleRows : 0 ); }
+
 		CGUITreeView*			Owner;
 		CGUITreeViewNode*		Parent;
 		core::stringw			Text;
@@ -232,6 +244,12 @@ namespace gui
 		IReferenceCounted*		Data2;
 		bool				Expanded;
 		core::list<CGUITreeViewNode*>	Children;
+
+		//! Position of this node in the Children of the parent
+		core::list<CGUITreeViewNode*>::Iterator	Position;
+
+		//! Number of rows below this node when it is expanded
+		u32				VisibleRows;
 	};
 
 
@@ -263,7 +281,7 @@ namespace gui
 
 		//! sets if the tree lines are visible
 		virtual void setLinesVisible( bool visible ) IRR_OVERRIDE
-		{ LinesVisible = visible; }
+		{ LinesVisible = visible; invalidate(); }
 
 		//! called if an event happened.
 		virtual bool OnEvent( const SEvent &event ) IRR_OVERRIDE;
@@ -300,7 +318,7 @@ namespace gui
 
 		//! Sets if the image is left of the icon. Default is true.
 		virtual void setImageLeftOfIcon( bool bLeftOf ) IRR_OVERRIDE
-		{ ImageLeftOfIcon = bLeftOf; }
+		{ ImageLeftOfIcon = bLeftOf; invalidate(); }
 
 		//! Returns if the Image is left of the icon. Default is true.
 		virtual bool getImageLeftOfIcon() const IRR_OVERRIDE
@@ -326,6 +344,15 @@ namespace gui
 		//! executes an mouse action (like selectNew of CGUIListBox)
 		void mouseAction( s32 xpos, s32 ypos, bool onlyHover = false );
 
+		//! Returns the node shown in a row, 0 if there are less rows.
+		/** Walks from the node found last time when the row is close to
+		it, otherwise skips whole subtrees by their number of rows. */
+		IGUITreeViewNode* getNodeAtRow( s32 row );
+
+		//! Forget the node found last by getNodeAtRow, called when nodes change
+		void resetRowCache()
+		{ RowCacheNode = 0; }
+
 		CGUITreeViewNode*	Root;
 		IGUITreeViewNode*	Selected;
 		s32			ItemHeight;
@@ -340,6 +367,8 @@ namespace gui
 		IGUIScrollBar*		ScrollBarV;
 		IGUIImageList*		ImageList;
 		IGUITreeViewNode*	LastEventNode;
+		IGUITreeViewNode*	RowCacheNode;
+		s32			RowCacheRow;
 		bool			LinesVisible;
 		bool			Selecting;
 		bool			Clip;
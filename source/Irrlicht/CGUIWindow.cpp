@@ -309,6 +309,7 @@ void CGUIWindow::setDraggable(bool draggable)
 void CGUIWindow::setDrawBackground(bool draw)
 {
 	DrawBackground = draw;
+	invalidate();
 }
 
 
@@ -323,6 +324,7 @@ bool CGUIWindow::getDrawBackground() const
 void CGUIWindow::setDrawTitlebar(bool draw)
 {
 	DrawTitlebar = draw;
+	invalidate();
 }
 
 
@@ -7,6 +7,7 @@
 #ifdef _IRR_COMPILE_WITH_JPG_LOADER_
 
 #include "IReadFile.h"
+#include "IMemoryReadFile.h"
 #include "CImage.h"
 #include "os.h"
 #include "irrString.h"
@@ -135,6 +136,13 @@ bool CImageLoaderJPG::isALoadableFileFormat(io::IReadFile* file) const
 
 //! creates a surface from the file
 IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
+{
+	return loadImageAs(file, ECF_UNKNOWN);
+}
+
+//! creates a surface from the file, decoding to ECF_A8R8G8B8 when wanted
+//! and supported by the jpeg library
+IImage* CImageLoaderJPG::loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format) const
 {
 	#ifndef _IRR_COMPILE_WITH_LIBJPEG_
 	os::Printer::log("Can't load as not compiled with _IRR_COMPILE_WITH_LIBJPEG_", file->getFileName(), ELL_DEBUG);
@@ -150,8 +158,24 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 		return 0;
 
 	u8 **rowPtr=0;
-	u8* input = new u8[fileSize];
-	file->read(input, fileSize);
+
+	// files which are already in memory are decoded in place, others get copied
+	const u8* input = 0;
+	u8* inputCopy = 0;
+	const io::IMemoryReadFile* memoryFile = io::getMemoryReadFile(file);
+	if (memoryFile)
+	{
+		input = static_cast<const u8*>(memoryFile->getBuffer()) + file->getPos();
+		fileSize -= file->getPos();
+		// consume the data like reading the copy would
+		file->seek(fileSize, true);
+	}
+	else
+	{
+		inputCopy = new u8[fileSize];
+		file->read(inputCopy, fileSize);
+		input = inputCopy;
+	}
 
 	// allocate and initialize JPEG decompression object
 	struct jpeg_decompress_struct cinfo;
@@ -177,7 +201,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 
 		jpeg_destroy_decompress(&cinfo);
 
-		delete [] input;
+		delete [] inputCopy;
 		delete [] rowPtr;
 
 		// return null pointer
@@ -192,7 +216,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 
 	// Set up data pointer
 	jsrc.bytes_in_buffer = fileSize;
-	jsrc.next_input_byte = (JOCTET*)input;
+	jsrc.next_input_byte = (const JOCTET*)input;
 	cinfo.src = &jsrc;
 
 	jsrc.init_source = init_source;
@@ -210,12 +234,26 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 	jpeg_read_header(&cinfo, TRUE);
 
 	bool useCMYK=false;
+	ECOLOR_FORMAT colorFormat = ECF_R8G8B8;
 	if (cinfo.jpeg_color_space==JCS_CMYK)
 	{
 		cinfo.out_color_space=JCS_CMYK;
 		cinfo.out_color_components=4;
 		useCMYK=true;
 	}
+#ifdef JCS_EXTENSIONS
+	else if (format==ECF_A8R8G8B8)
+	{
+		// libjpeg-turbo can write the alpha channel itself
+#ifdef __BIG_ENDIAN__
+		cinfo.out_color_space=JCS_EXT_ARGB;
+#else
+		cinfo.out_color_space=JCS_EXT_BGRA;
+#endif
+		cinfo.out_color_components=4;
+		colorFormat = ECF_A8R8G8B8;
+	}
+#endif
 	else
 	{
 		cinfo.out_color_space=JCS_RGB;
@@ -233,7 +271,7 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 	u32 height = cinfo.image_height;
 
 	if (	width > JPEG_MAX_DIMENSION || height > JPEG_MAX_DIMENSION 
-		|| !IImage::checkDataSizeLimit(IImage::getDataSizeFromFormat(ECF_R8G8B8, width, height))
+		|| !IImage::checkDataSizeLimit(IImage::getDataSizeFromFormat(colorFormat, width, height))
 		)
 	{
 		os::Printer::log("Image dimensions too large in file", filename, ELL_ERROR);
@@ -291,10 +329,10 @@ IImage* CImageLoaderJPG::loadImage(io::IReadFile* file) const
 		delete [] output;
 	}
 	else
-		image = new CImage(ECF_R8G8B8,
+		image = new CImage(colorFormat,
 				core::dimension2d<u32>(width, height), output);
 
-	delete [] input;
+	delete [] inputCopy;
 
 	return image;
 
@@ -47,6 +47,9 @@ public:
 	//! creates a surface from the file
 	virtual IImage* loadImage(io::IReadFile* file) const IRR_OVERRIDE;
 
+	//! creates a surface from the file in the given color format
+	virtual IImage* loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format) const IRR_OVERRIDE;
+
 private:
 
 #ifdef _IRR_COMPILE_WITH_LIBJPEG_
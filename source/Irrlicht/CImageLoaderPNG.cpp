@@ -83,6 +83,13 @@ bool CImageLoaderPng::isALoadableFileFormat(io::IReadFile* file) const
 
 // load in the image data
 IImage* CImageLoaderPng::loadImage(io::IReadFile* file) const
+{
+	return loadImageAs(file, ECF_UNKNOWN);
+}
+
+
+// load in the image data, decoding rgb images to ECF_A8R8G8B8 when wanted
+IImage* CImageLoaderPng::loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format) const
 {
 #ifdef _IRR_COMPILE_WITH_LIBPNG_
 	if (!file)
@@ -192,6 +199,18 @@ IImage* CImageLoaderPng::loadImage(io::IReadFile* file) const
 			png_set_gamma(png_ptr, screen_gamma, 0.45455);
 	}
 
+	// Add an opaque alpha channel to images without one when 32 bit is wanted anyway
+	const bool addAlpha = format==ECF_A8R8G8B8 && !(ColorType & PNG_COLOR_MASK_ALPHA)
+		&& !png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+	if (addAlpha)
+	{
+#ifdef __BIG_ENDIAN__
+		png_set_filler(png_ptr, 0xff, PNG_FILLER_BEFORE);
+#else
+		png_set_filler(png_ptr, 0xff, PNG_FILLER_AFTER);
+#endif
+	}
+
 	// Update the changes in between, as we need to get the new color type
 	// for proper processing of the RGBA type
 	png_read_update_info(png_ptr, info_ptr);
@@ -207,13 +226,15 @@ IImage* CImageLoaderPng::loadImage(io::IReadFile* file) const
 	}
 
 	// Convert RGBA to BGRA
-	if (ColorType==PNG_COLOR_TYPE_RGB_ALPHA)
+	if (ColorType==PNG_COLOR_TYPE_RGB_ALPHA || addAlpha)
 	{
 #ifdef __BIG_ENDIAN__
-		png_set_swap_alpha(png_ptr);
+		if (!addAlpha)
+			png_set_swap_alpha(png_ptr);
 #else
 		png_set_bgr(png_ptr);
 #endif
+		ColorType = PNG_COLOR_TYPE_RGB_ALPHA;
 	}
 
 	ECOLOR_FORMAT colorFormat = ColorType==PNG_COLOR_TYPE_RGB_ALPHA ? ECF_A8R8G8B8  : ECF_R8G8B8;
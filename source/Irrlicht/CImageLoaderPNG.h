@@ -34,6 +34,9 @@ public:
 
 	//! creates a surface from the file
 	virtual IImage* loadImage(io::IReadFile* file) const IRR_OVERRIDE;
+
+	//! creates a surface from the file in the given color format
+	virtual IImage* loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format) const IRR_OVERRIDE;
 };
 
 
@@ -28,7 +28,8 @@ namespace irr
 	namespace scene
 	{
 		ISceneManager* createSceneManager(video::IVideoDriver* driver,
-			io::IFileSystem* fs, gui::ICursorControl* cc, gui::IGUIEnvironment *gui);
+			io::IFileSystem* fs, gui::ICursorControl* cc, gui::IGUIEnvironment *gui,
+			core::IJobSystem* jobSystem);
 	}
 
 	namespace io
@@ -111,6 +112,9 @@ namespace irr
 		//! Creates a new default randomizer.
 		virtual IRandomizer* createDefaultRandomizer() const IRR_OVERRIDE;
 
+		//! Provides access to the engine's job system.
+		virtual core::IJobSystem* getJobSystem() IRR_OVERRIDE;
+
 		//! Returns the operation system opertator object.
 		virtual IOSOperator* getOSOperator() IRR_OVERRIDE;
 
@@ -203,6 +207,7 @@ namespace irr
 		CLogger* Logger;
 		IOSOperator* Operator;
 		IRandomizer* Randomizer;
+		core::IJobSystem* JobSystem;
 		io::IFileSystem* FileSystem;
 		scene::ISceneManager* InputReceivingSceneManager;
 
@@ -0,0 +1,645 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	#if defined(_IRR_WINDOWS_API_)
+		// condition variables need Windows Vista
+		#if !defined(_WIN32_WINNT) || (_WIN32_WINNT < 0x0600)
+			#undef _WIN32_WINNT
+			#define _WIN32_WINNT 0x0600
+		#endif
+		#define WIN32_LEAN_AND_MEAN
+		#include <windows.h>
+	#else
+		#include <pthread.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+#include "CJobSystem.h"
+#include "IProfiler.h"
+#include "EProfileIDs.h"
+#include "os.h"
+
+namespace irr
+{
+namespace core
+{
+
+namespace
+{
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+
+#if defined(_IRR_WINDOWS_API_)
+
+// returns the new value
+inline s32 atomicAdd(s32& value, s32 add)
+{
+	return InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(&value), add) + add;
+}
+
+inline s32 atomicLoad(const s32& value)
+{
+	return InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(const_cast<s32*>(&value)), 0, 0);
+}
+
+class CMutex
+{
+public:
+	CMutex() { InitializeCriticalSection(&Section); }
+	~CMutex() { DeleteCriticalSection(&Section); }
+	void lock() { EnterCriticalSection(&Section); }
+	void unlock() { LeaveCriticalSection(&Section); }
+
+	CRITICAL_SECTION Section;
+};
+
+class CCondition
+{
+public:
+	CCondition() { InitializeConditionVariable(&Condition); }
+	void wait(CMutex& mutex) { SleepConditionVariableCS(&Condition, &mutex.Section, INFINITE); }
+	void signal() { WakeConditionVariable(&Condition); }
+	void broadcast() { WakeAllConditionVariable(&Condition); }
+
+	CONDITION_VARIABLE Condition;
+};
+
+typedef HANDLE ThreadHandle;
+typedef DWORD ThreadId;
+
+inline ThreadId getCurrentThreadId()
+{
+	return GetCurrentThreadId();
+}
+
+u32 getProcessorCount()
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors;
+}
+
+#else
+
+// returns the new value
+inline s32 atomicAdd(s32& value, s32 add)
+{
+	return __atomic_add_fetch(&value, add, __ATOMIC_ACQ_REL);
+}
+
+inline s32 atomicLoad(const s32& value)
+{
+	return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+}
+
+class CMutex
+{
+public:
+	CMutex() { pthread_mutex_init(&Mutex, 0); }
+	~CMutex() { pthread_mutex_destroy(&Mutex); }
+	void lock() { pthread_mutex_lock(&Mutex); }
+	void unlock() { pthread_mutex_unlock(&Mutex); }
+
+	pthread_mutex_t Mutex;
+};
+
+class CCondition
+{
+public:
+	CCondition() { pthread_cond_init(&Condition, 0); }
+	~CCondition() { pthread_cond_destroy(&Condition); }
+	void wait(CMutex& mutex) { pthread_cond_wait(&Condition, &mutex.Mutex); }
+	void signal() { pthread_cond_signal(&Condition); }
+	void broadcast() { pthread_cond_broadcast(&Condition); }
+
+	pthread_cond_t Condition;
+};
+
+typedef pthread_t ThreadHandle;
+typedef pthread_t ThreadId;
+
+inline ThreadId getCurrentThreadId()
+{
+	return pthread_self();
+}
+
+u32 getProcessorCount()
+{
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (u32)count : 1;
+}
+
+#endif
+
+#else
+
+// Without threads there is nothing to synchronize
+
+inline s32 atomicAdd(s32& value, s32 add)
+{
+	return value += add;
+}
+
+inline s32 atomicLoad(const s32& value)
+{
+	return value;
+}
+
+class CMutex
+{
+public:
+	void lock() {}
+	void unlock() {}
+};
+
+#endif
+
+} // end anonymous namespace
+
+
+struct CJobSystem::SQueue
+{
+	SQueue() : Front(0) {}
+
+	void push(const SJob& job)
+	{
+		Lock.lock();
+		// drop the taken jobs once they are the larger part
+		if (Front > 64 && Front * 2 > Jobs.size())
+		{
+			Jobs.erase(0, Front);
+			Front = 0;
+		}
+		Jobs.push_back(job);
+		Lock.unlock();
+	}
+
+	bool popBack(SJob& job)
+	{
+		Lock.lock();
+		const bool found = Jobs.size() > Front;
+		if (found)
+		{
+			job = Jobs.getLast();
+			Jobs.set_used(Jobs.size() - 1);
+			if (Jobs.size() == Front)
+			{
+				Jobs.set_used(0);
+				Front = 0;
+			}
+		}
+		Lock.unlock();
+		return found;
+	}
+
+	bool popFront(SJob& job)
+	{
+		Lock.lock();
+		const bool found = Jobs.size() > Front;
+		if (found)
+		{
+			job = Jobs[Front++];
+			if (Jobs.size() == Front)
+			{
+				Jobs.set_used(0);
+				Front = 0;
+			}
+		}
+		Lock.unlock();
+		return found;
+	}
+
+	CMutex Lock;
+	core::array<SJob> Jobs;
+	u32 Front;
+};
+
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+
+struct CJobSystem::SPlatform
+{
+	SPlatform() : Quit(false) {}
+
+	core::array<ThreadHandle> Threads;
+	core::array<ThreadId> ThreadIds;
+
+	//! Guards sleeping, waking and Quit
+	CMutex SleepLock;
+	CCondition Wake;
+	bool Quit;
+
+	CMutex DeferredLock;
+};
+
+namespace
+{
+	struct SWorkerStart
+	{
+		CJobSystem* System;
+		u32 Index;
+	};
+
+#if defined(_IRR_WINDOWS_API_)
+	DWORD WINAPI workerThread(LPVOID data)
+#else
+	void* workerThread(void* data)
+#endif
+	{
+		SWorkerStart* start = static_cast<SWorkerStart*>(data);
+		CJobSystem* system = start->System;
+		const u32 index = start->Index;
+		delete start;
+		system->runWorker(index);
+		return 0;
+	}
+}
+
+#else
+
+struct CJobSystem::SPlatform
+{
+	CMutex DeferredLock;
+};
+
+#endif
+
+
+//! constructor
+CJobSystem::CJobSystem(s32 workerCount)
+	: Platform(new SPlatform()), WorkerCount(0), QueuedJobs(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CJobSystem");
+	#endif
+
+	IRR_PROFILE(
+		static bool initProfile = false;
+		if (!initProfile )
+		{
+			initProfile = true;
+			getProfiler().add(EPID_JOB_WAIT, L"wait", L"Irrlicht jobs");
+			getProfiler().add(EPID_JOB_PARALLEL_FOR, L"parallelFor", L"Irrlicht jobs");
+		}
+	)
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	if (workerCount < 0)
+		workerCount = (s32)getProcessorCount() - 1;
+	WorkerCount = (u32)workerCount;
+#endif
+
+	for (u32 i=0; i<=WorkerCount; ++i)
+		Queues.push_back(new SQueue());
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	Platform->ThreadIds.set_used(WorkerCount);
+	Platform->Threads.set_used(WorkerCount);
+	for (u32 i=0; i<WorkerCount; ++i)
+	{
+		SWorkerStart* start = new SWorkerStart;
+		start->System = this;
+		start->Index = i;
+#if defined(_IRR_WINDOWS_API_)
+		Platform->Threads[i] = CreateThread(0, 0, workerThread, start, 0, &Platform->ThreadIds[i]);
+		const bool created = Platform->Threads[i] != 0;
+#else
+		const bool created = pthread_create(&Platform->Threads[i], 0, workerThread, start) == 0;
+		if (created)
+			Platform->ThreadIds[i] = Platform->Threads[i];
+#endif
+		if (!created)
+		{
+			delete start;
+			os::Printer::log("Could not create job system worker thread", ELL_WARNING);
+			// the queue of the first missing worker becomes the shared one, the others stay empty
+			WorkerCount = i;
+			Platform->ThreadIds.set_used(WorkerCount);
+			Platform->Threads.set_used(WorkerCount);
+			break;
+		}
+	}
+#endif
+}
+
+
+//! destructor
+CJobSystem::~CJobSystem()
+{
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	Platform->SleepLock.lock();
+	Platform->Quit = true;
+	Platform->Wake.broadcast();
+	Platform->SleepLock.unlock();
+
+	for (u32 i=0; i<WorkerCount; ++i)
+	{
+#if defined(_IRR_WINDOWS_API_)
+		WaitForSingleObject(Platform->Threads[i], INFINITE);
+		CloseHandle(Platform->Threads[i]);
+#else
+		pthread_join(Platform->Threads[i], 0);
+#endif
+	}
+#endif
+
+	// without workers there can be jobs nobody waited for
+	SJob job;
+	while (popJob(job, WorkerCount))
+		runJob(job);
+
+	for (u32 i=0; i<Queues.size(); ++i)
+		delete Queues[i];
+	delete Platform;
+}
+
+
+u32 CJobSystem::getWorkerCount() const
+{
+	return WorkerCount;
+}
+
+
+void CJobSystem::addJob(JobFunction function, void* data, SJobCounter* counter, const SJobCounter* dependency)
+{
+	SJob job;
+	job.Function = function;
+	job.Data = data;
+	job.Counter = counter;
+	job.Dependency = dependency;
+
+	if (counter)
+		atomicAdd(counter->Pending, 1);
+
+	if (dependency)
+	{
+		// checked under the lock, so it can't finish between the check and adding the job
+		Platform->DeferredLock.lock();
+		const bool waiting = atomicLoad(dependency->Pending) != 0;
+		if (waiting)
+			Deferred.push_back(job);
+		Platform->DeferredLock.unlock();
+		if (waiting)
+			return;
+	}
+
+	pushJob(job, getQueueIndex());
+}
+
+
+bool CJobSystem::isDone(const SJobCounter& counter) const
+{
+	return atomicLoad(counter.Pending) == 0;
+}
+
+
+void CJobSystem::wait(const SJobCounter& counter)
+{
+	const u32 queueIndex = getQueueIndex();
+
+	// workers only show up in traces, the profile data is kept by the main thread
+	IRR_PROFILE(getProfiler().start(EPID_JOB_WAIT);)
+
+	SJob job;
+	while (!isDone(counter))
+	{
+		if (popJob(job, queueIndex))
+			runJob(job);
+		else if (WorkerCount)
+			sleep(&counter);
+		else
+		{
+			// nothing left which could finish the counter, some dependency is never done
+			IRR_DEBUG_BREAK_IF(true);
+			break;
+		}
+	}
+
+	IRR_PROFILE(getProfiler().stop(EPID_JOB_WAIT);)
+}
+
+
+namespace
+{
+	struct SParallelFor
+	{
+		ParallelForFunction Function;
+		void* Data;
+		u32 Begin;
+		u32 End;
+		u32 GrainSize;
+		s32 ChunkCount;
+		s32 TakenChunks;
+	};
+
+	// takes chunks of the range until all are taken
+	void runParallelFor(void* data)
+	{
+		SParallelFor& p = *static_cast<SParallelFor*>(data);
+		for (;;)
+		{
+			const s32 chunk = atomicAdd(p.TakenChunks, 1) - 1;
+			if (chunk >= p.ChunkCount)
+				return;
+
+			const u32 begin = p.Begin + (u32)chunk * p.GrainSize;
+			const u32 end = p.End - begin > p.GrainSize ? begin + p.GrainSize : p.End;
+			p.Function(p.Data, begin, end);
+		}
+	}
+}
+
+
+void CJobSystem::parallelFor(u32 begin, u32 end, ParallelForFunction function, void* data, u32 grainSize)
+{
+	if (end <= begin)
+		return;
+
+	const u32 count = end - begin;
+	if (grainSize == 0)
+	{
+		// a few chunks per thread, so threads which got cheap ones can take more
+		grainSize = count / ((WorkerCount + 1) * 4);
+		if (grainSize == 0)
+			grainSize = 1;
+	}
+	const u32 chunkCount = count / grainSize + (count % grainSize ? 1 : 0);
+	if (WorkerCount == 0 || chunkCount == 1)
+	{
+		function(data, begin, end);
+		return;
+	}
+
+	IRR_PROFILE(getProfiler().start(EPID_JOB_PARALLEL_FOR);)
+
+	SParallelFor p;
+	p.Function = function;
+	p.Data = data;
+	p.Begin = begin;
+	p.End = end;
+	p.GrainSize = grainSize;
+	p.ChunkCount = (s32)chunkCount;
+	p.TakenChunks = 0;
+
+	// helpers which start late find all chunks taken and return at once
+	SJobCounter counter;
+	const u32 helpers = core::min_(WorkerCount, chunkCount - 1);
+	for (u32 i=0; i<helpers; ++i)
+		addJob(runParallelFor, &p, &counter);
+
+	runParallelFor(&p);
+	wait(counter);
+
+	IRR_PROFILE(getProfiler().stop(EPID_JOB_PARALLEL_FOR);)
+}
+
+
+void CJobSystem::runWorker(u32 index)
+{
+	SJob job;
+	for (;;)
+	{
+		if (popJob(job, index))
+		{
+			runJob(job);
+			continue;
+		}
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+		Platform->SleepLock.lock();
+		while (!Platform->Quit && atomicLoad(QueuedJobs) == 0)
+			Platform->Wake.wait(Platform->SleepLock);
+		const bool quit = Platform->Quit && atomicLoad(QueuedJobs) == 0;
+		Platform->SleepLock.unlock();
+		if (quit)
+			return;
+#else
+		return;
+#endif
+	}
+}
+
+
+u32 CJobSystem::getQueueIndex() const
+{
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	const ThreadId id = getCurrentThreadId();
+	for (u32 i=0; i<WorkerCount; ++i)
+	{
+#if defined(_IRR_WINDOWS_API_)
+		if (Platform->ThreadIds[i] == id)
+#else
+		if (pthread_equal(Platform->ThreadIds[i], id))
+#endif
+			return i;
+	}
+#endif
+	return WorkerCount;
+}
+
+
+void CJobSystem::pushJob(const SJob& job, u32 queueIndex)
+{
+	Queues[queueIndex]->push(job);
+	atomicAdd(QueuedJobs, 1);
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	if (WorkerCount)
+	{
+		Platform->SleepLock.lock();
+		Platform->Wake.signal();
+		Platform->SleepLock.unlock();
+	}
+#endif
+}
+
+
+bool CJobSystem::popJob(SJob& job, u32 queueIndex)
+{
+	if (atomicLoad(QueuedJobs) == 0)
+		return false;
+
+	// newest job of the own queue first, its data is most likely still in the cache
+	if (Queues[queueIndex]->popBack(job))
+	{
+		atomicAdd(QueuedJobs, -1);
+		return true;
+	}
+
+	// steal the oldest jobs of the others
+	const u32 count = Queues.size();
+	for (u32 i=1; i<count; ++i)
+	{
+		if (Queues[(queueIndex + i) % count]->popFront(job))
+		{
+			atomicAdd(QueuedJobs, -1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void CJobSystem::runJob(const SJob& job)
+{
+	job.Function(job.Data);
+
+	// the counter may be gone once it reached 0, as a waiting thread returns then
+	if (job.Counter && atomicAdd(job.Counter->Pending, -1) == 0)
+	{
+		releaseDeferredJobs();
+
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+		if (WorkerCount)
+		{
+			Platform->SleepLock.lock();
+			Platform->Wake.broadcast();
+			Platform->SleepLock.unlock();
+		}
+#endif
+	}
+}
+
+
+void CJobSystem::releaseDeferredJobs()
+{
+	core::array<SJob> ready;
+
+	// the dependencies of deferred jobs have to stay alive until those are started
+	Platform->DeferredLock.lock();
+	for (u32 i=0; i<Deferred.size();)
+	{
+		if (atomicLoad(Deferred[i].Dependency->Pending) == 0)
+		{
+			ready.push_back(Deferred[i]);
+			Deferred.erase(i);
+		}
+		else
+			++i;
+	}
+	Platform->DeferredLock.unlock();
+
+	const u32 queueIndex = getQueueIndex();
+	for (u32 i=0; i<ready.size(); ++i)
+		pushJob(ready[i], queueIndex);
+}
+
+
+void CJobSystem::sleep(const SJobCounter* counter)
+{
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	Platform->SleepLock.lock();
+	while (atomicLoad(QueuedJobs) == 0 && !(counter && isDone(*counter)))
+		Platform->Wake.wait(Platform->SleepLock);
+	Platform->SleepLock.unlock();
+#endif
+}
+
+
+} // end namespace core
+} // end namespace irr
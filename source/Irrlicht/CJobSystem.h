@@ -0,0 +1,93 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_C_JOB_SYSTEM_H_INCLUDED
+#define IRR_C_JOB_SYSTEM_H_INCLUDED
+
+#include "IJobSystem.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Job system with one work stealing queue per worker thread
+class CJobSystem : public IJobSystem
+{
+public:
+
+	//! constructor
+	/** \param workerCount Number of worker threads. Negative for one less
+	than the number of processors, the thread creating the jobs is busy too. */
+	CJobSystem(s32 workerCount);
+
+	//! destructor, runs the queued jobs and ends the worker threads
+	virtual ~CJobSystem();
+
+	//! Get the number of worker threads.
+	virtual u32 getWorkerCount() const IRR_OVERRIDE;
+
+	//! Add a job.
+	virtual void addJob(JobFunction function, void* data, SJobCounter* counter=0, const SJobCounter* dependency=0) IRR_OVERRIDE;
+
+	//! Check if all jobs of a counter are finished.
+	virtual bool isDone(const SJobCounter& counter) const IRR_OVERRIDE;
+
+	//! Wait until all jobs of a counter are finished.
+	virtual void wait(const SJobCounter& counter) IRR_OVERRIDE;
+
+	//! Call a function for all indices of a range, spread over all threads.
+	virtual void parallelFor(u32 begin, u32 end, ParallelForFunction function, void* data, u32 grainSize=0) IRR_OVERRIDE;
+
+	//! Entry point of the worker threads
+	void runWorker(u32 index);
+
+private:
+
+	struct SJob
+	{
+		JobFunction Function;
+		void* Data;
+		SJobCounter* Counter;
+		const SJobCounter* Dependency;
+	};
+
+	// platform specific threads, locks and queues
+	struct SPlatform;
+	struct SQueue;
+
+	//! Index of the queue of the calling thread, the shared queue for threads outside the pool
+	u32 getQueueIndex() const;
+
+	void pushJob(const SJob& job, u32 queueIndex);
+
+	//! Takes the newest job of the own queue or the oldest one of another queue
+	bool popJob(SJob& job, u32 queueIndex);
+
+	void runJob(const SJob& job);
+
+	//! Queues the waiting jobs whose dependency is done now
+	void releaseDeferredJobs();
+
+	//! Block until new jobs are queued, or the counter is done when one is passed
+	void sleep(const SJobCounter* counter);
+
+	SPlatform* Platform;
+
+	//! One queue per worker and a last one shared by all other threads
+	core::array<SQueue*> Queues;
+
+	//! Jobs with unfinished dependencies
+	core::array<SJob> Deferred;
+
+	u32 WorkerCount;
+
+	//! Number of jobs in all queues
+	s32 QueuedJobs;
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
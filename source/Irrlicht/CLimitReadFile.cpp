@@ -3,17 +3,19 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "CLimitReadFile.h"
+#include "IMemoryReadFile.h"
+#include "CReadFile.h"
+#include <string.h>
 
 namespace irr
 {
 namespace io
 {
 
-
 CLimitReadFile::CLimitReadFile(IReadFile* alreadyOpenedFile, long pos,
 		long areaSize, const io::path& name)
 	: Filename(name), AreaStart(0), AreaEnd(0), Pos(0),
-	File(alreadyOpenedFile)
+	File(alreadyOpenedFile), Memory(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CLimitReadFile");
@@ -24,6 +26,10 @@ CLimitReadFile::CLimitReadFile(IReadFile* alreadyOpenedFile, long pos,
 		File->grab();
 		AreaStart = pos;
 		AreaEnd = AreaStart + areaSize;
+
+		const IMemoryReadFile* memoryFile = getMemoryReadFile(File);
+		if (memoryFile && AreaStart >= 0 && AreaEnd <= File->getSize())
+			Memory = static_cast<const c8*>(memoryFile->getBuffer()) + AreaStart;
 	}
 }
 
@@ -46,8 +52,13 @@ size_t CLimitReadFile::read(void* buffer, size_t sizeToRead)
 	long toRead = core::min_(AreaEnd, r + (long)sizeToRead) - core::max_(AreaStart, r);
 	if (toRead < 0)
 		return 0;
-	File->seek(r);
-	r = (long)File->read(buffer, toRead);
+	if (Memory)
+	{
+		memcpy(buffer, Memory + Pos, toRead);
+		Pos += toRead;
+		return toRead;
+	}
+	r = (long)readFileAt(File, buffer, toRead, r);
 	Pos += r;
 	return r;
 #else
@@ -19,6 +19,12 @@ namespace io
 		and may only read until a certain file position.
 		This can be useful, for example for reading uncompressed files
 		in an archive (zip, tar).
+		Reads never use the read position of the underlying file when it's
+		a file on disk or an IMemoryReadFile, so several limit files on the
+		same file can be read from different threads. Creating and dropping
+		them from different threads needs
+		_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_, as they all grab the
+		underlying file.
 	!*/
 	class CLimitReadFile : public IReadFile
 	{
@@ -58,6 +64,10 @@ namespace io
 		long AreaEnd;
 		long Pos;
 		IReadFile* File;
+
+		//! Start of the area when File is in memory, 0 otherwise.
+		//! Reading from it doesn't touch the read position of File.
+		const c8* Memory;
 	};
 
 } // end namespace io
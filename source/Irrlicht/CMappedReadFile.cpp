@@ -0,0 +1,174 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CMappedReadFile.h"
+
+#ifdef _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+
+#include <string.h>
+
+#if defined(_IRR_WINDOWS_API_)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace irr
+{
+namespace io
+{
+
+
+CMappedReadFile::CMappedReadFile(const io::path& fileName)
+: Buffer(0), FileSize(0), Pos(0), Filename(fileName)
+{
+	#ifdef _DEBUG
+	setDebugName("CMappedReadFile");
+	#endif
+
+	mapFile();
+}
+
+
+CMappedReadFile::~CMappedReadFile()
+{
+	if (!Buffer)
+		return;
+
+#if defined(_IRR_WINDOWS_API_)
+	UnmapViewOfFile(Buffer);
+#else
+	munmap(const_cast<void*>(Buffer), FileSize);
+#endif
+}
+
+
+//! returns how much was read
+size_t CMappedReadFile::read(void* buffer, size_t sizeToRead)
+{
+	long amount = static_cast<long>(sizeToRead);
+	if (Pos + amount > FileSize)
+		amount = FileSize - Pos;
+
+	if (amount <= 0)
+		return 0;
+
+	memcpy(buffer, static_cast<const c8*>(Buffer) + Pos, amount);
+	Pos += amount;
+
+	return static_cast<size_t>(amount);
+}
+
+
+//! changes position in file, returns true if successful
+//! if relativeMovement==true, the pos is changed relative to current pos,
+//! otherwise from begin of file
+bool CMappedReadFile::seek(long finalPos, bool relativeMovement)
+{
+	if (relativeMovement)
+		finalPos += Pos;
+
+	if (finalPos < 0 || finalPos > FileSize)
+		return false;
+
+	Pos = finalPos;
+	return true;
+}
+
+
+//! returns size of file
+long CMappedReadFile::getSize() const
+{
+	return FileSize;
+}
+
+
+//! returns where in the file we are.
+long CMappedReadFile::getPos() const
+{
+	return Pos;
+}
+
+
+//! maps the whole file read-only into memory
+void CMappedReadFile::mapFile()
+{
+	if (Filename.size() == 0)
+		return;
+
+#if defined(_IRR_WINDOWS_API_)
+	#if defined ( _IRR_WCHAR_FILESYSTEM )
+	HANDLE file = CreateFileW(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	#else
+	HANDLE file = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	// mapping empty files fails and files not fitting into a long can't be handled by IReadFile
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= 0x7fffffff)
+	{
+		HANDLE mapping = CreateFileMapping(file, 0, PAGE_READONLY, 0, 0, 0);
+		if (mapping)
+		{
+			Buffer = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (Buffer)
+				FileSize = static_cast<long>(size.QuadPart);
+
+			// the view keeps the mapping alive
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	const int file = open(Filename.c_str(), O_RDONLY);
+	if (file < 0)
+		return;
+
+	struct stat info;
+	// mapping empty files fails and files not fitting into a long can't be handled by IReadFile
+	if (fstat(file, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 && info.st_size <= 0x7fffffff)
+	{
+		void* data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data != MAP_FAILED)
+		{
+			Buffer = data;
+			FileSize = static_cast<long>(info.st_size);
+		}
+	}
+
+	// the mapping stays valid after closing the descriptor
+	close(file);
+#endif
+}
+
+
+//! returns name of file
+const io::path& CMappedReadFile::getFileName() const
+{
+	return Filename;
+}
+
+
+IReadFile* CMappedReadFile::createMappedReadFile(const io::path& fileName)
+{
+	CMappedReadFile* file = new CMappedReadFile(fileName);
+	if (file->isOpen())
+		return file;
+
+	file->drop();
+	return 0;
+}
+
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_MAPPED_READ_FILE_
@@ -0,0 +1,87 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_C_MAPPED_READ_FILE_H_INCLUDED
+#define IRR_C_MAPPED_READ_FILE_H_INCLUDED
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+
+#include "IMemoryReadFile.h"
+
+namespace irr
+{
+
+namespace io
+{
+
+	/*!
+		Class for reading a real file from disk which is mapped into memory.
+		As the whole file content is accessible through getBuffer() loaders
+		can parse it in place instead of copying it into their own buffers.
+	*/
+	class CMappedReadFile : public IMemoryReadFile
+	{
+	public:
+
+		CMappedReadFile(const io::path& fileName);
+
+		virtual ~CMappedReadFile();
+
+		//! returns how much was read
+		virtual size_t read(void* buffer, size_t sizeToRead) IRR_OVERRIDE;
+
+		//! changes position in file, returns true if successful
+		virtual bool seek(long finalPos, bool relativeMovement = false) IRR_OVERRIDE;
+
+		//! returns size of file
+		virtual long getSize() const IRR_OVERRIDE;
+
+		//! returns if file is open
+		bool isOpen() const
+		{
+			return Buffer != 0;
+		}
+
+		//! returns where in the file we are.
+		virtual long getPos() const IRR_OVERRIDE;
+
+		//! returns name of file
+		virtual const io::path& getFileName() const IRR_OVERRIDE;
+
+		//! Get the type of the class implementing this interface
+		virtual EREAD_FILE_TYPE getType() const IRR_OVERRIDE
+		{
+			return ERFT_MAPPED_READ_FILE;
+		}
+
+		//! Get direct access to the mapped file content
+		virtual const void *getBuffer() const IRR_OVERRIDE
+		{
+			return Buffer;
+		}
+
+		//! create mapped read file on disk.
+		/** \return 0 if the file can't be mapped, for example because
+		it's empty or doesn't exist. */
+		static IReadFile* createMappedReadFile(const io::path& fileName);
+
+	private:
+
+		//! maps the file
+		void mapFile();
+
+		const void* Buffer;
+		long FileSize;
+		long Pos;
+		io::path Filename;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+
+#endif
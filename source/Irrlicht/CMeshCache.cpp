@@ -29,6 +29,7 @@ void CMeshCache::addMesh(const io::path& filename, IAnimatedMesh* mesh)
 	e.Mesh = mesh;
 
 	Meshes.push_back(e);
+	MeshesByName.insert(e.NamedPath.getInternalName(), mesh);
 }
 
 
@@ -41,8 +42,10 @@ void CMeshCache::removeMesh(const IMesh* const mesh)
 	{
 		if (Meshes[i].Mesh == mesh || (Meshes[i].Mesh && Meshes[i].Mesh->getMesh(0) == mesh))
 		{
-			Meshes[i].Mesh->drop();
+			const MeshEntry e(Meshes[i]);
 			Meshes.erase(i);
+			removeMeshName(e);
+			e.Mesh->drop();
 			return;
 		}
 	}
@@ -82,9 +85,8 @@ IAnimatedMesh* CMeshCache::getMeshByIndex(u32 number)
 //! Returns a mesh based on its name.
 IAnimatedMesh* CMeshCache::getMeshByName(const io::path& name)
 {
-	MeshEntry e ( name );
-	s32 id = Meshes.binary_search(e);
-	return (id != -1) ? Meshes[id].Mesh : 0;
+	const core::hash_map<io::path, IAnimatedMesh*>::Node* node = MeshesByName.find(io::SNamedPath(name).getInternalName());
+	return node ? node->getValue() : 0;
 }
 
 
@@ -119,7 +121,9 @@ bool CMeshCache::renameMesh(u32 index, const io::path& name)
 	if (index >= Meshes.size())
 		return false;
 
+	removeMeshName(Meshes[index]);
 	Meshes[index].NamedPath.setPath(name);
+	MeshesByName.insert(Meshes[index].NamedPath.getInternalName(), Meshes[index].Mesh);
 	Meshes.sort();
 	return true;
 }
@@ -131,11 +135,7 @@ bool CMeshCache::renameMesh(const IMesh* const mesh, const io::path& name)
 	for (u32 i=0; i<Meshes.size(); ++i)
 	{
 		if (Meshes[i].Mesh == mesh || (Meshes[i].Mesh && Meshes[i].Mesh->getMesh(0) == mesh))
-		{
-			Meshes[i].NamedPath.setPath(name);
-			Meshes.sort();
-			return true;
-		}
+			return renameMesh(i, name);
 	}
 
 	return false;
@@ -156,6 +156,7 @@ void CMeshCache::clear()
 		Meshes[i].Mesh->drop();
 
 	Meshes.clear();
+	MeshesByName.clear();
 }
 
 //! Clears all meshes that are held in the mesh cache but not used anywhere else.
@@ -165,14 +166,38 @@ void CMeshCache::clearUnusedMeshes()
 	{
 		if (Meshes[i].Mesh->getReferenceCount() == 1)
 		{
-			Meshes[i].Mesh->drop();
+			const MeshEntry e(Meshes[i]);
 			Meshes.erase(i);
+			removeMeshName(e);
+			e.Mesh->drop();
 			--i;
 		}
 	}
 }
 
 
+//! Update MeshesByName for a mesh which is no longer in the cache under its name
+void CMeshCache::removeMeshName(const MeshEntry& entry)
+{
+	const io::path& name = entry.NamedPath.getInternalName();
+	core::hash_map<io::path, IAnimatedMesh*>::Node* node = MeshesByName.find(name);
+	if (!node || node->getValue() != entry.Mesh)
+		return;
+
+	// another mesh with the same name can be found now
+	for (u32 i=0; i<Meshes.size(); ++i)
+	{
+		if (&Meshes[i] != &entry && Meshes[i].NamedPath.getInternalName() == name)
+		{
+			node->setValue(Meshes[i].Mesh);
+			return;
+		}
+	}
+
+	MeshesByName.remove(name);
+}
+
+
 } // end namespace scene
 } // end namespace irr
 
@@ -7,6 +7,7 @@
 
 #include "IMeshCache.h"
 #include "irrArray.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
@@ -111,8 +112,14 @@ namespace scene
 			}
 		};
 
+		//! Update MeshesByName for a mesh which is no longer in the cache under its name
+		void removeMeshName(const MeshEntry& entry);
+
 		//! loaded meshes
 		core::array<MeshEntry> Meshes;
+
+		//! Meshes by their internal name, the first added one for duplicate names
+		core::hash_map<io::path, IAnimatedMesh*> MeshesByName;
 	};
 
 
@@ -5,7 +5,9 @@
 #include "CMeshManipulator.h"
 #include "SMesh.h"
 #include "CMeshBuffer.h"
+#include "CDynamicMeshBuffer.h"
 #include "SAnimatedMesh.h"
+#include "SLodMesh.h"
 #include "os.h"
 #include "irrMap.h"
 #include "triangle3d.h"
@@ -36,6 +38,83 @@ static inline core::vector3df getAngleWeight(const core::vector3df& v1,
 }
 
 
+namespace
+{
+//! Meshbuffers with less triangles are not split into jobs
+const u32 ParallelTriangleCount = 8192;
+
+//! Triangles or vertices handled by one call of a parallelFor function
+const u32 ParallelGrainSize = 2048;
+
+//! Angle of a triangle at its corner v1
+inline f32 getCornerAngle(const core::vector3df& v1,
+		const core::vector3df& v2,
+		const core::vector3df& v3)
+{
+	const f32 a = v2.getDistanceFromSQ(v3);
+	const f32 b = v1.getDistanceFromSQ(v3);
+	const f32 c = v1.getDistanceFromSQ(v2);
+	return acosf((b + c - a) / (2.f * sqrtf(b) * sqrtf(c)));
+}
+
+//! Counts the corners of the vertices and lists them sorted by triangle
+template <typename T>
+void sortVertexCorners(const T* idx, u32 cornerCount, u32 vtxcnt,
+		core::array<u32>& firstCorner, core::array<u32>& corners)
+{
+	u32 i;
+	firstCorner.set_used(vtxcnt+1);
+	memset(firstCorner.pointer(), 0, firstCorner.size()*sizeof(u32));
+	for (i=0; i<cornerCount; ++i)
+		++firstCorner[idx[i]+1];
+	for (i=0; i<vtxcnt; ++i)
+		firstCorner[i+1] += firstCorner[i];
+
+	core::array<u32> next(firstCorner);
+	corners.set_used(cornerCount);
+	for (i=0; i<cornerCount; ++i)
+		corners[next[idx[i]]++] = i;
+}
+}
+
+//! Lists the corners of the triangles around each vertex of a meshbuffer.
+/** The corners of vertex v are Corners[FirstCorner[v]] up to
+Corners[FirstCorner[v+1]], each one the position of the vertex in the index
+list. They are sorted by triangle, so adding up values of the corners in that
+order gives the same sums as walking the triangles. */
+struct SVertexCorners
+{
+	core::array<u32> FirstCorner;
+	core::array<u32> Corners;
+};
+
+
+//! constructor
+CMeshManipulator::CMeshManipulator()
+	: JobSystem(0)
+{
+}
+
+
+//! destructor
+CMeshManipulator::~CMeshManipulator()
+{
+	if (JobSystem)
+		JobSystem->drop();
+}
+
+
+//! Set the job system used for the normals and tangents of large meshbuffers.
+void CMeshManipulator::setJobSystem(core::IJobSystem* jobSystem)
+{
+	if (jobSystem)
+		jobSystem->grab();
+	if (JobSystem)
+		JobSystem->drop();
+	JobSystem = jobSystem;
+}
+
+
 //! Flips the direction of surfaces. Changes backfacing triangles to frontfacing
 //! triangles and vice versa.
 //! \param mesh: Mesh on which the operation is performed.
@@ -73,10 +152,73 @@ void CMeshManipulator::flipSurfaces(scene::IMesh* mesh) const
 }
 
 
+//! Get the corners of the triangles around the vertices of a meshbuffer
+bool CMeshManipulator::getVertexCorners(SVertexCorners& corners, IMeshBuffer* buffer) const
+{
+	const u32 idxcnt = buffer->getIndexCount();
+	if (!JobSystem || !JobSystem->getWorkerCount() || idxcnt/3 < ParallelTriangleCount)
+		return false;
+
+	const u32 cornerCount = idxcnt - idxcnt%3;
+	if (buffer->getIndexType() == video::EIT_16BIT)
+		sortVertexCorners(buffer->getIndices(), cornerCount, buffer->getVertexCount(), corners.FirstCorner, corners.Corners);
+	else
+		sortVertexCorners(reinterpret_cast<const u32*>(buffer->getIndices()), cornerCount, buffer->getVertexCount(), corners.FirstCorner, corners.Corners);
+	return true;
+}
+
+
 namespace
 {
+//! Data of the jobs calculating smooth normals
+template <typename T>
+struct SNormalsJob
+{
+	IMeshBuffer* Buffer;
+	const T* Indices;
+	bool AngleWeighted;
+	const SVertexCorners* Corners;
+};
+
+//! Adds up the weighted normals of the triangles around some vertices
+/** Each vertex works out the triangles at its own corners, so no thread
+writes to a vertex of another one and no temporary arrays are needed. */
+template <typename T>
+void sumNormalsJob(void* data, u32 begin, u32 end)
+{
+	const SNormalsJob<T>& job = *(const SNormalsJob<T>*)data;
+	const core::array<u32>& firstCorner = job.Corners->FirstCorner;
+	const core::array<u32>& corners = job.Corners->Corners;
+	for (u32 v=begin; v<end; ++v)
+	{
+		core::vector3df normal(0.f, 0.f, 0.f);
+		for (u32 c=firstCorner[v]; c<firstCorner[v+1]; ++c)
+		{
+			const u32 corner = corners[c];
+			const u32 i = corner - corner%3;
+			const core::vector3df& v1 = job.Buffer->getPosition(job.Indices[i+0]);
+			const core::vector3df& v2 = job.Buffer->getPosition(job.Indices[i+1]);
+			const core::vector3df& v3 = job.Buffer->getPosition(job.Indices[i+2]);
+			const core::vector3df faceNormal = core::plane3d<f32>(v1, v2, v3).Normal;
+
+			f32 weight = 1.f;
+			if (job.AngleWeighted)
+			{
+				const u32 i1 = job.Indices[corner];
+				const u32 i2 = job.Indices[i + (corner+1)%3];
+				const u32 i3 = job.Indices[i + (corner+2)%3];
+				weight = getCornerAngle(job.Buffer->getPosition(i1),
+					job.Buffer->getPosition(i2), job.Buffer->getPosition(i3));
+			}
+			normal += weight*faceNormal;
+		}
+		job.Buffer->getNormal(v) = normal.normalize();
+	}
+}
+
 template <typename T>
-void recalculateNormalsT(IMeshBuffer* buffer, bool smooth, bool angleWeighted)
+void recalculateNormalsT(IMeshBuffer* buffer, bool smooth, bool angleWeighted,
+		core::IJobSystem* jobSystem, const SVertexCorners* corners)
 {
 	const u32 vtxcnt = buffer->getVertexCount();
 	const u32 idxcnt = buffer->getIndexCount();
@@ -95,6 +237,15 @@ void recalculateNormalsT(IMeshBuffer* buffer, bool smooth, bool angleWeighted)
 			buffer->getNormal(idx[i+2]) = normal;
 		}
 	}
+	else if (corners)
+	{
+		SNormalsJob<T> job;
+		job.Buffer = buffer;
+		job.Indices = idx;
+		job.AngleWeighted = angleWeighted;
+		job.Corners = corners;
+		jobSystem->parallelFor(0, vtxcnt, sumNormalsJob<T>, &job, ParallelGrainSize);
+	}
 	else
 	{
 		u32 i;
@@ -132,10 +283,12 @@ void CMeshManipulator::recalculateNormals(IMeshBuffer* buffer, bool smooth, bool
 	if (!buffer)
 		return;
 
+	SVertexCorners corners;
+	const SVertexCorners* parallel = (smooth && getVertexCorners(corners, buffer)) ? &corners : 0;
 	if (buffer->getIndexType()==video::EIT_16BIT)
-		recalculateNormalsT<u16>(buffer, smooth, angleWeighted);
+		recalculateNormalsT<u16>(buffer, smooth, angleWeighted, JobSystem, parallel);
 	else
-		recalculateNormalsT<u32>(buffer, smooth, angleWeighted);
+		recalculateNormalsT<u32>(buffer, smooth, angleWeighted, JobSystem, parallel);
 }
 
 
@@ -250,9 +403,111 @@ void calculateTangents(
 }
 
 
+//! Calculates the weighted normals, tangents and binormals of the corners of a triangle
+/** \return false for degenerated triangles, which are skipped */
+bool calculateCornerTangents(
+	core::vector3df* normals, core::vector3df* tangents, core::vector3df* binormals,
+	const video::S3DVertexTangents& v0, const video::S3DVertexTangents& v1,
+	const video::S3DVertexTangents& v2, bool angleWeighted)
+{
+	// if this triangle is degenerate, skip it!
+	if (v0.Pos == v1.Pos ||
+		v0.Pos == v2.Pos ||
+		v1.Pos == v2.Pos
+		/*||
+		v0.TCoords == v1.TCoords ||
+		v0.TCoords == v2.TCoords ||
+		v1.TCoords == v2.TCoords */
+		)
+		return false;
+
+	//Angle-weighted normals look better, but are slightly more CPU intensive to calculate
+	core::vector3df weight(1.f,1.f,1.f);
+	if (angleWeighted)
+		weight = irr::scene::getAngleWeight(v0.Pos,v1.Pos,v2.Pos);	// writing irr::scene:: necessary for borland
+
+	calculateTangents(normals[0], tangents[0], binormals[0],
+		v0.Pos, v1.Pos, v2.Pos, v0.TCoords, v1.TCoords, v2.TCoords);
+	calculateTangents(normals[1], tangents[1], binormals[1],
+		v1.Pos, v2.Pos, v0.Pos, v1.TCoords, v2.TCoords, v0.TCoords);
+	calculateTangents(normals[2], tangents[2], binormals[2],
+		v2.Pos, v0.Pos, v1.Pos, v2.TCoords, v0.TCoords, v1.TCoords);
+
+	const f32 weights[3] = { weight.X, weight.Y, weight.Z };
+	for (u32 c=0; c<3; ++c)
+	{
+		normals[c] = normals[c] * weights[c];
+		tangents[c] = tangents[c] * weights[c];
+		binormals[c] = binormals[c] * weights[c];
+	}
+	return true;
+}
+
+
+//! Data of the jobs calculating smooth tangents
+template <typename T>
+struct STangentsJob
+{
+	video::S3DVertexTangents* Vertices;
+	const T* Indices;
+	bool RecalculateNormals;
+	bool AngleWeighted;
+	const SVertexCorners* Corners;
+};
+
+//! Adds up the weighted tangents of the triangles around some vertices
+/** Each vertex works out the triangles at its own corners, so no thread
+writes to a vertex of another one and no temporary arrays are needed. */
+template <typename T>
+void sumTangentsJob(void* data, u32 begin, u32 end)
+{
+	const STangentsJob<T>& job = *(const STangentsJob<T>*)data;
+	const video::S3DVertexTangents* vtx = job.Vertices;
+	const T* idx = job.Indices;
+	const core::array<u32>& firstCorner = job.Corners->FirstCorner;
+	const core::array<u32>& corners = job.Corners->Corners;
+	for (u32 v=begin; v<end; ++v)
+	{
+		core::vector3df normal(0.f, 0.f, 0.f);
+		core::vector3df tangent(0.f, 0.f, 0.f);
+		core::vector3df binormal(0.f, 0.f, 0.f);
+		for (u32 c=firstCorner[v]; c<firstCorner[v+1]; ++c)
+		{
+			// the triangle starting at this corner, like calculateCornerTangents does it
+			const u32 corner = corners[c];
+			const u32 i = corner - corner%3;
+			const video::S3DVertexTangents& v0 = vtx[idx[corner]];
+			const video::S3DVertexTangents& v1 = vtx[idx[i + (corner+1)%3]];
+			const video::S3DVertexTangents& v2 = vtx[idx[i + (corner+2)%3]];
+
+			// skip degenerated triangles
+			if (v0.Pos == v1.Pos || v0.Pos == v2.Pos || v1.Pos == v2.Pos)
+				continue;
+
+			core::vector3df localNormal;
+			core::vector3df localTangent;
+			core::vector3df localBinormal;
+			calculateTangents(localNormal, localTangent, localBinormal,
+				v0.Pos, v1.Pos, v2.Pos, v0.TCoords, v1.TCoords, v2.TCoords);
+
+			const f32 weight = job.AngleWeighted ? getCornerAngle(v0.Pos, v1.Pos, v2.Pos) : 1.f;
+			normal += localNormal * weight;
+			tangent += localTangent * weight;
+			binormal += localBinormal * weight;
+		}
+
+		if (job.RecalculateNormals)
+			job.Vertices[v].Normal = normal.normalize();
+		job.Vertices[v].Tangent = tangent.normalize();
+		job.Vertices[v].Binormal = binormal.normalize();
+	}
+}
+
+
 //! Recalculates tangents for a tangent mesh buffer
 template <typename T>
-void recalculateTangentsT(IMeshBuffer* buffer, bool recalculateNormals, bool smooth, bool angleWeighted)
+void recalculateTangentsT(IMeshBuffer* buffer, bool recalculateNormals, bool smooth, bool angleWeighted,
+		core::IJobSystem* jobSystem, const SVertexCorners* corners)
 {
 	if (!buffer || (buffer->getVertexType()!= video::EVT_TANGENTS))
 		return;
@@ -264,7 +519,17 @@ void recalculateTangentsT(IMeshBuffer* buffer, bool recalculateNormals, bool smo
 	video::S3DVertexTangents* v =
 		(video::S3DVertexTangents*)buffer->getVertices();
 
-	if (smooth)
+	if (smooth && corners)
+	{
+		STangentsJob<T> job;
+		job.Vertices = v;
+		job.Indices = idx;
+		job.RecalculateNormals = recalculateNormals;
+		job.AngleWeighted = angleWeighted;
+		job.Corners = corners;
+		jobSystem->parallelFor(0, vtxCnt, sumTangentsJob<T>, &job, ParallelGrainSize);
+	}
+	else if (smooth)
 	{
 		u32 i;
 
@@ -279,72 +544,22 @@ void recalculateTangentsT(IMeshBuffer* buffer, bool recalculateNormals, bool smo
 		//Each vertex gets the sum of the tangents and binormals from the faces around it
 		for ( i=0; i<idxCnt; i+=3)
 		{
-			// if this triangle is degenerate, skip it!
-			if (v[idx[i+0]].Pos == v[idx[i+1]].Pos ||
-				v[idx[i+0]].Pos == v[idx[i+2]].Pos ||
-				v[idx[i+1]].Pos == v[idx[i+2]].Pos
-				/*||
-				v[idx[i+0]].TCoords == v[idx[i+1]].TCoords ||
-				v[idx[i+0]].TCoords == v[idx[i+2]].TCoords ||
-				v[idx[i+1]].TCoords == v[idx[i+2]].TCoords */
-				)
-				continue;
-
-			//Angle-weighted normals look better, but are slightly more CPU intensive to calculate
-			core::vector3df weight(1.f,1.f,1.f);
-			if (angleWeighted)
-				weight = irr::scene::getAngleWeight(v[i+0].Pos,v[i+1].Pos,v[i+2].Pos);	// writing irr::scene:: necessary for borland
-			core::vector3df localNormal;
-			core::vector3df localTangent;
-			core::vector3df localBinormal;
-
-			calculateTangents(
-				localNormal,
-				localTangent,
-				localBinormal,
-				v[idx[i+0]].Pos,
-				v[idx[i+1]].Pos,
-				v[idx[i+2]].Pos,
-				v[idx[i+0]].TCoords,
-				v[idx[i+1]].TCoords,
-				v[idx[i+2]].TCoords);
-
-			if (recalculateNormals)
-				v[idx[i+0]].Normal += localNormal * weight.X;
-			v[idx[i+0]].Tangent += localTangent * weight.X;
-			v[idx[i+0]].Binormal += localBinormal * weight.X;
-
-			calculateTangents(
-				localNormal,
-				localTangent,
-				localBinormal,
-				v[idx[i+1]].Pos,
-				v[idx[i+2]].Pos,
-				v[idx[i+0]].Pos,
-				v[idx[i+1]].TCoords,
-				v[idx[i+2]].TCoords,
-				v[idx[i+0]].TCoords);
-
-			if (recalculateNormals)
-				v[idx[i+1]].Normal += localNormal * weight.Y;
-			v[idx[i+1]].Tangent += localTangent * weight.Y;
-			v[idx[i+1]].Binormal += localBinormal * weight.Y;
+			core::vector3df localNormals[3];
+			core::vector3df localTangents[3];
+			core::vector3df localBinormals[3];
 
-			calculateTangents(
-				localNormal,
-				localTangent,
-				localBinormal,
-				v[idx[i+2]].Pos,
-				v[idx[i+0]].Pos,
-				v[idx[i+1]].Pos,
-				v[idx[i+2]].TCoords,
-				v[idx[i+0]].TCoords,
-				v[idx[i+1]].TCoords);
+			if (!calculateCornerTangents(localNormals, localTangents, localBinormals,
+				v[idx[i+0]], v[idx[i+1]], v[idx[i+2]], angleWeighted))
+				continue;
 
-			if (recalculateNormals)
-				v[idx[i+2]].Normal += localNormal * weight.Z;
-			v[idx[i+2]].Tangent += localTangent * weight.Z;
-			v[idx[i+2]].Binormal += localBinormal * weight.Z;
+			for (u32 c=0; c<3; ++c)
+			{
+				video::S3DVertexTangents& vertex = v[idx[i+c]];
+				if (recalculateNormals)
+					vertex.Normal += localNormals[c];
+				vertex.Tangent += localTangents[c];
+				vertex.Binormal += localBinormals[c];
+			}
 		}
 
 		// Normalize the tangents and binormals
@@ -413,10 +628,12 @@ void CMeshManipulator::recalculateTangents(IMeshBuffer* buffer, bool recalculate
 {
 	if (buffer && (buffer->getVertexType() == video::EVT_TANGENTS))
 	{
+		SVertexCorners corners;
+		const SVertexCorners* parallel = (smooth && getVertexCorners(corners, buffer)) ? &corners : 0;
 		if (buffer->getIndexType() == video::EIT_16BIT)
-			recalculateTangentsT<u16>(buffer, recalculateNormals, smooth, angleWeighted);
+			recalculateTangentsT<u16>(buffer, recalculateNormals, smooth, angleWeighted, JobSystem, parallel);
 		else
-			recalculateTangentsT<u32>(buffer, recalculateNormals, smooth, angleWeighted);
+			recalculateTangentsT<u32>(buffer, recalculateNormals, smooth, angleWeighted, JobSystem, parallel);
 	}
 }
 
@@ -704,192 +921,1161 @@ IMesh* CMeshManipulator::createMeshUniquePrimitives(IMesh* mesh) const
 }
 
 
-//! Creates a copy of a mesh, which will have identical vertices welded together
-// not yet 32bit
-IMesh* CMeshManipulator::createMeshWelded(IMesh *mesh, f32 tolerance) const
+namespace
 {
-	SMesh* meshClone = new SMesh();
-	meshClone->BoundingBox = mesh->getBoundingBox();
+// vertices createMeshWelded merges into one
+inline bool isWeldable(const video::S3DVertex& a, const video::S3DVertex& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		(a.Color == b.Color);
+}
 
-	core::array<u16> redirects;
+inline bool isWeldable(const video::S3DVertex2TCoords& a, const video::S3DVertex2TCoords& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		a.TCoords2.equals(b.TCoords2) &&
+		(a.Color == b.Color);
+}
 
-	for (u32 b=0; b<mesh->getMeshBufferCount(); ++b)
+inline bool isWeldable(const video::S3DVertexTangents& a, const video::S3DVertexTangents& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		a.Tangent.equals(b.Tangent, tolerance) &&
+		a.Binormal.equals(b.Binormal, tolerance) &&
+		(a.Color == b.Color);
+}
+
+// cell of the weld grid containing a position
+inline void getWeldCell(const core::vector3df& pos, f64 cellSize, s64* cell)
+{
+	const f32* p = &pos.X;
+	for (u32 i=0; i<3; ++i)
 	{
-		const IMeshBuffer* const mb = mesh->getMeshBuffer(b);
-		const u32 vertexCount = mb->getVertexCount();
-		// reset redirect list
-		redirects.set_used(vertexCount);
+		f64 c = floor(p[i] / cellSize);
+		// also catches NaN
+		if (!(c > -1e15))
+			c = -1e15;
+		else if (c > 1e15)
+			c = 1e15;
+		cell[i] = (s64)c;
+	}
+}
 
-		const video::E_INDEX_TYPE indexType = mb->getIndexType();
-		const u16* indices = mb->getIndices();
-		const u32 indexCount = mb->getIndexCount();
-		core::array<u16>* outIdx = 0;
+inline u32 hashWeldCell(s64 x, s64 y, s64 z)
+{
+	const u64 h = (u64)x * 73856093u ^ (u64)y * 19349663u ^ (u64)z * 83492791u;
+	return (u32)(h ^ (h >> 32));
+}
 
-		if ( indexType == video::EIT_32BIT )
+//! Finds the vertices which are welded.
+/** redirects[i] is the new index of vertex i, kept contains the indices of
+the vertices which are kept. Each vertex is welded to the first vertex before
+it which is the same within the tolerance. Only vertices in the 27 cells of a
+grid around the vertex are compared, so this takes linear time. */
+template <class T>
+void weldVertices(const T* v, u32 vertexCount, f32 tolerance,
+		core::array<u32>& redirects, core::array<u32>& kept)
+{
+	const u32 none = 0xffffffff;
+
+	// f32 comparisons with the tolerance can round up to almost twice of it,
+	// with cells of that size same vertices are still in neighbouring cells
+	const f64 cellSize = tolerance > 0.f ? 2.0 * tolerance : 1.0;
+
+	// hash table of the cells, vertices of a bucket are chained by next
+	u32 bucketCount = 64;
+	while (bucketCount < vertexCount * 2)
+		bucketCount <<= 1;
+	const u32 mask = bucketCount - 1;
+	core::array<u32> buckets;
+	buckets.set_used(bucketCount);
+	for (u32 i=0; i<bucketCount; ++i)
+		buckets[i] = none;
+	core::array<u32> next;
+	next.set_used(vertexCount);
+
+	redirects.set_used(vertexCount);
+	kept.set_used(0);
+
+	for (u32 i=0; i<vertexCount; ++i)
+	{
+		s64 cell[3];
+		getWeldCell(v[i].Pos, cellSize, cell);
+
+		u32 visited[27];
+		u32 visitedCount = 0;
+		u32 found = none;
+		for (s64 x=cell[0]-1; x<=cell[0]+1; ++x)
+		for (s64 y=cell[1]-1; y<=cell[1]+1; ++y)
+		for (s64 z=cell[2]-1; z<=cell[2]+1; ++z)
 		{
-			IMeshBuffer* buffer = mb->createClone();
-			buffer->setBoundingBox(mb->getBoundingBox());
-			buffer->getMaterial() = mb->getMaterial();
-			meshClone->addMeshBuffer(buffer);
-			buffer->drop();
-			continue;	// TODO: handle 32-bit buffers beside copying them
+			const u32 bucket = hashWeldCell(x, y, z) & mask;
+			u32 k;
+			for (k=0; k<visitedCount && visited[k] != bucket; ++k)
+				;
+			if (k < visitedCount)
+				continue;
+			visited[visitedCount++] = bucket;
+
+			for (u32 j=buckets[bucket]; j != none; j=next[j])
+			{
+				if (j < found && isWeldable(v[i], v[j], tolerance))
+					found = j;
+			}
 		}
 
-		switch(mb->getVertexType())
+		if (found != none)
+			redirects[i] = redirects[found];
+		else
 		{
-		case video::EVT_STANDARD:
+			redirects[i] = kept.size();
+			kept.push_back(i);
+		}
+
+		const u32 own = hashWeldCell(cell[0], cell[1], cell[2]) & mask;
+		next[i] = buckets[own];
+		buckets[own] = i;
+	}
+}
+
+//! Returns the triangles of a meshbuffer with redirected indices, without degenerated triangles
+void getRedirectedIndices(const IMeshBuffer* mb, const core::array<u32>& redirects, core::array<u32>& indices)
+{
+	const u32 indexCount = mb->getIndexCount();
+	const u16* indices16 = mb->getIndices();
+	const u32* indices32 = reinterpret_cast<const u32*>(mb->getIndices());
+	const bool is32Bit = (mb->getIndexType() == video::EIT_32BIT);
+
+	indices.set_used(0);
+	indices.reallocate(indexCount);
+	for (u32 i=0; i+2 < indexCount; i+=3)
+	{
+		u32 a, b, c;
+		if (is32Bit)
 		{
-			SMeshBuffer* buffer = new SMeshBuffer();
-			buffer->setBoundingBox(mb->getBoundingBox());
-			buffer->Material = mb->getMaterial();
-			meshClone->addMeshBuffer(buffer);
-			buffer->drop();
+			a = redirects[indices32[i]];
+			b = redirects[indices32[i+1]];
+			c = redirects[indices32[i+2]];
+		}
+		else
+		{
+			a = redirects[indices16[i]];
+			b = redirects[indices16[i+1]];
+			c = redirects[indices16[i+2]];
+		}
 
-			video::S3DVertex* v = (video::S3DVertex*)mb->getVertices();
+		// Clean up any degenerate tris
+		if (a == b || b == c || a == c)
+			continue;
 
-			outIdx = &buffer->Indices;
+		indices.push_back(a);
+		indices.push_back(b);
+		indices.push_back(c);
+	}
+}
 
-			buffer->Vertices.reallocate(vertexCount);
+//! Creates a meshbuffer from some vertices of a meshbuffer
+/** \param kept Indices of the vertices in v which are copied
+\param indices Triangles, indexing into kept */
+template <class T>
+IMeshBuffer* createIndexedBuffer(const IMeshBuffer* mb, const T* v,
+		const core::array<u32>& kept, const core::array<u32>& indices)
+{
+	// 32 bit indices are only needed when too many vertices are left
+	if (kept.size() > 65535)
+	{
+		CDynamicMeshBuffer* buffer = new CDynamicMeshBuffer(T::getType(), video::EIT_32BIT);
+		buffer->setBoundingBox(mb->getBoundingBox());
+		buffer->getMaterial() = mb->getMaterial();
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
+		IVertexBuffer& vertices = buffer->getVertexBuffer();
+		vertices.reallocate(kept.size());
+		for (u32 i=0; i<kept.size(); ++i)
+			vertices.push_back(v[kept[i]]);
 
-			break;
-		}
-		case video::EVT_2TCOORDS:
-		{
-			SMeshBufferLightMap* buffer = new SMeshBufferLightMap();
-			buffer->setBoundingBox(mb->getBoundingBox());
-			buffer->Material = mb->getMaterial();
-			meshClone->addMeshBuffer(buffer);
-			buffer->drop();
+		IIndexBuffer& outIndices = buffer->getIndexBuffer();
+		outIndices.reallocate(indices.size());
+		for (u32 i=0; i<indices.size(); ++i)
+			outIndices.push_back(indices[i]);
 
-			video::S3DVertex2TCoords* v =
-					(video::S3DVertex2TCoords*)mb->getVertices();
+		return buffer;
+	}
 
-			outIdx = &buffer->Indices;
+	CMeshBuffer<T>* buffer = new CMeshBuffer<T>();
+	buffer->setBoundingBox(mb->getBoundingBox());
+	buffer->Material = mb->getMaterial();
 
-			buffer->Vertices.reallocate(vertexCount);
+	buffer->Vertices.reallocate(kept.size());
+	for (u32 i=0; i<kept.size(); ++i)
+		buffer->Vertices.push_back(v[kept[i]]);
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						 v[i].TCoords2.equals( v[j].TCoords2 ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
-			break;
-		}
-		case video::EVT_TANGENTS:
-		{
-			SMeshBufferTangents* buffer = new SMeshBufferTangents();
-			buffer->setBoundingBox(mb->getBoundingBox());
-			buffer->Material = mb->getMaterial();
-			meshClone->addMeshBuffer(buffer);
-			buffer->drop();
+	buffer->Indices.reallocate(indices.size());
+	for (u32 i=0; i<indices.size(); ++i)
+		buffer->Indices.push_back((u16)indices[i]);
 
-			video::S3DVertexTangents* v = (video::S3DVertexTangents*)mb->getVertices();
+	return buffer;
+}
 
-			outIdx = &buffer->Indices;
+//! Creates the welded copy of a meshbuffer
+template <class T>
+IMeshBuffer* createWeldedBuffer(const IMeshBuffer* mb, f32 tolerance)
+{
+	const T* v = static_cast<const T*>(mb->getVertices());
+	core::array<u32> redirects;
+	core::array<u32> kept;
+	weldVertices(v, mb->getVertexCount(), tolerance, redirects, kept);
 
-			buffer->Vertices.reallocate(vertexCount);
+	core::array<u32> indices;
+	getRedirectedIndices(mb, redirects, indices);
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						 v[i].Tangent.equals( v[j].Tangent, tolerance ) &&
-						 v[i].Binormal.equals( v[j].Binormal, tolerance ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
+	return createIndexedBuffer(mb, v, kept, indices);
+}
+} // end anonymous namespace
+
+
+//! Creates a copy of a mesh, which will have identical vertices welded together
+IMesh* CMeshManipulator::createMeshWelded(IMesh *mesh, f32 tolerance) const
+{
+	if (!mesh)
+		return 0;
+
+	SMesh* meshClone = new SMesh();
+	meshClone->BoundingBox = mesh->getBoundingBox();
+
+	for (u32 b=0; b<mesh->getMeshBufferCount(); ++b)
+	{
+		const IMeshBuffer* const mb = mesh->getMeshBuffer(b);
+		IMeshBuffer* buffer = 0;
+
+		switch(mb->getVertexType())
+		{
+		case video::EVT_STANDARD:
+			buffer = createWeldedBuffer<video::S3DVertex>(mb, tolerance);
+			break;
+		case video::EVT_2TCOORDS:
+			buffer = createWeldedBuffer<video::S3DVertex2TCoords>(mb, tolerance);
+			break;
+		case video::EVT_TANGENTS:
+			buffer = createWeldedBuffer<video::S3DVertexTangents>(mb, tolerance);
 			break;
-		}
 		default:
 			os::Printer::log("Cannot create welded mesh, vertex type unsupported", ELL_ERROR);
 			break;
 		}
 
-		// set indices for new buffer
- 		core::array<u16> &Indices = *outIdx;
-		Indices.clear();
-		Indices.reallocate(indexCount);
-		for (u32 i = 0; i < indexCount; i+=3)
- 		{
-			u16 a, b, c;
-			a = redirects[indices[i]];
-			b = redirects[indices[i+1]];
-			c = redirects[indices[i+2]];
-
-			bool drop = false;
-
-			// Clean up any degenerate tris
-			if (a == b || b == c || a == c)
-				drop = true;
-
-			// Open for other checks
-
-			if (!drop)
-			{
-				Indices.push_back(a);
-				Indices.push_back(b);
-				Indices.push_back(c);
-			}
+		if (buffer)
+		{
+			meshClone->addMeshBuffer(buffer);
+			buffer->drop();
 		}
-		// indexCount-Indices.size() vertices got welded for this meshbuffer
 	}
 	return meshClone;
 }
 
 
+namespace
+{
+//! Symmetric 4x4 matrix giving the squared distances of a point to some planes
+struct SQuadric
+{
+	SQuadric()
+	{
+		for (u32 i=0; i<10; ++i)
+			M[i] = 0.0;
+	}
+
+	//! Adds the plane ax+by+cz+d=0 with a normalized normal
+	void addPlane(const core::vector3d<f64>& n, f64 d, f64 weight)
+	{
+		M[0] += weight*n.X*n.X; M[1] += weight*n.X*n.Y; M[2] += weight*n.X*n.Z; M[3] += weight*n.X*d;
+		M[4] += weight*n.Y*n.Y; M[5] += weight*n.Y*n.Z; M[6] += weight*n.Y*d;
+		M[7] += weight*n.Z*n.Z; M[8] += weight*n.Z*d;
+		M[9] += weight*d*d;
+	}
+
+	void add(const SQuadric& other)
+	{
+		for (u32 i=0; i<10; ++i)
+			M[i] += other.M[i];
+	}
+
+	f64 getError(const core::vector3df& p) const
+	{
+		const f64 x = p.X;
+		const f64 y = p.Y;
+		const f64 z = p.Z;
+		return M[0]*x*x + 2.0*M[1]*x*y + 2.0*M[2]*x*z + 2.0*M[3]*x
+			+ M[4]*y*y + 2.0*M[5]*y*z + 2.0*M[6]*y
+			+ M[7]*z*z + 2.0*M[8]*z + M[9];
+	}
+
+	f64 M[10];
+};
+
+//! Collapse of a vertex into a neighbour, sorted by its error
+struct SCollapse
+{
+	f64 Cost;
+	u32 Vertex;
+	u32 Target;
+	u32 Stamp;
+
+	bool operator<(const SCollapse& other) const
+	{
+		return Cost < other.Cost;
+	}
+};
+
+//! Removes triangles of a meshbuffer by collapsing edges with the smallest quadric error
+/** Each collapse moves a vertex onto one of its neighbours, so no vertex
+positions or attributes have to be made up. Locked vertices are never moved,
+vertices on the border only along straight parts of the border.
+Twins are vertices at the same position with other attributes, like on
+texture seams or hard edges. They are only moved all together, each onto a
+twin of the target next to it, so seams stay closed. */
+class CMeshSimplifier
+{
+public:
+
+	CMeshSimplifier(const core::array<core::vector3df>& positions, const core::array<u8>& locked,
+			const core::array<u32>& twins, core::array<u32>& indices)
+		: Positions(positions), Indices(indices), Locked(locked), Twins(twins)
+	{
+	}
+
+	//! Collapses edges until targetCount triangles are left, the remaining ones are in indices
+	void simplify(u32 targetCount)
+	{
+		const u32 vertexCount = Positions.size();
+		const u32 triangleCount = Indices.size() / 3;
+		if (triangleCount <= targetCount)
+			return;
+
+		// triangles of each vertex
+		FirstTriangle.set_used(vertexCount);
+		TriangleCount.set_used(vertexCount);
+		for (u32 i=0; i<vertexCount; ++i)
+			TriangleCount[i] = 0;
+		for (u32 i=0; i<Indices.size(); ++i)
+			++TriangleCount[Indices[i]];
+		u32 first = 0;
+		for (u32 i=0; i<vertexCount; ++i)
+		{
+			FirstTriangle[i] = first;
+			first += TriangleCount[i];
+			TriangleCount[i] = 0;
+		}
+		VertexTriangles.set_used(Indices.size());
+		for (u32 i=0; i<Indices.size(); ++i)
+		{
+			const u32 v = Indices[i];
+			VertexTriangles[FirstTriangle[v] + TriangleCount[v]++] = i / 3;
+		}
+
+		Stamps.set_used(vertexCount);
+		Border.set_used(vertexCount);
+		SeamBorder.set_used(vertexCount);
+		Fixed.set_used(vertexCount);
+		Marks.set_used(vertexCount);
+		Mark = 0;
+		for (u32 i=0; i<vertexCount; ++i)
+		{
+			Stamps[i] = 0;
+			Border[i] = 0;
+			SeamBorder[i] = 0;
+			Fixed[i] = Locked[i];
+			Marks[i] = 0;
+		}
+		Removed.set_used(triangleCount);
+		for (u32 i=0; i<triangleCount; ++i)
+			Removed[i] = 0;
+		LiveCount = triangleCount;
+
+		// the planes of the triangles around each vertex
+		Quadrics.set_used(0);
+		Quadrics.reallocate(vertexCount);
+		for (u32 i=0; i<vertexCount; ++i)
+			Quadrics.push_back(SQuadric());
+
+		for (u32 t=0; t<triangleCount; ++t)
+		{
+			core::vector3d<f64> normal;
+			if (!getTriangleNormal(t, normal))
+				continue;
+			const f64 area = normal.getLength();
+			normal /= area;
+			const core::vector3d<f64> p0(Positions[Indices[t*3]].X, Positions[Indices[t*3]].Y, Positions[Indices[t*3]].Z);
+			const f64 d = -normal.dotProduct(p0);
+			for (u32 k=0; k<3; ++k)
+				Quadrics[Indices[t*3+k]].addPlane(normal, d, area * 0.5);
+		}
+
+		findBorders();
+
+		for (u32 i=0; i<vertexCount; ++i)
+			addBestCollapse(i);
+
+		while (LiveCount > targetCount && !Heap.empty())
+		{
+			const SCollapse collapse = Heap[0];
+			popHeap();
+
+			if (collapse.Stamp != Stamps[collapse.Vertex])
+				continue;
+
+			// the vertex and its twins move together, the stamps only tell
+			// if the surroundings of the vertex itself changed
+			bool haveNeighbours = false;
+			if (!hasTwins(collapse.Vertex))
+			{
+				TwinCollapses.set_used(0);
+				TwinCollapses.push_back(collapse.Vertex);
+				TwinCollapses.push_back(collapse.Target);
+			}
+			else if (!canCollapseTwins(collapse.Vertex, collapse.Target, haveNeighbours))
+			{
+				++Stamps[collapse.Vertex];
+				addBestCollapse(collapse.Vertex);
+				continue;
+			}
+
+			Dirty.set_used(0);
+			for (u32 i=0; i<TwinCollapses.size(); i+=2)
+				collapseVertex(TwinCollapses[i], TwinCollapses[i+1]);
+			updateCollapses();
+		}
+
+		// the triangles which are left
+		u32 count = 0;
+		for (u32 t=0; t<triangleCount; ++t)
+		{
+			if (Removed[t])
+				continue;
+			Indices[count++] = Indices[t*3];
+			Indices[count++] = Indices[t*3+1];
+			Indices[count++] = Indices[t*3+2];
+		}
+		Indices.set_used(count);
+	}
+
+private:
+
+	static const u32 NoVertex = 0xffffffff;
+
+	core::vector3d<f64> getPosition(u32 v) const
+	{
+		return core::vector3d<f64>(Positions[v].X, Positions[v].Y, Positions[v].Z);
+	}
+
+	bool getTriangleNormal(u32 t, core::vector3d<f64>& normal) const
+	{
+		const core::vector3d<f64> p0 = getPosition(Indices[t*3]);
+		normal = (getPosition(Indices[t*3+1]) - p0).crossProduct(getPosition(Indices[t*3+2]) - p0);
+		return normal.getLengthSQ() > 0.0;
+	}
+
+	bool hasTwins(u32 v) const
+	{
+		return Twins[v] != v;
+	}
+
+	//! Marks vertices on edges with only one triangle as border
+	/** Border vertices are only moved along straight parts of the border,
+	so corners are fixed. Edges between twins are seams, which the twins on
+	the other side follow, so those may also bend. */
+	void findBorders()
+	{
+		const u32 triangleCount = Indices.size() / 3;
+		core::array<u64> edges;
+		edges.set_used(Indices.size());
+		for (u32 t=0; t<triangleCount; ++t)
+		{
+			for (u32 k=0; k<3; ++k)
+			{
+				const u32 a = Indices[t*3+k];
+				const u32 b = Indices[t*3+(k+1)%3];
+				edges[t*3+k] = a < b ? ((u64)a << 32) | b : ((u64)b << 32) | a;
+			}
+		}
+		edges.set_sorted(false);
+		edges.sort();
+
+		// the other end of the first border edge of each vertex
+		core::array<u32> borderNeighbours;
+		borderNeighbours.set_used(Positions.size());
+		for (u32 i=0; i<borderNeighbours.size(); ++i)
+			borderNeighbours[i] = NoVertex;
+
+		for (u32 i=0; i<edges.size(); )
+		{
+			u32 j = i+1;
+			while (j < edges.size() && edges[j] == edges[i])
+				++j;
+
+			const u32 a = (u32)(edges[i] >> 32);
+			const u32 b = (u32)(edges[i] & 0xffffffff);
+			if (j - i > 2 || Positions[a] == Positions[b])
+			{
+				// edges of more than two triangles stay as they are, also
+				// twins joined by degenerated triangles
+				Fixed[a] = 1;
+				Fixed[b] = 1;
+			}
+			else if (j - i == 1)
+			{
+				const bool seam = hasTwins(a) && hasTwins(b);
+				addBorderEdge(a, b, seam, borderNeighbours);
+				addBorderEdge(b, a, seam, borderNeighbours);
+				if (seam)
+					addSeamPlane(a, b);
+			}
+			i = j;
+		}
+	}
+
+	void addBorderEdge(u32 v, u32 other, bool seam, core::array<u32>& borderNeighbours)
+	{
+		if (!Border[v])
+		{
+			Border[v] = 1;
+			SeamBorder[v] = seam;
+			borderNeighbours[v] = other;
+			return;
+		}
+
+		// the second border edge must continue the first one in a straight line,
+		// unless both are seams, vertices with even more border edges are fixed anyway
+		const core::vector3d<f64> first = getPosition(borderNeighbours[v]) - getPosition(v);
+		const core::vector3d<f64> second = getPosition(other) - getPosition(v);
+		const f64 lengths = first.getLengthSQ() * second.getLengthSQ();
+		if (Border[v] > 1 || SeamBorder[v] != (u8)seam)
+			Fixed[v] = 1;
+		else if (!seam && (first.dotProduct(second) >= 0.0 ||
+			first.crossProduct(second).getLengthSQ() > core::ROUNDING_ERROR_f64 * lengths))
+			Fixed[v] = 1;
+		Border[v] = 2;
+	}
+
+	//! Adds the plane through a seam edge, upright on its triangle, to the quadrics of both ends
+	/** Moving a vertex away from the seam then has an error, like moving it
+	away from the surface. */
+	void addSeamPlane(u32 a, u32 b)
+	{
+		u32 t = NoVertex;
+		const u32 end = FirstTriangle[a] + TriangleCount[a];
+		for (u32 i=FirstTriangle[a]; i<end && t == NoVertex; ++i)
+		{
+			if (hasVertex(VertexTriangles[i], b))
+				t = VertexTriangles[i];
+		}
+		core::vector3d<f64> normal;
+		if (t == NoVertex || !getTriangleNormal(t, normal))
+			return;
+		const core::vector3d<f64> edge = getPosition(b) - getPosition(a);
+		core::vector3d<f64> seamNormal = edge.crossProduct(normal);
+		const f64 length = seamNormal.getLength();
+		if (length <= 0.0)
+			return;
+		seamNormal /= length;
+		const f64 d = -seamNormal.dotProduct(getPosition(a));
+		Quadrics[a].addPlane(seamNormal, d, edge.getLengthSQ());
+		Quadrics[b].addPlane(seamNormal, d, edge.getLengthSQ());
+	}
+
+	//! Collects the triangles which are left around a vertex
+	void getTriangles(u32 v, core::array<u32>& triangles)
+	{
+		triangles.set_used(0);
+		const u32 end = FirstTriangle[v] + TriangleCount[v];
+		for (u32 i=FirstTriangle[v]; i<end; ++i)
+		{
+			if (!Removed[VertexTriangles[i]])
+				triangles.push_back(VertexTriangles[i]);
+		}
+	}
+
+	//! Collects the vertices of some triangles, except v
+	/** All collected vertices and v are marked with the current Mark. */
+	void getNeighbours(u32 v, const core::array<u32>& triangles, core::array<u32>& neighbours)
+	{
+		++Mark;
+		Marks[v] = Mark;
+		neighbours.set_used(0);
+		for (u32 i=0; i<triangles.size(); ++i)
+		{
+			for (u32 k=0; k<3; ++k)
+			{
+				const u32 n = Indices[triangles[i]*3+k];
+				if (Marks[n] != Mark)
+				{
+					Marks[n] = Mark;
+					neighbours.push_back(n);
+				}
+			}
+		}
+	}
+
+	bool hasVertex(u32 t, u32 v) const
+	{
+		return Indices[t*3] == v || Indices[t*3+1] == v || Indices[t*3+2] == v;
+	}
+
+	//! Finds the collapses of a vertex and its twins onto the twins of a neighbour
+	/** The collapses are stored as pairs of vertex and target in TwinCollapses.
+	\return false if a twin has no twin of the target next to it, then the
+	seam would open. */
+	bool getTwinCollapses(u32 v, u32 target)
+	{
+		// twins are never moved onto each other
+		if (Positions[target] == Positions[v])
+			return false;
+
+		TwinCollapses.set_used(0);
+		TwinCollapses.push_back(v);
+		TwinCollapses.push_back(target);
+		for (u32 twin=Twins[v]; twin!=v; twin=Twins[twin])
+		{
+			getTriangles(twin, TwinTriangles);
+			if (TwinTriangles.empty())
+				continue;
+			if (Fixed[twin])
+				return false;
+
+			u32 twinTarget = NoVertex;
+			for (u32 i=0; i<TwinTriangles.size() && twinTarget == NoVertex; ++i)
+			{
+				for (u32 k=0; k<3; ++k)
+				{
+					const u32 n = Indices[TwinTriangles[i]*3+k];
+					if (n != twin && Positions[n] == Positions[target])
+					{
+						twinTarget = n;
+						break;
+					}
+				}
+			}
+			if (twinTarget == NoVertex)
+				return false;
+			TwinCollapses.push_back(twin);
+			TwinCollapses.push_back(twinTarget);
+		}
+		return true;
+	}
+
+	//! Checks if a vertex and its twins can be moved onto the twins of a neighbour
+	/** The collapses of vertices with twins are left in TwinCollapses.
+	\param haveNeighbours True if VTriangles and VNeighbours are those of v,
+	set to false when they are overwritten. */
+	bool canCollapseTwins(u32 v, u32 target, bool& haveNeighbours)
+	{
+		if (!hasTwins(v))
+		{
+			if (!haveNeighbours)
+			{
+				getTriangles(v, VTriangles);
+				getNeighbours(v, VTriangles, VNeighbours);
+				haveNeighbours = true;
+			}
+			return canCollapse(v, target);
+		}
+
+		if (!getTwinCollapses(v, target))
+			return false;
+		for (u32 i=0; i<TwinCollapses.size(); i+=2)
+		{
+			if (i > 0 || !haveNeighbours)
+			{
+				getTriangles(TwinCollapses[i], VTriangles);
+				getNeighbours(TwinCollapses[i], VTriangles, VNeighbours);
+				haveNeighbours = (i == 0);
+			}
+			if (!canCollapse(TwinCollapses[i], TwinCollapses[i+1]))
+				return false;
+		}
+		return true;
+	}
+
+	//! Checks if a vertex can be moved onto a neighbour
+	/** VTriangles and VNeighbours have to be those of the vertex. */
+	bool canCollapse(u32 v, u32 target)
+	{
+		// triangles with both vertices are removed by the collapse
+		u32 shared = 0;
+		for (u32 i=0; i<VTriangles.size(); ++i)
+		{
+			if (hasVertex(VTriangles[i], target))
+				++shared;
+		}
+		if (Border[v] ? shared != 1 : shared != 2)
+			return false;
+
+		// the vertices next to both may only be those of the removed triangles,
+		// otherwise the mesh gets folded
+		getTriangles(target, TargetTriangles);
+		getNeighbours(target, TargetTriangles, TargetNeighbours);
+		u32 common = 0;
+		for (u32 i=0; i<VNeighbours.size(); ++i)
+		{
+			if (VNeighbours[i] != target && Marks[VNeighbours[i]] == Mark)
+				++common;
+		}
+		if (common != shared)
+			return false;
+
+		// the other triangles must not flip
+		const core::vector3d<f64> targetPos = getPosition(target);
+		for (u32 i=0; i<VTriangles.size(); ++i)
+		{
+			const u32 t = VTriangles[i];
+			core::vector3d<f64> p[3];
+			core::vector3d<f64> moved[3];
+			bool hasTarget = false;
+			for (u32 k=0; k<3; ++k)
+			{
+				const u32 c = Indices[t*3+k];
+				hasTarget |= (c == target);
+				p[k] = getPosition(c);
+				moved[k] = (c == v) ? targetPos : p[k];
+			}
+			if (hasTarget)
+				continue;
+
+			const core::vector3d<f64> before = (p[1] - p[0]).crossProduct(p[2] - p[0]);
+			const core::vector3d<f64> after = (moved[1] - moved[0]).crossProduct(moved[2] - moved[0]);
+			if (before.getLengthSQ() > 0.0 && before.dotProduct(after) <= 0.0)
+				return false;
+		}
+		return true;
+	}
+
+	//! Finds the cheapest collapse of a vertex and adds it to the heap
+	void addBestCollapse(u32 v)
+	{
+		if (Fixed[v])
+			return;
+
+		getTriangles(v, VTriangles);
+		getNeighbours(v, VTriangles, VNeighbours);
+
+		// the cheapest collapse which is possible, with the errors of all twins
+		Candidates.set_used(0);
+		for (u32 i=0; i<VNeighbours.size(); ++i)
+		{
+			SCollapse candidate;
+			candidate.Target = VNeighbours[i];
+			const core::vector3df& targetPos = Positions[candidate.Target];
+			if (!hasTwins(v))
+			{
+				candidate.Cost = Quadrics[v].getError(targetPos) +
+					Quadrics[candidate.Target].getError(targetPos);
+			}
+			else if (getTwinCollapses(v, candidate.Target))
+			{
+				candidate.Cost = 0.0;
+				for (u32 c=0; c<TwinCollapses.size(); c+=2)
+				{
+					candidate.Cost += Quadrics[TwinCollapses[c]].getError(targetPos) +
+						Quadrics[TwinCollapses[c+1]].getError(targetPos);
+				}
+			}
+			else
+				continue;
+			candidate.Vertex = v;
+			candidate.Stamp = Stamps[v];
+
+			u32 k = Candidates.size();
+			Candidates.push_back(candidate);
+			for (; k > 0 && candidate < Candidates[k-1]; --k)
+				Candidates[k] = Candidates[k-1];
+			Candidates[k] = candidate;
+		}
+
+		bool haveNeighbours = true;
+		for (u32 i=0; i<Candidates.size(); ++i)
+		{
+			if (canCollapseTwins(v, Candidates[i].Target, haveNeighbours))
+			{
+				pushHeap(Candidates[i]);
+				return;
+			}
+		}
+	}
+
+	//! Moves a vertex onto a neighbour
+	/** The vertices around the target are added to Dirty. */
+	void collapseVertex(u32 v, u32 target)
+	{
+		getTriangles(v, VTriangles);
+		getTriangles(target, TargetTriangles);
+		for (u32 i=0; i<VTriangles.size(); ++i)
+		{
+			const u32 t = VTriangles[i];
+			if (hasVertex(t, target))
+			{
+				Removed[t] = 1;
+				--LiveCount;
+			}
+			else
+			{
+				for (u32 k=0; k<3; ++k)
+				{
+					if (Indices[t*3+k] == v)
+						Indices[t*3+k] = target;
+				}
+				TargetTriangles.push_back(t);
+			}
+		}
+
+		// the collapses of v which are still in the heap are not used
+		++Stamps[v];
+		Quadrics[target].add(Quadrics[v]);
+
+		// the triangles of both are added as a new list of the target
+		FirstTriangle[target] = VertexTriangles.size();
+		TriangleCount[target] = 0;
+		for (u32 i=0; i<TargetTriangles.size(); ++i)
+		{
+			if (!Removed[TargetTriangles[i]])
+			{
+				VertexTriangles.push_back(TargetTriangles[i]);
+				++TriangleCount[target];
+			}
+		}
+
+		getTriangles(target, TargetTriangles);
+		getNeighbours(target, TargetTriangles, Ring);
+		for (u32 i=0; i<Ring.size(); ++i)
+			Dirty.push_back(Ring[i]);
+		Dirty.push_back(target);
+	}
+
+	//! Updates the collapses of the vertices in Dirty and of their twins
+	void updateCollapses()
+	{
+		++Mark;
+		Ring.set_used(0);
+		for (u32 i=0; i<Dirty.size(); ++i)
+		{
+			u32 twin = Dirty[i];
+			do
+			{
+				if (Marks[twin] != Mark)
+				{
+					Marks[twin] = Mark;
+					Ring.push_back(twin);
+				}
+				twin = Twins[twin];
+			} while (twin != Dirty[i]);
+		}
+
+		for (u32 i=0; i<Ring.size(); ++i)
+		{
+			++Stamps[Ring[i]];
+			addBestCollapse(Ring[i]);
+		}
+	}
+
+	void pushHeap(const SCollapse& collapse)
+	{
+		u32 i = Heap.size();
+		Heap.push_back(collapse);
+		while (i > 0)
+		{
+			const u32 parent = (i - 1) / 2;
+			if (!(Heap[i] < Heap[parent]))
+				break;
+			core::swap(Heap[i], Heap[parent]);
+			i = parent;
+		}
+	}
+
+	void popHeap()
+	{
+		Heap[0] = Heap.getLast();
+		Heap.erase(Heap.size()-1);
+		u32 i = 0;
+		for (;;)
+		{
+			const u32 left = i*2 + 1;
+			if (left >= Heap.size())
+				break;
+			u32 smallest = left;
+			if (left + 1 < Heap.size() && Heap[left+1] < Heap[left])
+				smallest = left + 1;
+			if (!(Heap[smallest] < Heap[i]))
+				break;
+			core::swap(Heap[i], Heap[smallest]);
+			i = smallest;
+		}
+	}
+
+	const core::array<core::vector3df>& Positions;
+	core::array<u32>& Indices;
+	const core::array<u8>& Locked;
+	// the next vertex at the same position, each twin ring ends at its start
+	const core::array<u32>& Twins;
+
+	// the triangles of each vertex, also removed ones
+	core::array<u32> FirstTriangle;
+	core::array<u32> TriangleCount;
+	core::array<u32> VertexTriangles;
+	core::array<u8> Removed;
+	u32 LiveCount;
+
+
+	core::array<SQuadric> Quadrics;
+	core::array<u32> Stamps;
+	core::array<u8> Border;
+	core::array<u8> SeamBorder;
+	core::array<u8> Fixed;
+	core::array<SCollapse> Heap;
+
+	// marks the vertices found by getNeighbours
+	core::array<u32> Marks;
+	u32 Mark;
+
+	// reused for each vertex
+	core::array<u32> VTriangles;
+	core::array<u32> VNeighbours;
+	core::array<u32> TargetTriangles;
+	core::array<u32> TargetNeighbours;
+	core::array<u32> Ring;
+	core::array<u32> Dirty;
+	core::array<u32> TwinTriangles;
+	core::array<u32> TwinCollapses;
+	core::array<SCollapse> Candidates;
+};
+
+//! Welded vertices and triangles of a meshbuffer which is simplified
+struct SSimplifiedBuffer
+{
+	core::array<u32> Kept;
+	core::array<u32> Indices;
+	core::array<core::vector3df> Positions;
+	core::array<u8> Locked;
+	core::array<u32> Twins;
+};
+
+//! Position of a vertex in one of the meshbuffers of a mesh
+struct SBufferPosition
+{
+	core::vector3df Pos;
+	u32 Buffer;
+	u32 Vertex;
+
+	bool operator<(const SBufferPosition& other) const
+	{
+		if (Pos.X != other.Pos.X)
+			return Pos.X < other.Pos.X;
+		if (Pos.Y != other.Pos.Y)
+			return Pos.Y < other.Pos.Y;
+		return Pos.Z < other.Pos.Z;
+	}
+};
+
+template <class T>
+void weldSimplifiedBuffer(const IMeshBuffer* mb, SSimplifiedBuffer& data)
+{
+	const T* v = static_cast<const T*>(mb->getVertices());
+	core::array<u32> redirects;
+	weldVertices(v, mb->getVertexCount(), 0.f, redirects, data.Kept);
+	getRedirectedIndices(mb, redirects, data.Indices);
+
+	data.Positions.set_used(data.Kept.size());
+	data.Locked.set_used(data.Kept.size());
+	data.Twins.set_used(data.Kept.size());
+	for (u32 i=0; i<data.Kept.size(); ++i)
+	{
+		data.Positions[i] = v[data.Kept[i]].Pos;
+		data.Locked[i] = 0;
+		data.Twins[i] = i;
+	}
+}
+
+template <class T>
+IMeshBuffer* createSimplifiedBuffer(const IMeshBuffer* mb, SSimplifiedBuffer& data)
+{
+	// only the vertices which are still used, in their old order
+	core::array<u32> redirects;
+	redirects.set_used(data.Kept.size());
+	for (u32 i=0; i<redirects.size(); ++i)
+		redirects[i] = 0;
+	for (u32 i=0; i<data.Indices.size(); ++i)
+		redirects[data.Indices[i]] = 1;
+
+	core::array<u32> kept;
+	for (u32 i=0; i<redirects.size(); ++i)
+	{
+		if (redirects[i])
+		{
+			redirects[i] = kept.size();
+			kept.push_back(data.Kept[i]);
+		}
+	}
+	for (u32 i=0; i<data.Indices.size(); ++i)
+		data.Indices[i] = redirects[data.Indices[i]];
+
+	IMeshBuffer* buffer = createIndexedBuffer(mb, static_cast<const T*>(mb->getVertices()), kept, data.Indices);
+	buffer->recalculateBoundingBox();
+	return buffer;
+}
+} // end anonymous namespace
+
+
+//! Creates a copy of the mesh with less triangles, by collapsing the edges with the smallest quadric error.
+IMesh* CMeshManipulator::createMeshSimplified(IMesh* mesh, f32 ratio) const
+{
+	if (!mesh)
+		return 0;
+
+	const u32 bufferCount = mesh->getMeshBufferCount();
+	core::array<SSimplifiedBuffer> buffers;
+	buffers.set_used(0);
+	buffers.reallocate(bufferCount);
+	core::array<SBufferPosition> positions;
+
+	for (u32 b=0; b<bufferCount; ++b)
+	{
+		const IMeshBuffer* const mb = mesh->getMeshBuffer(b);
+		buffers.push_back(SSimplifiedBuffer());
+		SSimplifiedBuffer& data = buffers.getLast();
+
+		switch(mb->getVertexType())
+		{
+		case video::EVT_STANDARD:
+			weldSimplifiedBuffer<video::S3DVertex>(mb, data);
+			break;
+		case video::EVT_2TCOORDS:
+			weldSimplifiedBuffer<video::S3DVertex2TCoords>(mb, data);
+			break;
+		case video::EVT_TANGENTS:
+			weldSimplifiedBuffer<video::S3DVertexTangents>(mb, data);
+			break;
+		default:
+			break;
+		}
+
+		for (u32 i=0; i<data.Positions.size(); ++i)
+		{
+			SBufferPosition p;
+			p.Pos = data.Positions[i];
+			p.Buffer = b;
+			p.Vertex = i;
+			positions.push_back(p);
+		}
+	}
+
+	// vertices sharing their position with vertices of another meshbuffer
+	// are on the border to another material, those are kept. Those sharing
+	// it only in their own meshbuffer are on a seam and become twins.
+	positions.sort();
+	for (u32 i=0; i<positions.size(); )
+	{
+		u32 j = i+1;
+		bool sameBuffer = true;
+		while (j < positions.size() && positions[j].Pos == positions[i].Pos)
+		{
+			sameBuffer &= (positions[j].Buffer == positions[i].Buffer);
+			++j;
+		}
+		if (j - i > 1 && sameBuffer)
+		{
+			core::array<u32>& twins = buffers[positions[i].Buffer].Twins;
+			for (u32 k=i; k<j; ++k)
+				twins[positions[k].Vertex] = positions[k+1 < j ? k+1 : i].Vertex;
+		}
+		else if (j - i > 1)
+		{
+			for (u32 k=i; k<j; ++k)
+				buffers[positions[k].Buffer].Locked[positions[k].Vertex] = 1;
+		}
+		i = j;
+	}
+
+	SMesh* meshClone = new SMesh();
+	meshClone->BoundingBox = mesh->getBoundingBox();
+	ratio = core::clamp(ratio, 0.f, 1.f);
+	u32 targetTotal = 0;
+	u32 triangleTotal = 0;
+
+	for (u32 b=0; b<bufferCount; ++b)
+	{
+		const IMeshBuffer* const mb = mesh->getMeshBuffer(b);
+		SSimplifiedBuffer& data = buffers[b];
+		const u32 targetCount = (u32)(ratio * (data.Indices.size() / 3) + 0.5f);
+
+		CMeshSimplifier simplifier(data.Positions, data.Locked, data.Twins, data.Indices);
+		IMeshBuffer* buffer = 0;
+
+		switch(mb->getVertexType())
+		{
+		case video::EVT_STANDARD:
+			simplifier.simplify(targetCount);
+			buffer = createSimplifiedBuffer<video::S3DVertex>(mb, data);
+			break;
+		case video::EVT_2TCOORDS:
+			simplifier.simplify(targetCount);
+			buffer = createSimplifiedBuffer<video::S3DVertex2TCoords>(mb, data);
+			break;
+		case video::EVT_TANGENTS:
+			simplifier.simplify(targetCount);
+			buffer = createSimplifiedBuffer<video::S3DVertexTangents>(mb, data);
+			break;
+		default:
+			// keep it, so all levels of detail have the same meshbuffers
+			os::Printer::log("Cannot simplify meshbuffer, vertex type unsupported", ELL_WARNING);
+			buffer = mb->createClone();
+			break;
+		}
+
+		targetTotal += core::min_(targetCount, buffer->getIndexCount() / 3);
+		triangleTotal += buffer->getIndexCount() / 3;
+		meshClone->addMeshBuffer(buffer);
+		buffer->drop();
+	}
+
+	if (triangleTotal > targetTotal)
+	{
+		c8 tmp[64];
+		snprintf_irr(tmp, 64, "%u instead of %u triangles", triangleTotal, targetTotal);
+		os::Printer::log("Could not simplify mesh as much as requested, as corners, borders and borders between meshbuffers are kept", tmp, ELL_INFORMATION);
+	}
+
+	return meshClone;
+}
+
+
+//! Creates a mesh with several levels of detail.
+IAnimatedMesh* CMeshManipulator::createLodMesh(IMesh* mesh, u32 lodCount, f32 ratio, f32 screenSize) const
+{
+	if (!mesh)
+		return 0;
+
+	SLodMesh* lodMesh = new SLodMesh();
+	lodMesh->addMesh(mesh, screenSize);
+
+	f32 lodRatio = 1.f;
+	for (u32 i=1; i<lodCount; ++i)
+	{
+		lodRatio *= ratio;
+		screenSize *= ratio;
+
+		IMesh* lod = createMeshSimplified(mesh, lodRatio);
+		lodMesh->addMesh(lod, screenSize);
+		lod->drop();
+	}
+
+	lodMesh->setBoundingBox(mesh->getBoundingBox());
+	return lodMesh;
+}
+
+
 //! Creates a copy of the mesh, which will only consist of S3DVertexTangents vertices.
 // not yet 32bit
 IMesh* CMeshManipulator::createMeshWithTangents(IMesh* mesh, bool recalculateNormals, bool smooth, bool angleWeighted, bool calculateTangents) const
@@ -6,12 +6,16 @@
 #define IRR_C_MESH_MANIPULATOR_H_INCLUDED
 
 #include "IMeshManipulator.h"
+#include "IJobSystem.h"
+#include "irrArray.h"
 
 namespace irr
 {
 namespace scene
 {
 
+struct SVertexCorners;
+
 //! An interface for easy manipulation of meshes.
 /** Scale, set alpha value, flip surfaces, and so on. This exists for fixing
 problems with wrong imported or exported meshes quickly after loading. It is
@@ -20,6 +24,16 @@ not intended for doing mesh modifications and/or animations during runtime.
 class CMeshManipulator : public IMeshManipulator
 {
 public:
+	//! constructor
+	CMeshManipulator();
+
+	//! destructor
+	virtual ~CMeshManipulator();
+
+	//! Set the job system used for the normals and tangents of large meshbuffers.
+	/** Those are calculated on the calling thread without a job system. */
+	void setJobSystem(core::IJobSystem* jobSystem);
+
 	//! Flips the direction of surfaces.
 	/** Changes backfacing triangles to frontfacing triangles and vice versa.
 	\param mesh: Mesh on which the operation is performed. */
@@ -75,6 +89,12 @@ public:
 	//! Creates a copy of the mesh, which will have all duplicated vertices removed, i.e. maximal amount of vertices are shared via indexing.
 	virtual IMesh* createMeshWelded(IMesh *mesh, f32 tolerance=core::ROUNDING_ERROR_f32) const IRR_OVERRIDE;
 
+	//! Creates a copy of the mesh with less triangles, by collapsing the edges with the smallest quadric error.
+	virtual IMesh* createMeshSimplified(IMesh* mesh, f32 ratio) const IRR_OVERRIDE;
+
+	//! Creates a mesh with several levels of detail.
+	virtual IAnimatedMesh* createLodMesh(IMesh* mesh, u32 lodCount=4, f32 ratio=0.5f, f32 screenSize=0.25f) const IRR_OVERRIDE;
+
 	//! Returns amount of polygons in mesh.
 	virtual s32 getPolyCount(scene::IMesh* mesh) const IRR_OVERRIDE;
 
@@ -92,6 +112,18 @@ public:
 
 	//! Optimizes the mesh using an algorithm tuned for heightmaps
 	virtual void heightmapOptimizeMesh(IMeshBuffer * const m, const f32 tolerance = core::ROUNDING_ERROR_f32) const IRR_OVERRIDE;
+
+private:
+
+	//! Get the corners of the triangles around the vertices of a meshbuffer
+	/** Only meshbuffers which are large enough to be split into jobs get
+	corners. They are sorted again on each call, as indices can be changed
+	without telling the meshbuffer, for example by flipSurfaces(). That's
+	a counting sort, cheap compared to the normals.
+	\return False when the meshbuffer is handled on the calling thread. */
+	bool getVertexCorners(SVertexCorners& corners, IMeshBuffer* buffer) const;
+
+	core::IJobSystem* JobSystem;
 };
 
 } // end namespace scene
@@ -8,6 +8,8 @@
 #include "ISceneManager.h"
 #include "IMeshCache.h"
 #include "IAnimatedMesh.h"
+#include "SLodMesh.h"
+#include "ICameraSceneNode.h"
 #include "IFileSystem.h"
 #ifdef _IRR_COMPILE_WITH_SHADOW_VOLUME_SCENENODE_
 #include "CShadowVolumeSceneNode.h"
@@ -25,7 +27,7 @@ CMeshSceneNode::CMeshSceneNode(IMesh* mesh, ISceneNode* parent, ISceneManager* m
 			const core::vector3df& position, const core::vector3df& rotation,
 			const core::vector3df& scale)
 	: IMeshSceneNode(parent, mgr, id, position, rotation, scale)
-	, Mesh(0), Shadow(0), ReadOnlyMaterials(false)
+	, Mesh(0), LodMesh(0), Shadow(0), ReadOnlyMaterials(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CMeshSceneNode");
@@ -53,6 +55,15 @@ void CMeshSceneNode::OnRegisterSceneNode()
 	{
 		Box = Mesh->getBoundingBox(); // in case mesh was modified, as clipping happens when registering nodes for rendering
 
+		// meshes with levels of detail draw the level fitting the size on the screen
+		LodMesh = Mesh;
+		if (Mesh->getMeshType() == EAMT_LOD)
+		{
+			LodMesh = static_cast<SLodMesh*>(Mesh)->getLod(getScreenSize());
+			if (!LodMesh)
+				LodMesh = Mesh;
+		}
+
 		// Because this node supports rendering of mixed mode meshes consisting of
 		// transparent and solid material at the same time, we need to go through all
 		// materials, check of what type they are and register this node for the right
@@ -75,7 +86,7 @@ void CMeshSceneNode::OnRegisterSceneNode()
 
 				if ( driver->needsTransparentRenderPass(material) )
 				{
-					BufferRenderNodes[i]->prepareRendering(ESNRP_TRANSPARENT, parentRenders);
+					BufferRenderNodes[i]->prepareRendering(ESNRP_TRANSPARENT, parentRenders, LodMesh);
 					if ( parentRenders )
 					{
 						++transparentCount;
@@ -83,7 +94,7 @@ void CMeshSceneNode::OnRegisterSceneNode()
 				}
 				else
 				{
-					BufferRenderNodes[i]->prepareRendering(ESNRP_SOLID, parentRenders);
+					BufferRenderNodes[i]->prepareRendering(ESNRP_SOLID, parentRenders, LodMesh);
 					if ( parentRenders )
 					{
 						++solidCount;
@@ -135,12 +146,12 @@ void CMeshSceneNode::render()
 			// render with half transparency
 			if (DebugDataVisible & scene::EDS_HALF_TRANSPARENCY)
 			{
-				for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+				for (u32 g=0; g<LodMesh->getMeshBufferCount(); ++g)
 				{
 					irr::video::SMaterial mat = Materials[g];
 					mat.MaterialType = video::EMT_TRANSPARENT_ADD_COLOR;
 					driver->setMaterial(mat);
-					driver->drawMeshBuffer(Mesh->getMeshBuffer(g));
+					driver->drawMeshBuffer(LodMesh->getMeshBuffer(g));
 				}
 			}
 
@@ -155,10 +166,10 @@ void CMeshSceneNode::render()
 			}
 			if (DebugDataVisible & scene::EDS_BBOX_BUFFERS)
 			{
-				for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+				for (u32 g=0; g<LodMesh->getMeshBufferCount(); ++g)
 				{
 					driver->draw3DBox(
-						Mesh->getMeshBuffer(g)->getBoundingBox(),
+						LodMesh->getMeshBuffer(g)->getBoundingBox(),
 						video::SColor(255,190,128,128));
 				}
 			}
@@ -168,11 +179,11 @@ void CMeshSceneNode::render()
 				// draw normals
  				const f32 debugNormalLength = SceneManager->getParameters()->getAttributeAsFloat(DEBUG_NORMAL_LENGTH);
 				const video::SColor debugNormalColor = SceneManager->getParameters()->getAttributeAsColor(DEBUG_NORMAL_COLOR);
-				const u32 count = Mesh->getMeshBufferCount();
+				const u32 count = LodMesh->getMeshBufferCount();
 
 				for (u32 i=0; i != count; ++i)
 				{
-					driver->drawMeshBufferNormals(Mesh->getMeshBuffer(i), debugNormalLength, debugNormalColor);
+					driver->drawMeshBufferNormals(LodMesh->getMeshBuffer(i), debugNormalLength, debugNormalColor);
 				}
 			}
 
@@ -182,9 +193,9 @@ void CMeshSceneNode::render()
 				m.Wireframe = true;
 				driver->setMaterial(m);
 
-				for (u32 g=0; g<Mesh->getMeshBufferCount(); ++g)
+				for (u32 g=0; g<LodMesh->getMeshBufferCount(); ++g)
 				{
-					driver->drawMeshBuffer(Mesh->getMeshBuffer(g));
+					driver->drawMeshBuffer(LodMesh->getMeshBuffer(g));
 				}
 			}
 		}
@@ -275,6 +286,25 @@ u32 CMeshSceneNode::getMaterialCount() const
 	return Materials.size();
 }
 
+//! Part of the screen height covered by the bounding sphere of the node
+f32 CMeshSceneNode::getScreenSize() const
+{
+	const ICameraSceneNode* camera = SceneManager->getActiveCamera();
+	if (!camera)
+		return 1.f;
+
+	const core::aabbox3d<f32> box = getTransformedBoundingBox();
+	const f32 radius = box.getExtent().getLength() * 0.5f;
+
+	// the projection scales the height of the view volume to 2
+	const f32 scale = camera->getProjectionMatrix()[5];
+	if (camera->isOrthogonal())
+		return radius * scale;
+
+	const f32 distance = camera->getAbsolutePosition().getDistanceFrom(box.getCenter());
+	return radius * scale / core::max_(distance, core::ROUNDING_ERROR_f32);
+}
+
 void CMeshSceneNode::setUsedBufferRenderNodes(irr::u32 num)
 {
 	if ( BufferRenderNodes.size() > num )
@@ -304,6 +334,7 @@ void CMeshSceneNode::setMesh(IMesh* mesh)
 		}
 
 		Mesh = mesh;
+		LodMesh = mesh;
 
 		// Note: Mesh can change amount of meshbuffers later and we don't handle that so far so that would cause trouble
 		// For now assuming users call setMesh again in that case
@@ -87,11 +87,16 @@ namespace scene
 		void setUsedBufferRenderNodes(irr::u32 num);
 		void copyMaterials();
 
+		//! Part of the screen height covered by the bounding sphere of the node
+		f32 getScreenSize() const;
+
 		core::array<video::SMaterial> Materials;
 		core::aabbox3d<f32> Box;
 		video::SMaterial ReadOnlyMaterial;
 
 		IMesh* Mesh;
+		// level of detail of the mesh drawn in this frame, the mesh itself when it has no levels
+		IMesh* LodMesh;
 		IShadowVolumeSceneNode* Shadow;
 
 		bool ReadOnlyMaterials;
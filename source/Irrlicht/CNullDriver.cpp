@@ -17,6 +17,7 @@
 #include "CColorConverter.h"
 #include "IAttributeExchangingObject.h"
 #include "IRenderTarget.h"
+#include "IJobSystem.h"
 
 
 namespace irr
@@ -87,8 +88,9 @@ IImageWriter* createImageWriterPPM();
 
 //! constructor
 CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& screenSize)
-	: SharedRenderTarget(0), CurrentRenderTarget(0), CurrentRenderTargetSize(0, 0), FileSystem(io), MeshManipulator(0),
+	: SharedRenderTarget(0), CurrentRenderTarget(0), CurrentRenderTargetSize(0, 0), FileSystem(io), JobSystem(0), MeshManipulator(0),
 	ViewPort(0, 0, 0, 0), ScreenSize(screenSize), PrimitivesDrawn(0), MinVertexCountForVBO(500),
+	FrameStats(120), Recording2D(0), Recording2DFailed(false), CanRecord2D(false),
 	TextureCreationFlags(0), OverrideMaterial2DEnabled(false), AllowZWriteOnTransparent(false)
 {
 	#ifdef _DEBUG
@@ -220,6 +222,9 @@ CNullDriver::~CNullDriver()
 	if (FileSystem)
 		FileSystem->drop();
 
+	if (JobSystem)
+		JobSystem->drop();
+
 	if (MeshManipulator)
 		MeshManipulator->drop();
 
@@ -314,6 +319,7 @@ void CNullDriver::deleteAllTextures()
 		Textures[i].Surface->drop();
 
 	Textures.clear();
+	TexturesByName.clear();
 
 	SharedDepthTextures.clear();
 }
@@ -321,6 +327,8 @@ void CNullDriver::deleteAllTextures()
 bool CNullDriver::beginScene(u16 clearFlag, SColor clearColor, f32 clearDepth, u8 clearStencil, const SExposedVideoData& videoData, core::rect<s32>* sourceRect)
 {
 	PrimitivesDrawn = 0;
+	FrameArena.reset();
+	FrameArena.resetPeakBytes();
 	return true;
 }
 
@@ -329,6 +337,8 @@ bool CNullDriver::endScene()
 	FPSCounter.registerFrame(os::Timer::getRealTime(), PrimitivesDrawn);
 	updateAllHardwareBuffers();
 	updateAllOcclusionQueries();
+	FrameStats.current().FrameArenaBytes = (u32)FrameArena.getPeakBytes();
+	FrameStats.endFrame();
 	return true;
 }
 
@@ -370,6 +380,35 @@ const core::matrix4& CNullDriver::getTransform(E_TRANSFORMATION_STATE state) con
 //! sets a material
 void CNullDriver::setMaterial(const SMaterial& material)
 {
+	SMaterial used(material);
+	OverrideMaterial.apply(used);
+	countMaterialChange(used);
+}
+
+
+//! counts material and texture changes for the frame stats
+void CNullDriver::countMaterialChange(const SMaterial& material)
+{
+	if (material == LastCountedMaterial)
+		return;
+
+	SFrameStats& stats = FrameStats.current();
+	++stats.MaterialChanges;
+	for (u32 i=0; i<MATERIAL_MAX_TEXTURES; ++i)
+	{
+		if (material.TextureLayer[i].Texture != LastCountedMaterial.TextureLayer[i].Texture)
+			++stats.TextureChanges;
+	}
+	LastCountedMaterial = material;
+}
+
+
+//! counts a copy into a hardware buffer for the frame stats
+void CNullDriver::countHardwareBufferUpload(u32 size)
+{
+	SFrameStats& stats = FrameStats.current();
+	++stats.HardwareBufferUploads;
+	stats.HardwareBufferUploadBytes += size;
 }
 
 
@@ -384,8 +423,9 @@ void CNullDriver::removeTexture(ITexture* texture)
 	{
 		if (Textures[i].Surface == texture)
 		{
-			texture->drop();
 			Textures.erase(i);
+			removeTextureName(texture);
+			texture->drop();
 			return;
 		}
 	}
@@ -425,12 +465,37 @@ void CNullDriver::renameTexture(ITexture* texture, const io::path& newName)
 	// is just readonly to prevent the user changing the texture name without invoking
 	// this method, because the textures will need resorting afterwards
 
+	removeTextureName(texture);
+
 	io::SNamedPath& name = const_cast<io::SNamedPath&>(texture->getName());
 	name.setPath(newName);
 
+	TexturesByName.insert(name.getInternalName(), texture);
 	Textures.sort();
 }
 
+
+//! Update TexturesByName for a texture which is no longer in the cache under its name
+void CNullDriver::removeTextureName(ITexture* texture)
+{
+	const io::path& name = texture->getName().getInternalName();
+	core::hash_map<io::path, ITexture*>::Node* node = TexturesByName.find(name);
+	if (!node || node->getValue() != texture)
+		return;
+
+	// another texture with the same name can be found now
+	for (u32 i=0; i<Textures.size(); ++i)
+	{
+		if (Textures[i].Surface != texture && Textures[i].Surface->getName().getInternalName() == name)
+		{
+			node->setValue(Textures[i].Surface);
+			return;
+		}
+	}
+
+	TexturesByName.remove(name);
+}
+
 ITexture* CNullDriver::addTexture(const core::dimension2d<u32>& size, const io::path& name, ECOLOR_FORMAT format)
 {
 	if (0 == name.size())
@@ -640,41 +705,166 @@ ITexture* CNullDriver::getTexture(io::IReadFile* file)
 }
 
 
+namespace
+{
+	//! A texture file loaded by CNullDriver::getTextures
+	struct STextureFileLoad
+	{
+		STextureFileLoad() : Index(0), File(0), Type(ETT_2D) {}
+
+		u32 Index;
+		io::path AbsolutePath;
+		io::IReadFile* File;
+		core::array<IImage*> Images;
+		E_TEXTURE_TYPE Type;
+	};
+
+	struct SLoadTexturesJob
+	{
+		CNullDriver* Driver;
+		const core::array<io::path>* Filenames;
+		STextureFileLoad* Loads;
+	};
+}
+
+//! loads several textures, decoding them on the job system
+core::array<ITexture*> CNullDriver::getTextures(const core::array<io::path>& filenames)
+{
+	core::array<ITexture*> textures;
+	textures.set_used(filenames.size());
+
+	// textures in the cache are found like getTexture does
+	core::array<STextureFileLoad> loads;
+	for (u32 i=0; i<filenames.size(); ++i)
+	{
+		const io::path absolutePath = FileSystem->getAbsolutePath(filenames[i]);
+		textures[i] = findTexture(absolutePath);
+		if (!textures[i])
+			textures[i] = findTexture(filenames[i]);
+
+		if (textures[i])
+			textures[i]->updateSource(ETS_FROM_CACHE);
+		else
+		{
+			loads.push_back(STextureFileLoad());
+			loads.getLast().Index = i;
+			loads.getLast().AbsolutePath = absolutePath;
+		}
+	}
+
+	// the others are opened and decoded on all threads
+	SLoadTexturesJob job;
+	job.Driver = this;
+	job.Filenames = &filenames;
+	job.Loads = loads.pointer();
+	if (JobSystem && loads.size() > 1)
+		JobSystem->parallelFor(0, loads.size(), loadTexturesJob, &job, 1);
+	else
+		loadTexturesJob(&job, 0, loads.size());
+
+	// only creating the textures and adding them to the cache is serial
+	for (u32 i=0; i<loads.size(); ++i)
+	{
+		STextureFileLoad& load = loads[i];
+		const io::path& filename = filenames[load.Index];
+		ITexture* texture = 0;
+
+		if (!load.File)
+			os::Printer::log("Could not open file of texture", filename, ELL_WARNING);
+		else
+		{
+			// Re-check name for actual archive names and files listed twice
+			texture = findTexture(load.File->getFileName());
+			if (texture)
+				texture->updateSource(ETS_FROM_CACHE);
+			else
+			{
+				texture = createTextureFromImages(load.File->getFileName(), load.Images, load.Type);
+				if (texture)
+				{
+					os::Printer::log("Loaded texture", load.File->getFileName(), ELL_DEBUG);
+					texture->updateSource(ETS_FROM_FILE);
+					addTexture(texture);
+					texture->drop(); // drop it because we created it, one grab too much
+				}
+				else
+					os::Printer::log("Could not load texture", filename, ELL_ERROR);
+			}
+			load.File->drop();
+		}
+
+		for (u32 j=0; j<load.Images.size(); ++j)
+		{
+			if (load.Images[j])
+				load.Images[j]->drop();
+		}
+
+		textures[load.Index] = texture;
+	}
+
+	return textures;
+}
+
+
+//! opens and decodes the files of a range of textures for getTextures, run by the job system
+void CNullDriver::loadTexturesJob(void* data, u32 begin, u32 end)
+{
+	SLoadTexturesJob& job = *static_cast<SLoadTexturesJob*>(data);
+	for (u32 i=begin; i<end; ++i)
+	{
+		STextureFileLoad& load = job.Loads[i];
+		load.File = job.Driver->FileSystem->createAndOpenFile(load.AbsolutePath);
+		if (!load.File)
+			load.File = job.Driver->FileSystem->createAndOpenFile((*job.Filenames)[load.Index]);
+		if (load.File)
+			load.Images = job.Driver->createImagesFromFile(load.File, &load.Type);
+	}
+}
+
+
 //! opens the file and loads it into the surface
 video::ITexture* CNullDriver::loadTextureFromFile(io::IReadFile* file, const io::path& hashName )
 {
-	ITexture* texture = 0;
-
 	E_TEXTURE_TYPE type = ETT_2D;
 
 	core::array<IImage*> imageArray = createImagesFromFile(file, &type);
 
+	ITexture* texture = createTextureFromImages(hashName.size() ? hashName : file->getFileName(), imageArray, type);
+	if (texture)
+		os::Printer::log("Loaded texture", file->getFileName(), ELL_DEBUG);
+
+	for (u32 i = 0; i < imageArray.size(); ++i)
+	{
+		if (imageArray[i])
+			imageArray[i]->drop();
+	}
+
+	return texture;
+}
+
+
+//! creates the texture for the images loaded from a file
+ITexture* CNullDriver::createTextureFromImages(const io::path& name, const core::array<IImage*>& imageArray, E_TEXTURE_TYPE type)
+{
+	ITexture* texture = 0;
+
 	if (checkImage(imageArray))
 	{
 		switch (type)
 		{
 		case ETT_2D:
-			texture = createDeviceDependentTexture(hashName.size() ? hashName : file->getFileName(), imageArray[0]);
+			texture = createDeviceDependentTexture(name, imageArray[0]);
 			break;
 		case ETT_CUBEMAP:
 			if (imageArray.size() >= 6 && imageArray[0] && imageArray[1] && imageArray[2] && imageArray[3] && imageArray[4] && imageArray[5])
 			{
-				texture = createDeviceDependentTextureCubemap(hashName.size() ? hashName : file->getFileName(), imageArray);
+				texture = createDeviceDependentTextureCubemap(name, imageArray);
 			}
 			break;
 		default:
 			IRR_DEBUG_BREAK_IF(true);
 			break;
 		}
-
-		if (texture)
-			os::Printer::log("Loaded texture", file->getFileName(), ELL_DEBUG);
-	}
-
-	for (u32 i = 0; i < imageArray.size(); ++i)
-	{
-		if (imageArray[i])
-			imageArray[i]->drop();
 	}
 
 	return texture;
@@ -691,6 +881,8 @@ void CNullDriver::addTexture(video::ITexture* texture)
 		texture->grab();
 
 		Textures.push_back(s);
+		TexturesByName.insert(texture->getName().getInternalName(), texture);
+		++FrameStats.current().TexturesCreated;
 
 		// the new texture is now at the end of the texture list. when searching for
 		// the next new texture, the texture array will be sorted and the index of this texture
@@ -705,15 +897,8 @@ void CNullDriver::addTexture(video::ITexture* texture)
 //! looks if the image is already loaded
 video::ITexture* CNullDriver::findTexture(const io::path& filename)
 {
-	SSurface s;
-	SDummyTexture dummy(filename, ETT_2D);
-	s.Surface = &dummy;
-
-	s32 index = Textures.binary_search(s);
-	if (index != -1)
-		return Textures[index].Surface;
-
-	return 0;
+	const core::hash_map<io::path, ITexture*>::Node* node = TexturesByName.find(io::SNamedPath(filename).getInternalName());
+	return node ? node->getValue() : 0;
 }
 
 ITexture* CNullDriver::createDeviceDependentTexture(const io::path& name, IImage* image)
@@ -788,6 +973,9 @@ void CNullDriver::drawVertexPrimitiveList(const void* vertices, u32 vertexCount,
 	if ((iType==EIT_16BIT) && (vertexCount>65536))
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 	PrimitivesDrawn += primitiveCount;
+	SFrameStats& stats = FrameStats.current();
+	++stats.DrawCalls;
+	stats.PrimitivesDrawn += primitiveCount;
 }
 
 
@@ -797,6 +985,9 @@ void CNullDriver::draw2DVertexPrimitiveList(const void* vertices, u32 vertexCoun
 	if ((iType==EIT_16BIT) && (vertexCount>65536))
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 	PrimitivesDrawn += primitiveCount;
+	SFrameStats& stats = FrameStats.current();
+	++stats.DrawCalls;
+	stats.PrimitivesDrawn += primitiveCount;
 }
 
 
@@ -998,6 +1189,269 @@ void CNullDriver::draw2DPolygon(core::position2d<s32> center,
 }
 
 
+//! Starts recording the 2d drawing into a batch instead of drawing it.
+bool CNullDriver::beginRecording2D(S2DVertexBatch* batch)
+{
+	if (!CanRecord2D || !batch || Recording2D)
+		return false;
+
+	batch->clear();
+	Recording2D = batch;
+	Recording2DFailed = false;
+	return true;
+}
+
+
+//! Stops recording the 2d drawing.
+bool CNullDriver::endRecording2D()
+{
+	if (!Recording2D)
+		return false;
+
+	Recording2D = 0;
+	return !Recording2DFailed;
+}
+
+
+//! records draw2DImage() while recording 2d drawing
+bool CNullDriver::record2DImage(const ITexture* texture, const core::position2d<s32>& destPos,
+	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+	SColor color, bool useAlphaChannelOfTexture)
+{
+	if (!Recording2D)
+		return false;
+
+	if (texture && sourceRect.isValid())
+	{
+		const SColor colors[4] = { color, color, color, color };
+		record2DQuad(texture, core::rect<s32>(destPos, sourceRect.getSize()), sourceRect,
+			clipRect, colors, useAlphaChannelOfTexture);
+	}
+	return true;
+}
+
+
+//! records draw2DImage() while recording 2d drawing
+bool CNullDriver::record2DImage(const ITexture* texture, const core::rect<s32>& destRect,
+	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+	const SColor* colors, bool useAlphaChannelOfTexture)
+{
+	if (!Recording2D)
+		return false;
+
+	if (texture)
+	{
+		// draw2DImage gets the colors counterclockwise
+		const SColor white(0xFFFFFFFF);
+		const SColor corners[4] =
+		{
+			colors ? colors[0] : white,
+			colors ? colors[3] : white,
+			colors ? colors[2] : white,
+			colors ? colors[1] : white
+		};
+		record2DQuad(texture, destRect, sourceRect, clipRect, corners, useAlphaChannelOfTexture);
+	}
+	return true;
+}
+
+
+//! records draw2DRectangle() while recording 2d drawing
+bool CNullDriver::record2DRectangle(const core::rect<s32>& pos,
+	SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
+	const core::rect<s32>* clip)
+{
+	if (!Recording2D)
+		return false;
+
+	// the drivers keep the corner colors of clipped rectangles
+	core::rect<s32> area(pos);
+	if (clip)
+		area.clipAgainst(*clip);
+
+	const SColor colors[4] = { colorLeftUp, colorRightUp, colorRightDown, colorLeftDown };
+	record2DQuad(0, area, area, 0, colors, false);
+	return true;
+}
+
+
+//! adds a quad to the recorded 2d drawing
+void CNullDriver::record2DQuad(const ITexture* texture, const core::rect<s32>& destRect,
+	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+	const SColor* colors, bool useAlphaChannelOfTexture)
+{
+	core::rect<s32> area(destRect);
+	if (clipRect)
+		area.clipAgainst(*clipRect);
+	if (area.getWidth() <= 0 || area.getHeight() <= 0)
+		return;
+
+	// clipped corners relative to the whole quad, like a scissor test would clip it
+	const f32 invWidth = 1.f / destRect.getWidth();
+	const f32 invHeight = 1.f / destRect.getHeight();
+	const f32 left = (area.UpperLeftCorner.X - destRect.UpperLeftCorner.X) * invWidth;
+	const f32 right = (area.LowerRightCorner.X - destRect.UpperLeftCorner.X) * invWidth;
+	const f32 top = (area.UpperLeftCorner.Y - destRect.UpperLeftCorner.Y) * invHeight;
+	const f32 bottom = (area.LowerRightCorner.Y - destRect.UpperLeftCorner.Y) * invHeight;
+
+	core::rect<f32> tcoords(0.f, 0.f, 0.f, 0.f);
+	u32 alphaSource = 0;
+	if (texture)
+	{
+		const core::dimension2d<u32>& size = texture->getOriginalSize();
+		const f32 invW = 1.f / static_cast<f32>(size.Width);
+		const f32 invH = 1.f / static_cast<f32>(size.Height);
+		const f32 u0 = sourceRect.UpperLeftCorner.X * invW;
+		const f32 v0 = sourceRect.UpperLeftCorner.Y * invH;
+		const f32 du = sourceRect.LowerRightCorner.X * invW - u0;
+		const f32 dv = sourceRect.LowerRightCorner.Y * invH - v0;
+		tcoords = core::rect<f32>(u0 + du*left, v0 + dv*top, u0 + du*right, v0 + dv*bottom);
+		if (useAlphaChannelOfTexture)
+			alphaSource |= EAS_TEXTURE;
+	}
+
+	SColor c[4] = { colors[0], colors[1], colors[2], colors[3] };
+	if (c[0] != c[1] || c[0] != c[2] || c[0] != c[3])
+	{
+		const SColor topLeft(colors[0].getInterpolated(colors[1], 1.f - left));
+		const SColor topRight(colors[0].getInterpolated(colors[1], 1.f - right));
+		const SColor bottomLeft(colors[3].getInterpolated(colors[2], 1.f - left));
+		const SColor bottomRight(colors[3].getInterpolated(colors[2], 1.f - right));
+		c[0] = topLeft.getInterpolated(bottomLeft, 1.f - top);
+		c[1] = topRight.getInterpolated(bottomRight, 1.f - top);
+		c[2] = topRight.getInterpolated(bottomRight, 1.f - bottom);
+		c[3] = topLeft.getInterpolated(bottomLeft, 1.f - bottom);
+	}
+	if (c[0].getAlpha() < 255 || c[1].getAlpha() < 255 || c[2].getAlpha() < 255 || c[3].getAlpha() < 255)
+		alphaSource |= EAS_VERTEX_COLOR;
+
+	const f32 x0 = (f32)area.UpperLeftCorner.X;
+	const f32 y0 = (f32)area.UpperLeftCorner.Y;
+	const f32 x1 = (f32)area.LowerRightCorner.X;
+	const f32 y1 = (f32)area.LowerRightCorner.Y;
+	Recording2D->addQuad(const_cast<ITexture*>(texture), alphaSource, area,
+		S3DVertex(x0, y0, 0.f, 0.f, 0.f, 0.f, c[0], tcoords.UpperLeftCorner.X, tcoords.UpperLeftCorner.Y),
+		S3DVertex(x1, y0, 0.f, 0.f, 0.f, 0.f, c[1], tcoords.LowerRightCorner.X, tcoords.UpperLeftCorner.Y),
+		S3DVertex(x1, y1, 0.f, 0.f, 0.f, 0.f, c[2], tcoords.LowerRightCorner.X, tcoords.LowerRightCorner.Y),
+		S3DVertex(x0, y1, 0.f, 0.f, 0.f, 0.f, c[3], tcoords.UpperLeftCorner.X, tcoords.LowerRightCorner.Y));
+}
+
+
+//! Draws recorded 2d batches.
+void CNullDriver::draw2DVertexBatches(const S2DVertexBatch* const* batches, u32 count)
+{
+	// Parts with the same texture and blending join a group drawn earlier,
+	// unless a group drawn in between overlaps them
+	Batch2DRuns.set_used(0);
+	Batch2DGroups.set_used(0);
+	for (u32 b=0; b<count; ++b)
+	{
+		if (!batches[b])
+			continue;
+
+		const core::array<S2DVertexBatch::SPart>& parts = batches[b]->Parts;
+		for (u32 p=0; p<parts.size(); ++p)
+		{
+			const S2DVertexBatch::SPart& part = parts[p];
+
+			S2DBatchRun run;
+			run.Vertices = batches[b]->Vertices.const_pointer() + part.FirstVertex;
+			run.VertexCount = part.VertexCount;
+			run.Next = -1;
+
+			s32 g = (s32)Batch2DGroups.size() - 1;
+			for (; g >= 0; --g)
+			{
+				const S2DBatchGroup& group = Batch2DGroups[g];
+				if (group.Texture == part.Texture && group.AlphaSource == part.AlphaSource)
+					break;
+				if (group.Area.isRectCollided(part.Area))
+				{
+					g = -1;
+					break;
+				}
+			}
+
+			if (g < 0)
+			{
+				S2DBatchGroup group;
+				group.Texture = part.Texture;
+				group.AlphaSource = part.AlphaSource;
+				group.Area = part.Area;
+				group.FirstRun = Batch2DRuns.size();
+				group.LastRun = group.FirstRun;
+				Batch2DGroups.push_back(group);
+			}
+			else
+			{
+				S2DBatchGroup& group = Batch2DGroups[g];
+				group.Area.addInternalPoint(part.Area.UpperLeftCorner);
+				group.Area.addInternalPoint(part.Area.LowerRightCorner);
+				Batch2DRuns[group.LastRun].Next = Batch2DRuns.size();
+				group.LastRun = Batch2DRuns.size();
+			}
+			Batch2DRuns.push_back(run);
+		}
+	}
+
+	// quads share one index list, limited by the 16 bit indices
+	const u32 maxQuads = 0x4000;
+	if (Batch2DIndices.empty())
+	{
+		Batch2DIndices.reallocate(maxQuads * 6);
+		for (u32 i=0; i<maxQuads; ++i)
+		{
+			const u16 v = (u16)(i*4);
+			Batch2DIndices.push_back(v);
+			Batch2DIndices.push_back(v+1);
+			Batch2DIndices.push_back(v+2);
+			Batch2DIndices.push_back(v);
+			Batch2DIndices.push_back(v+2);
+			Batch2DIndices.push_back(v+3);
+		}
+	}
+
+	SMaterial material;
+	material.Lighting = false;
+	material.ZBuffer = ECFN_DISABLED;
+	material.ZWriteEnable = EZW_OFF;
+	material.MaterialType = EMT_ONETEXTURE_BLEND;
+
+	for (u32 g=0; g<Batch2DGroups.size(); ++g)
+	{
+		const S2DBatchGroup& group = Batch2DGroups[g];
+
+		material.setTexture(0, group.Texture);
+		material.MaterialTypeParam = pack_textureBlendFunc(EBF_SRC_ALPHA, EBF_ONE_MINUS_SRC_ALPHA,
+			EMFN_MODULATE_1X, group.AlphaSource);
+		setMaterial(material);
+
+		Batch2DVertices.set_used(0);
+		for (s32 r = group.FirstRun; r >= 0; r = Batch2DRuns[r].Next)
+		{
+			const S2DBatchRun& run = Batch2DRuns[r];
+			for (u32 v=0; v<run.VertexCount; v+=4)
+			{
+				if (Batch2DVertices.size() == maxQuads*4)
+				{
+					draw2DVertexPrimitiveList(Batch2DVertices.const_pointer(), Batch2DVertices.size(),
+						Batch2DIndices.const_pointer(), maxQuads*2, EVT_STANDARD, scene::EPT_TRIANGLES, EIT_16BIT);
+					Batch2DVertices.set_used(0);
+				}
+				Batch2DVertices.push_back(run.Vertices[v]);
+				Batch2DVertices.push_back(run.Vertices[v+1]);
+				Batch2DVertices.push_back(run.Vertices[v+2]);
+				Batch2DVertices.push_back(run.Vertices[v+3]);
+			}
+		}
+
+		if (!Batch2DVertices.empty())
+			draw2DVertexPrimitiveList(Batch2DVertices.const_pointer(), Batch2DVertices.size(),
+				Batch2DIndices.const_pointer(), Batch2DVertices.size()/2, EVT_STANDARD, scene::EPT_TRIANGLES, EIT_16BIT);
+	}
+}
+
+
 //! returns color format
 ECOLOR_FORMAT CNullDriver::getColorFormat() const
 {
@@ -1044,6 +1498,34 @@ u32 CNullDriver::getPrimitiveCountDrawn( u32 param ) const
 }
 
 
+//! Returns counters of a finished frame
+const SFrameStats& CNullDriver::getFrameStats(u32 framesAgo) const
+{
+	return FrameStats.get(framesAgo);
+}
+
+
+//! Returns how many finished frames are stored for getFrameStats()
+u32 CNullDriver::getFrameStatsCount() const
+{
+	return FrameStats.size();
+}
+
+
+//! Returns the counters of the frame which is currently drawn
+SFrameStats& CNullDriver::getCurrentFrameStats()
+{
+	return FrameStats.current();
+}
+
+
+//! Returns an arena for temporary memory which is only needed during one frame
+core::irrArena* CNullDriver::getFrameArena()
+{
+	return &FrameArena;
+}
+
+
 
 //! Sets the dynamic ambient light color. The default color is
 //! (0,0,0,0) which means it is dark.
@@ -1624,6 +2106,125 @@ core::array<IImage*> CNullDriver::createImagesFromFile(io::IReadFile* file, E_TE
 	return imageArray;
 }
 
+namespace
+{
+	//! Images loaded by CNullDriver::createImagesFromFiles
+	struct SLoadImagesJob
+	{
+		CNullDriver* Driver;
+		const core::array<io::path>* Filenames;
+		ECOLOR_FORMAT Format;
+		IImage** Images;
+		bool* Opened;
+	};
+}
+
+//! loads the images of a range of files for createImagesFromFiles, run by the job system
+void CNullDriver::loadImagesJob(void* data, u32 begin, u32 end)
+{
+	SLoadImagesJob& job = *static_cast<SLoadImagesJob*>(data);
+	for (u32 i=begin; i<end; ++i)
+	{
+		io::IReadFile* file = job.Driver->FileSystem->createAndOpenFile((*job.Filenames)[i]);
+		job.Opened[i] = (file != 0);
+		if (file)
+		{
+			job.Images[i] = job.Driver->loadImageAs(file, job.Format);
+			file->drop();
+		}
+	}
+}
+
+core::array<IImage*> CNullDriver::createImagesFromFiles(const core::array<io::path>& filenames, ECOLOR_FORMAT format)
+{
+	core::array<IImage*> imageArray;
+	imageArray.set_used(filenames.size());
+	core::array<bool> opened;
+	opened.set_used(filenames.size());
+
+	for (u32 i = 0; i < filenames.size(); ++i)
+		imageArray[i] = 0;
+
+	// each file is opened and decoded on its own, so they are spread over
+	// the threads one by one
+	SLoadImagesJob job;
+	job.Driver = this;
+	job.Filenames = &filenames;
+	job.Format = format;
+	job.Images = imageArray.pointer();
+	job.Opened = opened.pointer();
+	if (JobSystem && filenames.size() > 1)
+		JobSystem->parallelFor(0, filenames.size(), loadImagesJob, &job, 1);
+	else
+		loadImagesJob(&job, 0, filenames.size());
+
+	for (u32 i = 0; i < filenames.size(); ++i)
+	{
+		if (!opened[i])
+			os::Printer::log("Could not open file of image", filenames[i], ELL_WARNING);
+	}
+
+	return imageArray;
+}
+
+
+//! Set the job system used to load several images or textures at once, can be 0
+void CNullDriver::setJobSystem(core::IJobSystem* jobSystem)
+{
+	if (jobSystem)
+		jobSystem->grab();
+	if (JobSystem)
+		JobSystem->drop();
+	JobSystem = jobSystem;
+
+	// created in the constructor
+	static_cast<scene::CMeshManipulator*>(MeshManipulator)->setJobSystem(jobSystem);
+}
+
+
+IImage* CNullDriver::loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format)
+{
+	IImage* image = 0;
+	s32 i;
+
+	// try to load file based on file extension
+	for (i = SurfaceLoader.size() - 1; i >= 0 && !image; --i)
+	{
+		if (SurfaceLoader[i]->isALoadableFileExtension(file->getFileName()))
+		{
+			file->seek(0);
+			image = SurfaceLoader[i]->loadImageAs(file, format);
+		}
+	}
+
+	// try to load file based on what is in it
+	for (i = SurfaceLoader.size() - 1; i >= 0 && !image; --i)
+	{
+		file->seek(0);
+		if (SurfaceLoader[i]->isALoadableFileFormat(file)
+			&& !SurfaceLoader[i]->isALoadableFileExtension(file->getFileName()))
+		{
+			file->seek(0);
+			image = SurfaceLoader[i]->loadImageAs(file, format);
+		}
+	}
+
+	if (!image)
+		return 0;
+
+	// loaders which can't decode to the wanted format still need a conversion
+	if (format != ECF_UNKNOWN && image->getColorFormat() != format
+		&& !IImage::isCompressedFormat(image->getColorFormat()))
+	{
+		IImage* converted = createImage(format, image->getDimension());
+		image->copyTo(converted);
+		image->drop();
+		image = converted;
+	}
+
+	return image;
+}
+
 
 //! Writes the provided image to disk file
 bool CNullDriver::writeImageToFile(IImage* image, const io::path& filename,u32 param)
@@ -1801,7 +2402,7 @@ CNullDriver::SHWBufferLink *CNullDriver::getBufferLink(const scene::IMeshBuffer*
 		return 0;
 
 	//search for hardware links
-	core::map< const scene::IMeshBuffer*,SHWBufferLink* >::Node* node = HWBufferMap.find(mb);
+	const core::hash_map< const scene::IMeshBuffer*,SHWBufferLink* >::Node* node = HWBufferMap.find(mb);
 	if (node)
 		return node->getValue();
 
@@ -1812,21 +2413,21 @@ CNullDriver::SHWBufferLink *CNullDriver::getBufferLink(const scene::IMeshBuffer*
 //! Update all hardware buffers, remove unused ones
 void CNullDriver::updateAllHardwareBuffers()
 {
-	core::map<const scene::IMeshBuffer*,SHWBufferLink*>::ParentFirstIterator Iterator=HWBufferMap.getParentFirstIterator();
+	// deleting changes the map, so collect the unused buffers first
+	core::array<SHWBufferLink*> unused;
+	core::hash_map<const scene::IMeshBuffer*,SHWBufferLink*>::Iterator Iterator=HWBufferMap.getIterator();
 
-	for (;!Iterator.atEnd();Iterator++)
+	for (;!Iterator.atEnd();++Iterator)
 	{
-		SHWBufferLink *Link=Iterator.getNode()->getValue();
+		SHWBufferLink *Link=Iterator->getValue();
 
 		Link->LastUsed++;
 		if (Link->LastUsed>20000)
-		{
-			deleteHardwareBuffer(Link);
-
-			// todo: needs better fix
-			Iterator = HWBufferMap.getParentFirstIterator();
-		}
+			unused.push_back(Link);
 	}
+
+	for (u32 i=0; i<unused.size(); ++i)
+		deleteHardwareBuffer(unused[i]);
 }
 
 
@@ -1842,7 +2443,7 @@ void CNullDriver::deleteHardwareBuffer(SHWBufferLink *HWBuffer)
 //! Remove hardware buffer
 void CNullDriver::removeHardwareBuffer(const scene::IMeshBuffer* mb)
 {
-	core::map<const scene::IMeshBuffer*,SHWBufferLink*>::Node* node = HWBufferMap.find(mb);
+	const core::hash_map<const scene::IMeshBuffer*,SHWBufferLink*>::Node* node = HWBufferMap.find(mb);
 	if (node)
 		deleteHardwareBuffer(node->getValue());
 }
@@ -1852,7 +2453,7 @@ void CNullDriver::removeHardwareBuffer(const scene::IMeshBuffer* mb)
 void CNullDriver::removeAllHardwareBuffers()
 {
 	while (HWBufferMap.size())
-		deleteHardwareBuffer(HWBufferMap.getRoot()->getValue());
+		deleteHardwareBuffer(HWBufferMap.getIterator()->getValue());
 }
 
 
@@ -2116,7 +2717,8 @@ void CNullDriver::swapMaterialRenderers(u32 idx1, u32 idx2, bool swapNames)
 io::IAttributes* CNullDriver::createAttributesFromMaterial(const video::SMaterial& material,
 	io::SAttributeReadWriteOptions* options)
 {
-	io::CAttributes* attr = new io::CAttributes(this);
+	// 29 material values plus texture and 7 layer values for each texture slot
+	io::CAttributes* attr = new io::CAttributes(this, 29+8*MATERIAL_MAX_TEXTURES);
 
 	attr->addEnum("Type", material.MaterialType, sBuiltInMaterialTypeNames);
 
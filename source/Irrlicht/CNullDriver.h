@@ -10,7 +10,7 @@
 #include "IGPUProgrammingServices.h"
 #include "irrArray.h"
 #include "irrString.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 #include "IAttributes.h"
 #include "IMesh.h"
 #include "IMeshBuffer.h"
@@ -21,6 +21,7 @@
 #include "SLight.h"
 #include "SExposedVideoData.h"
 #include "SOverrideMaterial.h"
+#include "CFrameHistory.h"
 
 #ifdef _MSC_VER
 #pragma warning( disable: 4996)
@@ -28,6 +29,10 @@
 
 namespace irr
 {
+namespace core
+{
+	class IJobSystem;
+} // end namespace core
 namespace io
 {
 	class IWriteFile;
@@ -86,6 +91,9 @@ namespace video
 		//! loads a Texture
 		virtual ITexture* getTexture(io::IReadFile* file) IRR_OVERRIDE;
 
+		//! loads several textures, decoding them on the job system
+		virtual core::array<ITexture*> getTextures(const core::array<io::path>& filenames) IRR_OVERRIDE;
+
 		//! Returns a texture by index
 		virtual ITexture* getTextureByIndex(u32 index) IRR_OVERRIDE;
 
@@ -225,6 +233,15 @@ namespace video
 		virtual void draw2DPolygon(core::position2d<s32> center,
 			f32 radius, video::SColor Color, s32 vertexCount) IRR_OVERRIDE;
 
+		//! Starts recording the 2d drawing into a batch instead of drawing it.
+		virtual bool beginRecording2D(S2DVertexBatch* batch) IRR_OVERRIDE;
+
+		//! Stops recording the 2d drawing.
+		virtual bool endRecording2D() IRR_OVERRIDE;
+
+		//! Draws recorded 2d batches.
+		virtual void draw2DVertexBatches(const S2DVertexBatch* const* batches, u32 count) IRR_OVERRIDE;
+
 		virtual void setFog(SColor color=SColor(0,255,255,255),
 				E_FOG_TYPE fogType=EFT_FOG_LINEAR,
 				f32 start=50.0f, f32 end=100.0f, f32 density=0.01f,
@@ -253,6 +270,18 @@ namespace video
 		//! very useful method for statistics.
 		virtual u32 getPrimitiveCountDrawn( u32 param = 0 ) const IRR_OVERRIDE;
 
+		//! Returns counters of a finished frame
+		virtual const SFrameStats& getFrameStats(u32 framesAgo=0) const IRR_OVERRIDE;
+
+		//! Returns how many finished frames are stored for getFrameStats()
+		virtual u32 getFrameStatsCount() const IRR_OVERRIDE;
+
+		//! Returns the counters of the frame which is currently drawn
+		virtual SFrameStats& getCurrentFrameStats() IRR_OVERRIDE;
+
+		//! Returns an arena for temporary memory which is only needed during one frame
+		virtual core::irrArena* getFrameArena() IRR_OVERRIDE;
+
 		//! deletes all dynamic lights there are
 		virtual void deleteAllDynamicLights() IRR_OVERRIDE;
 
@@ -354,6 +383,11 @@ namespace video
 
 		virtual core::array<IImage*> createImagesFromFile(io::IReadFile* file, E_TEXTURE_TYPE* type = 0) IRR_OVERRIDE;
 
+		virtual core::array<IImage*> createImagesFromFiles(const core::array<io::path>& filenames, ECOLOR_FORMAT format = ECF_UNKNOWN) IRR_OVERRIDE;
+
+		//! Set the job system used to load several images or textures at once, can be 0
+		virtual void setJobSystem(core::IJobSystem* jobSystem) IRR_OVERRIDE;
+
 		//! Creates a software image from a byte array.
 		/** \param useForeignMemory: If true, the image will use the data pointer
 		directly and own it from now on, which means it will also try to delete [] the
@@ -696,9 +730,24 @@ namespace video
 		//! deletes all textures
 		void deleteAllTextures();
 
+		//! Update TexturesByName for a texture which is no longer in the cache under its name
+		void removeTextureName(ITexture* texture);
+
 		//! opens the file and loads it into the surface
 		ITexture* loadTextureFromFile(io::IReadFile* file, const io::path& hashName = "");
 
+		//! creates the texture for the images loaded from a file
+		ITexture* createTextureFromImages(const io::path& name, const core::array<IImage*>& imageArray, E_TEXTURE_TYPE type);
+
+		//! opens and decodes the files of a range of textures for getTextures, run by the job system
+		static void loadTexturesJob(void* data, u32 begin, u32 end);
+
+		//! loads a single image from the file, converted to format unless that is ECF_UNKNOWN
+		IImage* loadImageAs(io::IReadFile* file, ECOLOR_FORMAT format);
+
+		//! loads the images of a range of files for createImagesFromFiles, run by the job system
+		static void loadImagesJob(void* data, u32 begin, u32 end);
+
 		//! adds a surface, not loaded or created by the Irrlicht Engine
 		void addTexture(ITexture* surface);
 
@@ -709,6 +758,42 @@ namespace video
 		//! checks triangle count and print warning if wrong
 		bool checkPrimitiveCount(u32 prmcnt) const;
 
+		//! records draw2DImage() while recording 2d drawing, returns false when not recording
+		bool record2DImage(const ITexture* texture, const core::position2d<s32>& destPos,
+			const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+			SColor color, bool useAlphaChannelOfTexture);
+
+		//! records draw2DImage() while recording 2d drawing, returns false when not recording
+		bool record2DImage(const ITexture* texture, const core::rect<s32>& destRect,
+			const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+			const SColor* colors, bool useAlphaChannelOfTexture);
+
+		//! records draw2DRectangle() while recording 2d drawing, returns false when not recording
+		bool record2DRectangle(const core::rect<s32>& pos,
+			SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
+			const core::rect<s32>* clip);
+
+		//! adds a quad to the recorded 2d drawing
+		/** \param colors Colors of the corners, clockwise starting with the upper left one. */
+		void record2DQuad(const ITexture* texture, const core::rect<s32>& destRect,
+			const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
+			const SColor* colors, bool useAlphaChannelOfTexture);
+
+		//! called by drawing which can't be recorded, returns true when it has to be skipped
+		bool failRecording2D()
+		{
+			if (!Recording2D)
+				return false;
+			Recording2DFailed = true;
+			return true;
+		}
+
+		//! counts material and texture changes for the frame stats, call with the material really used
+		void countMaterialChange(const SMaterial& material);
+
+		//! counts a copy of size bytes into a hardware buffer for the frame stats
+		void countHardwareBufferUpload(u32 size);
+
 		bool checkImage(const core::array<IImage*>& image) const;
 		bool checkImage(ECOLOR_FORMAT format, const core::dimension2du& size) const;
 
@@ -790,6 +875,9 @@ namespace video
 		};
 		core::array<SSurface> Textures;
 
+		//! Textures by their internal name, the first added one for duplicate names
+		core::hash_map<io::path, ITexture*> TexturesByName;
+
 		struct SOccQuery
 		{
 			SOccQuery(scene::ISceneNode* node, const scene::IMesh* mesh=0) : Node(node), Mesh(mesh), PID(0), Result(0xffffffff), Run(0xffffffff)
@@ -867,10 +955,13 @@ namespace video
 		core::array<SMaterialRenderer> MaterialRenderers;
 
 		//core::array<SHWBufferLink*> HWBufferLinks;
-		core::map< const scene::IMeshBuffer* , SHWBufferLink* > HWBufferMap;
+		core::hash_map< const scene::IMeshBuffer* , SHWBufferLink* > HWBufferMap;
 
 		io::IFileSystem* FileSystem;
 
+		//! threads loading images, 0 when the driver isn't used by a device
+		core::IJobSystem* JobSystem;
+
 		//! mesh manipulator
 		scene::IMeshManipulator* MeshManipulator;
 
@@ -883,6 +974,42 @@ namespace video
 		u32 PrimitivesDrawn;
 		u32 MinVertexCountForVBO;
 
+		CFrameHistory<SFrameStats> FrameStats;
+		SMaterial LastCountedMaterial;
+
+		//! Memory for temporary arrays, reset in beginScene
+		core::irrArena FrameArena;
+
+		//! Quads of a recorded batch which are drawn in a group
+		struct S2DBatchRun
+		{
+			const S3DVertex* Vertices;
+			u32 VertexCount;
+			s32 Next;
+		};
+
+		//! Runs of recorded batches drawn together by draw2DVertexBatches()
+		struct S2DBatchGroup
+		{
+			ITexture* Texture;
+			u32 AlphaSource;
+			core::rect<s32> Area;
+			s32 FirstRun;
+			s32 LastRun;
+		};
+
+		//! Batch receiving the 2d drawing while recording, 0 otherwise
+		S2DVertexBatch* Recording2D;
+		bool Recording2DFailed;
+
+		//! Set by drivers which record in their 2d drawing and can draw the batches
+		bool CanRecord2D;
+
+		core::array<S2DBatchRun> Batch2DRuns;
+		core::array<S2DBatchGroup> Batch2DGroups;
+		core::array<S3DVertex> Batch2DVertices;
+		core::array<u16> Batch2DIndices;
+
 		u32 TextureCreationFlags;
 
 		f32 FogStart;
@@ -571,6 +571,8 @@ COGLES2Driver::~COGLES2Driver()
 				glBufferData(GL_ARRAY_BUFFER, vertexCount * vertexSize, buffer.const_pointer(), GL_DYNAMIC_DRAW);
 		}
 
+		countHardwareBufferUpload(vertexCount * vertexSize);
+
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 		return (!testGLError(__LINE__));
@@ -636,6 +638,8 @@ COGLES2Driver::~COGLES2Driver()
 				glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * indexSize, indices, GL_DYNAMIC_DRAW);
 		}
 
+		countHardwareBufferUpload(indexCount * indexSize);
+
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 		return (!testGLError(__LINE__));
@@ -1219,8 +1223,10 @@ COGLES2Driver::~COGLES2Driver()
 
 		const irr::u32 drawCount = core::min_<u32>(positions.size(), sourceRects.size());
 
-		core::array<S3DVertex> vtx(drawCount * 4);
-		core::array<u16> indices(drawCount * 6);
+		typedef core::irrArenaAllocator<S3DVertex> TVertexAlloc;
+		typedef core::irrArenaAllocator<u16> TIndexAlloc;
+		core::array<S3DVertex, TVertexAlloc> vtx(TVertexAlloc(&FrameArena), drawCount * 4);
+		core::array<u16, TIndexAlloc> indices(TIndexAlloc(&FrameArena), drawCount * 6);
 
 		for (u32 i = 0; i < drawCount; i++)
 		{
@@ -1403,10 +1409,10 @@ COGLES2Driver::~COGLES2Driver()
 		const f32 invW = 1.f / static_cast<f32>(ss.Width);
 		const f32 invH = 1.f / static_cast<f32>(ss.Height);
 
-		core::array<S3DVertex> vertices;
-		core::array<u16> quadIndices;
-		vertices.reallocate(indices.size()*4);
-		quadIndices.reallocate(indices.size()*3);
+		typedef core::irrArenaAllocator<S3DVertex> TVertexAlloc;
+		typedef core::irrArenaAllocator<u16> TIndexAlloc;
+		core::array<S3DVertex, TVertexAlloc> vertices(TVertexAlloc(&FrameArena), indices.size()*4);
+		core::array<u16, TIndexAlloc> quadIndices(TIndexAlloc(&FrameArena), indices.size()*3);
 
 		for (u32 i = 0; i < indices.size(); ++i)
 		{
@@ -1642,6 +1648,7 @@ COGLES2Driver::~COGLES2Driver()
 	{
 		Material = material;
 		OverrideMaterial.apply(Material);
+		countMaterialChange(Material);
 
 		for (u32 i = 0; i < Feature.MaxTextureUnits; ++i)
 		{
@@ -412,6 +412,8 @@ bool COGLES1Driver::updateVertexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 			glBufferData(GL_ARRAY_BUFFER, vertexCount * vertexSize, buffer.const_pointer(), GL_DYNAMIC_DRAW);
 	}
 
+	countHardwareBufferUpload(vertexCount * vertexSize);
+
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	return (!testGLError(__LINE__));
@@ -476,6 +478,8 @@ bool COGLES1Driver::updateIndexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * indexSize, indices, GL_DYNAMIC_DRAW);
 	}
 
+	countHardwareBufferUpload(indexCount * indexSize);
+
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	return (!testGLError(__LINE__));
@@ -1164,10 +1168,10 @@ void COGLES1Driver::draw2DImageBatch(const video::ITexture* texture,
 	const f32 invW = 1.f / static_cast<f32>(ss.Width);
 	const f32 invH = 1.f / static_cast<f32>(ss.Height);
 
-	core::array<S3DVertex> vertices;
-	core::array<u16> quadIndices;
-	vertices.reallocate(indices.size()*4);
-	quadIndices.reallocate(indices.size()*6);
+	typedef core::irrArenaAllocator<S3DVertex> TVertexAlloc;
+	typedef core::irrArenaAllocator<u16> TIndexAlloc;
+	core::array<S3DVertex, TVertexAlloc> vertices(TVertexAlloc(&FrameArena), indices.size()*4);
+	core::array<u16, TIndexAlloc> quadIndices(TIndexAlloc(&FrameArena), indices.size()*6);
 	for (u32 i=0; i<indices.size(); ++i)
 	{
 		const s32 currentIndex = indices[i];
@@ -1235,10 +1239,10 @@ void COGLES1Driver::draw2DImageBatch(const video::ITexture* texture,
 
 	setRenderStates2DMode(color.getAlpha()<255, true, useAlphaChannelOfTexture);
 
-	core::array<S3DVertex> vertices;
-	core::array<u16> quadIndices;
-	vertices.reallocate(drawCount*4);
-	quadIndices.reallocate(drawCount*6);
+	typedef core::irrArenaAllocator<S3DVertex> TVertexAlloc;
+	typedef core::irrArenaAllocator<u16> TIndexAlloc;
+	core::array<S3DVertex, TVertexAlloc> vertices(TVertexAlloc(&FrameArena), drawCount*4);
+	core::array<u16, TIndexAlloc> quadIndices(TIndexAlloc(&FrameArena), drawCount*6);
 
 	for (u32 i=0; i<drawCount; ++i)
 	{
@@ -1490,6 +1494,7 @@ void COGLES1Driver::setMaterial(const SMaterial& material)
 {
 	Material = material;
 	OverrideMaterial.apply(Material);
+	countMaterialChange(Material);
 
 	for (u32 i = 0; i < Feature.MaxTextureUnits; ++i)
 		setTransform((E_TRANSFORMATION_STATE)(ETS_TEXTURE_0 + i), material.getTextureMatrix(i));
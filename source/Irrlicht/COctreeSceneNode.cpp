@@ -101,31 +101,42 @@ void COctreeSceneNode::OnRegisterSceneNode()
 }
 
 template <class VT>
-void renderMeshBuffer(video::IVideoDriver* driver, EOCTREENODE_VBO useVBO, typename Octree<VT>::SMeshChunk& meshChunk, const typename Octree<VT>::SIndexData& indexData)
+void renderMeshBuffer(video::IVideoDriver* driver, EOCTREENODE_VBO useVBO, typename Octree<VT>::SMeshChunk& meshChunk, const Octree<VT>& octree, u32 index)
 {
+	const typename Octree<VT>::SIndexData& indexData = octree.getIndexData()[index];
+
 	switch ( useVBO )
 	{
 		case EOV_NO_VBO:
+			// a single visible range is drawn directly from the sorted indices of the tree,
+			// several ranges are joined in the chunk only when they changed
+			if (indexData.Ranges.size() == 1)
+			{
+				driver->drawIndexedTriangleList(
+					&meshChunk.Vertices[0],
+					meshChunk.Vertices.size(),
+					indexData.Indices + indexData.Ranges[0].Offset, indexData.CurrentSize / 3);
+				break;
+			}
+			if (indexData.Changed)
+				octree.copyVisibleIndices(index, meshChunk.Indices);
 			driver->drawIndexedTriangleList(
 				&meshChunk.Vertices[0],
 				meshChunk.Vertices.size(),
-				indexData.Indices, indexData.CurrentSize / 3);
-				break;
+				meshChunk.Indices.const_pointer(), meshChunk.Indices.size() / 3);
+			break;
 		case EOV_USE_VBO:
 			driver->drawMeshBuffer ( &meshChunk );
 			break;
 		case EOV_USE_VBO_WITH_VISIBITLY:
-		{
-			u16* oldPointer = meshChunk.Indices.pointer();
-			const u32 oldSize = meshChunk.Indices.size();
-			meshChunk.Indices.set_free_when_destroyed(false);
-			meshChunk.Indices.set_pointer(indexData.Indices, indexData.CurrentSize, false, false);
-			meshChunk.setDirty(scene::EBT_INDEX);
+			// the index buffer is only uploaded again when other parts became visible
+			if (indexData.Changed)
+			{
+				octree.copyVisibleIndices(index, meshChunk.Indices);
+				meshChunk.setDirty(scene::EBT_INDEX);
+			}
 			driver->drawMeshBuffer ( &meshChunk );
-			meshChunk.Indices.set_pointer(oldPointer, oldSize);
-			meshChunk.setDirty(scene::EBT_INDEX);
 			break;
-		}
 	}
 }
 
@@ -162,21 +173,26 @@ void COctreeSceneNode::render()
 
 	const core::aabbox3d<float> &box = frust.getBoundingBox();
 
+	// the visible ranges are calculated once per frame for all render passes
+
 	switch (VertexType)
 	{
 	case video::EVT_STANDARD:
 		{
-			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
+			if (PassCount == 1)
 			{
-				case EOPC_BOX:
-					StdOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					StdOctree->calculatePolys(frust);
-					break;
+				IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
+				switch ( PolygonChecks )
+				{
+					case EOPC_BOX:
+						StdOctree->calculatePolys(box);
+						break;
+					case EOPC_FRUSTUM:
+						StdOctree->calculatePolys(frust);
+						break;
+				}
+				IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 			}
-			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertex>::SIndexData* d = StdOctree->getIndexData();
 
@@ -192,24 +208,27 @@ void COctreeSceneNode::render()
 				if (transparent == isTransparentPass)
 				{
 					driver->setMaterial(Materials[i]);
-					renderMeshBuffer<video::S3DVertex>(driver, UseVBOs, StdMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertex>(driver, UseVBOs, StdMeshes[i], *StdOctree, i);
 				}
 			}
 		}
 		break;
 	case video::EVT_2TCOORDS:
 		{
-			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
+			if (PassCount == 1)
 			{
-				case EOPC_BOX:
-					LightMapOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					LightMapOctree->calculatePolys(frust);
-					break;
+				IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
+				switch ( PolygonChecks )
+				{
+					case EOPC_BOX:
+						LightMapOctree->calculatePolys(box);
+						break;
+					case EOPC_FRUSTUM:
+						LightMapOctree->calculatePolys(frust);
+						break;
+				}
+				IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 			}
-			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertex2TCoords>::SIndexData* d = LightMapOctree->getIndexData();
 
@@ -227,24 +246,27 @@ void COctreeSceneNode::render()
 				{
 					driver->setMaterial(Materials[i]);
 
-					renderMeshBuffer<video::S3DVertex2TCoords>(driver, UseVBOs, LightMapMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertex2TCoords>(driver, UseVBOs, LightMapMeshes[i], *LightMapOctree, i);
 				}
 			}
 		}
 		break;
 	case video::EVT_TANGENTS:
 		{
-			IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
-			switch ( PolygonChecks )
+			if (PassCount == 1)
 			{
-				case EOPC_BOX:
-					TangentsOctree->calculatePolys(box);
-					break;
-				case EOPC_FRUSTUM:
-					TangentsOctree->calculatePolys(frust);
-					break;
+				IRR_PROFILE(getProfiler().start(EPID_OC_CALCPOLYS));
+				switch ( PolygonChecks )
+				{
+					case EOPC_BOX:
+						TangentsOctree->calculatePolys(box);
+						break;
+					case EOPC_FRUSTUM:
+						TangentsOctree->calculatePolys(frust);
+						break;
+				}
+				IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 			}
-			IRR_PROFILE(getProfiler().stop(EPID_OC_CALCPOLYS));
 
 			const Octree<video::S3DVertexTangents>::SIndexData* d =  TangentsOctree->getIndexData();
 
@@ -261,7 +283,7 @@ void COctreeSceneNode::render()
 				if (transparent == isTransparentPass)
 				{
 					driver->setMaterial(Materials[i]);
-					renderMeshBuffer<video::S3DVertexTangents>(driver, UseVBOs, TangentsMeshes[i], d[i]);
+					renderMeshBuffer<video::S3DVertexTangents>(driver, UseVBOs, TangentsMeshes[i], *TangentsOctree, i);
 				}
 			}
 		}
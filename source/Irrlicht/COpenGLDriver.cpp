@@ -48,6 +48,9 @@ COpenGLDriver::COpenGLDriver(const SIrrlichtCreationParameters& params, io::IFil
 #ifdef _DEBUG
 	setDebugName("COpenGLDriver");
 #endif
+
+	// the 2d drawing can be recorded into batches, see beginRecording2D
+	CanRecord2D = true;
 }
 #endif
 
@@ -62,6 +65,9 @@ COpenGLDriver::COpenGLDriver(const SIrrlichtCreationParameters& params, io::IFil
 	setDebugName("COpenGLDriver");
 #endif
 
+	// the 2d drawing can be recorded into batches, see beginRecording2D
+	CanRecord2D = true;
+
 	ExposedData.OpenGLSDL.Window = device->getWindow();
 	ExposedData.OpenGLSDL.Context = device->getContext();
 
@@ -468,6 +474,8 @@ bool COpenGLDriver::updateVertexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 			extGlBufferData(GL_ARRAY_BUFFER, vertexCount * vertexSize, vbuf, GL_STREAM_DRAW);
 	}
 
+	countHardwareBufferUpload(vertexCount * vertexSize);
+
 	extGlBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	return (!testGLError(__LINE__));
@@ -542,6 +550,8 @@ bool COpenGLDriver::updateIndexHardwareBuffer(SHWBufferLink_opengl *HWBuffer)
 			extGlBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * indexSize, indices, GL_STREAM_DRAW);
 	}
 
+	countHardwareBufferUpload(indexCount * indexSize);
+
 	extGlBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	return (!testGLError(__LINE__));
@@ -648,6 +658,9 @@ void COpenGLDriver::deleteHardwareBuffer(SHWBufferLink *_HWBuffer)
 //! Draw hardware buffer
 void COpenGLDriver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 {
+	if (failRecording2D())
+		return;
+
 	if (!_HWBuffer)
 		return;
 
@@ -820,6 +833,9 @@ void COpenGLDriver::drawVertexPrimitiveList(const void* vertices, u32 vertexCoun
 		const void* indexList, u32 primitiveCount,
 		E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType, E_INDEX_TYPE iType)
 {
+	if (failRecording2D())
+		return;
+
 	if (!primitiveCount || !vertexCount)
 		return;
 
@@ -1136,6 +1152,9 @@ void COpenGLDriver::draw2DVertexPrimitiveList(const void* vertices, u32 vertexCo
 		const void* indexList, u32 primitiveCount,
 		E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType, E_INDEX_TYPE iType)
 {
+	if (failRecording2D())
+		return;
+
 	if (!primitiveCount || !vertexCount)
 		return;
 
@@ -1280,6 +1299,9 @@ void COpenGLDriver::draw2DImage(const video::ITexture* texture, const core::posi
 	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect, SColor color,
 	bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destPos, sourceRect, clipRect, color, useAlphaChannelOfTexture))
+		return;
+
 	if (!texture)
 		return;
 
@@ -1363,6 +1385,9 @@ void COpenGLDriver::draw2DImage(const video::ITexture* texture, const core::rect
 	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
 	const video::SColor* const colors, bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destRect, sourceRect, clipRect, colors, useAlphaChannelOfTexture))
+		return;
+
 	if (!texture)
 		return;
 
@@ -1448,6 +1473,9 @@ void COpenGLDriver::draw2DImage(const video::ITexture* texture, const core::rect
 
 void COpenGLDriver::draw2DImageQuad(const video::ITexture* texture, u32 layer, bool flip)
 {
+	if (failRecording2D())
+		return;
+
 	if (!texture || !CacheHandler->getTextureCache().set(0, texture))
 		return;
 
@@ -1562,6 +1590,12 @@ void COpenGLDriver::draw2DImageBatch(const video::ITexture* texture,
 				SColor color,
 				bool useAlphaChannelOfTexture)
 {
+	if (Recording2D)
+	{
+		CNullDriver::draw2DImageBatch(texture, positions, sourceRects, clipRect, color, useAlphaChannelOfTexture);
+		return;
+	}
+
 	if (!texture)
 		return;
 
@@ -1724,6 +1758,12 @@ void COpenGLDriver::draw2DImageBatch(const video::ITexture* texture,
 				const core::rect<s32>* clipRect, SColor color,
 				bool useAlphaChannelOfTexture)
 {
+	if (Recording2D)
+	{
+		CNullDriver::draw2DImageBatch(texture, pos, sourceRects, indices, kerningWidth, clipRect, color, useAlphaChannelOfTexture);
+		return;
+	}
+
 	if (!texture)
 		return;
 
@@ -1812,6 +1852,9 @@ void COpenGLDriver::draw2DImageBatch(const video::ITexture* texture,
 void COpenGLDriver::draw2DRectangle(SColor color, const core::rect<s32>& position,
 		const core::rect<s32>* clip)
 {
+	if (record2DRectangle(position, color, color, color, color, clip))
+		return;
+
 	disableTextures();
 	setRenderStates2DMode(color.getAlpha() < 255, false, false);
 
@@ -1834,6 +1877,9 @@ void COpenGLDriver::draw2DRectangle(const core::rect<s32>& position,
 			SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
 			const core::rect<s32>* clip)
 {
+	if (record2DRectangle(position, colorLeftUp, colorRightUp, colorLeftDown, colorRightDown, clip))
+		return;
+
 	core::rect<s32> pos = position;
 
 	if (clip)
@@ -1887,6 +1933,9 @@ void COpenGLDriver::draw2DRectangle(const core::rect<s32>& position,
 void COpenGLDriver::draw2DLine(const core::position2d<s32>& start,
 				const core::position2d<s32>& end, SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	// TODO: It's not pixel-exact. Reason is the way OpenGL handles line-drawing (search the web for "diamond exit rule").
 
 	if (start==end)
@@ -1929,6 +1978,9 @@ void COpenGLDriver::draw2DLine(const core::position2d<s32>& start,
 //! Draws a pixel
 void COpenGLDriver::drawPixel(u32 x, u32 y, const SColor &color)
 {
+	if (failRecording2D())
+		return;
+
 	const core::dimension2d<u32>& renderTargetSize = getCurrentRenderTargetSize();
 	if (x > (u32)renderTargetSize.Width || y > (u32)renderTargetSize.Height)
 		return;
@@ -2042,6 +2094,7 @@ void COpenGLDriver::setMaterial(const SMaterial& material)
 {
 	Material = material;
 	OverrideMaterial.apply(Material);
+	countMaterialChange(Material);
 
 	for (u32 i = 0; i < Feature.MaxTextureUnits; ++i)
 	{
@@ -3244,6 +3297,9 @@ void COpenGLDriver::setViewPort(const core::rect<s32>& area)
 //! volume. Next use IVideoDriver::drawStencilShadow() to visualize the shadow.
 void COpenGLDriver::drawStencilShadowVolume(const core::array<core::vector3df>& triangles, bool zfail, u32 debugDataVisible)
 {
+	if (failRecording2D())
+		return;
+
 	const u32 count=triangles.size();
 	if (!StencilBuffer || !count)
 		return;
@@ -3394,6 +3450,9 @@ void COpenGLDriver::drawStencilShadowVolume(const core::array<core::vector3df>&
 void COpenGLDriver::drawStencilShadow(bool clearStencilBuffer, video::SColor leftUpEdge,
 	video::SColor rightUpEdge, video::SColor leftDownEdge, video::SColor rightDownEdge)
 {
+	if (failRecording2D())
+		return;
+
 	if (!StencilBuffer)
 		return;
 
@@ -3510,6 +3569,9 @@ void COpenGLDriver::setFog(SColor c, E_FOG_TYPE fogType, f32 start,
 //! Draws a 3d box.
 void COpenGLDriver::draw3DBox( const core::aabbox3d<f32>& box, SColor color )
 {
+	if (failRecording2D())
+		return;
+
 	core::vector3df edges[8];
 	box.getEdges(edges);
 
@@ -3573,6 +3635,9 @@ void COpenGLDriver::draw3DBox( const core::aabbox3d<f32>& box, SColor color )
 void COpenGLDriver::draw3DLine(const core::vector3df& start,
 				const core::vector3df& end, SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	setRenderStates3DMode();
 
 	Quad2DVertices[0].Color = color;
@@ -3936,6 +4001,9 @@ bool COpenGLDriver::setRenderTargetEx(IRenderTarget* target, u16 clearFlag, SCol
 
 void COpenGLDriver::clearBuffers(u16 flag, SColor color, f32 depth, u8 stencil)
 {
+	if (failRecording2D())
+		return;
+
 	GLbitfield mask = 0;
 	u8 colorMask = 0;
 	bool depthMask = false;
@@ -436,11 +436,10 @@ void CParticleSystemSceneNode::doParticleSystem(u32 time)
 			s32 j=Particles.size();
 			if (newParticles > 16250-j)	// avoid having more than 64k vertices in the scenenode
 				newParticles=16250-j;
-			Particles.set_used(j+newParticles);
+			// grows like push_back, so the array is not reallocated each frame while the particles get more
+			Particles.insert_range(array, newParticles, j);
 			for (s32 i=j; i<j+newParticles; ++i)
 			{
-				Particles[i]=array[i-j];
-
 				if ( ParticlesAreGlobal && behavior & EPB_EMITTER_FRAME_INTERPOLATION )
 				{
 					// Interpolate between current node transformations and last ones.
@@ -523,6 +522,7 @@ void CParticleSystemSceneNode::doParticleSystem(u32 time)
 				++i;
 			}
 		}
+		SceneManager->getCurrentFrameStats().ParticlesSimulated += Particles.size();
 	}
 
 	const f32 m = (ParticleSize.Width > ParticleSize.Height ? ParticleSize.Width : ParticleSize.Height) * 0.5f;
@@ -588,8 +588,12 @@ void CParticleSystemSceneNode::reallocateBuffers()
 	if (Particles.size() * 4 > Buffer->getVertexCount() ||
 			Particles.size() * 6 > Buffer->getIndexCount())
 	{
+		// make room for as many particles as the particle array has, it only
+		// grows from time to time, so the buffers don't grow each frame either
+		const u32 particleCount = core::max_(Particles.size(), core::min_(Particles.allocated_size(), (u32)16250));
+
 		u32 oldSize = Buffer->getVertexCount();
-		Buffer->Vertices.set_used(Particles.size() * 4);
+		Buffer->Vertices.set_used(particleCount * 4);
 
 		u32 i;
 
@@ -605,7 +609,7 @@ void CParticleSystemSceneNode::reallocateBuffers()
 		// fill remaining indices
 		u32 oldIdxSize = Buffer->getIndexCount();
 		u32 oldvertices = oldSize;
-		Buffer->Indices.set_used(Particles.size() * 6);
+		Buffer->Indices.set_used(particleCount * 6);
 
 		for (i=oldIdxSize; i<Buffer->Indices.size(); i+=6)
 		{
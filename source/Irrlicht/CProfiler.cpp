@@ -6,6 +6,13 @@
 #include "IrrCompileConfig.h"
 #include "CTimer.h"
 
+#if defined(_IRR_WINDOWS_API_)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#elif defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	#include <pthread.h>
+#endif
+
 namespace irr
 {
 IRRLICHT_API IProfiler& IRRCALLCONV getProfiler()
@@ -17,6 +24,7 @@ IRRLICHT_API IProfiler& IRRCALLCONV getProfiler()
 CProfiler::CProfiler()
 {
 	Timer = new CTimer(true);
+	ProfilingThread = getTraceThreadId();
 
 	addGroup(L"overview");
 }
@@ -80,9 +88,11 @@ core::stringw CProfiler::getAsString(const SProfileData& data) const
 		// Can't use swprintf as it fails on some platforms (especially mobile platforms)
 		// Can't use Irrlicht functions because we have no string formatting.
 		char dummy[1023];
-		sprintf(dummy, "%-15.15s%-12u%-12u%-12u%-12u",
-			core::stringc(data.getName()).c_str(), data.getCallsCounter(), data.getTimeSum(),
-			data.getTimeSum() / data.getCallsCounter(), data.getLongestTime());
+		const f64 timeSum = data.getTimeSumNanoseconds() / 1000000.0;
+		sprintf(dummy, "%-15.15s%-12u%-12.3f%-12.3f%-12.3f%-12.3f",
+			core::stringc(data.getName()).c_str(), data.getCallsCounter(), timeSum,
+			timeSum / data.getCallsCounter(), data.getPercentileTime(0.95f) / 1000000.0,
+			data.getLongestTimeNanoseconds() / 1000000.0);
 		dummy[1022] = 0;
 
 		return core::stringw(dummy);
@@ -99,7 +109,92 @@ core::stringw CProfiler::getAsString(const SProfileData& data) const
 //! Return a string which describes the columns returned by getAsString
 core::stringw CProfiler::makeTitleString() const
 {
-	return core::stringw("name           calls       time(sum)   time(avg)   time(max)");
+	return core::stringw("name           calls       time(sum)   time(avg)   time(p95)   time(max)");
+}
+
+//! Write the recorded events in the Chrome trace event format (JSON)
+void CProfiler::printTrace(core::stringc &ostream) const
+{
+	u32 firstEvent;
+	const u32 eventCount = getTraceEventCount(firstEvent);
+
+	// strings grow only as much as needed, so reserve enough for usual names
+	ostream.reserve(ostream.size() + 128 * (eventCount + 1));
+	ostream += "{\"traceEvents\":[";
+
+	// Once the buffer got full the oldest events are overwritten, so the
+	// first stop events might miss their start. Those are skipped.
+	// Starts and stops are matched for each thread.
+	core::array<u64> runningIds;
+	bool first = true;
+	u64 startTime = eventCount > 0 ? TraceEvents[firstEvent].Time : 0;
+	for ( u32 i=0; i<eventCount; ++i )
+	{
+		// threads add their events in parallel, so the order of the times can differ a little
+		const u64 time = TraceEvents[(firstEvent + i) % TraceEvents.size()].Time;
+		if ( time < startTime )
+			startTime = time;
+	}
+	for ( u32 i=0; i<eventCount; ++i )
+	{
+		const SProfileEvent& e = TraceEvents[(firstEvent + i) % TraceEvents.size()];
+		const u64 threadId = ((u64)e.Thread << 32) | (u32)e.Id;
+		if ( e.Start )
+			runningIds.push_back(threadId);
+		else
+		{
+			const s32 running = runningIds.linear_reverse_search(threadId);
+			if ( running < 0 )
+				continue;
+			runningIds.erase(running);
+		}
+
+		const SProfileData* data = getProfileDataById(e.Id);
+		if ( !data )
+			continue;
+
+		core::stringc name(data->getName());
+		name.replace('"', '\'');
+		name.replace('\\', '/');
+		core::stringc group(ProfileGroups[data->getGroupIndex()].getName());
+		group.replace('"', '\'');
+		group.replace('\\', '/');
+
+		// the trace format uses microseconds
+#ifdef _MSC_VER
+#pragma warning(disable:4996)	// 'sprintf' was declared deprecated
+#endif
+		char dummy[64];
+		sprintf(dummy, "%.3f,\"pid\":1,\"tid\":%u}", (e.Time - startTime) / 1000.0, e.Thread);
+#ifdef _MSC_VER
+#pragma warning(default :4996)	// 'sprintf' was declared deprecated
+#endif
+
+		if ( !first )
+			ostream += ",";
+		first = false;
+		ostream += "\n{\"name\":\"";
+		ostream += name;
+		ostream += "\",\"cat\":\"";
+		ostream += group;
+		ostream += e.Start ? "\",\"ph\":\"B\",\"ts\":" : "\",\"ph\":\"E\",\"ts\":";
+		ostream += dummy;
+	}
+
+	ostream += "\n]}\n";
+}
+
+//! Id of the calling thread for the trace events
+u32 CProfiler::getTraceThreadId() const
+{
+#if defined(_IRR_WINDOWS_API_)
+	return (u32)GetCurrentThreadId();
+#elif defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+	// only used to tell threads apart, the lower bits differ between threads
+	return (u32)(size_t)pthread_self();
+#else
+	return 1;
+#endif
 }
 
 } // namespace irr
@@ -22,7 +22,13 @@ public:
 	//! Write the profile data of one group into a string
     virtual void printGroup(core::stringw &result, u32 groupIndex, bool suppressUncalled) const  IRR_OVERRIDE;
 
+	//! Write the recorded events in the Chrome trace event format (JSON)
+	virtual void printTrace(core::stringc &result) const IRR_OVERRIDE;
+
 protected:
+	//! Id of the calling thread for the trace events
+	virtual u32 getTraceThreadId() const IRR_OVERRIDE;
+
 	core::stringw makeTitleString() const;
 	core::stringw getAsString(const SProfileData& data) const;
 };
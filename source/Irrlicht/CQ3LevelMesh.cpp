@@ -36,6 +36,10 @@ CQ3LevelMesh::CQ3LevelMesh(io::IFileSystem* fs, scene::ISceneManager* smgr,
 	IReferenceCounted::setDebugName("CQ3LevelMesh");
 	#endif
 
+	VisData.numOfClusters = 0;
+	VisData.bytesPerCluster = 0;
+	VisData.pBitsets = 0;
+
 	for ( s32 i = 0; i!= E_Q3_MESH_SIZE; ++i )
 	{
 		Mesh[i] = 0;
@@ -57,6 +61,7 @@ CQ3LevelMesh::CQ3LevelMesh(io::IFileSystem* fs, scene::ISceneManager* smgr,
 CQ3LevelMesh::~CQ3LevelMesh()
 {
 	cleanLoader ();
+	cleanBSP ();
 
 	if (Driver)
 		Driver->drop();
@@ -159,6 +164,7 @@ bool CQ3LevelMesh::loadFile(io::IReadFile* file)
 	solveTJunction();
 
 	cleanMeshes();
+	resolveFaces();
 	calcBoundingBoxes();
 	cleanLoader();
 
@@ -174,8 +180,6 @@ void CQ3LevelMesh::cleanLoader ()
 	delete [] Vertices; Vertices = 0;
 	delete [] Faces; Faces = 0;
 	delete [] Models; Models = 0;
-	delete [] Planes; Planes = 0;
-	delete [] Nodes; Nodes = 0;
 	delete [] Leafs; Leafs = 0;
 	delete [] LeafFaces; LeafFaces = 0;
 	delete [] MeshVerts; MeshVerts = 0;
@@ -183,6 +187,21 @@ void CQ3LevelMesh::cleanLoader ()
 
 	Lightmap.clear();
 	Tex.clear();
+	FaceBuffers.clear();
+}
+
+/*!
+	the planes, nodes and the visibility data are needed after loading
+*/
+void CQ3LevelMesh::cleanBSP ()
+{
+	delete [] Planes; Planes = 0;
+	NumPlanes = 0;
+	delete [] Nodes; Nodes = 0;
+	NumNodes = 0;
+	delete [] VisData.pBitsets; VisData.pBitsets = 0;
+	VisData.numOfClusters = 0;
+	VisData.bytesPerCluster = 0;
 }
 
 //! returns the amount of frames in milliseconds. If the amount is 1, it is a static (=non animated) mesh.
@@ -312,7 +331,24 @@ void CQ3LevelMesh::loadFaces(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadPlanes(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumPlanes = l->length / sizeof(tBSPPlane);
+	if ( !NumPlanes )
+		return;
+	Planes = new tBSPPlane[NumPlanes];
+
+	file->seek(l->offset);
+	file->read(Planes, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for ( s32 i=0;i<NumPlanes;i++)
+		{
+			Planes[i].vNormal[0] = os::Byteswap::byteswap(Planes[i].vNormal[0]);
+			Planes[i].vNormal[1] = os::Byteswap::byteswap(Planes[i].vNormal[1]);
+			Planes[i].vNormal[2] = os::Byteswap::byteswap(Planes[i].vNormal[2]);
+			Planes[i].d = os::Byteswap::byteswap(Planes[i].d);
+		}
+	}
 }
 
 
@@ -320,7 +356,28 @@ void CQ3LevelMesh::loadPlanes(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadNodes(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumNodes = l->length / sizeof(tBSPNode);
+	if ( !NumNodes )
+		return;
+	Nodes = new tBSPNode[NumNodes];
+
+	file->seek(l->offset);
+	file->read(Nodes, l->length);
+
+	if ( LoadParam.swapHeader )
+	{
+		for ( s32 i=0;i<NumNodes;i++)
+		{
+			Nodes[i].plane = os::Byteswap::byteswap(Nodes[i].plane);
+			Nodes[i].front = os::Byteswap::byteswap(Nodes[i].front);
+			Nodes[i].back = os::Byteswap::byteswap(Nodes[i].back);
+			for ( u32 j=0; j<3; ++j )
+			{
+				Nodes[i].mins[j] = os::Byteswap::byteswap(Nodes[i].mins[j]);
+				Nodes[i].maxs[j] = os::Byteswap::byteswap(Nodes[i].maxs[j]);
+			}
+		}
+	}
 }
 
 
@@ -328,7 +385,43 @@ void CQ3LevelMesh::loadNodes(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadLeafs(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumLeafs = l->length / sizeof(tBSPLeaf);
+	if ( !NumLeafs )
+		return;
+	Leafs = new tBSPLeaf[NumLeafs];
+
+	file->seek(l->offset);
+	file->read(Leafs, l->length);
+
+	BSPLeafs.reallocate(NumLeafs);
+	for ( s32 i=0;i<NumLeafs;i++)
+	{
+		tBSPLeaf& leaf = Leafs[i];
+		if ( LoadParam.swapHeader )
+		{
+			leaf.cluster = os::Byteswap::byteswap(leaf.cluster);
+			leaf.area = os::Byteswap::byteswap(leaf.area);
+			for ( u32 j=0; j<3; ++j )
+			{
+				leaf.mins[j] = os::Byteswap::byteswap(leaf.mins[j]);
+				leaf.maxs[j] = os::Byteswap::byteswap(leaf.maxs[j]);
+			}
+			leaf.leafface = os::Byteswap::byteswap(leaf.leafface);
+			leaf.numOfLeafFaces = os::Byteswap::byteswap(leaf.numOfLeafFaces);
+			leaf.leafBrush = os::Byteswap::byteswap(leaf.leafBrush);
+			leaf.numOfLeafBrushes = os::Byteswap::byteswap(leaf.numOfLeafBrushes);
+		}
+
+		// same swap of y and z as for the vertices
+		SBSPLeaf bspLeaf;
+		bspLeaf.Cluster = leaf.cluster;
+		bspLeaf.BoundingBox.MinEdge.set( (f32) leaf.mins[0], (f32) leaf.mins[2], (f32) leaf.mins[1] );
+		bspLeaf.BoundingBox.MaxEdge.set( (f32) leaf.maxs[0], (f32) leaf.maxs[2], (f32) leaf.maxs[1] );
+		bspLeaf.BoundingBox.repair();
+		bspLeaf.FirstLeafFace = leaf.numOfLeafFaces > 0 ? leaf.leafface : 0;
+		bspLeaf.LeafFaceCount = leaf.numOfLeafFaces > 0 ? leaf.numOfLeafFaces : 0;
+		BSPLeafs.push_back(bspLeaf);
+	}
 }
 
 
@@ -336,7 +429,21 @@ void CQ3LevelMesh::loadLeafs(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadLeafFaces(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	NumLeafFaces = l->length / sizeof(s32);
+	if ( !NumLeafFaces )
+		return;
+	LeafFaces = new s32[NumLeafFaces];
+
+	file->seek(l->offset);
+	file->read(LeafFaces, l->length);
+
+	BSPLeafFaces.reallocate(NumLeafFaces);
+	for ( s32 i=0;i<NumLeafFaces;i++)
+	{
+		if ( LoadParam.swapHeader )
+			LeafFaces[i] = os::Byteswap::byteswap(LeafFaces[i]);
+		BSPLeafFaces.push_back( LeafFaces[i] );
+	}
 }
 
 
@@ -344,7 +451,29 @@ void CQ3LevelMesh::loadLeafFaces(tBSPLump* l, io::IReadFile* file)
 */
 void CQ3LevelMesh::loadVisData(tBSPLump* l, io::IReadFile* file)
 {
-	// ignore
+	if ( l->length < 8 )
+		return;
+
+	file->seek(l->offset);
+	file->read(&VisData.numOfClusters, sizeof(s32));
+	file->read(&VisData.bytesPerCluster, sizeof(s32));
+
+	if ( LoadParam.swapHeader )
+	{
+		VisData.numOfClusters = os::Byteswap::byteswap(VisData.numOfClusters);
+		VisData.bytesPerCluster = os::Byteswap::byteswap(VisData.bytesPerCluster);
+	}
+
+	const s32 size = VisData.numOfClusters * VisData.bytesPerCluster;
+	if ( VisData.numOfClusters <= 0 || VisData.bytesPerCluster <= 0 || size > l->length - 8 )
+	{
+		VisData.numOfClusters = 0;
+		VisData.bytesPerCluster = 0;
+		return;
+	}
+
+	VisData.pBitsets = new c8[size];
+	file->read(VisData.pBitsets, size);
 }
 
 
@@ -963,6 +1092,8 @@ scene::SMesh** CQ3LevelMesh::buildMesh(s32 num)
 			}
 
 
+			const u32 firstIndex = buffer->getIndexCount();
+
 			switch(Faces[i].type)
 			{
 				case 4: // billboards
@@ -1016,6 +1147,14 @@ scene::SMesh** CQ3LevelMesh::buildMesh(s32 num)
 					break;
 
 			} // end switch
+
+			// remember where the face of the level is for the bsp leafs
+			if ( num == 0 && item[g].index == E_Q3_MESH_GEOMETRY && buffer->getIndexCount() > firstIndex )
+			{
+				FaceBuffers[i] = buffer;
+				BSPFaces[i].FirstIndex = firstIndex;
+				BSPFaces[i].IndexCount = buffer->getIndexCount() - firstIndex;
+			}
 		}
 	}
 
@@ -1052,6 +1191,19 @@ void CQ3LevelMesh::constructMesh()
 
 	s32 i, j;
 
+	SBSPFace noFace;
+	noFace.MeshBuffer = -1;
+	noFace.FirstIndex = 0;
+	noFace.IndexCount = 0;
+	BSPFaces.set_used(0);
+	BSPFaces.reallocate(NumFaces);
+	for (i = 0; i < NumFaces; i++)
+		BSPFaces.push_back(noFace);
+	FaceBuffers.set_used(0);
+	FaceBuffers.reallocate(NumFaces);
+	for (i = 0; i < NumFaces; i++)
+		FaceBuffers.push_back(0);
+
 	// First the main level
 	SMesh **tmp = buildMesh(0);
 
@@ -1871,6 +2023,78 @@ void CQ3LevelMesh::cleanMesh(SMesh *m, const bool texture0important)
 }
 
 
+// find the meshbuffers of the faces after cleaning the meshes
+void CQ3LevelMesh::resolveFaces()
+{
+	const SMesh* geometry = Mesh[E_Q3_MESH_GEOMETRY];
+
+	for ( u32 i = 0; i < FaceBuffers.size(); ++i )
+	{
+		if ( !FaceBuffers[i] )
+			continue;
+
+		BSPFaces[i].MeshBuffer = -1;
+		for ( u32 b = 0; b < geometry->MeshBuffers.size(); ++b )
+		{
+			if ( geometry->MeshBuffers[b] == FaceBuffers[i] )
+			{
+				BSPFaces[i].MeshBuffer = b;
+				break;
+			}
+		}
+
+		// the buffer was removed
+		if ( BSPFaces[i].MeshBuffer < 0 )
+			BSPFaces[i].IndexCount = 0;
+	}
+
+	FaceBuffers.clear();
+}
+
+
+// returns the leaf of the bsp tree which contains a position
+s32 CQ3LevelMesh::findLeaf(const core::vector3df& pos) const
+{
+	if ( !NumNodes || BSPLeafs.empty() )
+		return -1;
+
+	s32 index = 0;
+	while ( index >= 0 )
+	{
+		if ( index >= NumNodes )
+			return -1;
+
+		const tBSPNode& node = Nodes[index];
+		if ( node.plane < 0 || node.plane >= NumPlanes )
+			return -1;
+
+		// the level has y and z swapped
+		const tBSPPlane& plane = Planes[node.plane];
+		const f32 distance = plane.vNormal[0] * pos.X + plane.vNormal[1] * pos.Z +
+				plane.vNormal[2] * pos.Y - plane.d;
+
+		index = distance >= 0.f ? node.front : node.back;
+	}
+
+	const s32 leaf = -(index + 1);
+	return leaf < (s32) BSPLeafs.size() ? leaf : -1;
+}
+
+
+// checks the potentially visible set of a cluster
+bool CQ3LevelMesh::isClusterVisible(s32 from, s32 to) const
+{
+	if ( !VisData.pBitsets || from < 0 || from >= VisData.numOfClusters )
+		return true;
+
+	if ( to < 0 || to >= VisData.numOfClusters )
+		return false;
+
+	const u8 bits = (u8) VisData.pBitsets[ from * VisData.bytesPerCluster + ( to >> 3 ) ];
+	return ( bits & ( 1 << ( to & 7 ) ) ) != 0;
+}
+
+
 // recalculate bounding boxes
 void CQ3LevelMesh::calcBoundingBoxes()
 {
@@ -88,6 +88,42 @@ namespace scene
 		//! returns the requested brush entity
 		virtual IMesh* getBrushEntityMesh(quake3::IEntity &ent) const IRR_OVERRIDE;
 
+		//! returns the leaf of the bsp tree which contains a position
+		virtual s32 findLeaf(const core::vector3df& pos) const IRR_OVERRIDE;
+
+		//! returns the number of leafs of the bsp tree
+		virtual u32 getLeafCount() const IRR_OVERRIDE
+		{
+			return BSPLeafs.size();
+		}
+
+		//! returns a leaf of the bsp tree
+		virtual const quake3::SBSPLeaf& getLeaf(u32 index) const IRR_OVERRIDE
+		{
+			return BSPLeafs[index];
+		}
+
+		//! returns the face for an entry of the leaf face list
+		virtual u32 getLeafFace(u32 index) const IRR_OVERRIDE
+		{
+			return BSPLeafFaces[index];
+		}
+
+		//! returns the number of faces of the level
+		virtual u32 getFaceCount() const IRR_OVERRIDE
+		{
+			return BSPFaces.size();
+		}
+
+		//! returns where the indices of a face are in the geometry mesh
+		virtual const quake3::SBSPFace& getFace(u32 index) const IRR_OVERRIDE
+		{
+			return BSPFaces[index];
+		}
+
+		//! checks the potentially visible set of a cluster
+		virtual bool isClusterVisible(s32 from, s32 to) const IRR_OVERRIDE;
+
 		//Link to held meshes? ...
 
 
@@ -403,6 +439,14 @@ namespace scene
 		s32 *LeafFaces;
 		s32 NumLeafFaces;
 
+		tBSPVisData VisData;
+
+		// bsp tree and faces kept after loading for the visibility queries
+		core::array<quake3::SBSPLeaf> BSPLeafs;
+		core::array<u32> BSPLeafFaces;
+		core::array<quake3::SBSPFace> BSPFaces;
+		core::array<const IMeshBuffer*> FaceBuffers;
+
 		s32 *MeshVerts;           // The vertex offsets for a mesh
 		s32 NumMeshVerts;
 
@@ -475,7 +519,9 @@ namespace scene
 		void cleanMeshes();
 		void cleanMesh(SMesh *m, const bool texture0important = false);
 		void cleanLoader ();
+		void cleanBSP();
 		void calcBoundingBoxes();
+		void resolveFaces();
 		c8 buf[128];
 		f32 FramesPerSecond;
 	};
@@ -0,0 +1,318 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_BSP_LOADER_
+
+#include "CQ3LevelSceneNode.h"
+#include "ISceneManager.h"
+#include "IVideoDriver.h"
+#include "ICameraSceneNode.h"
+#ifdef _IRR_COMPILE_WITH_SHADOW_VOLUME_SCENENODE_
+#include "CShadowVolumeSceneNode.h"
+#else
+#include "IShadowVolumeSceneNode.h"
+#endif
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CQ3LevelSceneNode::CQ3LevelSceneNode(IQ3LevelMesh* level, ISceneNode* parent,
+			ISceneManager* mgr, s32 id)
+	: IMeshSceneNode(parent, mgr, id), Level(level), Mesh(0), Shadow(0),
+	ReadOnlyMaterials(false), Cluster(-2), Frame(0), PassCount(0)
+{
+#ifdef _DEBUG
+	setDebugName("CQ3LevelSceneNode");
+#endif
+
+	Level->grab();
+	Mesh = Level->getMesh(quake3::E_Q3_MESH_GEOMETRY);
+	if (Mesh)
+	{
+		Mesh->grab();
+
+		Materials.reallocate(Mesh->getMeshBufferCount());
+		Indices.reallocate(Mesh->getMeshBufferCount());
+		for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
+		{
+			Materials.push_back(Mesh->getMeshBuffer(i)->getMaterial());
+			Indices.push_back(core::array<u16>());
+		}
+	}
+
+	FaceFrames.set_used(Level->getFaceCount());
+	for (u32 i=0; i<FaceFrames.size(); ++i)
+		FaceFrames[i] = 0;
+}
+
+
+//! destructor
+CQ3LevelSceneNode::~CQ3LevelSceneNode()
+{
+	if (Shadow)
+		Shadow->drop();
+	if (Mesh)
+		Mesh->drop();
+	Level->drop();
+}
+
+
+void CQ3LevelSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible && Mesh)
+	{
+		// the level usually has solid and transparent materials, so
+		// register for the passes of all materials like the octree does
+		video::IVideoDriver* driver = SceneManager->getVideoDriver();
+
+		PassCount = 0;
+		u32 transparentCount = 0;
+		u32 solidCount = 0;
+
+		for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
+		{
+			const video::SMaterial& material = ReadOnlyMaterials ?
+				Mesh->getMeshBuffer(i)->getMaterial() : Materials[i];
+
+			if (driver->needsTransparentRenderPass(material))
+				++transparentCount;
+			else
+				++solidCount;
+
+			if (solidCount && transparentCount)
+				break;
+		}
+
+		if (solidCount)
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_SOLID);
+
+		if (transparentCount)
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_TRANSPARENT);
+	}
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! collects the leafs which can be seen from a cluster
+void CQ3LevelSceneNode::collectLeafs(s32 cluster)
+{
+	Cluster = cluster;
+	PotentiallyVisibleLeafs.set_used(0);
+
+	for (u32 i=0; i<Level->getLeafCount(); ++i)
+	{
+		const quake3::SBSPLeaf& leaf = Level->getLeaf(i);
+		if (leaf.LeafFaceCount && Level->isClusterVisible(cluster, leaf.Cluster))
+			PotentiallyVisibleLeafs.push_back(i);
+	}
+}
+
+
+//! collects the indices of the faces in visible leafs inside the frustum
+void CQ3LevelSceneNode::collectIndices(const SViewFrustum& frustum)
+{
+	for (u32 b=0; b<Indices.size(); ++b)
+		Indices[b].set_used(0);
+	VisibleLeafs.set_used(0);
+
+	++Frame;
+
+	for (u32 l=0; l<PotentiallyVisibleLeafs.size(); ++l)
+	{
+		const quake3::SBSPLeaf& leaf = Level->getLeaf(PotentiallyVisibleLeafs[l]);
+
+		u32 p;
+		for (p=0; p!=SViewFrustum::VF_PLANE_COUNT; ++p)
+		{
+			if (leaf.BoundingBox.classifyPlaneRelation(frustum.planes[p]) == core::ISREL3D_FRONT)
+				break;
+		}
+		if (p != SViewFrustum::VF_PLANE_COUNT)
+			continue;
+
+		VisibleLeafs.push_back(PotentiallyVisibleLeafs[l]);
+
+		for (u32 f=0; f<leaf.LeafFaceCount; ++f)
+		{
+			const u32 faceIndex = Level->getLeafFace(leaf.FirstLeafFace + f);
+			if (faceIndex >= FaceFrames.size() || FaceFrames[faceIndex] == Frame)
+				continue;
+			FaceFrames[faceIndex] = Frame;
+
+			const quake3::SBSPFace& face = Level->getFace(faceIndex);
+			if (face.MeshBuffer < 0 || !face.IndexCount)
+				continue;
+
+			// the level meshbuffers always have 16 bit indices
+			const u16* source = Mesh->getMeshBuffer(face.MeshBuffer)->getIndices() + face.FirstIndex;
+			core::array<u16>& dest = Indices[face.MeshBuffer];
+			for (u32 i=0; i<face.IndexCount; ++i)
+				dest.push_back(source[i]);
+		}
+	}
+}
+
+
+//! renders the node.
+void CQ3LevelSceneNode::render()
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	ICameraSceneNode* camera = SceneManager->getActiveCamera();
+
+	if (!driver || !camera || !Mesh)
+		return;
+
+	const bool isTransparentPass =
+		SceneManager->getSceneNodeRenderPass() == scene::ESNRP_TRANSPARENT;
+	++PassCount;
+
+	driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
+
+	if (Shadow)
+		Shadow->updateShadowVolumes();
+
+	const bool hasTree = Level->getLeafCount() != 0;
+
+	// the faces are collected once per frame for all render passes
+	if (hasTree && PassCount == 1)
+	{
+		SViewFrustum frust = *camera->getViewFrustum();
+		core::vector3df cameraPos = camera->getAbsolutePosition();
+
+		// transform the frustum and the camera to the space of the level
+		if (!AbsoluteTransformation.isIdentity())
+		{
+			core::matrix4 invTrans(AbsoluteTransformation, core::matrix4::EM4CONST_INVERSE);
+			frust.transform(invTrans);
+			invTrans.transformVect(cameraPos);
+		}
+
+		const s32 leaf = Level->findLeaf(cameraPos);
+		const s32 cluster = leaf >= 0 ? Level->getLeaf(leaf).Cluster : -1;
+		if (cluster != Cluster)
+			collectLeafs(cluster);
+
+		collectIndices(frust);
+	}
+
+	for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
+	{
+		IMeshBuffer* mb = Mesh->getMeshBuffer(i);
+		if (hasTree && Indices[i].empty())
+			continue;
+
+		const video::SMaterial& material = ReadOnlyMaterials ? mb->getMaterial() : Materials[i];
+
+		// only render transparent buffer if this is the transparent render pass
+		// and solid only in solid pass
+		if (driver->needsTransparentRenderPass(material) != isTransparentPass)
+			continue;
+
+		driver->setMaterial(material);
+		if (hasTree)
+		{
+			driver->drawVertexPrimitiveList(mb->getVertices(), mb->getVertexCount(),
+				Indices[i].const_pointer(), Indices[i].size() / 3,
+				mb->getVertexType(), scene::EPT_TRIANGLES, video::EIT_16BIT);
+		}
+		else
+			driver->drawMeshBuffer(mb);
+	}
+
+	// for debug purposes only
+	if (DebugDataVisible && PassCount==1)
+	{
+		video::SMaterial m;
+		m.Lighting = false;
+		driver->setMaterial(m);
+
+		if (DebugDataVisible & scene::EDS_BBOX_BUFFERS)
+		{
+			for (u32 l=0; l<VisibleLeafs.size(); ++l)
+				driver->draw3DBox(Level->getLeaf(VisibleLeafs[l]).BoundingBox);
+		}
+
+		if (DebugDataVisible & scene::EDS_BBOX)
+			driver->draw3DBox(Mesh->getBoundingBox(), video::SColor(0,255,0,0));
+	}
+}
+
+
+//! returns the axis aligned bounding box of this node
+const core::aabbox3d<f32>& CQ3LevelSceneNode::getBoundingBox() const
+{
+	return Mesh ? Mesh->getBoundingBox() : Level->getBoundingBox();
+}
+
+
+//! returns the material based on the zero based index i.
+video::SMaterial& CQ3LevelSceneNode::getMaterial(u32 i)
+{
+	if (Mesh && ReadOnlyMaterials && i<Mesh->getMeshBufferCount())
+	{
+		ReadOnlyMaterial = Mesh->getMeshBuffer(i)->getMaterial();
+		return ReadOnlyMaterial;
+	}
+
+	if (i >= Materials.size())
+		return ISceneNode::getMaterial(i);
+
+	return Materials[i];
+}
+
+
+//! returns amount of materials used by this scene node.
+u32 CQ3LevelSceneNode::getMaterialCount() const
+{
+	return Materials.size();
+}
+
+
+//! Creates shadow volume scene node as child of this node
+//! and returns a pointer to it.
+IShadowVolumeSceneNode* CQ3LevelSceneNode::addShadowVolumeSceneNode(
+		const IMesh* shadowMesh, s32 id, bool zfailmethod, f32 infinity)
+{
+#ifdef _IRR_COMPILE_WITH_SHADOW_VOLUME_SCENENODE_
+	if (!SceneManager->getVideoDriver()->queryFeature(video::EVDF_STENCIL_BUFFER))
+		return 0;
+
+	if (!shadowMesh)
+		shadowMesh = Mesh; // if null is given, use the mesh of node
+
+	if (Shadow)
+		Shadow->drop();
+
+	Shadow = new CShadowVolumeSceneNode(shadowMesh, this, SceneManager, id,  zfailmethod, infinity);
+	return Shadow;
+#else
+	return 0;
+#endif
+}
+
+
+//! Removes a child from this scene node.
+//! Implemented here, to be able to remove the shadow properly, if there is one,
+//! or to remove attached childs.
+bool CQ3LevelSceneNode::removeChild(ISceneNode* child)
+{
+	if (child && Shadow == child)
+	{
+		Shadow->drop();
+		Shadow = 0;
+	}
+
+	return ISceneNode::removeChild(child);
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BSP_LOADER_
@@ -0,0 +1,106 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_C_Q3_LEVEL_SCENE_NODE_H_INCLUDED
+#define IRR_C_Q3_LEVEL_SCENE_NODE_H_INCLUDED
+
+#include "IMeshSceneNode.h"
+#include "IQ3LevelMesh.h"
+#include "SViewFrustum.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! Scene node which draws the geometry of a quake3 level.
+/** Only the faces of the leafs in the potentially visible set of the
+cluster the camera is in and which are inside the view frustum are drawn.
+The leafs of the set are only collected again when the camera enters
+another cluster. */
+class CQ3LevelSceneNode : public IMeshSceneNode
+{
+public:
+
+	//! constructor
+	CQ3LevelSceneNode(IQ3LevelMesh* level, ISceneNode* parent, ISceneManager* mgr, s32 id);
+
+	//! destructor
+	virtual ~CQ3LevelSceneNode();
+
+	virtual void OnRegisterSceneNode() IRR_OVERRIDE;
+
+	//! renders the node.
+	virtual void render() IRR_OVERRIDE;
+
+	//! returns the axis aligned bounding box of this node
+	virtual const core::aabbox3d<f32>& getBoundingBox() const IRR_OVERRIDE;
+
+	//! returns the material based on the zero based index i.
+	virtual video::SMaterial& getMaterial(u32 i) IRR_OVERRIDE;
+
+	//! returns amount of materials used by this scene node.
+	virtual u32 getMaterialCount() const IRR_OVERRIDE;
+
+	//! Returns type of the scene node
+	virtual ESCENE_NODE_TYPE getType() const IRR_OVERRIDE { return ESNT_Q3LEVEL_SCENE_NODE; }
+
+	//! The mesh is given by the level, so this does nothing.
+	virtual void setMesh(IMesh* mesh) IRR_OVERRIDE {}
+
+	//! Returns the geometry mesh of the level.
+	virtual IMesh* getMesh() IRR_OVERRIDE { return Mesh; }
+
+	//! Sets if the scene node should not copy the materials of the mesh but use them in a read only style.
+	virtual void setReadOnlyMaterials(bool readonly) IRR_OVERRIDE { ReadOnlyMaterials = readonly; }
+
+	//! Check if the scene node should not copy the materials of the mesh but use them in a read only style
+	virtual bool isReadOnlyMaterials() const IRR_OVERRIDE { return ReadOnlyMaterials; }
+
+	//! Creates shadow volume scene node as child of this node
+	//! and returns a pointer to it.
+	virtual IShadowVolumeSceneNode* addShadowVolumeSceneNode(const IMesh* shadowMesh,
+		s32 id, bool zfailmethod=true, f32 infinity=10000.0f) IRR_OVERRIDE;
+
+	//! Removes a child from this scene node.
+	//! Implemented here, to be able to remove the shadow properly, if there is one,
+	//! or to remove attached childs.
+	virtual bool removeChild(ISceneNode* child) IRR_OVERRIDE;
+
+private:
+
+	//! collects the leafs which can be seen from a cluster
+	void collectLeafs(s32 cluster);
+
+	//! collects the indices of the faces in visible leafs inside the frustum
+	void collectIndices(const SViewFrustum& frustum);
+
+	IQ3LevelMesh* Level;
+	IMesh* Mesh;
+	IShadowVolumeSceneNode* Shadow;
+
+	core::array<video::SMaterial> Materials;
+	video::SMaterial ReadOnlyMaterial;
+	bool ReadOnlyMaterials;
+
+	// cluster the leafs were collected for, -2 before the first frame
+	s32 Cluster;
+	core::array<u32> PotentiallyVisibleLeafs;
+
+	// leafs inside of the frustum in the last frame, for debug drawing
+	core::array<u32> VisibleLeafs;
+
+	// frame in which a face was added last, so faces in several leafs are drawn once
+	core::array<u32> FaceFrames;
+	u32 Frame;
+
+	// indices of the visible faces for each meshbuffer
+	core::array< core::array<u16> > Indices;
+
+	s32 PassCount;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
@@ -3,6 +3,16 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "CReadFile.h"
+#include "IMemoryReadFile.h"
+#include <string.h>
+
+#if defined(_IRR_WINDOWS_API_) && !defined(_WIN32_WCE)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+	#include <io.h>
+#elif defined(_IRR_POSIX_API_)
+	#include <unistd.h>
+#endif
 
 namespace irr
 {
@@ -38,6 +48,32 @@ size_t CReadFile::read(void* buffer, size_t sizeToRead)
 }
 
 
+//! reads from a position without using the read position of the file
+size_t CReadFile::readAt(void* buffer, size_t sizeToRead, long pos)
+{
+	if (!isOpen() || pos < 0)
+		return 0;
+
+#if defined(_IRR_WINDOWS_API_) && !defined(_WIN32_WCE)
+	// the offset in the OVERLAPPED struct is used instead of the file pointer
+	OVERLAPPED overlapped;
+	memset(&overlapped, 0, sizeof(overlapped));
+	overlapped.Offset = (DWORD)pos;
+	DWORD bytesRead = 0;
+	if (!ReadFile((HANDLE)_get_osfhandle(_fileno(File)), buffer, (DWORD)sizeToRead, &bytesRead, &overlapped))
+		return 0;
+	return bytesRead;
+#elif defined(_IRR_POSIX_API_)
+	const ssize_t bytesRead = pread(fileno(File), buffer, sizeToRead, pos);
+	return bytesRead > 0 ? (size_t)bytesRead : 0;
+#else
+	if (fseek(File, pos, SEEK_SET) != 0)
+		return 0;
+	return fread(buffer, 1, sizeToRead, File);
+#endif
+}
+
+
 //! changes position in file, returns true if successful
 //! if relativeMovement==true, the pos is changed relative to current pos,
 //! otherwise from begin of file
@@ -108,6 +144,27 @@ IReadFile* CReadFile::createReadFile(const io::path& fileName)
 }
 
 
+size_t readFileAt(IReadFile* file, void* buffer, size_t sizeToRead, long pos)
+{
+	if (file->getType() == ERFT_READ_FILE)
+		return static_cast<CReadFile*>(file)->readAt(buffer, sizeToRead, pos);
+
+	const IMemoryReadFile* memoryFile = getMemoryReadFile(file);
+	if (memoryFile)
+	{
+		if (pos < 0 || pos >= file->getSize())
+			return 0;
+		sizeToRead = core::min_(sizeToRead, (size_t)(file->getSize() - pos));
+		memcpy(buffer, static_cast<const c8*>(memoryFile->getBuffer()) + pos, sizeToRead);
+		return sizeToRead;
+	}
+
+	if (!file->seek(pos))
+		return 0;
+	return file->read(buffer, sizeToRead);
+}
+
+
 } // end namespace io
 } // end namespace irr
 
@@ -28,6 +28,14 @@ namespace io
 		//! returns how much was read
 		virtual size_t read(void* buffer, size_t sizeToRead) IRR_OVERRIDE;
 
+		//! reads from a position without using the read position of the file
+		/** Uses pread on POSIX systems and ReadFile with an offset on
+		Windows, so several threads can read at once. On Windows the system
+		file pointer still moves, which is fine as read() is only used
+		after a seek(). Other platforms fall back to seek and read.
+		\return how much was read */
+		size_t readAt(void* buffer, size_t sizeToRead, long pos);
+
 		//! changes position in file, returns true if successful
 		virtual bool seek(long finalPos, bool relativeMovement = false) IRR_OVERRIDE;
 
@@ -65,6 +73,13 @@ namespace io
 		io::path Filename;
 	};
 
+	//! Reads from a position of a file
+	/** Files on disk and in memory are read without using their read
+	position, so several threads can do this at once. Other files are
+	read after a seek, which only works from one thread.
+	\return how much was read */
+	size_t readFileAt(IReadFile* file, void* buffer, size_t sizeToRead, long pos);
+
 } // end namespace io
 } // end namespace irr
 
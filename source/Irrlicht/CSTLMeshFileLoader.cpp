@@ -43,7 +43,7 @@ IAnimatedMesh* CSTLMeshFileLoader::createMesh(io::IReadFile* fileIn)
 
 	// We copy the whole file into a memory-read file if it isn't already one.
 	io::CMemoryReadFile * memoryFile = 0;
-	if ( fileIn->getType() != io::ERFT_MEMORY_READ_FILE )
+	if ( !io::getMemoryReadFile(fileIn) )
 	{
 		u8* fileBuffer = new u8[filesize];
 		if ( fileIn->read(fileBuffer, filesize) != (size_t)filesize )
@@ -4,11 +4,15 @@
 
 #include "CSceneLoaderIrr.h"
 #include "ISceneUserDataSerializer.h"
-#include "ISceneManager.h"
+#include "CSceneManager.h"
 #include "ISceneNode.h"
 #include "IVideoDriver.h"
 #include "IFileSystem.h"
+#include "IReadFile.h"
 #include "IAttributes.h"
+#include "IMeshCache.h"
+#include "IMeshLoader.h"
+#include "IJobSystem.h"
 #include "os.h"
 
 namespace irr
@@ -17,7 +21,7 @@ namespace scene
 {
 
 //! Constructor
-CSceneLoaderIrr::CSceneLoaderIrr(ISceneManager *smgr, io::IFileSystem* fs)
+CSceneLoaderIrr::CSceneLoaderIrr(CSceneManager *smgr, io::IFileSystem* fs)
  : SceneManager(smgr), FileSystem(fs),
    IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type"),
    IRR_XML_FORMAT_ATTRIBUTES(L"attributes"), IRR_XML_FORMAT_MATERIALS(L"materials"),
@@ -62,48 +66,69 @@ bool CSceneLoaderIrr::loadScene(io::IReadFile* file, ISceneUserDataSerializer* u
 		return false;
 	}
 
+	// read file, nothing gets loaded yet
+	core::array<SNodeDesc*> nodes;
+	while (reader->read())
+	{
+		SNodeDesc* desc = new SNodeDesc();
+		readSceneNode(reader, desc);
+		nodes.push_back(desc);
+	}
+	reader->drop();
+
 	// TODO: COLLADA_CREATE_SCENE_INSTANCES can be removed when the COLLADA loader is a scene loader
 	bool oldColladaSingleMesh = SceneManager->getParameters()->getAttributeAsBool(COLLADA_CREATE_SCENE_INSTANCES);
 	SceneManager->getParameters()->setAttribute(COLLADA_CREATE_SCENE_INSTANCES, false);
 
-	// read file
-	while (reader->read())
+	// load all referenced resources before creating the nodes
+	loadResources();
+
+	for (u32 i=0; i<nodes.size(); ++i)
 	{
-		readSceneNode(reader, rootNode, userDataSerializer);
+		createSceneNode(nodes[i], rootNode, userDataSerializer);
+		delete nodes[i];
 	}
 
 	// restore old collada parameters
 	SceneManager->getParameters()->setAttribute(COLLADA_CREATE_SCENE_INSTANCES, oldColladaSingleMesh);
 
 	// clean up
-	reader->drop();
+	MeshPaths.clear();
+	TexturePaths.clear();
 	return true;
 }
 
 
+CSceneLoaderIrr::SNodeDesc::~SNodeDesc()
+{
+	if (Attributes)
+		Attributes->drop();
+
+	u32 i;
+	for (i=0; i<Materials.size(); ++i)
+		Materials[i]->drop();
+	for (i=0; i<Animators.size(); ++i)
+		Animators[i]->drop();
+	for (i=0; i<UserData.size(); ++i)
+		UserData[i]->drop();
+	for (i=0; i<Children.size(); ++i)
+		delete Children[i];
+}
+
+
 //! Reads the next node
-void CSceneLoaderIrr::readSceneNode(io::IXMLReader* reader, ISceneNode* parent,
-	ISceneUserDataSerializer* userDataSerializer)
+void CSceneLoaderIrr::readSceneNode(io::IXMLReader* reader, SNodeDesc* desc)
 {
 	if (!reader)
 		return;
 
-	scene::ISceneNode* node = 0;
-
-	if (!parent && IRR_XML_FORMAT_SCENE==reader->getNodeName())
-		node = SceneManager->getRootSceneNode();
-	else if (parent && IRR_XML_FORMAT_NODE==reader->getNodeName())
+	if (IRR_XML_FORMAT_SCENE==reader->getNodeName())
+		desc->IsScene = true;
+	else if (IRR_XML_FORMAT_NODE==reader->getNodeName())
 	{
-		// find node type and create it
-		core::stringc attrName = reader->getAttributeValue(IRR_XML_FORMAT_NODE_ATTR_TYPE.c_str());
-
-		node = SceneManager->addSceneNode(attrName.c_str(), parent);
-
-		if (!node)
-			os::Printer::log("Could not create scene node of unknown type", attrName.c_str());
+		desc->IsNode = true;
+		desc->Type = reader->getAttributeValue(IRR_XML_FORMAT_NODE_ATTR_TYPE.c_str());
 	}
-	else
-		node=parent;
 
 	// read attributes
 	while(reader->read())
@@ -124,29 +149,31 @@ void CSceneLoaderIrr::readSceneNode(io::IXMLReader* reader, ISceneNode* parent,
 		case io::EXN_ELEMENT:
 			if (IRR_XML_FORMAT_ATTRIBUTES == name)
 			{
-				// read attributes
-				io::IAttributes* attr = FileSystem->createEmptyAttributes(SceneManager->getVideoDriver());
+				// read attributes, without a driver textures are only kept by name
+				io::IAttributes* attr = FileSystem->createEmptyAttributes();
 				attr->read(reader, true);
+				collectResources(attr, true);
 
-				if (node)
-					node->deserializeAttributes(attr);
-
-				attr->drop();
+				if (desc->Attributes)
+					desc->Attributes->drop();
+				desc->Attributes = attr;
 			}
 			else
 			if (IRR_XML_FORMAT_MATERIALS == name)
-				readMaterials(reader, node);
+				readMaterials(reader, desc);
 			else
 			if (IRR_XML_FORMAT_ANIMATORS == name)
-				readAnimators(reader, node);
+				readAnimators(reader, desc);
 			else
 			if (IRR_XML_FORMAT_USERDATA  == name)
-				readUserData(reader, node, userDataSerializer);
+				readUserData(reader, desc);
 			else
 			if ((IRR_XML_FORMAT_NODE  == name) ||
 				(IRR_XML_FORMAT_SCENE == name))
 			{
-				readSceneNode(reader, node, userDataSerializer);
+				SNodeDesc* child = new SNodeDesc();
+				readSceneNode(reader, child);
+				desc->Children.push_back(child);
 			}
 			else
 			{
@@ -161,15 +188,11 @@ void CSceneLoaderIrr::readSceneNode(io::IXMLReader* reader, ISceneNode* parent,
 		if (endreached)
 			break;
 	}
-	if (node && userDataSerializer)
-		userDataSerializer->OnCreateNode(node);
 }
 
 //! reads materials of a node
-void CSceneLoaderIrr::readMaterials(io::IXMLReader* reader, ISceneNode* node)
+void CSceneLoaderIrr::readMaterials(io::IXMLReader* reader, SNodeDesc* desc)
 {
-	u32 nr = 0;
-
 	while(reader->read())
 	{
 		const wchar_t* name = reader->getNodeName();
@@ -184,17 +207,10 @@ void CSceneLoaderIrr::readMaterials(io::IXMLReader* reader, ISceneNode* node)
 			if (IRR_XML_FORMAT_ATTRIBUTES == name)
 			{
 				// read materials from attribute list
-				io::IAttributes* attr = FileSystem->createEmptyAttributes(SceneManager->getVideoDriver());
+				io::IAttributes* attr = FileSystem->createEmptyAttributes();
 				attr->read(reader);
-
-				if (node && node->getMaterialCount() > nr)
-				{
-					SceneManager->getVideoDriver()->fillMaterialStructureFromAttributes(
-						node->getMaterial(nr), attr);
-				}
-
-				attr->drop();
-				++nr;
+				collectResources(attr, false);
+				desc->Materials.push_back(attr);
 			}
 			break;
 		default:
@@ -205,7 +221,7 @@ void CSceneLoaderIrr::readMaterials(io::IXMLReader* reader, ISceneNode* node)
 
 
 //! reads animators of a node
-void CSceneLoaderIrr::readAnimators(io::IXMLReader* reader, ISceneNode* node)
+void CSceneLoaderIrr::readAnimators(io::IXMLReader* reader, SNodeDesc* desc)
 {
 	while(reader->read())
 	{
@@ -221,22 +237,10 @@ void CSceneLoaderIrr::readAnimators(io::IXMLReader* reader, ISceneNode* node)
 			if (IRR_XML_FORMAT_ATTRIBUTES == name)
 			{
 				// read animator data from attribute list
-				io::IAttributes* attr = FileSystem->createEmptyAttributes(SceneManager->getVideoDriver());
+				io::IAttributes* attr = FileSystem->createEmptyAttributes();
 				attr->read(reader);
-
-				if (node)
-				{
-					core::stringc typeName = attr->getAttributeAsString("Type");
-					ISceneNodeAnimator* anim = SceneManager->createSceneNodeAnimator(typeName.c_str(), node);
-
-					if (anim)
-					{
-						anim->deserializeAttributes(attr);
-						anim->drop();
-					}
-				}
-
-				attr->drop();
+				collectResources(attr, false);
+				desc->Animators.push_back(attr);
 			}
 			break;
 		default:
@@ -247,7 +251,7 @@ void CSceneLoaderIrr::readAnimators(io::IXMLReader* reader, ISceneNode* node)
 
 
 //! reads user data of a node
-void CSceneLoaderIrr::readUserData(io::IXMLReader* reader, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer)
+void CSceneLoaderIrr::readUserData(io::IXMLReader* reader, SNodeDesc* desc)
 {
 	while(reader->read())
 	{
@@ -263,15 +267,10 @@ void CSceneLoaderIrr::readUserData(io::IXMLReader* reader, ISceneNode* node, ISc
 			if (IRR_XML_FORMAT_ATTRIBUTES == name)
 			{
 				// read user data from attribute list
-				io::IAttributes* attr = FileSystem->createEmptyAttributes(SceneManager->getVideoDriver());
+				io::IAttributes* attr = FileSystem->createEmptyAttributes();
 				attr->read(reader);
-
-				if (node && userDataSerializer)
-				{
-					userDataSerializer->OnReadUserData(node, attr);
-				}
-
-				attr->drop();
+				collectResources(attr, false);
+				desc->UserData.push_back(attr);
 			}
 			break;
 		default:
@@ -280,6 +279,221 @@ void CSceneLoaderIrr::readUserData(io::IXMLReader* reader, ISceneNode* node, ISc
 	}
 }
 
+
+//! remember textures referenced by the attributes, and meshes in those of nodes
+void CSceneLoaderIrr::collectResources(io::IAttributes* attr, bool nodeAttributes)
+{
+	for (u32 i=0; i<attr->getAttributeCount(); ++i)
+	{
+		const io::E_ATTRIBUTE_TYPE type = attr->getAttributeType(i);
+		if (type == io::EAT_TEXTURE)
+		{
+			const io::path name(attr->getAttributeAsString(i));
+			if (!name.empty())
+				TexturePaths.push_back(name);
+		}
+		else if (nodeAttributes && type == io::EAT_STRING && !strcmp(attr->getAttributeName(i), "Mesh"))
+		{
+			// other strings called Mesh, e.g. of custom scene nodes, are left alone
+			const io::path name(attr->getAttributeAsString(i));
+			if (!name.empty() && isMeshFile(name))
+				MeshPaths.push_back(name);
+		}
+	}
+}
+
+
+//! check if one of the mesh loaders can load the file
+bool CSceneLoaderIrr::isMeshFile(const io::path& filename) const
+{
+	for (u32 i=0; i<SceneManager->getMeshLoaderCount(); ++i)
+	{
+		if (SceneManager->getMeshLoader(i)->isALoadableFileExtension(filename))
+			return true;
+	}
+	return false;
+}
+
+
+namespace
+{
+	//! Mesh files read by CSceneLoaderIrr::loadResources
+	struct SReadMeshFilesJob
+	{
+		io::IFileSystem* FileSystem;
+		const io::path* Paths;
+		io::IReadFile** Files;
+	};
+
+	//! reads a range of mesh files into memory, run by the job system
+	void readMeshFilesJob(void* data, u32 begin, u32 end)
+	{
+		SReadMeshFilesJob& job = *static_cast<SReadMeshFilesJob*>(data);
+		for (u32 i=begin; i<end; ++i)
+		{
+			io::IReadFile* file = job.FileSystem->createAndOpenFile(job.Paths[i]);
+			if (!file)
+				continue;
+
+			const long size = file->getSize();
+			c8* memory = new c8[size];
+			if (file->read(memory, size) == (size_t)size)
+				job.Files[i] = job.FileSystem->createMemoryReadFile(memory, (s32)size, file->getFileName(), true);
+			else
+				delete [] memory;
+			file->drop();
+		}
+	}
+}
+
+
+//! load all meshes and textures collected while reading
+/** The mesh files are read and the textures decoded on the job system.
+Mesh loaders keep the state of the file they load in the loader and might
+request textures from the driver, so the meshes are created one after
+another from the files in memory. Meshes come first as their loaders might
+already request some of the textures. Everything ends up in the mesh and
+texture caches, so the scene nodes find them there when they are created. */
+void CSceneLoaderIrr::loadResources()
+{
+	core::array<io::path> meshes;
+	MeshPaths.sort();
+	for (u32 i=0; i<MeshPaths.size(); ++i)
+	{
+		if (i > 0 && MeshPaths[i] == MeshPaths[i-1])
+			continue;
+		if (!SceneManager->getMeshCache()->isMeshLoaded(MeshPaths[i]))
+			meshes.push_back(MeshPaths[i]);
+	}
+
+	core::array<io::IReadFile*> files;
+	files.set_used(meshes.size());
+	for (u32 i=0; i<files.size(); ++i)
+		files[i] = 0;
+
+	SReadMeshFilesJob job;
+	job.FileSystem = FileSystem;
+	job.Paths = meshes.const_pointer();
+	job.Files = files.pointer();
+	core::IJobSystem* jobSystem = SceneManager->getJobSystem();
+	if (jobSystem && meshes.size() > 1)
+		jobSystem->parallelFor(0, meshes.size(), readMeshFilesJob, &job, 1);
+	else
+		readMeshFilesJob(&job, 0, meshes.size());
+
+	for (u32 i=0; i<meshes.size(); ++i)
+	{
+		// cached by the name in the scene, like getMesh does
+		if (files[i])
+		{
+			SceneManager->getUncachedMesh(files[i], meshes[i], meshes[i]);
+			files[i]->drop();
+		}
+		else
+			SceneManager->getMesh(meshes[i], io::path());
+	}
+
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	if (!driver)
+		return;
+
+	core::array<io::path> textures;
+	TexturePaths.sort();
+	for (u32 i=0; i<TexturePaths.size(); ++i)
+	{
+		if (i > 0 && TexturePaths[i] == TexturePaths[i-1])
+			continue;
+		textures.push_back(TexturePaths[i]);
+	}
+	driver->getTextures(textures);
+}
+
+
+//! replace texture names by the loaded textures
+void CSceneLoaderIrr::resolveTextures(io::IAttributes* attr) const
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+	if (!driver)
+		return;
+
+	for (u32 i=0; i<attr->getAttributeCount(); ++i)
+	{
+		if (attr->getAttributeType(i) == io::EAT_TEXTURE)
+		{
+			const io::path name(attr->getAttributeAsString(i));
+			if (!name.empty())
+				attr->setAttribute(i, driver->getTexture(name), name);
+		}
+	}
+}
+
+
+//! Creates the scene node described by desc and all its children
+void CSceneLoaderIrr::createSceneNode(SNodeDesc* desc, ISceneNode* parent,
+	ISceneUserDataSerializer* userDataSerializer)
+{
+	scene::ISceneNode* node = 0;
+
+	if (!parent && desc->IsScene)
+		node = SceneManager->getRootSceneNode();
+	else if (parent && desc->IsNode)
+	{
+		// find node type and create it
+		node = SceneManager->addSceneNode(desc->Type.c_str(), parent);
+
+		if (!node)
+			os::Printer::log("Could not create scene node of unknown type", desc->Type.c_str());
+	}
+	else
+		node=parent;
+
+	if (node)
+	{
+		u32 i;
+		if (desc->Attributes)
+		{
+			resolveTextures(desc->Attributes);
+			node->deserializeAttributes(desc->Attributes);
+		}
+
+		for (i=0; i<desc->Materials.size() && i<node->getMaterialCount(); ++i)
+		{
+			resolveTextures(desc->Materials[i]);
+			SceneManager->getVideoDriver()->fillMaterialStructureFromAttributes(
+				node->getMaterial(i), desc->Materials[i]);
+		}
+
+		for (i=0; i<desc->Animators.size(); ++i)
+		{
+			io::IAttributes* attr = desc->Animators[i];
+			core::stringc typeName = attr->getAttributeAsString("Type");
+			ISceneNodeAnimator* anim = SceneManager->createSceneNodeAnimator(typeName.c_str(), node);
+
+			if (anim)
+			{
+				resolveTextures(attr);
+				anim->deserializeAttributes(attr);
+				anim->drop();
+			}
+		}
+
+		if (userDataSerializer)
+		{
+			for (i=0; i<desc->UserData.size(); ++i)
+			{
+				resolveTextures(desc->UserData[i]);
+				userDataSerializer->OnReadUserData(node, desc->UserData[i]);
+			}
+		}
+	}
+
+	for (u32 c=0; c<desc->Children.size(); ++c)
+		createSceneNode(desc->Children[c], node, userDataSerializer);
+
+	if (node && userDataSerializer)
+		userDataSerializer->OnCreateNode(node);
+}
+
 } // scene
 } // irr
 
@@ -15,12 +15,13 @@ namespace irr
 namespace io
 {
 	class IFileSystem;
+	class IAttributes;
 }
 
 namespace scene
 {
 
-class ISceneManager;
+class CSceneManager;
 
 //! Class which can load a scene into the scene manager.
 class CSceneLoaderIrr : public virtual ISceneLoader
@@ -28,7 +29,7 @@ class CSceneLoaderIrr : public virtual ISceneLoader
 public:
 
 	//! Constructor
-	CSceneLoaderIrr(ISceneManager *smgr, io::IFileSystem* fs);
+	CSceneLoaderIrr(CSceneManager *smgr, io::IFileSystem* fs);
 
 	//! Destructor
 	virtual ~CSceneLoaderIrr();
@@ -46,23 +47,61 @@ public:
 
 private:
 
-	//! Recursively reads nodes from the xml file
-	void readSceneNode(io::IXMLReader* reader, ISceneNode* parent,
-		ISceneUserDataSerializer* userDataSerializer);
+	//! Everything read from the xml file for one element.
+	/** Scenes are loaded in two passes. The first one only parses the file
+	into these descriptions and collects all mesh and texture paths. Then
+	those resources get loaded in one go and only after that the scene
+	nodes are created. */
+	struct SNodeDesc
+	{
+		SNodeDesc() : IsScene(false), IsNode(false), Attributes(0) {}
+		~SNodeDesc();
+
+		core::stringc Type;
+		bool IsScene;
+		bool IsNode;
+		io::IAttributes* Attributes;
+		core::array<io::IAttributes*> Materials;
+		core::array<io::IAttributes*> Animators;
+		core::array<io::IAttributes*> UserData;
+		core::array<SNodeDesc*> Children;
+	};
+
+	//! Recursively reads node descriptions from the xml file
+	void readSceneNode(io::IXMLReader* reader, SNodeDesc* desc);
 
 	//! read a node's materials
-	void readMaterials(io::IXMLReader* reader, ISceneNode* node);
+	void readMaterials(io::IXMLReader* reader, SNodeDesc* desc);
 
 	//! read a node's animators
-	void readAnimators(io::IXMLReader* reader, ISceneNode* node);
+	void readAnimators(io::IXMLReader* reader, SNodeDesc* desc);
+
+	//! read any other data for the user serializer
+	void readUserData(io::IXMLReader* reader, SNodeDesc* desc);
+
+	//! remember textures referenced by the attributes, and meshes in those of nodes
+	void collectResources(io::IAttributes* attr, bool nodeAttributes);
+
+	//! check if one of the mesh loaders can load the file
+	bool isMeshFile(const io::path& filename) const;
 
-	//! read any other data into the user serializer
-	void readUserData(io::IXMLReader* reader, ISceneNode* node,
+	//! load all meshes and textures collected while reading
+	void loadResources();
+
+	//! replace texture names by the loaded textures
+	void resolveTextures(io::IAttributes* attr) const;
+
+	//! Recursively creates the scene nodes from their descriptions
+	void createSceneNode(SNodeDesc* desc, ISceneNode* parent,
 		ISceneUserDataSerializer* userDataSerializer);
 
-	ISceneManager   *SceneManager;
+	CSceneManager   *SceneManager;
 	io::IFileSystem *FileSystem;
 
+	//! resources referenced by the scene which is currently loaded
+	core::array<io::path> MeshPaths;
+	core::array<io::path> TexturePaths;
+
 	//! constants for reading and writing XML.
 	//! Not made static due to portability problems.
 	// TODO: move to own header
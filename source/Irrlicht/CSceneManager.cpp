@@ -12,6 +12,7 @@
 #include "IXMLWriter.h"
 #include "ISceneUserDataSerializer.h"
 #include "IGUIEnvironment.h"
+#include "IJobSystem.h"
 #include "IReadFile.h"
 #include "IWriteFile.h"
 #include "ISceneLoader.h"
@@ -179,6 +180,7 @@
 #include "CEmptySceneNode.h"
 #include "CTextSceneNode.h"
 #include "CQuake3ShaderSceneNode.h"
+#include "CQ3LevelSceneNode.h"
 #include "CVolumeLightSceneNode.h"
 
 #include "CDefaultSceneNodeFactory.h"
@@ -215,11 +217,11 @@ namespace scene
 //! constructor
 CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 		gui::ICursorControl* cursorControl, IMeshCache* cache,
-		gui::IGUIEnvironment* gui)
+		gui::IGUIEnvironment* gui, core::IJobSystem* jobSystem)
 : ISceneNode(0, 0), Driver(driver), FileSystem(fs), GUIEnvironment(gui),
-	CursorControl(cursorControl), CollisionManager(0),
+	CursorControl(cursorControl), JobSystem(jobSystem), CollisionManager(0),
 	ActiveCamera(0), ShadowColor(150,0,0,0), AmbientLight(0,0,0,0), Parameters(0),
-	MeshCache(cache), CurrentRenderPass(ESNRP_NONE), LightManager(0),
+	MeshCache(cache), CurrentRenderPass(ESNRP_NONE), SceneStats(120), LightManager(0),
 	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type")
 {
 	#ifdef _DEBUG
@@ -242,6 +244,9 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 	if (GUIEnvironment)
 		GUIEnvironment->grab();
 
+	if (JobSystem)
+		JobSystem->grab();
+
 	// create mesh cache if not there already
 	if (!MeshCache)
 		MeshCache = new CMeshCache();
@@ -424,6 +429,10 @@ CSceneManager::~CSceneManager()
 
 	if (Driver)
 		Driver->drop();
+
+	// after the nodes which might still have jobs running
+	if (JobSystem)
+		JobSystem->drop();
 }
 
 
@@ -518,6 +527,13 @@ io::IFileSystem* CSceneManager::getFileSystem()
 	return FileSystem;
 }
 
+
+//! Returns the job system used by the scene nodes
+core::IJobSystem* CSceneManager::getJobSystem()
+{
+	return JobSystem;
+}
+
 //! Adds a text scene node, which is able to display
 //! 2d text at a position in three dimensional space
 ITextSceneNode* CSceneManager::addTextSceneNode(gui::IGUIFont* font,
@@ -587,6 +603,27 @@ IMeshSceneNode* CSceneManager::addQuake3SceneNode(const IMeshBuffer* meshBuffer,
 }
 
 
+//! Adds a scene node, which draws the visible faces of a quake3 level
+IMeshSceneNode* CSceneManager::addQuake3LevelSceneNode(IQ3LevelMesh* level,
+					ISceneNode* parent, s32 id)
+{
+#ifdef _IRR_COMPILE_WITH_BSP_LOADER_
+	if (!level)
+		return 0;
+
+	if (!parent)
+		parent = this;
+
+	CQ3LevelSceneNode* node = new CQ3LevelSceneNode(level, parent, this, id);
+	node->drop();
+
+	return node;
+#else
+	return 0;
+#endif
+}
+
+
 //! adds Volume Lighting Scene Node.
 //! the returned pointer must not be dropped.
 IVolumeLightSceneNode* CSceneManager::addVolumeLightSceneNode(
@@ -1236,30 +1273,38 @@ const core::aabbox3d<f32>& CSceneManager::getBoundingBox() const
 
 //! returns if node is culled
 bool CSceneManager::isCulled(const ISceneNode* node) const
+{
+	return getCulledBy(node) != EAC_OFF;
+}
+
+
+//! returns the culling test which found the node invisible or EAC_OFF
+E_CULLING_TYPE CSceneManager::getCulledBy(const ISceneNode* node) const
 {
 	const ICameraSceneNode* cam = getActiveCamera();
 	if (!cam)
 	{
-		return false;
+		return EAC_OFF;
 	}
-	bool result = false;
 
 	// has occlusion query information
 	if (node->getAutomaticCulling() & scene::EAC_OCC_QUERY)
 	{
-		result = (Driver->getOcclusionQueryResult(node)==0);
+		if (Driver->getOcclusionQueryResult(node)==0)
+			return EAC_OCC_QUERY;
 	}
 
 	// can be seen by a bounding box ?
-	if (!result && (node->getAutomaticCulling() & scene::EAC_BOX))
+	if (node->getAutomaticCulling() & scene::EAC_BOX)
 	{
 		core::aabbox3d<f32> tbox = node->getBoundingBox();
 		node->getAbsoluteTransformation().transformBoxEx(tbox);
-		result = !(tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox() ));
+		if (!tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox()))
+			return EAC_BOX;
 	}
 
 	// can be seen by a bounding sphere
-	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_SPHERE))
+	if (node->getAutomaticCulling() & scene::EAC_FRUSTUM_SPHERE)
 	{
 		const core::aabbox3df nbox = node->getTransformedBoundingBox();
 		const float rad = nbox.getRadius();
@@ -1271,11 +1316,12 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 		const float dist = (center - camcenter).getLengthSQ();
 		const float maxdist = (rad + camrad) * (rad + camrad);
 
-		result = dist > maxdist;
+		if (dist > maxdist)
+			return EAC_FRUSTUM_SPHERE;
 	}
 
 	// can be seen by cam pyramid planes ?
-	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX))
+	if (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX)
 	{
 		SViewFrustum frust = *cam->getViewFrustum();
 
@@ -1300,14 +1346,39 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 			}
 
 			if (!boxInFrustum)
-			{
-				result = true;
-				break;
-			}
+				return EAC_FRUSTUM_BOX;
 		}
 	}
 
-	return result;
+	return EAC_OFF;
+}
+
+
+//! like isCulled, but adds the result to the frame stats
+bool CSceneManager::isCulledCounted(const ISceneNode* node)
+{
+	SSceneStats& stats = SceneStats.current();
+	switch (getCulledBy(node))
+	{
+	case EAC_OFF:
+		++stats.NodesVisible;
+		return false;
+	case EAC_BOX:
+		++stats.NodesCulledByBox;
+		break;
+	case EAC_FRUSTUM_BOX:
+		++stats.NodesCulledByFrustumBox;
+		break;
+	case EAC_FRUSTUM_SPHERE:
+		++stats.NodesCulledByFrustumSphere;
+		break;
+	case EAC_OCC_QUERY:
+		++stats.NodesCulledByOcclusionQuery;
+		break;
+	default:
+		break;
+	}
+	return true;
 }
 
 
@@ -1353,28 +1424,28 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		taken = 1;
 		break;
 	case ESNRP_SOLID:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			SolidNodeList.push_back(node);
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			TransparentNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT_EFFECT:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			TransparentEffectNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_AUTOMATIC:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			const u32 count = node->getMaterialCount();
 
@@ -1400,7 +1471,7 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		}
 		break;
 	case ESNRP_SHADOW:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			ShadowNodeList.push_back(node);
 			taken = 1;
@@ -1408,7 +1479,7 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		break;
 
 	case ESNRP_GUI:
-		if (!isCulled(node))
+		if (!isCulledCounted(node))
 		{
 			GuiNodeList.push_back(node);
 			taken = 1;
@@ -1533,7 +1604,8 @@ void CSceneManager::drawAll()
 			if (ActiveCamera)
 				camWorldPos = ActiveCamera->getAbsolutePosition();
 
-			core::array<DistanceNodeEntry> SortedLights;
+			typedef core::irrArenaAllocator<DistanceNodeEntry> TArenaAlloc;
+			core::array<DistanceNodeEntry, TArenaAlloc> SortedLights(TArenaAlloc(Driver->getFrameArena()));
 			SortedLights.set_used(LightList.size());
 			for (s32 light = (s32)LightList.size() - 1; light >= 0; --light)
 				SortedLights[light].setNodeAndDistanceFromPosition(LightList[light], camWorldPos);
@@ -1619,6 +1691,7 @@ void CSceneManager::drawAll()
 #ifdef _IRR_SCENEMANAGER_DEBUG
 		Parameters->setAttribute("drawn_solid", (s32) SolidNodeList.size() );
 #endif
+		SceneStats.current().NodesDrawnSolid += SolidNodeList.size();
 		SolidNodeList.set_used(0);
 
 		if (LightManager)
@@ -1686,6 +1759,7 @@ void CSceneManager::drawAll()
 #ifdef _IRR_SCENEMANAGER_DEBUG
 		Parameters->setAttribute ( "drawn_transparent", (s32) TransparentNodeList.size() );
 #endif
+		SceneStats.current().NodesDrawnTransparent += TransparentNodeList.size();
 		TransparentNodeList.set_used(0);
 
 		if (LightManager)
@@ -1720,6 +1794,7 @@ void CSceneManager::drawAll()
 #ifdef _IRR_SCENEMANAGER_DEBUG
 		Parameters->setAttribute("drawn_transparent_effect", (s32) TransparentEffectNodeList.size());
 #endif
+		SceneStats.current().NodesDrawnTransparentEffect += TransparentEffectNodeList.size();
 		TransparentEffectNodeList.set_used(0);
 	}
 
@@ -1760,6 +1835,28 @@ void CSceneManager::drawAll()
 	clearDeletionList();
 
 	CurrentRenderPass = ESNRP_NONE;
+	SceneStats.endFrame();
+}
+
+
+//! Returns counters of a finished frame
+const SSceneStats& CSceneManager::getFrameStats(u32 framesAgo) const
+{
+	return SceneStats.get(framesAgo);
+}
+
+
+//! Returns how many finished frames are stored for getFrameStats()
+u32 CSceneManager::getFrameStatsCount() const
+{
+	return SceneStats.size();
+}
+
+
+//! Returns the counters of the frame which is currently drawn
+SSceneStats& CSceneManager::getCurrentFrameStats()
+{
+	return SceneStats.current();
 }
 
 void CSceneManager::setLightManager(ILightManager* lightManager)
@@ -2202,7 +2299,7 @@ IMeshCache* CSceneManager::getMeshCache()
 //! Creates a new scene manager.
 ISceneManager* CSceneManager::createNewSceneManager(bool cloneContent)
 {
-	CSceneManager* manager = new CSceneManager(Driver, FileSystem, CursorControl, MeshCache, GUIEnvironment);
+	CSceneManager* manager = new CSceneManager(Driver, FileSystem, CursorControl, MeshCache, GUIEnvironment, JobSystem);
 
 	if (cloneContent)
 		manager->cloneMembers(this, manager);
@@ -2697,9 +2794,9 @@ IMeshWriter* CSceneManager::createMeshWriter(EMESH_WRITER_TYPE type)
 // creates a scenemanager
 ISceneManager* createSceneManager(video::IVideoDriver* driver,
 		io::IFileSystem* fs, gui::ICursorControl* cursorcontrol,
-		gui::IGUIEnvironment *guiEnvironment)
+		gui::IGUIEnvironment *guiEnvironment, core::IJobSystem* jobSystem)
 {
-	return new CSceneManager(driver, fs, cursorcontrol, 0, guiEnvironment );
+	return new CSceneManager(driver, fs, cursorcontrol, 0, guiEnvironment, jobSystem );
 }
 
 
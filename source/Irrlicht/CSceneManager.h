@@ -13,6 +13,7 @@
 #include "IMeshLoader.h"
 #include "CAttributes.h"
 #include "ILightManager.h"
+#include "CFrameHistory.h"
 
 namespace irr
 {
@@ -32,10 +33,13 @@ namespace scene
 	{
 	public:
 
+		// creates the meshes of a scene from the files it read on the job system
+		friend class CSceneLoaderIrr;
+
 		//! constructor
 		CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 			gui::ICursorControl* cursorControl, IMeshCache* cache = 0,
-			gui::IGUIEnvironment *guiEnvironment = 0);
+			gui::IGUIEnvironment *guiEnvironment = 0, core::IJobSystem* jobSystem = 0);
 
 		//! destructor
 		virtual ~CSceneManager();
@@ -58,6 +62,9 @@ namespace scene
 		//! return the filesystem
 		virtual io::IFileSystem* getFileSystem() IRR_OVERRIDE;
 
+		//! return the job system
+		virtual core::IJobSystem* getJobSystem() IRR_OVERRIDE;
+
 		//! adds Volume Lighting Scene Node.
 		//! the returned pointer must not be dropped.
 		virtual IVolumeLightSceneNode* addVolumeLightSceneNode(ISceneNode* parent=0, s32 id=-1,
@@ -206,6 +213,10 @@ namespace scene
 		virtual IMeshSceneNode* addQuake3SceneNode(const IMeshBuffer* meshBuffer, const quake3::IShader * shader,
 			ISceneNode* parent=0, s32 id=-1) IRR_OVERRIDE;
 
+		//! Adds a scene node, which draws the visible faces of a quake3 level
+		virtual IMeshSceneNode* addQuake3LevelSceneNode(IQ3LevelMesh* level,
+			ISceneNode* parent=0, s32 id=-1) IRR_OVERRIDE;
+
 
 		//! Adds a Hill Plane mesh to the mesh pool. The mesh is
 		//! generated on the fly and looks like a plane with some hills
@@ -537,8 +548,23 @@ namespace scene
 		//! returns if node is culled
 		virtual bool isCulled(const ISceneNode* node) const IRR_OVERRIDE;
 
+		//! Returns counters of a finished frame
+		virtual const SSceneStats& getFrameStats(u32 framesAgo=0) const IRR_OVERRIDE;
+
+		//! Returns how many finished frames are stored for getFrameStats()
+		virtual u32 getFrameStatsCount() const IRR_OVERRIDE;
+
+		//! Returns the counters of the frame which is currently drawn
+		virtual SSceneStats& getCurrentFrameStats() IRR_OVERRIDE;
+
 	private:
 
+		//! returns the culling test which found the node invisible or EAC_OFF
+		E_CULLING_TYPE getCulledBy(const ISceneNode* node) const;
+
+		//! like isCulled, but adds the result to the frame stats
+		bool isCulledCounted(const ISceneNode* node);
+
 		// load and create a mesh which we know already isn't in the cache and put it in there
 		IAnimatedMesh* getUncachedMesh(io::IReadFile* file, const io::path& filename, const io::path& cachename);
 
@@ -647,6 +673,9 @@ namespace scene
 		//! cursor control
 		gui::ICursorControl* CursorControl;
 
+		//! job system of the device
+		core::IJobSystem* JobSystem;
+
 		//! collision manager
 		ISceneCollisionManager* CollisionManager;
 
@@ -682,6 +711,8 @@ namespace scene
 
 		E_SCENE_NODE_RENDER_PASS CurrentRenderPass;
 
+		CFrameHistory<SSceneStats> SceneStats;
+
 		//! An optional callbacks manager to allow the user app finer control
 		//! over the scene lighting and rendering.
 		ILightManager* LightManager;
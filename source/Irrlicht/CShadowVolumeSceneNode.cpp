@@ -13,6 +13,7 @@
 #include "ICameraSceneNode.h"
 #include "SViewFrustum.h"
 #include "SLight.h"
+#include "IJobSystem.h"
 #include "os.h"
 
 namespace irr
@@ -25,13 +26,18 @@ namespace scene
 CShadowVolumeSceneNode::CShadowVolumeSceneNode(const IMesh* shadowMesh, ISceneNode* parent,
 		ISceneManager* mgr, s32 id, bool zfailmethod, f32 infinity)
 : IShadowVolumeSceneNode(parent, mgr, id),
-	AdjacencyDirtyFlag(true),
+	AdjacencyDirtyFlag(true), MeshDirtyFlag(true), IsStatic(false),
 	ShadowMesh(0), IndexCount(0), VertexCount(0), ShadowVolumesUsed(0),
-	Infinity(infinity), UseZFailMethod(zfailmethod), Optimization(ESV_SILHOUETTE_BY_POS)
+	Infinity(infinity), UseZFailMethod(zfailmethod), Optimization(ESV_SILHOUETTE_BY_POS),
+	JobSystem(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CShadowVolumeSceneNode");
 	#endif
+	if (SceneManager)
+		JobSystem = SceneManager->getJobSystem();
+	if (JobSystem)
+		JobSystem->grab();
 	setShadowMesh(shadowMesh);
 	setAutomaticCulling(scene::EAC_OFF);
 }
@@ -40,51 +46,90 @@ CShadowVolumeSceneNode::CShadowVolumeSceneNode(const IMesh* shadowMesh, ISceneNo
 //! destructor
 CShadowVolumeSceneNode::~CShadowVolumeSceneNode()
 {
+	waitForShadowVolumes();
+
+	if (JobSystem)
+		JobSystem->drop();
+
 	if (ShadowMesh)
 		ShadowMesh->drop();
 }
 
 
-void CShadowVolumeSceneNode::createShadowVolume(const core::vector3df& light, bool isDirectional)
+void CShadowVolumeSceneNode::addShadowVolume(const core::vector3df& light, bool isDirectional)
 {
-	SShadowVolume* svp = 0;
-	core::aabbox3d<f32>* bb = 0;
-
-	// builds the shadow volume and adds it to the shadow volume list.
-
-	if (ShadowVolumes.size() > ShadowVolumesUsed)
+	// static meshes keep the shadow volumes of lights which didn't move
+	if (IsStatic)
 	{
-		// get the next unused buffer
-
-		svp = &ShadowVolumes[ShadowVolumesUsed];
-		svp->set_used(0);
-
-		bb = &ShadowBBox[ShadowVolumesUsed];
+		for (u32 i=ShadowVolumesUsed; i<ShadowVolumeLights.size(); ++i)
+		{
+			if (ShadowVolumeLights[i].IsDirectional == isDirectional && ShadowVolumeLights[i].Light == light)
+			{
+				if (i != ShadowVolumesUsed)
+				{
+					ShadowVolumes[i].swap(ShadowVolumes[ShadowVolumesUsed]);
+					core::swap(ShadowBBox[i], ShadowBBox[ShadowVolumesUsed]);
+					core::swap(ShadowVolumeLights[i].Light, ShadowVolumeLights[ShadowVolumesUsed].Light);
+					core::swap(ShadowVolumeLights[i].IsDirectional, ShadowVolumeLights[ShadowVolumesUsed].IsDirectional);
+				}
+				ShadowVolumeLights[ShadowVolumesUsed].Update = false;
+				++ShadowVolumesUsed;
+				return;
+			}
+		}
 	}
-	else
+
+	// adds a buffer to the shadow volume list, the volume is built later
+	if (ShadowVolumes.size() == ShadowVolumesUsed)
 	{
 		ShadowVolumes.push_back(SShadowVolume());
-		svp = &ShadowVolumes.getLast();
-
 		ShadowBBox.push_back(core::aabbox3d<f32>());
-		bb = &ShadowBBox.getLast();
+		ShadowVolumeLights.push_back(SShadowVolumeLight());
+		ShadowVolumeLights.getLast().Node = this;
+		ShadowVolumeLights.getLast().Index = ShadowVolumesUsed;
 	}
-	svp->reallocate(IndexCount*5);
+	SShadowVolumeLight& volumeLight = ShadowVolumeLights[ShadowVolumesUsed];
+	volumeLight.Light = light;
+	volumeLight.IsDirectional = isDirectional;
+	volumeLight.Update = true;
 	++ShadowVolumesUsed;
+}
+
+
+void CShadowVolumeSceneNode::createShadowVolumeJob(void* data)
+{
+	SShadowVolumeLight* volumeLight = (SShadowVolumeLight*)data;
+	volumeLight->Node->createShadowVolume(volumeLight->Index);
+}
+
+
+void CShadowVolumeSceneNode::createShadowVolume(u32 index)
+{
+	// builds the shadow volume of one light
+	// only touches the buffers of this light, so volumes of several lights can be built at once
+	SShadowVolumeLight& volumeLight = ShadowVolumeLights[index];
+	const core::vector3df& light = volumeLight.Light;
+	const bool isDirectional = volumeLight.IsDirectional;
+
+	SShadowVolume* svp = &ShadowVolumes[index];
+	svp->set_used(0);
+	svp->reallocate(IndexCount*5);
 
 	// We use triangle lists
-	Edges.set_used(IndexCount*2);
+	core::array<u32>& edges = volumeLight.Edges;
+	edges.set_used(IndexCount*2);
+	volumeLight.FaceData.set_used(IndexCount / 3);
 	u32 numEdges = 0;
 
-	numEdges=createEdgesAndCaps(light, isDirectional, svp, bb);
+	numEdges=createEdgesAndCaps(volumeLight, svp, &ShadowBBox[index]);
 
 	// for all edges add the near->far quads
 	core::vector3df lightDir1(light*Infinity);
 	core::vector3df lightDir2(light*Infinity);
 	for (u32 i=0; i<numEdges; ++i)
 	{
-		const core::vector3df &v1 = Vertices[Edges[2*i+0]];
-		const core::vector3df &v2 = Vertices[Edges[2*i+1]];
+		const core::vector3df &v1 = Vertices[edges[2*i+0]];
+		const core::vector3df &v2 = Vertices[edges[2*i+1]];
 		if ( !isDirectional )
 		{
 			lightDir1 = (v1 - light).normalize()*Infinity;
@@ -116,9 +161,14 @@ void CShadowVolumeSceneNode::createShadowVolume(const core::vector3df& light, bo
 // is probably ending up with same value anyway 
 #define IRR_USE_REVERSE_EXTRUDED
 
-u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light, bool isDirectional,
+u32 CShadowVolumeSceneNode::createEdgesAndCaps(SShadowVolumeLight& volumeLight,
 					SShadowVolume* svp, core::aabbox3d<f32>* bb)
 {
+	const core::vector3df& light = volumeLight.Light;
+	const bool isDirectional = volumeLight.IsDirectional;
+	core::array<bool>& faceData = volumeLight.FaceData;
+	core::array<u32>& edges = volumeLight.Edges;
+
 	u32 numEdges=0;
 	const u32 faceCount = IndexCount / 3;
 
@@ -128,28 +178,66 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light, boo
 		bb->reset(0,0,0);
 
 	// Check every face if it is front or back facing the light.
-	core::vector3df lightDir0(light);
-	core::vector3df lightDir1(light);
-	core::vector3df lightDir2(light);
-	for (u32 i=0; i<faceCount; ++i)
+	// Static meshes use the same test as triangle3df::isFrontFacing, but
+	// with the normals calculated once in copyMesh.
+	if ( IsStatic && isDirectional )
 	{
-		const core::vector3df v0 = Vertices[Indices[3*i+0]];
-		const core::vector3df v1 = Vertices[Indices[3*i+1]];
-		const core::vector3df v2 = Vertices[Indices[3*i+2]];
-
-		if ( !isDirectional )
+		for (u32 i=0; i<faceCount; ++i)
 		{
-			lightDir0 = (v0-light).normalize();
+			const f32 d = FaceNormals[i].dotProduct(light);
+			faceData[i] = F32_LOWER_EQUAL_0(d);
 		}
+	}
+	else if ( IsStatic )
+	{
+		for (u32 i=0; i<faceCount; ++i)
+		{
+			const f32 d = FaceNormals[i].dotProduct((Vertices[Indices[3*i]]-light).normalize());
+			faceData[i] = F32_LOWER_EQUAL_0(d);
+		}
+	}
+	else
+	{
+		core::vector3df lightDir(light);
+		for (u32 i=0; i<faceCount; ++i)
+		{
+			const core::vector3df& v0 = Vertices[Indices[3*i+0]];
+			const core::vector3df& v1 = Vertices[Indices[3*i+1]];
+			const core::vector3df& v2 = Vertices[Indices[3*i+2]];
+
+			if ( !isDirectional )
+				lightDir = (v0-light).normalize();
 #ifdef IRR_USE_REVERSE_EXTRUDED
-		FaceData[i]=core::triangle3df(v2,v1,v0).isFrontFacing(lightDir0);	// actually the back-facing polygons
+			faceData[i] = core::triangle3df(v2,v1,v0).isFrontFacing(lightDir);	// actually the back-facing polygons
 #else
-		FaceData[i]=core::triangle3df(v0,v1,v2).isFrontFacing(lightDir0);
+			faceData[i] = core::triangle3df(v0,v1,v2).isFrontFacing(lightDir);
 #endif
+		}
+	}
 
-#if 0	// Useful for internal debugging & testing. Show all the faces in the light.
-		if ( FaceData[i] )
+	// Add front and back caps of the faces in the light
+	if (UseZFailMethod)
+	{
+		core::vector3df lightDir0(light);
+		core::vector3df lightDir1(light);
+		core::vector3df lightDir2(light);
+		for (u32 i=0; i<faceCount; ++i)
 		{
+			if (!faceData[i])
+				continue;
+
+			const core::vector3df v0 = Vertices[Indices[3*i+0]];
+			const core::vector3df v1 = Vertices[Indices[3*i+1]];
+			const core::vector3df v2 = Vertices[Indices[3*i+2]];
+
+			if ( !isDirectional )
+			{
+				lightDir0 = (v0-light).normalize();
+				lightDir1 = (v1-light).normalize();
+				lightDir2 = (v2-light).normalize();
+			}
+
+#if 0	// Useful for internal debugging & testing. Show all the faces in the light.
 			video::SMaterial m;
 			m.Lighting = false;
 			SceneManager->getVideoDriver()->setMaterial(m);
@@ -158,11 +246,8 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light, boo
 #else
 			SceneManager->getVideoDriver()->draw3DTriangle(core::triangle3df(v0-lightDir0,v1-lightDir0,v2-lightDir0), irr::video::SColor(255,255, 0, 0));
 #endif
-		}
 #endif
 
-		if (UseZFailMethod && FaceData[i])
-		{
 #ifdef _DEBUG
 			if (svp->size() >= svp->allocated_size()-5)
 				os::Printer::log("Allocation too small.", ELL_DEBUG);
@@ -173,11 +258,6 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light, boo
 			svp->push_back(v0);
 
 			// add back cap
-			if ( !isDirectional )
-			{
-				lightDir1 = (v1-light).normalize();
-				lightDir2 = (v2-light).normalize();
-			}
 			const core::vector3df i0 = v0+lightDir0*Infinity;
 			const core::vector3df i1 = v1+lightDir1*Infinity;
 			const core::vector3df i2 = v2+lightDir2*Infinity;
@@ -196,58 +276,58 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light, boo
 	for (u32 i=0; i<faceCount; ++i)
 	{
 		// check all front facing faces
-		if (FaceData[i] == true)
+		if (faceData[i] == true)
 		{
-			const u16 wFace0 = Indices[3*i+0];
-			const u16 wFace1 = Indices[3*i+1];
-			const u16 wFace2 = Indices[3*i+2];
+			const u32 wFace0 = Indices[3*i+0];
+			const u32 wFace1 = Indices[3*i+1];
+			const u32 wFace2 = Indices[3*i+2];
 
 			if ( Optimization == ESV_NONE )
 			{
 				// add edge v0-v1
-				Edges[2*numEdges+0] = wFace0;
-				Edges[2*numEdges+1] = wFace1;
+				edges[2*numEdges+0] = wFace0;
+				edges[2*numEdges+1] = wFace1;
 				++numEdges;
 
 				// add edge v1-v2
-				Edges[2*numEdges+0] = wFace1;
-				Edges[2*numEdges+1] = wFace2;
+				edges[2*numEdges+0] = wFace1;
+				edges[2*numEdges+1] = wFace2;
 				++numEdges;
 
 				// add edge v2-v0
-				Edges[2*numEdges+0] = wFace2;
-				Edges[2*numEdges+1] = wFace0;
+				edges[2*numEdges+0] = wFace2;
+				edges[2*numEdges+1] = wFace0;
 				++numEdges;
 			}
 			else
 			{
-				const u16 adj0 = Adjacency[3*i+0];
-				const u16 adj1 = Adjacency[3*i+1];
-				const u16 adj2 = Adjacency[3*i+2];
+				const u32 adj0 = Adjacency[3*i+0];
+				const u32 adj1 = Adjacency[3*i+1];
+				const u32 adj2 = Adjacency[3*i+2];
 
 				// add edges if face is adjacent to back-facing face
 				// or if no adjacent face was found
-				if (adj0 == i || FaceData[adj0] == false)
+				if (adj0 == i || faceData[adj0] == false)
 				{
 					// add edge v0-v1
-					Edges[2*numEdges+0] = wFace0;
-					Edges[2*numEdges+1] = wFace1;
+					edges[2*numEdges+0] = wFace0;
+					edges[2*numEdges+1] = wFace1;
 					++numEdges;
 				}
 
-				if (adj1 == i || FaceData[adj1] == false)
+				if (adj1 == i || faceData[adj1] == false)
 				{
 					// add edge v1-v2
-					Edges[2*numEdges+0] = wFace1;
-					Edges[2*numEdges+1] = wFace2;
+					edges[2*numEdges+0] = wFace1;
+					edges[2*numEdges+1] = wFace2;
 					++numEdges;
 				}
 
-				if (adj2 == i || FaceData[adj2] == false)
+				if (adj2 == i || faceData[adj2] == false)
 				{
 					// add edge v2-v0
-					Edges[2*numEdges+0] = wFace2;
-					Edges[2*numEdges+1] = wFace0;
+					edges[2*numEdges+0] = wFace2;
+					edges[2*numEdges+1] = wFace0;
 					++numEdges;
 				}
 			}
@@ -264,6 +344,7 @@ void CShadowVolumeSceneNode::setShadowMesh(const IMesh* mesh)
 	if (ShadowMesh)
 		ShadowMesh->drop();
 	ShadowMesh = mesh;
+	MeshDirtyFlag = true;
 	if (ShadowMesh)
 	{
 		ShadowMesh->grab();
@@ -272,24 +353,24 @@ void CShadowVolumeSceneNode::setShadowMesh(const IMesh* mesh)
 }
 
 
-void CShadowVolumeSceneNode::updateShadowVolumes()
+void CShadowVolumeSceneNode::setStatic(bool isStatic)
+{
+	// the jobs of the last update check which face normals to use
+	waitForShadowVolumes();
+	IsStatic = isStatic;
+	MeshDirtyFlag = true;
+}
+
+
+bool CShadowVolumeSceneNode::copyMesh()
 {
 	const u32 oldIndexCount = IndexCount;
 	const u32 oldVertexCount = VertexCount;
 
 	VertexCount = 0;
 	IndexCount = 0;
-	ShadowVolumesUsed = 0;
 
 	const IMesh* const mesh = ShadowMesh;
-	if (!mesh)
-		return;
-
-	// create as much shadow volumes as there are lights but
-	// do not ignore the max light settings.
-	const u32 lightCount = SceneManager->getVideoDriver()->getDynamicLightCount();
-	if (!lightCount)
-		return;
 
 	// calculate total amount of vertices and indices
 
@@ -301,42 +382,42 @@ void CShadowVolumeSceneNode::updateShadowVolumes()
 	for (i=0; i<bufcnt; ++i)
 	{
 		const IMeshBuffer* buf = mesh->getMeshBuffer(i);
-		if (	buf->getIndexType() == video::EIT_16BIT 
-			&& buf->getPrimitiveType() == scene::EPT_TRIANGLES )
+		if ( buf->getPrimitiveType() == scene::EPT_TRIANGLES )
 		{
 			totalIndices += buf->getIndexCount();
 			totalVertices += buf->getVertexCount();
 		}
 		else
 		{
-			os::Printer::log("ShadowVolumeSceneNode only supports meshbuffers with 16 bit indices and triangles", ELL_WARNING);
-			return;
+			os::Printer::log("ShadowVolumeSceneNode only supports meshbuffers with triangles", ELL_WARNING);
+			return false;
 		}
 	}
-	if ( totalIndices != (u32)(u16)totalIndices)
-	{
-		// We could switch to 32-bit indices, not much work and just bit of extra memory (< 192k) per shadow volume.
-		// If anyone ever complains and really needs that just switch it. But huge shadows are usually a bad idea as they will be slow.
-		os::Printer::log("ShadowVolumeSceneNode does not yet support shadowvolumes which need more than 16 bit indices", ELL_WARNING);
-		return;
-	}
 
 	// allocate memory if necessary
 
 	Vertices.set_used(totalVertices);
 	Indices.set_used(totalIndices);
-	FaceData.set_used(totalIndices / 3);
 
-	// copy mesh 
-	// (could speed this up for static meshes by adding some user flag to prevents copying)
+	// copy mesh, the indices of all meshbuffers together might need 32 bit
 	for (i=0; i<bufcnt; ++i)
 	{
 		const IMeshBuffer* buf = mesh->getMeshBuffer(i);
 
-		const u16* idxp = buf->getIndices();
-		const u16* idxpend = idxp + buf->getIndexCount();
-		for (; idxp!=idxpend; ++idxp)
-			Indices[IndexCount++] = *idxp + VertexCount;
+		if ( buf->getIndexType() == video::EIT_16BIT )
+		{
+			const u16* idxp = buf->getIndices();
+			const u16* idxpend = idxp + buf->getIndexCount();
+			for (; idxp!=idxpend; ++idxp)
+				Indices[IndexCount++] = *idxp + VertexCount;
+		}
+		else
+		{
+			const u32* idxp = (const u32*)buf->getIndices();
+			const u32* idxpend = idxp + buf->getIndexCount();
+			for (; idxp!=idxpend; ++idxp)
+				Indices[IndexCount++] = *idxp + VertexCount;
+		}
 
 		const u32 vtxcnt = buf->getVertexCount();
 		for (u32 j=0; j<vtxcnt; ++j)
@@ -344,15 +425,71 @@ void CShadowVolumeSceneNode::updateShadowVolumes()
 	}
 
 	// recalculate adjacency if necessary
-	if (oldVertexCount != VertexCount || oldIndexCount != IndexCount || AdjacencyDirtyFlag)
+	if (oldVertexCount != VertexCount || oldIndexCount != IndexCount || AdjacencyDirtyFlag || MeshDirtyFlag)
 		calculateAdjacency();
 
+	// the face normals don't depend on the light, so static meshes keep them
+	// for all updates. Other meshes calculate them while checking the faces.
+	FaceNormals.set_used(IsStatic ? IndexCount / 3 : 0);
+	for (i=0; i<FaceNormals.size(); ++i)
+	{
+		const core::vector3df& v0 = Vertices[Indices[3*i+0]];
+		const core::vector3df& v1 = Vertices[Indices[3*i+1]];
+		const core::vector3df& v2 = Vertices[Indices[3*i+2]];
+#ifdef IRR_USE_REVERSE_EXTRUDED
+		FaceNormals[i] = core::triangle3df(v2,v1,v0).getNormal().normalize();	// actually the back-facing polygons
+#else
+		FaceNormals[i] = core::triangle3df(v0,v1,v2).getNormal().normalize();
+#endif
+	}
+
+	// volumes of the old copy can't be used anymore
+	if (MeshDirtyFlag)
+	{
+		ShadowVolumes.clear();
+		ShadowBBox.clear();
+		ShadowVolumeLights.clear();
+		MeshDirtyFlag = false;
+	}
+
+	return true;
+}
+
+
+void CShadowVolumeSceneNode::waitForShadowVolumes()
+{
+	if (JobSystem)
+		JobSystem->wait(Jobs);
+}
+
+
+void CShadowVolumeSceneNode::updateShadowVolumes()
+{
+	// the jobs of the last update still use the buffers
+	waitForShadowVolumes();
+
+	ShadowVolumesUsed = 0;
+
+	const IMesh* const mesh = ShadowMesh;
+	if (!mesh)
+		return;
+
+	// create as much shadow volumes as there are lights but
+	// do not ignore the max light settings.
+	const u32 lightCount = SceneManager->getVideoDriver()->getDynamicLightCount();
+	if (!lightCount)
+		return;
+
+	// static meshes are only copied once
+	if ((!IsStatic || MeshDirtyFlag) && !copyMesh())
+		return;
+
 	core::matrix4 matInv(Parent->getAbsoluteTransformation());
 	matInv.makeInverse();
 	core::matrix4 matTransp(Parent->getAbsoluteTransformation(), core::matrix4::EM4CONST_TRANSPOSED);
 	const core::vector3df parentpos = Parent->getAbsolutePosition();
 
-	for (i=0; i<lightCount; ++i)
+	for (u32 i=0; i<lightCount; ++i)
 	{
 		const video::SLight& dl = SceneManager->getVideoDriver()->getDynamicLight(i);
 
@@ -360,7 +497,7 @@ void CShadowVolumeSceneNode::updateShadowVolumes()
 		{
 			core::vector3df ldir(dl.Direction);
 			matTransp.transformVect(ldir);
-			createShadowVolume(ldir, true);
+			addShadowVolume(ldir, true);
 		}
 		else
 		{
@@ -369,18 +506,33 @@ void CShadowVolumeSceneNode::updateShadowVolumes()
 				fabs((lpos - parentpos).getLengthSQ()) <= (dl.Radius*dl.Radius*4.0f))
 			{
 				matInv.transformVect(lpos);
-				createShadowVolume(lpos, false);
+				addShadowVolume(lpos, false);
 			}
 		}
 	}
+
+	// Build the volumes in jobs, so they get built while other nodes are rendered.
+	// render() waits for them.
+	for (u32 i=0; i<ShadowVolumesUsed; ++i)
+	{
+		if (!ShadowVolumeLights[i].Update)
+			continue;
+
+		if (JobSystem)
+			JobSystem->addJob(createShadowVolumeJob, &ShadowVolumeLights[i], &Jobs);
+		else
+			createShadowVolume(i);
+	}
 }
 
 void CShadowVolumeSceneNode::setOptimization(ESHADOWVOLUME_OPTIMIZATION optimization)
 {
 	if ( Optimization != optimization )
 	{
+		waitForShadowVolumes();
 		Optimization = optimization;
 		AdjacencyDirtyFlag = true;
+		MeshDirtyFlag = true;
 	}
 }
 
@@ -397,6 +549,8 @@ void CShadowVolumeSceneNode::OnRegisterSceneNode()
 //! renders the node.
 void CShadowVolumeSceneNode::render()
 {
+	waitForShadowVolumes();
+
 	video::IVideoDriver* driver = SceneManager->getVideoDriver();
 
 	if (!ShadowVolumesUsed || !driver)
@@ -6,6 +6,7 @@
 #define IRR_C_SHADOW_VOLUME_SCENE_NODE_H_INCLUDED
 
 #include "IShadowVolumeSceneNode.h"
+#include "IJobSystem.h"
 
 namespace irr
 {
@@ -44,6 +45,15 @@ namespace scene
 			return Optimization;
 		}
 
+		//! Set if the shadow mesh never changes
+		virtual void setStatic(bool isStatic) IRR_OVERRIDE;
+
+		//! Check if the shadow mesh is static
+		virtual bool isStatic() const IRR_OVERRIDE
+		{
+			return IsStatic;
+		}
+
 		//! pre render method
 		virtual void OnRegisterSceneNode() IRR_OVERRIDE;
 
@@ -60,8 +70,34 @@ namespace scene
 
 		typedef core::array<core::vector3df> SShadowVolume;
 
-		void createShadowVolume(const core::vector3df& pos, bool isDirectional);
-		u32 createEdgesAndCaps(const core::vector3df& light, bool isDirectional, SShadowVolume* svp, core::aabbox3d<f32>* bb);
+		//! Light of a shadow volume and the buffers of the job creating it
+		struct SShadowVolumeLight
+		{
+			SShadowVolumeLight() : IsDirectional(false), Update(false), Node(0), Index(0) {}
+
+			// light position or direction in mesh space
+			core::vector3df Light;
+			bool IsDirectional;
+			// volume has to be created again
+			bool Update;
+
+			CShadowVolumeSceneNode* Node;
+			u32 Index;
+			core::array<u32> Edges;
+			// tells if face is front facing
+			core::array<bool> FaceData;
+		};
+
+		//! Copies positions and indices of the shadow mesh, false when the mesh can't be used.
+		bool copyMesh();
+
+		//! Waits until the shadow volumes of the last update are created.
+		void waitForShadowVolumes();
+
+		void addShadowVolume(const core::vector3df& light, bool isDirectional);
+		static void createShadowVolumeJob(void* data);
+		void createShadowVolume(u32 index);
+		u32 createEdgesAndCaps(SShadowVolumeLight& volumeLight, SShadowVolume* svp, core::aabbox3d<f32>* bb);
 
 		//! Generates adjacency information based on mesh indices.
 		void calculateAdjacency();
@@ -74,13 +110,17 @@ namespace scene
 		// a back cap bounding box for every light
 		core::array<core::aabbox3d<f32> > ShadowBBox;
 
+		// the light of every shadow volume
+		core::array<SShadowVolumeLight> ShadowVolumeLights;
+
 		core::array<core::vector3df> Vertices;
-		core::array<u16> Indices;
-		core::array<u16> Adjacency;
-		core::array<u16> Edges;
-		// tells if face is front facing
-		core::array<bool> FaceData;
+		core::array<u32> Indices;
+		core::array<u32> Adjacency;
+		// face normals, the same for all lights
+		core::array<core::vector3df> FaceNormals;
 		bool AdjacencyDirtyFlag;
+		bool MeshDirtyFlag;
+		bool IsStatic;
 
 		const scene::IMesh* ShadowMesh;
 
@@ -91,6 +131,10 @@ namespace scene
 		f32 Infinity;
 		bool UseZFailMethod;
 		ESHADOWVOLUME_OPTIMIZATION Optimization;
+
+		// creates the shadow volumes, counts the unfinished ones
+		core::IJobSystem* JobSystem;
+		core::SJobCounter Jobs;
 	};
 
 } // end namespace scene
@@ -561,6 +561,19 @@ void CSkinnedMesh::skinMesh()
 }
 
 
+//! Returns how many vertices the next skinMesh() call transforms in software
+u32 CSkinnedMesh::getVerticesToSkin() const
+{
+	if (!HasAnimation || SkinnedLastFrame || HardwareSkinning)
+		return 0;
+
+	u32 count = 0;
+	for (u32 i=0; i<SkinningBuffers->size(); ++i)
+		count += (*SkinningBuffers)[i]->getVertexCount();
+	return count;
+}
+
+
 void CSkinnedMesh::skinJoint(SJoint *joint, SJoint *parentJoint)
 {
 	if (joint->Weights.size())
@@ -51,6 +51,9 @@ namespace scene
 		//! Preforms a software skin on this mesh based of joint positions
 		virtual void skinMesh() IRR_OVERRIDE;
 
+		//! Returns how many vertices the next skinMesh() call transforms in software
+		u32 getVerticesToSkin() const;
+
 		//! returns amount of mesh buffers.
 		virtual u32 getMeshBufferCount() const IRR_OVERRIDE;
 
@@ -219,6 +219,7 @@ void CSoftwareDriver::setMaterial(const SMaterial& material)
 {
 	Material = material;
 	OverrideMaterial.apply(Material);
+	countMaterialChange(Material);
 
 	for (u32 i = 0; i < 1; ++i)
 	{
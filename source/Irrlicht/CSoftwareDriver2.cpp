@@ -549,6 +549,9 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 	setDebugName("CBurningVideoDriver");
 #endif
 
+	// the 2d drawing can be recorded into batches, see beginRecording2D
+	CanRecord2D = true;
+
 	VertexCache_map_source_format();
 
 	//Use AntiAlias(hack) to shrink BackBuffer Size and keep ScreenSize the same as Input
@@ -2756,6 +2759,9 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 	E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType, E_INDEX_TYPE iType)
 
 {
+	if (failRecording2D())
+		return;
+
 	if (!checkPrimitiveCount(primitiveCount))
 		return;
 
@@ -3250,6 +3256,7 @@ void CBurningVideoDriver::setMaterial(const SMaterial& material)
 	// ---------- Override
 	Material.org = material;
 	OverrideMaterial.apply(Material.org);
+	countMaterialChange(Material.org);
 
 	const SMaterial& in = Material.org;
 
@@ -3785,6 +3792,9 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 	const core::rect<s32>* clipRect, SColor color,
 	bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destPos, sourceRect, clipRect, color, useAlphaChannelOfTexture))
+		return;
+
 	if (texture)
 	{
 		if (texture->getOriginalSize() != texture->getSize())
@@ -3818,6 +3828,9 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture,
 	const core::rect<s32>* clipRect,
 	const video::SColor* const colors, bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destRect, sourceRect, clipRect, colors, useAlphaChannelOfTexture))
+		return;
+
 	if (texture)
 	{
 		if (texture->getDriverType() != EDT_BURNINGSVIDEO)
@@ -3842,6 +3855,9 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<s32>& position,
 	SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
 	const core::rect<s32>* clip)
 {
+	if (record2DRectangle(position, colorLeftUp, colorRightUp, colorLeftDown, colorRightDown, clip))
+		return;
+
 	core::rect<s32> p(position);
 	if (clip) p.clipAgainst(*clip);
 	if (p.isValid()) drawRectangle(RenderTargetSurface, p, colorLeftUp);
@@ -3979,11 +3995,13 @@ void CBurningVideoDriver::draw2DVertexPrimitiveList(const void* vertices, u32 ve
 	const void* indexList, u32 primitiveCount,
 	E_VERTEX_TYPE vType, scene::E_PRIMITIVE_TYPE pType, E_INDEX_TYPE iType)
 {
-	if (!checkPrimitiveCount(primitiveCount))
+	if (failRecording2D())
 		return;
 
-	CNullDriver::draw2DVertexPrimitiveList(vertices, vertexCount, indexList, primitiveCount, vType, pType, iType);
+	if (!checkPrimitiveCount(primitiveCount))
+		return;
 
+	// counted as draw call by drawVertexPrimitiveList below
 	bool useAlphaChannelOfTexture = false;
 	video::SColor color(0xFFFFFFFF);
 	switch (Material.org.MaterialType)
@@ -3994,6 +4012,19 @@ void CBurningVideoDriver::draw2DVertexPrimitiveList(const void* vertices, u32 ve
 	case EMT_TRANSPARENT_VERTEX_ALPHA:
 		color.setAlpha(127);
 		break;
+	case EMT_ONETEXTURE_BLEND:
+	{
+		// used by draw2DVertexBatches
+		E_BLEND_FACTOR srcFact;
+		E_BLEND_FACTOR dstFact;
+		E_MODULATE_FUNC modulo;
+		u32 alphaSource;
+		unpack_textureBlendFunc(srcFact, dstFact, modulo, alphaSource, Material.org.MaterialTypeParam);
+		useAlphaChannelOfTexture = (alphaSource & EAS_TEXTURE) != 0;
+		if (alphaSource & EAS_VERTEX_COLOR)
+			color.setAlpha(127);
+	}
+	break;
 	default:
 		break;
 	}
@@ -4020,6 +4051,9 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 	const core::rect<s32>* clipRect, SColor color,
 	bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destPos, sourceRect, clipRect, color, useAlphaChannelOfTexture))
+		return;
+
 	if (!texture)
 		return;
 
@@ -4085,6 +4119,9 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 	const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
 	const video::SColor* const colors, bool useAlphaChannelOfTexture)
 {
+	if (record2DImage(texture, destRect, sourceRect, clipRect, colors, useAlphaChannelOfTexture))
+		return;
+
 	if (!texture)
 		return;
 
@@ -4157,6 +4194,9 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<s32>& position,
 	SColor colorLeftUp, SColor colorRightUp, SColor colorLeftDown, SColor colorRightDown,
 	const core::rect<s32>* clip)
 {
+	if (record2DRectangle(position, colorLeftUp, colorRightUp, colorLeftDown, colorRightDown, clip))
+		return;
+
 	core::rect<s32> pos = position;
 
 	if (clip)
@@ -4209,6 +4249,9 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<s32>& start,
 	const core::position2d<s32>& end,
 	SColor color)
 {
+	if (failRecording2D())
+		return;
+
 	drawLine(RenderTargetSurface, start, end, color);
 }
 
@@ -4216,6 +4259,9 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<s32>& start,
 //! Draws a pixel
 void CBurningVideoDriver::drawPixel(u32 x, u32 y, const SColor& color)
 {
+	if (failRecording2D())
+		return;
+
 	RenderTargetSurface->setPixel(x, y, color, true);
 }
 
@@ -4270,6 +4316,9 @@ const core::dimension2d<u32>& CBurningVideoDriver::getCurrentRenderTargetSize()
 void CBurningVideoDriver::draw3DLine(const core::vector3df& start,
 	const core::vector3df& end, SColor color_start)
 {
+	if (failRecording2D())
+		return;
+
 	SColor color_end = color_start;
 
 	VertexShader.primitiveHasVertex = 2;
@@ -4433,6 +4482,9 @@ ITexture* CBurningVideoDriver::addRenderTargetTexture(const core::dimension2d<u3
 
 void CBurningVideoDriver::clearBuffers(u16 flag, SColor color, f32 depth, u8 stencil)
 {
+	if (failRecording2D())
+		return;
+
 	if ((flag & ECBF_COLOR) && RenderTargetSurface) image_fill(RenderTargetSurface, color, Interlaced);
 	if ((flag & ECBF_DEPTH) && DepthBuffer) DepthBuffer->clear(depth, Interlaced);
 	if ((flag & ECBF_STENCIL) && StencilBuffer) StencilBuffer->clear(stencil, Interlaced);
@@ -4513,6 +4565,9 @@ u32 CBurningVideoDriver::getMaximalPrimitiveCount() const
 //! volume. Next use IVideoDriver::drawStencilShadow() to visualize the shadow.
 void CBurningVideoDriver::drawStencilShadowVolume(const core::array<core::vector3df>& triangles, bool zfail, u32 debugDataVisible)
 {
+	if (failRecording2D())
+		return;
+
 	const u32 count = triangles.size();
 	if (!StencilBuffer || !count)
 		return;
@@ -4577,6 +4632,9 @@ void CBurningVideoDriver::drawStencilShadowVolume(const core::array<core::vector
 void CBurningVideoDriver::drawStencilShadow(bool clearStencilBuffer, video::SColor leftUpEdge,
 	video::SColor rightUpEdge, video::SColor leftDownEdge, video::SColor rightDownEdge)
 {
+	if (failRecording2D())
+		return;
+
 	if (!StencilBuffer)
 		return;
 
@@ -29,6 +29,12 @@ namespace irr
 			return os::Timer::getRealTime();
 		}
 
+		//! Returns current real time in nanoseconds of the system.
+		virtual u64 getRealTimeNanoseconds() const IRR_OVERRIDE
+		{
+			return os::Timer::getRealTimeNanoseconds();
+		}
+
 		//! Get current time and date in calendar form
 		virtual RealTimeDate getRealTimeAndDate() const IRR_OVERRIDE
 		{
@@ -11,6 +11,7 @@
 
 #include "CFileList.h"
 #include "CReadFile.h"
+#include "IMemoryReadFile.h"
 #include "coreutil.h"
 
 #include "IrrCompileConfig.h"
@@ -663,11 +664,19 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				return 0;
 			}
 
-			u8 *pcData = decryptedBuf;
-			if (!pcData)
+			const u8 *pcData = decryptedBuf;
+			u8 *pcDataCopy = 0;
+			const IMemoryReadFile* memoryFile = getMemoryReadFile(File);
+			if (!pcData && memoryFile && e.Offset + (long)decryptedSize <= File->getSize())
 			{
-				pcData = new u8[decryptedSize];
-				if (!pcData)
+				// Inflate directly from the archive memory. This also leaves the
+				// archive's read position alone, so it works from several threads.
+				pcData = static_cast<const u8*>(memoryFile->getBuffer()) + e.Offset;
+			}
+			else if (!pcData)
+			{
+				pcDataCopy = new u8[decryptedSize];
+				if (!pcDataCopy)
 				{
 					swprintf_irr ( buf, 64, L"Not enough memory for decompressing %s", core::stringw(Files[index].FullName).c_str() );
 					os::Printer::log( buf, ELL_ERROR);
@@ -675,9 +684,9 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 					return 0;
 				}
 
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
+				//memset(pcDataCopy, 0, decryptedSize);
+				readFileAt(File, pcDataCopy, decryptedSize, e.Offset);
+				pcData = pcDataCopy;
 			}
 
 			// Setup the inflate stream.
@@ -705,8 +714,7 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 
 			if (decrypted)
 				decrypted->drop();
-			else
-				delete[] pcData;
+			delete[] pcDataCopy;
 
 			if (err != Z_OK)
 			{
@@ -48,7 +48,11 @@ namespace irr
 		EPID_ES2_SET_RENDERSTATE_3D,
 		EPID_ES2_SET_RENDERSTATE_BASIC,
 		EPID_ES2_SET_RENDERSTATE_TEXTURE,
-		EPID_ES2_DRAW_SHADOW
+		EPID_ES2_DRAW_SHADOW,
+
+		//! job system
+		EPID_JOB_WAIT,
+		EPID_JOB_PARALLEL_FOR
     };
 } // end namespace irr
 
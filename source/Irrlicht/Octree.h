@@ -57,11 +57,33 @@ public:
 		s32 MaterialId;
 	};
 
+	//! Range of indices in the sorted indices of a meshbuffer
+	struct SIndexRange
+	{
+		bool operator!=(const SIndexRange& other) const
+		{
+			return Offset != other.Offset || Count != other.Count;
+		}
+
+		u32 Offset;
+		u32 Count;
+	};
+
 	struct SIndexData
 	{
+		//! All indices of the meshbuffer, sorted so that each node and
+		//! each subtree owns a contiguous range.
 		u16* Indices;
+		//! Number of visible indices
 		s32 CurrentSize;
+		//! Number of all indices
 		s32 MaxSize;
+		//! Visible ranges of Indices, adjacent ranges are merged
+		core::array<SIndexRange> Ranges;
+		//! True when Ranges differ from the ones of the calculatePolys call before
+		bool Changed;
+		//! Ranges of the calculatePolys call before
+		core::array<SIndexRange> PreviousRanges;
 	};
 
 
@@ -80,6 +102,7 @@ public:
 			IndexData[i].CurrentSize = 0;
 			IndexData[i].MaxSize = meshes[i].Indices.size();
 			IndexData[i].Indices = new u16[IndexData[i].MaxSize];
+			IndexData[i].Changed = false;
 
 			indexChunks->push_back(SIndexChunk());
 			SIndexChunk& tic = indexChunks->getLast();
@@ -90,26 +113,29 @@ public:
 
 		// create tree
 		Root = new OctreeNode(NodeCount, 0, meshes, indexChunks, minimalPolysPerNode);
+
+		// move the indices of all nodes into one array per meshbuffer
+		Root->sortIndices(IndexData, IndexDataCount);
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			IndexData[i].CurrentSize = 0;
 	}
 
 	//! returns all ids of polygons partially or fully enclosed
 	//! by this bounding box.
 	void calculatePolys(const core::aabbox3d<f32>& box)
 	{
-		for (u32 i=0; i!=IndexDataCount; ++i)
-			IndexData[i].CurrentSize = 0;
-
+		beginRanges();
 		Root->getPolys(box, IndexData, 0);
+		endRanges();
 	}
 
 	//! returns all ids of polygons partially or fully enclosed
 	//! by a view frustum.
 	void calculatePolys(const scene::SViewFrustum& frustum)
 	{
-		for (u32 i=0; i!=IndexDataCount; ++i)
-			IndexData[i].CurrentSize = 0;
-
+		beginRanges();
 		Root->getPolys(frustum, IndexData, 0);
+		endRanges();
 	}
 
 	const SIndexData* getIndexData() const
@@ -127,6 +153,20 @@ public:
 		return NodeCount;
 	}
 
+	//! copies the visible ranges of a meshbuffer into one array
+	void copyVisibleIndices(u32 index, core::array<u16>& outIndices) const
+	{
+		const SIndexData& d = IndexData[index];
+		outIndices.set_used(d.CurrentSize);
+
+		u16* out = outIndices.pointer();
+		for (u32 r=0; r<d.Ranges.size(); ++r)
+		{
+			memcpy(out, d.Indices + d.Ranges[r].Offset, d.Ranges[r].Count * sizeof(u16));
+			out += d.Ranges[r].Count;
+		}
+	}
+
 	//! for debug purposes only, collects the bounding boxes of the tree
 	void getBoundingBoxes(const core::aabbox3d<f32>& box,
 		core::array< const core::aabbox3d<f32>* >&outBoxes) const
@@ -145,6 +185,23 @@ public:
 	}
 
 private:
+
+	void beginRanges()
+	{
+		for (u32 i=0; i!=IndexDataCount; ++i)
+		{
+			IndexData[i].CurrentSize = 0;
+			IndexData[i].PreviousRanges.swap(IndexData[i].Ranges);
+			IndexData[i].Ranges.set_used(0);
+		}
+	}
+
+	void endRanges()
+	{
+		for (u32 i=0; i!=IndexDataCount; ++i)
+			IndexData[i].Changed = IndexData[i].Ranges != IndexData[i].PreviousRanges;
+	}
+
 	// private inner class
 	class OctreeNode
 	{
@@ -269,6 +326,39 @@ private:
 				delete Children[i];
 		}
 
+		// appends the indices of this node and then of its children to the
+		// indices of the tree, remembers the ranges and frees the own copy
+		void sortIndices(SIndexData* idxdata, u32 count)
+		{
+			Ranges.set_used(count);
+
+			u32 i;
+			for (i=0; i!=count; ++i)
+			{
+				Ranges[i].Begin = idxdata[i].CurrentSize;
+				Ranges[i].Count = 0;
+
+				if (IndexData && i < IndexData->size())
+				{
+					const core::array<u16>& own = (*IndexData)[i].Indices;
+					Ranges[i].Count = own.size();
+					if (!own.empty())
+						memcpy(&idxdata[i].Indices[idxdata[i].CurrentSize], own.const_pointer(), own.size() * sizeof(u16));
+					idxdata[i].CurrentSize += own.size();
+				}
+			}
+
+			delete IndexData;
+			IndexData = 0;
+
+			for (i=0; i!=8; ++i)
+				if (Children[i])
+					Children[i]->sortIndices(idxdata, count);
+
+			for (i=0; i!=count; ++i)
+				Ranges[i].TreeCount = idxdata[i].CurrentSize - Ranges[i].Begin;
+		}
+
 		// returns all ids of polygons partially or full enclosed
 		// by this bounding box.
 		void getPolys(const core::aabbox3d<f32>& box, SIndexData* idxdata, u32 parentTest ) const
@@ -284,29 +374,22 @@ private:
 				// fully inside ?
 				parentTest = Box.isFullInside(box)?2:1;
 			}
+
+			// the whole subtree is inside, so its indices are one range
+			if ( parentTest == 2 )
+			{
+				addRanges(idxdata, true);
+				return;
+			}
 #else
-			if (Box.intersectsWithBox(box))
+			if (!Box.intersectsWithBox(box))
+				return;
 #endif
-			{
-				const u32 cnt = IndexData->size();
-				u32 i; // new ISO for scoping problem in some compilers
-
-				for (i=0; i<cnt; ++i)
-				{
-					const s32 idxcnt = (*IndexData)[i].Indices.size();
-
-					if (idxcnt)
-					{
-						memcpy(&idxdata[i].Indices[idxdata[i].CurrentSize],
-							&(*IndexData)[i].Indices[0], idxcnt * sizeof(s16));
-						idxdata[i].CurrentSize += idxcnt;
-					}
-				}
+			addRanges(idxdata, false);
 
-				for (i=0; i!=8; ++i)
-					if (Children[i])
-						Children[i]->getPolys(box, idxdata,parentTest);
-			}
+			for (u32 i=0; i!=8; ++i)
+				if (Children[i])
+					Children[i]->getPolys(box, idxdata,parentTest);
 		}
 
 		// returns all ids of polygons partially or full enclosed
@@ -335,20 +418,15 @@ private:
 				}
 			}
 
-
-			const u32 cnt = IndexData->size();
-
-			for (i=0; i!=cnt; ++i)
+#if defined (OCTREE_PARENTTEST )
+			// the whole subtree is inside, so its indices are one range
+			if ( parentTest == 2 )
 			{
-				s32 idxcnt = (*IndexData)[i].Indices.size();
-
-				if (idxcnt)
-				{
-					memcpy(&idxdata[i].Indices[idxdata[i].CurrentSize],
-						&(*IndexData)[i].Indices[0], idxcnt * sizeof(s16));
-					idxdata[i].CurrentSize += idxcnt;
-				}
+				addRanges(idxdata, true);
+				return;
 			}
+#endif
+			addRanges(idxdata, false);
 
 			for (i=0; i!=8; ++i)
 				if (Children[i])
@@ -371,8 +449,40 @@ private:
 
 	private:
 
+		// adds the range of this node or of the whole subtree
+		void addRanges(SIndexData* idxdata, bool subtree) const
+		{
+			for (u32 i=0; i!=Ranges.size(); ++i)
+			{
+				const u32 count = subtree ? Ranges[i].TreeCount : Ranges[i].Count;
+				if (!count)
+					continue;
+
+				core::array<SIndexRange>& ranges = idxdata[i].Ranges;
+				if (!ranges.empty() && ranges.getLast().Offset + ranges.getLast().Count == Ranges[i].Begin)
+					ranges.getLast().Count += count;
+				else
+				{
+					SIndexRange range;
+					range.Offset = Ranges[i].Begin;
+					range.Count = count;
+					ranges.push_back(range);
+				}
+				idxdata[i].CurrentSize += count;
+			}
+		}
+
+		// indices of a meshbuffer owned by the node and its subtree
+		struct SNodeRange
+		{
+			u32 Begin;
+			u32 Count;
+			u32 TreeCount;
+		};
+
 		core::aabbox3df Box;
 		core::array<SIndexChunk>* IndexData;
+		core::array<SNodeRange> Ranges;
 		OctreeNode* Children[8];
 		u32 Depth;
 	};
@@ -0,0 +1,94 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+
+#include "irrPool.h"
+#include "irrSpinLock.h"
+
+namespace irr
+{
+namespace core
+{
+
+namespace
+{
+
+// Each pool has a spin lock. Only plain data here, so the pools are
+// usable before any constructor of a static object ran.
+struct SSizeClass
+{
+	irrPool* Pool;
+	s32 Lock;
+};
+
+const size_t SizeClassStep = 16;
+const u32 SizeClassCount = SMALL_OBJECT_MAX_SIZE / SizeClassStep;
+
+// Pools are never freed, objects in static containers may be destroyed
+// after this file's static data otherwise.
+SSizeClass SizeClasses[SizeClassCount];
+
+} // end anonymous namespace
+
+
+//! Allocate memory for a small object.
+void* IRRCALLCONV allocateSmallObject(size_t size)
+{
+	if (size > SMALL_OBJECT_MAX_SIZE || size == 0)
+		return operator new(size);
+
+	const u32 index = (u32)((size - 1) / SizeClassStep);
+	SSizeClass& sizeClass = SizeClasses[index];
+	lockSpin(sizeClass.Lock);
+	if (!sizeClass.Pool)
+		sizeClass.Pool = new irrPool((index + 1) * SizeClassStep);
+	void* ptr = sizeClass.Pool->allocate();
+	unlockSpin(sizeClass.Lock);
+	return ptr;
+}
+
+
+//! Free memory allocated by allocateSmallObject()
+void IRRCALLCONV deallocateSmallObject(void* ptr, size_t size)
+{
+	if (!ptr)
+		return;
+
+	if (size > SMALL_OBJECT_MAX_SIZE || size == 0)
+	{
+		operator delete(ptr);
+		return;
+	}
+
+	SSizeClass& sizeClass = SizeClasses[(size - 1) / SizeClassStep];
+	lockSpin(sizeClass.Lock);
+	sizeClass.Pool->deallocate(ptr);
+	unlockSpin(sizeClass.Lock);
+}
+
+
+//! Free memory allocated by allocateSmallObject() when the size is unknown
+void IRRCALLCONV deallocateSmallObject(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	for (u32 i=0; i<SizeClassCount; ++i)
+	{
+		SSizeClass& sizeClass = SizeClasses[i];
+		lockSpin(sizeClass.Lock);
+		const bool owned = sizeClass.Pool && sizeClass.Pool->owns(ptr);
+		if (owned)
+			sizeClass.Pool->deallocate(ptr);
+		unlockSpin(sizeClass.Lock);
+		if (owned)
+			return;
+	}
+
+	// not from a pool, so it was too big for them
+	operator delete(ptr);
+}
+
+} // end namespace core
+} // end namespace irr
@@ -0,0 +1,95 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef IRR_SPIN_LOCK_H_INCLUDED
+#define IRR_SPIN_LOCK_H_INCLUDED
+
+#include "IrrCompileConfig.h"
+#include "irrTypes.h"
+
+#if defined(_IRR_WINDOWS_API_)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#elif defined(__GNUC__)
+	#include <sched.h>
+#endif
+
+namespace irr
+{
+namespace core
+{
+
+// Spin locks for data which is only locked for a few instructions, where
+// spinning is cheaper than a mutex. A lock is a plain s32 which is 0 when
+// unlocked, so locks in static data work before any constructor ran.
+// They are used from all threads, also from application threads when the
+// engine itself runs no job threads, so they always lock.
+
+#if defined(_IRR_WINDOWS_API_)
+
+//! Try to take a spin lock, returns true when the lock was taken
+inline bool tryLockSpin(s32& lock)
+{
+	return InterlockedExchange(reinterpret_cast<volatile LONG*>(&lock), 1) == 0;
+}
+
+//! Give a spin lock back
+inline void unlockSpin(s32& lock)
+{
+	InterlockedExchange(reinterpret_cast<volatile LONG*>(&lock), 0);
+}
+
+inline void yieldSpin()
+{
+	SwitchToThread();
+}
+
+#elif defined(__GNUC__)
+
+//! Try to take a spin lock, returns true when the lock was taken
+inline bool tryLockSpin(s32& lock)
+{
+	return __atomic_exchange_n(&lock, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+//! Give a spin lock back
+inline void unlockSpin(s32& lock)
+{
+	__atomic_store_n(&lock, 0, __ATOMIC_RELEASE);
+}
+
+inline void yieldSpin()
+{
+	sched_yield();
+}
+
+#else
+
+// Targets without atomics have no threads either
+
+inline bool tryLockSpin(s32&)
+{
+	return true;
+}
+
+inline void unlockSpin(s32&)
+{
+}
+
+inline void yieldSpin()
+{
+}
+
+#endif
+
+//! Take a spin lock, waits until it's free
+inline void lockSpin(s32& lock)
+{
+	while (!tryLockSpin(lock))
+		yieldSpin();
+}
+
+} // end namespace core
+} // end namespace irr
+
+#endif
@@ -133,6 +133,20 @@ namespace os
 		return GetTickCount();
 	}
 
+	u64 Timer::getRealTimeNanoseconds()
+	{
+		// No affinity workaround here, this is called far too often by the profiler.
+		LARGE_INTEGER nTime;
+		if (HighPerformanceTimerSupport && QueryPerformanceCounter(&nTime))
+		{
+			const u64 count = nTime.QuadPart;
+			const u64 freq = HighPerformanceFreq.QuadPart;
+			return (count / freq) * 1000000000 + (count % freq) * 1000000000 / freq;
+		}
+
+		return (u64)GetTickCount() * 1000000;
+	}
+
 } // end namespace os
 
 
@@ -143,6 +157,7 @@ namespace os
 // ----------------------------------------------------------------
 
 #include <android/log.h>
+#include <time.h>
 
 namespace irr
 {
@@ -197,6 +212,13 @@ namespace os
 		gettimeofday(&tv, 0);
 		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	}
+
+	u64 Timer::getRealTimeNanoseconds()
+	{
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+	}
 } // end namespace os
 
 #elif defined(_IRR_EMSCRIPTEN_PLATFORM_)
@@ -249,6 +271,11 @@ namespace os
         double time = emscripten_get_now();
         return (u32)(time);
 	}
+
+	u64 Timer::getRealTimeNanoseconds()
+	{
+		return (u64)(emscripten_get_now() * 1000000.0);
+	}
 } // end namespace os
 
 #else
@@ -283,6 +310,13 @@ namespace os
 		gettimeofday(&tv, 0);
 		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	}
+
+	u64 Timer::getRealTimeNanoseconds()
+	{
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+	}
 } // end namespace os
 
 #endif // end linux / emscripten / android / windows
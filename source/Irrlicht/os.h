@@ -116,6 +116,9 @@ namespace os
 		//! returns the current real time in milliseconds
 		static u32 getRealTime();
 
+		//! returns the current real time in nanoseconds from a monotonic clock
+		static u64 getRealTimeNanoseconds();
+
 	private:
 
 		static void initVirtualTimer();
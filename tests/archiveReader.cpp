@@ -1,5 +1,11 @@
 #include "testUtils.h"
 
+#if defined(_IRR_WINDOWS_API_)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 using namespace irr;
 using namespace core;
 using namespace io;
@@ -423,6 +429,153 @@ bool testAddRemove(IFileSystem* fs, const io::path& archiveName)
 
 	return true;
 }
+
+struct SReadJob
+{
+	IFileSystem* FileSystem;
+	const core::array<io::path>* Names;
+	const core::array<u32>* Checksums;
+	core::array<IReadFile*> Files;	// opened before, when empty the job opens them
+	u32 Start;
+	u32 Errors;
+};
+
+// Reads the file in odd sized chunks to mix short and long reads
+bool checksumFile(IReadFile* file, u32& checksum)
+{
+	u8 buffer[1021];
+	checksum = 2166136261u;
+	long total = 0;
+	s32 bytes;
+	while ((bytes = file->read(buffer, sizeof(buffer))) > 0)
+	{
+		for (s32 i=0; i<bytes; ++i)
+			checksum = (checksum ^ buffer[i]) * 16777619u;
+		total += bytes;
+	}
+	return total == file->getSize();
+}
+
+void readAllEntries(SReadJob& job)
+{
+	const u32 count = job.Names->size();
+	for (u32 round=0; round<4; ++round)
+	{
+		for (u32 i=0; i<count; ++i)
+		{
+			const u32 index = (job.Start + i) % count;
+			IReadFile* file = job.Files.empty() ? job.FileSystem->createAndOpenFile((*job.Names)[index]) : job.Files[index];
+			if (!file)
+			{
+				++job.Errors;
+				continue;
+			}
+
+			u32 checksum;
+			file->seek(0);
+			if (!checksumFile(file, checksum) || checksum != (*job.Checksums)[index])
+				++job.Errors;
+
+			if (job.Files.empty())
+				file->drop();
+		}
+	}
+}
+
+#if defined(_IRR_WINDOWS_API_)
+DWORD WINAPI readThread(LPVOID data)
+{
+	readAllEntries(*static_cast<SReadJob*>(data));
+	return 0;
+}
+#else
+void* readThread(void* data)
+{
+	readAllEntries(*static_cast<SReadJob*>(data));
+	return 0;
+}
+#endif
+
+// Reads all entries of an archive from several threads and compares the
+// content with a single threaded run.
+bool testConcurrentReads(IFileSystem* fs, const io::path& archiveName)
+{
+	if ( !fs->addFileArchive(archiveName, /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	bool ret = true;
+	core::array<io::path> names;
+	core::array<u32> checksums;
+	const IFileList* list = fs->getFileArchive(fs->getFileArchiveCount()-1)->getFileList();
+	for (u32 i=0; i<list->getFileCount(); ++i)
+	{
+		if (list->isDirectory(i))
+			continue;
+		IReadFile* file = fs->createAndOpenFile(list->getFullFileName(i));
+		u32 checksum = 0;
+		if (!file || !checksumFile(file, checksum))
+		{
+			logTestString("Reading %s failed\n", list->getFullFileName(i).c_str());
+			ret = false;
+		}
+		if (file)
+			file->drop();
+		names.push_back(list->getFullFileName(i));
+		checksums.push_back(checksum);
+	}
+
+	const u32 threadCount = 4;
+	SReadJob jobs[threadCount];
+#if defined(_IRR_WINDOWS_API_)
+	HANDLE threads[threadCount];
+#else
+	pthread_t threads[threadCount];
+#endif
+	for (u32 t=0; t<threadCount; ++t)
+	{
+		jobs[t].FileSystem = fs;
+		jobs[t].Names = &names;
+		jobs[t].Checksums = &checksums;
+		jobs[t].Start = t*names.size()/threadCount;
+		jobs[t].Errors = 0;
+#ifndef _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+		// the files grab the archive file, so only reading them is thread safe
+		for (u32 i=0; i<names.size(); ++i)
+			jobs[t].Files.push_back(fs->createAndOpenFile(names[i]));
+#endif
+#if defined(_IRR_WINDOWS_API_)
+		threads[t] = CreateThread(0, 0, readThread, &jobs[t], 0, 0);
+#else
+		pthread_create(&threads[t], 0, readThread, &jobs[t]);
+#endif
+	}
+
+	for (u32 t=0; t<threadCount; ++t)
+	{
+#if defined(_IRR_WINDOWS_API_)
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], 0);
+#endif
+		if (jobs[t].Errors)
+		{
+			logTestString("Thread %u had %u read errors\n", t, jobs[t].Errors);
+			ret = false;
+		}
+		for (u32 i=0; i<jobs[t].Files.size(); ++i)
+		{
+			if (jobs[t].Files[i])
+				jobs[t].Files[i]->drop();
+		}
+	}
+
+	fs->removeFileArchive(fs->getFileArchiveCount()-1);
+	return ret;
+}
 }
 
 
@@ -459,6 +612,10 @@ bool archiveReader()
 //	ret &= testMountFile(fs);
 	logTestString("Testing add/remove with filenames.\n");
 	ret &= testAddRemove(fs, "media/file_with_path.zip");
+	logTestString("Testing concurrent reads.\n");
+	ret &= testConcurrentReads(fs, "media/Monty.zip");
+	ret &= testConcurrentReads(fs, "media/file_with_path.zip");
+	ret &= testConcurrentReads(fs, "../media/map-20kdm2.pk3");
 
 	device->closeDevice();
 	device->run();
@@ -122,6 +122,80 @@ static bool testgetRelativeFilename(io::IFileSystem* fs)
 	return result;
 }
 
+// Files on disk must behave the same, no matter if they are mapped or read with stdio
+static bool testReadFile(io::IFileSystem* fs, bool mapped)
+{
+	FILE* ref = fopen("media/licenses.txt", "rb");
+	if (!ref)
+		return false;
+	c8 refData[1024];
+	const long refSize = (long)fread(refData, 1, sizeof(refData), ref);
+	fclose(ref);
+
+	io::IReadFile* file = mapped ? fs->createAndOpenMappedFile("media/licenses.txt") : fs->createAndOpenFile("media/licenses.txt");
+	if (!file)
+	{
+		logTestString("Could not open file in %s:%d\n", __FILE__, __LINE__ );
+		return false;
+	}
+
+	bool result = (file->getSize() == refSize);
+
+	// mapping is only done on request
+	if (!mapped)
+		result &= (file->getType() == io::ERFT_READ_FILE);
+#ifdef _IRR_COMPILE_WITH_MAPPED_READ_FILE_
+	else
+	{
+		result &= (file->getType() == io::ERFT_MAPPED_READ_FILE);
+		const io::IMemoryReadFile* memFile = io::getMemoryReadFile(file);
+		result &= memFile && memcmp(memFile->getBuffer(), refData, refSize) == 0;
+	}
+#endif
+
+	c8 data[1024];
+	result &= (file->read(data, 10) == 10);
+	result &= (file->getPos() == 10);
+	result &= (memcmp(data, refData, 10) == 0);
+
+	result &= file->seek(5, true);
+	result &= (file->getPos() == 15);
+	result &= (file->read(data, sizeof(data)) == (size_t)(refSize-15));
+	result &= (memcmp(data, refData+15, refSize-15) == 0);
+	result &= (file->read(data, 1) == 0);
+
+	result &= file->seek(0);
+	result &= (file->read(data, 1) == 1 && data[0] == refData[0]);
+
+	file->drop();
+
+	if (!result)
+		logTestString("testReadFile failed in %s:%d\n", __FILE__, __LINE__ );
+	return result;
+}
+
+// Loaders parsing files in place must still move the read position like reading does
+static bool testLoadImageInPlace(video::IVideoDriver* driver, io::IFileSystem* fs)
+{
+	io::IReadFile* file = fs->createAndOpenMappedFile("../media/wall.jpg");
+	if (!file)
+	{
+		logTestString("Could not open file in %s:%d\n", __FILE__, __LINE__ );
+		return false;
+	}
+
+	video::IImage* image = driver->createImageFromFile(file);
+	bool result = (image != 0);
+	result &= (file->getPos() == file->getSize());
+	if (image)
+		image->drop();
+	file->drop();
+
+	if (!result)
+		logTestString("testLoadImageInPlace failed in %s:%d\n", __FILE__, __LINE__ );
+	return result;
+}
+
 bool filesystem(void)
 {
 	IrrlichtDevice * device = irr::createDevice(video::EDT_NULL, dimension2d<u32>(1, 1));
@@ -173,6 +247,9 @@ bool filesystem(void)
 	result &= testFlattenFilename(fs);
 	result &= testgetAbsoluteFilename(fs);
 	result &= testgetRelativeFilename(fs);
+	result &= testReadFile(fs, false);
+	result &= testReadFile(fs, true);
+	result &= testLoadImageInPlace(device->getVideoDriver(), fs);
 
 	device->closeDevice();
 	device->run();
@@ -0,0 +1,146 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+
+namespace
+{
+
+typedef irrArenaAllocator<u32> TArenaAlloc;
+
+bool testArena()
+{
+	bool result = true;
+
+	irrArena arena(256);
+	result &= (arena.getCapacity() == 0);
+
+	// allocations are aligned and freeing the last one gives the memory back
+	void* a = arena.allocate(3);
+	void* b = arena.allocate(20);
+	result &= ((((size_t)a) & 15) == 0);
+	result &= ((((size_t)b) & 15) == 0);
+	const size_t used = arena.getUsedBytes();
+	arena.deallocate(b);
+	result &= (arena.getUsedBytes() < used);
+	result &= (arena.allocate(20) == b);
+
+	// freeing older allocations does nothing
+	arena.deallocate(a);
+	result &= (arena.getUsedBytes() == used);
+
+	// more than fits in one block
+	for (u32 i=0; i<10; ++i)
+		result &= (arena.allocate(100) != 0);
+	result &= (arena.getCapacity() > 256);
+	const size_t peak = arena.getPeakBytes();
+	result &= (peak >= 10*100);
+
+	// reset merges the blocks, so the same allocations fit into the first one
+	arena.reset();
+	result &= (arena.getUsedBytes() == 0);
+	result &= (arena.getPeakBytes() == peak);
+	const size_t capacity = arena.getCapacity();
+	u8* first = (u8*)arena.allocate(3);
+	for (u32 i=0; i<10; ++i)
+	{
+		u8* p = (u8*)arena.allocate(100);
+		result &= (p > first && p < first + capacity);
+	}
+	result &= (arena.getCapacity() == capacity);
+
+	if (!result)
+		logTestString("irrArena failed\n");
+
+	return result;
+}
+
+bool testArenaArray()
+{
+	bool result = true;
+
+	irrArena arena;
+	{
+		array<u32, TArenaAlloc> values(TArenaAlloc(&arena), 4);
+		for (u32 i=0; i<1000; ++i)
+			values.push_back(i);
+		values.sort();
+		result &= (values.size() == 1000);
+		result &= (values.binary_search(500) == 500);
+
+		const TArenaAlloc alloc(&arena);
+		array<u32, TArenaAlloc> copy(alloc);
+		copy = values;
+		result &= (copy.size() == 1000 && copy[999] == 999);
+	}
+
+	// without arena the heap is used
+	{
+		array<u32, TArenaAlloc> values;
+		for (u32 i=0; i<1000; ++i)
+			values.push_back(i);
+		result &= (values.size() == 1000 && values[999] == 999);
+	}
+
+	if (!result)
+		logTestString("array with irrArenaAllocator failed\n");
+
+	return result;
+}
+
+bool testFrameArena()
+{
+	IrrlichtDevice * device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	irrArena* arena = driver->getFrameArena();
+	bool result = arena != 0;
+
+	if (arena)
+	{
+		driver->beginScene();
+		{
+			array<u32, TArenaAlloc> values(TArenaAlloc(arena), 100);
+			values.set_used(100);
+			result &= (arena->getUsedBytes() >= 100*sizeof(u32));
+		}
+		// keep some memory until the end of the frame
+		arena->allocate(1000);
+		driver->endScene();
+		result &= (driver->getFrameStats().FrameArenaBytes >= 1000);
+		result &= (arena->getUsedBytes() >= 1000);
+
+		// all memory is given back when the next frame starts
+		driver->beginScene();
+		result &= (arena->getUsedBytes() == 0);
+		driver->endScene();
+		result &= (driver->getFrameStats().FrameArenaBytes == 0);
+	}
+
+	if (!result)
+		logTestString("Frame arena of the video driver failed\n");
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+} // end anonymous namespace
+
+/** Test the linear memory arena and the frame arena of the video driver. */
+bool frameArena(void)
+{
+	bool result = true;
+	result &= testArena();
+	result &= testArenaArray();
+	result &= testFrameArena();
+	return result;
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+/** Test the per frame counters of the video driver and the scene manager. */
+bool frameStats(void)
+{
+	IrrlichtDevice * device = irr::createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if(!device)
+		return false;
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager * smgr = device->getSceneManager();
+
+	bool result = true;
+
+	// nothing stored before the first frame
+	result &= (driver->getFrameStatsCount() == 0);
+	result &= (smgr->getFrameStatsCount() == 0);
+	result &= (driver->getFrameStats().DrawCalls == 0);
+
+	smgr->addCameraSceneNode(0, vector3df(0, 0, 0), vector3df(0, 0, 100));
+
+	// two visible cubes with different textures
+	const u32 texturesBefore = driver->getCurrentFrameStats().TexturesCreated;
+	video::ITexture* tex1 = driver->addTexture(dimension2d<u32>(4, 4), "tex1");
+	video::ITexture* tex2 = driver->addTexture(dimension2d<u32>(4, 4), "tex2");
+	ISceneNode* visible1 = smgr->addCubeSceneNode(10.f, 0, -1, vector3df(-20, 0, 100));
+	ISceneNode* visible2 = smgr->addCubeSceneNode(10.f, 0, -1, vector3df(20, 0, 100));
+	visible1->setMaterialTexture(0, tex1);
+	visible2->setMaterialTexture(0, tex2);
+
+	// cubes behind the camera, one for each culling test
+	smgr->addCubeSceneNode(10.f, 0, -1, vector3df(0, 0, -100))->setAutomaticCulling(EAC_BOX);
+	smgr->addCubeSceneNode(10.f, 0, -1, vector3df(0, 0, -100))->setAutomaticCulling(EAC_FRUSTUM_BOX);
+	smgr->addCubeSceneNode(10.f, 0, -1, vector3df(0, 0, -10000))->setAutomaticCulling(EAC_FRUSTUM_SPHERE);
+
+	for (u32 i=0; i<3; ++i)
+	{
+		driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,0,0,0));
+		smgr->drawAll();
+		driver->endScene();
+	}
+
+	result &= (driver->getFrameStatsCount() == 3);
+	result &= (smgr->getFrameStatsCount() == 3);
+
+	// the textures were added before the first frame ended
+	result &= (driver->getFrameStats(2).TexturesCreated == texturesBefore + 2);
+	result &= (driver->getFrameStats(0).TexturesCreated == 0);
+
+	const video::SFrameStats& drv = driver->getFrameStats();
+	result &= (drv.DrawCalls == 2);
+	result &= (drv.PrimitivesDrawn == 24);
+	result &= (drv.MaterialChanges >= 2);
+	result &= (drv.TextureChanges >= 2);
+
+	const SSceneStats& scene = smgr->getFrameStats();
+	result &= (scene.NodesVisible == 2);
+	result &= (scene.NodesDrawnSolid == 2);
+	result &= (scene.NodesDrawnTransparent == 0);
+	result &= (scene.NodesCulledByBox == 1);
+	result &= (scene.NodesCulledByFrustumBox == 1);
+	result &= (scene.NodesCulledByFrustumSphere == 1);
+	result &= (scene.NodesCulledByOcclusionQuery == 0);
+
+	// frames which are not stored return zeroes
+	result &= (driver->getFrameStats(3).DrawCalls == 0);
+	result &= (smgr->getFrameStats(3).NodesVisible == 0);
+
+	if (!result)
+	{
+		logTestString("Frame stats: draw calls %u, primitives %u, material changes %u, texture changes %u\n",
+			drv.DrawCalls, drv.PrimitivesDrawn, drv.MaterialChanges, drv.TextureChanges);
+		logTestString("Scene stats: visible %u, box %u, frustum box %u, frustum sphere %u\n",
+			scene.NodesVisible, scene.NodesCulledByBox, scene.NodesCulledByFrustumBox, scene.NodesCulledByFrustumSphere);
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
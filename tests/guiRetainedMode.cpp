@@ -0,0 +1,223 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace gui;
+
+static void drawFrame(IrrlichtDevice* device, u16 clearFlag, video::SColor background)
+{
+	device->run();
+	device->getVideoDriver()->beginScene(clearFlag, background);
+	device->getGUIEnvironment()->drawAll();
+	device->getVideoDriver()->endScene();
+}
+
+// Builds a small gui and changes it in several ways, drawing a frame after each change
+static bool changeElements(IrrlichtDevice* device, video::SColor background)
+{
+	IGUIEnvironment* env = device->getGUIEnvironment();
+
+	IGUIWindow* window = env->addWindow(recti(10, 10, 110, 80), false, L"Window");
+	IGUIStaticText* text = env->addStaticText(L"Text", recti(10, 30, 90, 45), true, false, window);
+	IGUIButton* button = env->addButton(recti(100, 90, 150, 110), 0, -1, L"Button");
+	IGUICheckBox* checkBox = env->addCheckBox(false, recti(5, 90, 80, 110), 0, -1, L"Check");
+
+	bool result = true;
+
+	env->setRetainedMode(true, background);
+	result &= env->isRetainedMode();
+	result &= env->needsRedraw();
+
+	drawFrame(device, 0, background);
+	result &= !env->needsRedraw();
+
+	// element changes
+	text->setText(L"Changed");
+	result &= env->needsRedraw();
+	drawFrame(device, 0, background);
+	result &= !env->needsRedraw();
+
+	// moving over another element and removing elements
+	window->move(position2di(60, 20));
+	result &= env->needsRedraw();
+	drawFrame(device, 0, background);
+	button->setVisible(false);
+	result &= env->needsRedraw();
+	drawFrame(device, 0, background);
+	checkBox->setChecked(true);
+	result &= env->needsRedraw();
+	drawFrame(device, 0, background);
+	checkBox->remove();
+	result &= env->needsRedraw();
+	drawFrame(device, 0, background);
+	result &= !env->needsRedraw();
+
+	// setting a value which did not change needs no redraw
+	button->setVisible(false);
+	result &= !env->needsRedraw();
+
+	return result;
+}
+
+// Tests which changes make the retained mode redraw
+static bool redrawTracking()
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	const video::SColor background(255, 60, 90, 120);
+	bool result = changeElements(device, background);
+
+	IGUIEnvironment* env = device->getGUIEnvironment();
+	env->setRetainedMode(false);
+	result &= !env->isRetainedMode();
+	result &= env->needsRedraw();
+
+	// the null driver can't record, the elements were drawn directly
+	video::S2DVertexBatch batch;
+	result &= !device->getVideoDriver()->beginRecording2D(&batch);
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// Tests that redrawing only the changed area produces the same image as
+// drawing everything.
+static bool retainedImage(video::E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice *device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // No error if device does not exist
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	IGUIEnvironment* env = device->getGUIEnvironment();
+	const video::SColor background(255, 60, 90, 120);
+
+	bool result = changeElements(device, background);
+
+	video::IImage* retained = driver->createScreenShot();
+
+	env->setRetainedMode(false);
+	drawFrame(device, video::ECBF_COLOR | video::ECBF_DEPTH, background);
+	video::IImage* full = driver->createScreenShot();
+
+	if (retained && full && retained->getImageDataSizeInBytes() == full->getImageDataSizeInBytes())
+	{
+		result &= (memcmp(retained->getData(), full->getData(), full->getImageDataSizeInBytes()) == 0);
+	}
+	else
+		result = false;
+
+	if (retained)
+		retained->drop();
+	if (full)
+		full->drop();
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// Draws some rectangles and images, two of them with the same texture
+static void draw2D(video::IVideoDriver* driver, video::ITexture* texture)
+{
+	driver->draw2DRectangle(video::SColor(255, 200, 40, 40), recti(5, 5, 60, 50));
+	driver->draw2DImage(texture, position2di(10, 10), recti(0, 0, 32, 32));
+	driver->draw2DRectangle(video::SColor(128, 40, 200, 40), recti(100, 5, 150, 50));
+	driver->draw2DImage(texture, recti(100, 60, 150, 110), recti(0, 0, 64, 64));
+	const recti clip(0, 0, 40, 100);
+	driver->draw2DImage(texture, position2di(20, 60), recti(32, 32, 64, 64), &clip,
+		video::SColor(255, 255, 255, 255));
+}
+
+// Tests recording 2d drawing into batches and drawing the batches
+static bool recordedBatches(video::E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice *device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // No error if device does not exist
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	video::ITexture* texture = driver->getTexture("../media/water.jpg");
+	const video::SColor background(255, 60, 90, 120);
+
+	bool result = true;
+
+	video::S2DVertexBatch batch;
+	result &= driver->beginRecording2D(&batch);
+	draw2D(driver, texture);
+	result &= driver->endRecording2D();
+
+	// the last two images share texture and blending
+	result &= (batch.Parts.size() == 4);
+	result &= (batch.Vertices.size() == 5*4);
+
+	// unsupported drawing is skipped
+	video::S2DVertexBatch failed;
+	result &= driver->beginRecording2D(&failed);
+	driver->draw2DLine(position2di(0, 0), position2di(100, 100));
+	result &= !driver->endRecording2D();
+
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, background);
+	draw2D(driver, texture);
+	driver->endScene();
+	video::IImage* direct = driver->createScreenShot();
+
+	const video::S2DVertexBatch* batches[2] = { &batch, &batch };
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, background);
+	driver->draw2DVertexBatches(batches, 1);
+	driver->endScene();
+	video::IImage* batched = driver->createScreenShot();
+	result &= (driver->getFrameStats().DrawCalls == 3);
+
+	if (direct && batched && direct->getImageDataSizeInBytes() == batched->getImageDataSizeInBytes())
+	{
+		result &= (memcmp(direct->getData(), batched->getData(), direct->getImageDataSizeInBytes()) == 0);
+	}
+	else
+		result = false;
+
+	if (direct)
+		direct->drop();
+	if (batched)
+		batched->drop();
+
+	// the second batch covers the first one, only its transparent
+	// rectangle can join the one of the first batch
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, background);
+	driver->draw2DVertexBatches(batches, 2);
+	driver->endScene();
+	result &= (driver->getFrameStats().DrawCalls == 5);
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// Tests the retained mode of the gui environment
+bool guiRetainedMode(void)
+{
+	bool result = redrawTracking();
+	result &= retainedImage(video::EDT_SOFTWARE);
+	result &= retainedImage(video::EDT_BURNINGSVIDEO);
+	result &= recordedBatches(video::EDT_BURNINGSVIDEO);
+	return result;
+}
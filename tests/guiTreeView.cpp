@@ -0,0 +1,150 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace gui;
+
+// all nodes shown in the tree, in the order of their rows
+static void getVisibleNodes(IGUITreeView* tree, array<IGUITreeViewNode*>& nodes)
+{
+	nodes.clear();
+	for (IGUITreeViewNode* node = tree->getRoot()->getFirstChild(); node; node = node->getNextVisible())
+		nodes.push_back(node);
+}
+
+// clicks on the rows by mouse and checks that the right node gets selected
+static bool checkRows(IrrlichtDevice* device, IGUITreeView* tree, s32& itemHeight)
+{
+	IGUIScrollBar* scrollBar = tree->getVerticalScrollBar();
+	const recti& rect = tree->getAbsolutePosition();
+	s32 clientHeight = rect.getHeight();
+	if (tree->getHorizontalScrollBar())
+		clientHeight -= tree->getHorizontalScrollBar()->getAbsolutePosition().getHeight();
+
+	array<IGUITreeViewNode*> nodes;
+	getVisibleNodes(tree, nodes);
+
+	// the scroll range is updated when drawing
+	device->getGUIEnvironment()->drawAll();
+	if (itemHeight == 0)
+		itemHeight = (scrollBar->getMax() + clientHeight) / (s32)nodes.size();
+	bool result = (scrollBar->getMax() == core::max_(0, (s32)nodes.size() * itemHeight - clientHeight));
+
+	SEvent event;
+	event.EventType = EET_MOUSE_INPUT_EVENT;
+	event.MouseInput.X = rect.UpperLeftCorner.X + 150;
+	event.MouseInput.Wheel = 0.f;
+	event.MouseInput.ButtonStates = 0;
+	event.MouseInput.Shift = false;
+	event.MouseInput.Control = false;
+
+	// jumping around and moving row by row
+	const u32 rows[] = { 0, 1, 2, nodes.size() / 2, nodes.size() / 2 + 1, nodes.size() / 2 - 1,
+		nodes.size() - 1, nodes.size() / 3, 5, 4, 3, nodes.size() - 2 };
+	for (u32 i=0; i<sizeof(rows)/sizeof(rows[0]); ++i)
+	{
+		const s32 row = (s32)core::min_(rows[i], nodes.size() - 1);
+		scrollBar->setPos(row * itemHeight);
+		event.MouseInput.Y = rect.UpperLeftCorner.Y + 1 + row * itemHeight - scrollBar->getPos() + itemHeight / 2;
+
+		event.MouseInput.Event = EMIE_LMOUSE_PRESSED_DOWN;
+		tree->OnEvent(event);
+		event.MouseInput.Event = EMIE_LMOUSE_LEFT_UP;
+		tree->OnEvent(event);
+		result &= (tree->getSelected() == nodes[row]);
+
+		device->getGUIEnvironment()->drawAll();
+	}
+
+	return result;
+}
+
+// Tests that the tree view finds the nodes of rows while nodes are added,
+// removed, moved, expanded and collapsed.
+bool guiTreeView(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, dimension2d<u32>(640, 480));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	IGUIEnvironment* env = device->getGUIEnvironment();
+	IGUITreeView* tree = env->addTreeView(recti(10, 10, 210, 210));
+	IGUITreeViewNode* root = tree->getRoot();
+
+	array<IGUITreeViewNode*> parents;
+	for (u32 i=0; i<50; ++i)
+	{
+		IGUITreeViewNode* parent = root->addChildBack(L"Parent");
+		parents.push_back(parent);
+		for (u32 c=0; c<20; ++c)
+		{
+			IGUITreeViewNode* child = parent->addChildBack(L"Child");
+			if (c % 7 == 3)
+			{
+				child->addChildBack(L"Grandchild");
+				child->addChildFront(L"Grandchild");
+				child->setExpanded(true);
+			}
+		}
+		parent->setExpanded(i % 2 == 0);
+	}
+
+	bool result = true;
+	s32 itemHeight = 0;
+	result &= checkRows(device, tree, itemHeight);
+	result &= (itemHeight > 0);
+
+	// expand and collapse
+	parents[1]->setExpanded(true);
+	parents[0]->setExpanded(false);
+	parents[0]->getFirstChild()->getNextSibling()->getNextSibling()->getNextSibling()->setExpanded(false);
+	result &= checkRows(device, tree, itemHeight);
+
+	// insert before and after other nodes
+	IGUITreeViewNode* inserted = parents[4]->insertChildAfter(parents[4]->getFirstChild(), L"After");
+	result &= (inserted && inserted->getPrevSibling() == parents[4]->getFirstChild());
+	inserted = parents[4]->insertChildBefore(parents[4]->getFirstChild(), L"Before");
+	result &= (inserted && inserted == parents[4]->getFirstChild() && inserted->getPrevSibling() == 0);
+	result &= (parents[4]->insertChildAfter(parents[6]->getFirstChild(), L"Wrong parent") == 0);
+	parents[4]->addChildFront(L"Front")->addChildBack(L"Hidden");
+	root->insertChildAfter(parents[49], L"Last parent")->addChildBack(L"Hidden");
+	result &= checkRows(device, tree, itemHeight);
+
+	// move and delete
+	result &= root->moveChildDown(parents[2]);
+	result &= root->moveChildUp(parents[10]);
+	result &= !root->moveChildUp(parents[0]);
+	result &= (parents[2]->getPrevSibling() == parents[3] && parents[10]->getNextSibling() == parents[9]);
+	result &= parents[6]->deleteChild(parents[6]->getLastChild());
+	result &= !parents[6]->deleteChild(parents[8]->getFirstChild());
+	result &= root->deleteChild(parents[12]);
+	parents[14]->clearChildren();
+	result &= checkRows(device, tree, itemHeight);
+
+	// collapsing a parent hides its changed children
+	parents[20]->setExpanded(false);
+	parents[20]->getFirstChild()->addChildBack(L"Hidden");
+	parents[20]->deleteChild(parents[20]->getLastChild());
+	result &= checkRows(device, tree, itemHeight);
+	parents[20]->setExpanded(true);
+	result &= checkRows(device, tree, itemHeight);
+
+	root->clearChildren();
+	array<IGUITreeViewNode*> nodes;
+	getVisibleNodes(tree, nodes);
+	result &= nodes.empty();
+	env->drawAll();
+	result &= (tree->getVerticalScrollBar()->getMax() == 0);
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
@@ -163,6 +163,150 @@ static bool testSort()
 	return true;
 }
 
+
+// counts copies, moves don't count
+static u32 elementCopies = 0;
+
+struct SCopyCounter
+{
+	SCopyCounter(int value=0) : Value(value) {}
+
+	SCopyCounter(const SCopyCounter& other) : Value(other.Value)
+	{
+		++elementCopies;
+	}
+
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	SCopyCounter(SCopyCounter&& other) : Value(other.Value)
+	{
+		other.Value = -1;
+	}
+#endif
+
+	SCopyCounter& operator=(const SCopyCounter& other)
+	{
+		Value = other.Value;
+		++elementCopies;
+		return *this;
+	}
+
+	int Value;
+};
+
+static bool testMoveElements()
+{
+	bool result = true;
+
+	// growing moves the elements instead of copying them
+	elementCopies = 0;
+	core::array<SCopyCounter> counters;
+	for (int i=0; i<1000; ++i)
+		counters.push_back(SCopyCounter(i));
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	result &= (elementCopies == 0);
+#else
+	result &= (elementCopies >= 1000);
+#endif
+	for (int i=0; i<1000; ++i)
+		result &= (counters[i].Value == i);
+
+	// strings keep their content when moved around
+	core::array<stringc> names;
+	names.setAllocStrategy(core::ALLOC_STRATEGY_SAFE);
+	for (u32 i=0; i<50; ++i)
+		names.push_back(stringc(i) + (i & 1 ? "_a_long_name_which_needs_memory" : "_short"));
+	names.insert(stringc("first"), 0);
+	names.insert(names[10], 5);	// element of the array itself
+	names.push_back(names[0]);
+	names.erase(1, 3);
+	result &= (names.size() == 50);
+	result &= (names[0] == "first" && names[2] == "9_a_long_name_which_needs_memory");
+	result &= (names[1] == "3_a_long_name_which_needs_memory" && names[49] == "first");
+
+	// emplace_back constructs in place
+	core::array<SCopyCounter> emplaced;
+	elementCopies = 0;
+	emplaced.emplace_back().Value = 1;
+	emplaced.emplace_back().Value = 2;
+	result &= (emplaced.size() == 2 && emplaced[1].Value == 2);
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	emplaced.emplace_back(3);
+	result &= (emplaced.getLast().Value == 3);
+	result &= (elementCopies == 0);
+#endif
+
+	assert_log(result);
+	return result;
+}
+
+static bool testInsertRange()
+{
+	bool result = true;
+
+	core::array<int> numbers;
+	const int values[] = { 1, 2, 3, 4 };
+	numbers.insert_range(values, 4, 0);
+	numbers.insert_range(values, 2, 4);
+	numbers.insert_range(values + 2, 2, 1);
+	const int expected1[] = { 1, 3, 4, 2, 3, 4, 1, 2 };
+	result &= numbers.equals(expected1, 8);
+
+	// elements of the array itself, with and without reallocation
+	numbers.reallocate(20);
+	numbers.insert_range(numbers.const_pointer() + 5, 3, 0);
+	numbers.insert_range(numbers.const_pointer(), 11, 11);
+	result &= (numbers.size() == 22);
+	const int expected2[] = { 4, 1, 2, 1, 3, 4, 2, 3, 4, 1, 2 };
+	for (u32 i=0; i<11; ++i)
+		result &= (numbers[i] == expected2[i] && numbers[i+11] == expected2[i]);
+
+	// constructors and destructors are balanced
+	{
+		core::array<SDummy> dummies;
+		dummies.push_back(SDummy(10));
+		dummies.push_back(SDummy(11));
+		SDummy more[3] = { SDummy(12), SDummy(13), SDummy(14) };
+		dummies.insert_range(more, 3, 1);
+		dummies.insert_range(dummies.const_pointer(), 2, 2);
+		dummies.erase(1);
+		dummies.erase(0, 2);
+		result &= (dummies.size() == 4 && dummies[0].x == 12);
+	}
+	for ( core::map<int,int>::Iterator it = countReferences.getIterator(); !it.atEnd(); it++ )
+		result &= (it->getValue() == 0);
+
+	assert_log(result);
+	return result;
+}
+
+static bool testAllocStrategies()
+{
+	bool result = true;
+
+	core::array<u32> safe, doubling, squareRoot;
+	safe.setAllocStrategy(core::ALLOC_STRATEGY_SAFE);
+	squareRoot.setAllocStrategy(core::ALLOC_STRATEGY_SQRT);
+	u32 reallocations[3] = { 0, 0, 0 };
+	for (u32 i=0; i<10000; ++i)
+	{
+		const u32 before[3] = { safe.allocated_size(), doubling.allocated_size(), squareRoot.allocated_size() };
+		safe.push_back(i);
+		doubling.push_back(i);
+		squareRoot.push_back(i);
+		reallocations[0] += (safe.allocated_size() != before[0]) ? 1 : 0;
+		reallocations[1] += (doubling.allocated_size() != before[1]) ? 1 : 0;
+		reallocations[2] += (squareRoot.allocated_size() != before[2]) ? 1 : 0;
+	}
+	result &= (safe.allocated_size() == 10000 && reallocations[0] == 10000);
+	result &= (reallocations[1] < reallocations[2] && reallocations[2] < 300);
+	result &= (squareRoot.allocated_size() - squareRoot.size() <= 105);
+	for (u32 i=0; i<10000; ++i)
+		result &= (squareRoot[i] == i);
+
+	assert_log(result);
+	return result;
+}
+
 // Test the functionality of core::array
 bool testIrrArray(void)
 {
@@ -174,6 +318,9 @@ bool testIrrArray(void)
 	allExpected &= testSwap();
 	allExpected &= testErase();
 	allExpected &= testSort();
+	allExpected &= testMoveElements();
+	allExpected &= testInsertRange();
+	allExpected &= testAllocStrategies();
 
 	if(allExpected)
 		logTestString("\nAll tests passed\n");
@@ -0,0 +1,227 @@
+#include "testUtils.h"
+#include <irrlicht.h>
+
+using namespace irr;
+using namespace core;
+
+// all keys get the same hash, so every operation has to probe
+struct SCollidingHash
+{
+	u32 operator()(s32) const { return 42; }
+};
+
+// compare with core::map while inserting and removing pseudo random keys
+template <class THash>
+static bool testRandomKeys(u32 keyRange)
+{
+	bool result = true;
+
+	hash_map<s32, s32, THash> hashed;
+	map<s32, s32> reference;
+	u32 seed = 12345;
+	for (u32 i=0; i<20000; ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const s32 key = (s32)((seed >> 8) % keyRange);
+		switch ((seed >> 4) & 3)
+		{
+		case 0:
+			result &= (hashed.remove(key) == reference.remove(key));
+			break;
+		case 1:
+			result &= (hashed.insert(key, (s32)i) == (reference.find(key) == 0));
+			if (!reference.find(key))
+				reference.insert(key, (s32)i);
+			break;
+		default:
+			hashed[key] = (s32)i;
+			reference.set(key, (s32)i);
+			break;
+		}
+	}
+
+	result &= (hashed.size() == reference.size());
+	for (s32 key=0; key<(s32)keyRange; ++key)
+	{
+		const typename hash_map<s32, s32, THash>::Node* node = hashed.find(key);
+		const map<s32, s32>::Node* refNode = reference.find(key);
+		result &= ((node == 0) == (refNode == 0));
+		if (node && refNode)
+			result &= (node->getValue() == refNode->getValue());
+	}
+
+	// iteration finds every element once
+	u32 count = 0;
+	for (typename hash_map<s32, s32, THash>::ConstIterator it = hashed.getConstIterator(); !it.atEnd(); ++it)
+	{
+		const map<s32, s32>::Node* refNode = reference.find(it->getKey());
+		result &= (refNode && refNode->getValue() == it->getValue());
+		++count;
+	}
+	result &= (count == hashed.size());
+
+	assert_log(result);
+	return result;
+}
+
+static bool testKeyTypes()
+{
+	bool result = true;
+
+	hash_map<stringc, u32> names;
+	result &= names.insert("one", 1);
+	result &= names.insert("two", 2);
+	result &= !names.insert("one", 3);
+	result &= (names.find("one")->getValue() == 1);
+	result &= (names.find("three") == 0);
+	names.set("one", 11);
+	result &= (names["one"] == 11);
+	result &= (names["new"] == 0);
+	result &= (names.size() == 3);
+
+	hash_map<io::path, s32> paths;
+	paths["media/ninja.b3d"] = 1;
+	paths["media/dwarf.x"] = 2;
+	result &= (paths.find(io::path("media/ninja.b3d"))->getValue() == 1);
+	result &= (paths.find(io::path("media/Ninja.b3d")) == 0);
+
+	hash_map<stringw, s32> wideNames;
+	wideNames[L"wide"] = 5;
+	result &= (wideNames.find(L"wide") != 0);
+
+	s32 objects[100];
+	hash_map<const s32*, u32> pointers;
+	for (u32 i=0; i<100; ++i)
+		pointers.insert(&objects[i], i);
+	for (u32 i=0; i<100; ++i)
+		result &= (pointers.find(&objects[i])->getValue() == i);
+
+	hash_map<wchar_t, s32> characters;
+	for (wchar_t c=L'a'; c<=L'z'; ++c)
+		characters.insert(c, c - L'a');
+	result &= (characters.find(L'q')->getValue() == L'q' - L'a');
+
+	assert_log(result);
+	return result;
+}
+
+static bool testCopyAndSwap()
+{
+	bool result = true;
+
+	hash_map<s32, s32> map1(100), map2;
+	const u32 capacity = map1.allocated_size();
+	for (s32 i=0; i<100; ++i)
+		map1.insert(i, i*2);
+	result &= (map1.allocated_size() == capacity);
+
+	hash_map<s32, s32> copy(map1);
+	map2 = map1;
+	map1.remove(5);
+	result &= (copy.size() == 100 && map2.size() == 100 && map1.size() == 99);
+	result &= (copy.find(5)->getValue() == 10);
+
+	map1.swap(map2);
+	result &= (map1.size() == 100 && map2.size() == 99);
+	result &= (map2.find(5) == 0 && map1.find(5) != 0);
+
+	map1.clear();
+	result &= (map1.empty() && map1.find(1) == 0);
+	result &= map1.getIterator().atEnd();
+
+	assert_log(result);
+	return result;
+}
+
+// counts the living objects, so nodes have to be constructed and destructed exactly once
+struct SCounted
+{
+	SCounted() : Valid(0x600d) { ++Living; }
+	SCounted(const SCounted& other) : Valid(other.Valid) { ++Living; }
+	~SCounted() { Valid = 0; --Living; }
+	SCounted& operator=(const SCounted& other) { Valid = other.Valid; return *this; }
+
+	u32 Valid;
+	static s32 Living;
+};
+s32 SCounted::Living = 0;
+
+static bool testNodeLifetime()
+{
+	bool result = true;
+
+	{
+		hash_map<stringc, SCounted> map;
+		for (u32 i=0; i<300; ++i)
+			map[stringc(i)] = SCounted();
+		result &= (SCounted::Living == 300);
+
+		// removing moves the following nodes back
+		for (u32 i=0; i<300; i+=2)
+			result &= map.remove(stringc(i));
+		result &= (SCounted::Living == 150);
+
+		hash_map<stringc, SCounted> copy(map);
+		result &= (SCounted::Living == 300);
+		for (hash_map<stringc, SCounted>::Iterator it = copy.getIterator(); !it.atEnd(); ++it)
+			result &= (it->getValue().Valid == 0x600d);
+		for (u32 i=1; i<300; i+=2)
+			result &= (map.find(stringc(i)) && map.find(stringc(i))->getValue().Valid == 0x600d);
+
+		map.clear();
+		result &= (SCounted::Living == 150);
+	}
+	result &= (SCounted::Living == 0);
+
+	assert_log(result);
+	return result;
+}
+
+static bool testHashSet()
+{
+	bool result = true;
+
+	hash_set<stringc> set;
+	result &= set.insert("a");
+	result &= set.insert("b");
+	result &= !set.insert("a");
+	result &= set.contains("b");
+	result &= !set.contains("c");
+	result &= set.remove("a");
+	result &= !set.remove("a");
+	result &= (set.size() == 1);
+
+	hash_set<u32> numbers;
+	for (u32 i=0; i<1000; i+=3)
+		numbers.insert(i);
+	u32 sum = 0;
+	for (hash_set<u32>::ConstIterator it = numbers.getConstIterator(); !it.atEnd(); ++it)
+		sum += *it;
+	result &= (sum == 999 * 334 / 2);
+	for (u32 i=0; i<1000; ++i)
+		result &= (numbers.contains(i) == (i % 3 == 0));
+
+	assert_log(result);
+	return result;
+}
+
+// Test the functionality of core::hash_map and core::hash_set
+bool testIrrHashMap(void)
+{
+	bool success = true;
+
+	success &= testRandomKeys<hash<s32> >(1000);
+	success &= testRandomKeys<hash<s32> >(50000);
+	success &= testRandomKeys<SCollidingHash>(200);
+	success &= testKeyTypes();
+	success &= testCopyAndSwap();
+	success &= testNodeLifetime();
+	success &= testHashSet();
+
+	if(success)
+		logTestString("\nAll tests passed\n");
+	else
+		logTestString("\nFAIL!\n");
+
+	return success;
+}
@@ -333,6 +333,131 @@ bool testErase()
 	return true;
 }
 
+
+// counts allocations to see when strings use their local buffer
+static u32 stringAllocations = 0;
+
+template <class T>
+class CCountingAllocator : public core::irrAllocator<T>
+{
+protected:
+	virtual void* internal_new(size_t cnt) IRR_OVERRIDE
+	{
+		++stringAllocations;
+		return operator new(cnt);
+	}
+};
+
+typedef core::string<c8, CCountingAllocator<c8> > countedString;
+
+static bool testLocalBuffer()
+{
+	bool result = true;
+	stringAllocations = 0;
+
+	// short strings don't allocate
+	countedString a;
+	countedString b("Bip01_L_Foot");
+	countedString c(b);
+	a = c;
+	a.append("_nub");
+	result &= (stringAllocations == 0);
+	result &= (a == "Bip01_L_Foot_nub" && b == "Bip01_L_Foot");
+
+	// growing beyond it allocates and keeps the content
+	a.append("_with_a_much_longer_name");
+	result &= (stringAllocations == 1);
+	result &= (a == "Bip01_L_Foot_nub_with_a_much_longer_name");
+	countedString d(a);
+	result &= (stringAllocations == 2 && d == a);
+
+	// back to the local buffer when releasing memory
+	a.clear();
+	result &= a.empty();
+	a = "short";
+	result &= (stringAllocations == 2 && a == "short");
+
+	// substrings and characters of the local buffer
+	countedString e("abcdef");
+	e.insert(3, "XY", 2);
+	result &= (e == "abcXYdef");
+	e.erase(0);
+	e.replace('X', 'x');
+	result &= (e == "bcxYdef" && e.size() == 7);
+	e.remove('Y');
+	result &= (e == "bcxdef");
+
+	return result;
+}
+
+static bool testMove()
+{
+	bool result = true;
+#ifdef IRR_HAS_MOVE_SEMANTICS
+	stringAllocations = 0;
+
+	countedString longString("a string too long for the local buffer");
+	const c8* memory = longString.c_str();
+	countedString moved(static_cast<countedString&&>(longString));
+	result &= (moved.c_str() == memory && longString.empty());
+	result &= (moved == "a string too long for the local buffer");
+
+	countedString shortString("short");
+	moved = static_cast<countedString&&>(shortString);
+	result &= (moved == "short" && shortString.empty());
+
+	shortString = static_cast<countedString&&>(moved);
+	result &= (shortString == "short" && moved.empty());
+	moved = "reuse";
+	result &= (moved == "reuse");
+
+	result &= (stringAllocations == 1);
+
+	// strings survive reallocations of arrays
+	core::array<stringc> names;
+	for (u32 i=0; i<100; ++i)
+		names.push_back(stringc(i) + "_some_name_which_needs_memory");
+	result &= (names[42] == "42_some_name_which_needs_memory");
+#endif
+	return result;
+}
+
+static bool testHash()
+{
+	bool result = true;
+
+	stringc a("hashed");
+	stringc b("hashed");
+	const u32 hash = a.getHash();
+	result &= (hash == b.getHash());
+	result &= (hash == stringc(a).getHash());
+
+	// changes must not keep an old hash
+	a.append('!');
+	result &= (a.getHash() != hash);
+	a.erase(a.size()-1);
+	result &= (a.getHash() == hash);
+	a[0] = 'H';
+	result &= (a.getHash() != hash);
+	// characters changed through references taken before hashing
+	c8& first = a[0];
+	a.getHash();
+	first = 'h';
+	result &= (a.getHash() == hash);
+	first = 'H';
+	a.make_lower();
+	result &= (a.getHash() == hash);
+	a = "other";
+	result &= (a.getHash() == stringc("other").getHash());
+	a.clear();
+	result &= (a.getHash() == stringc().getHash());
+
+	stringw w(L"hashed");
+	result &= (w.getHash() == stringw(b).getHash());
+
+	return result;
+}
+
 // Test the functionality of irrString
 /** Validation is done with assert_log() against expected results. */
 bool testIrrString(void)
@@ -406,6 +531,15 @@ bool testIrrString(void)
 	logTestString("test erase functions\n");
 	allExpected &= testErase();
 
+	logTestString("test local buffer\n");
+	allExpected &= testLocalBuffer();
+
+	logTestString("test move\n");
+	allExpected &= testMove();
+
+	logTestString("test hash\n");
+	allExpected &= testHash();
+
 	if(allExpected)
 		logTestString("\nAll tests passed\n");
 	else
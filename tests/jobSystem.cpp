@@ -0,0 +1,180 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+
+namespace
+{
+
+struct SSlotJob
+{
+	u32* Slot;
+	u32 Value;
+};
+
+void writeSlot(void* data)
+{
+	SSlotJob* job = static_cast<SSlotJob*>(data);
+	*job->Slot = job->Value;
+}
+
+struct SSumJob
+{
+	const core::array<u32>* Values;
+	u32 Sum;
+};
+
+void sumValues(void* data)
+{
+	SSumJob* job = static_cast<SSumJob*>(data);
+	job->Sum = 0;
+	for (u32 i=0; i<job->Values->size(); ++i)
+		job->Sum += (*job->Values)[i];
+}
+
+void writeIndices(void* data, u32 begin, u32 end)
+{
+	u32* out = static_cast<u32*>(data);
+	for (u32 i=begin; i<end; ++i)
+		out[i] = i;
+}
+
+struct SNestedJob
+{
+	IJobSystem* Jobs;
+	core::array<u32> Values;
+};
+
+// a job which waits for a parallelFor of its own
+void nestedParallelFor(void* data)
+{
+	SNestedJob* job = static_cast<SNestedJob*>(data);
+	job->Jobs->parallelFor(0, job->Values.size(), writeIndices, job->Values.pointer(), 16);
+}
+
+bool testJobs(IJobSystem* jobs)
+{
+	bool result = true;
+
+	// independent jobs
+	const u32 jobCount = 1000;
+	core::array<u32> slots;
+	slots.set_used(jobCount);
+	core::array<SSlotJob> slotJobs;
+	slotJobs.set_used(jobCount);
+	SJobCounter written;
+	for (u32 i=0; i<jobCount; ++i)
+	{
+		slots[i] = 0;
+		slotJobs[i].Slot = &slots[i];
+		slotJobs[i].Value = i + 1;
+		jobs->addJob(writeSlot, &slotJobs[i], &written);
+	}
+
+	// a job which needs all others to be done first
+	SSumJob sumJob;
+	sumJob.Values = &slots;
+	sumJob.Sum = 0;
+	SJobCounter summed;
+	jobs->addJob(sumValues, &sumJob, &summed, &written);
+
+	jobs->wait(summed);
+	result &= jobs->isDone(written);
+	result &= (sumJob.Sum == jobCount * (jobCount + 1) / 2);
+
+	// a dependency which is already done
+	jobs->addJob(sumValues, &sumJob, &summed, &written);
+	jobs->wait(summed);
+	result &= (sumJob.Sum == jobCount * (jobCount + 1) / 2);
+
+	// parallel for with automatic and with odd grain sizes, and a range not starting at 0
+	const u32 count = 100000;
+	core::array<u32> indices;
+	indices.set_used(count);
+	const u32 grainSizes[] = { 0, 7, count };
+	for (u32 g=0; g<3; ++g)
+	{
+		for (u32 i=0; i<count; ++i)
+			indices[i] = 0;
+		jobs->parallelFor(10, count, writeIndices, indices.pointer(), grainSizes[g]);
+		for (u32 i=0; i<count; ++i)
+		{
+			if (indices[i] != (i < 10 ? 0 : i))
+			{
+				logTestString("parallelFor with grain size %u failed at index %u\n", grainSizes[g], i);
+				result = false;
+				break;
+			}
+		}
+	}
+
+	// empty ranges do nothing
+	jobs->parallelFor(5, 5, writeIndices, 0);
+
+	// jobs running parallel loops themselves
+	const u32 nestedCount = 8;
+	SNestedJob nested[nestedCount];
+	SJobCounter nestedDone;
+	for (u32 n=0; n<nestedCount; ++n)
+	{
+		nested[n].Jobs = jobs;
+		nested[n].Values.set_used(1000);
+		for (u32 i=0; i<1000; ++i)
+			nested[n].Values[i] = 0;
+		jobs->addJob(nestedParallelFor, &nested[n], &nestedDone);
+	}
+	jobs->wait(nestedDone);
+	for (u32 n=0; n<nestedCount; ++n)
+		result &= (nested[n].Values[999] == 999 && nested[n].Values[500] == 500);
+
+	return result;
+}
+
+bool testDevice(s32 workerCount)
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2d<u32>(160, 120);
+	params.JobWorkerCount = workerCount;
+	IrrlichtDevice * device = createDeviceEx(params);
+	assert_log(device);
+	if (!device)
+		return false;
+
+	IJobSystem* jobs = device->getJobSystem();
+	bool result = jobs != 0;
+	if (jobs)
+	{
+#if defined(_IRR_COMPILE_WITH_JOB_THREADS_)
+		if (workerCount >= 0)
+			result &= (jobs->getWorkerCount() == (u32)workerCount);
+#else
+		result &= (jobs->getWorkerCount() == 0);
+#endif
+		result &= testJobs(jobs);
+	}
+
+	if (!result)
+		logTestString("Job system with %d workers failed\n", workerCount);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+} // end anonymous namespace
+
+/** Test the job system with worker threads and without. */
+bool jobSystem(void)
+{
+	bool result = true;
+	result &= testDevice(0);
+	result &= testDevice(3);
+	result &= testDevice(-1);
+	return result;
+}
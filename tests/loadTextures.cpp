@@ -88,10 +88,161 @@ bool loadFromFileFolder(void)
 	return ((tex1 == tex2) && (tex1 == tex3) && (tex1 == tex4));
 }
 
+/** Loads all png and jpg images in the media folder with one call and
+	compares them to images loaded one by one and converted afterwards.
+	Also logs the time taken by both ways. */
+bool loadImagesInFormat(u32 workerCount)
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2du(160, 120);
+	params.JobWorkerCount = workerCount;
+	IrrlichtDevice *device = createDeviceEx(params);
+
+	if (!device)
+	{
+		logTestString("Unable to create EDT_NULL device\n");
+		return false;
+	}
+
+	IVideoDriver * driver = device->getVideoDriver();
+	IFileSystem * fs = device->getFileSystem();
+
+	array<path> names;
+	const path oldDir = fs->getWorkingDirectory();
+	fs->changeWorkingDirectoryTo("../media");
+	IFileList * list = fs->createFileList();
+	for (u32 i=0; i<list->getFileCount(); ++i)
+	{
+		if (!list->isDirectory(i) && hasFileExtension(list->getFileName(i), "png", "jpg"))
+			names.push_back(list->getFullFileName(i));
+	}
+	list->drop();
+	fs->changeWorkingDirectoryTo(oldDir);
+
+	bool result = names.size() > 0;
+
+	// missing files give 0 at their place
+	names.push_back("../media/missing.png");
+
+	array<IImage*> single;
+	for (u32 i=0; i<names.size(); ++i)
+	{
+		IImage * image = driver->createImageFromFile(names[i]);
+		if (image && image->getColorFormat() != ECF_A8R8G8B8)
+		{
+			IImage * converted = driver->createImage(ECF_A8R8G8B8, image->getDimension());
+			image->copyTo(converted);
+			image->drop();
+			image = converted;
+		}
+		single.push_back(image);
+	}
+
+	array<IImage*> batch = driver->createImagesFromFiles(names, ECF_A8R8G8B8);
+
+	if (batch.size() != names.size())
+	{
+		logTestString("Wrong number of images\n");
+		result = false;
+	}
+
+	for (u32 i=0; i<single.size() && i<batch.size(); ++i)
+	{
+		if (i == names.size()-1)
+		{
+			if (batch[i])
+			{
+				logTestString("Loaded missing file %s\n", names[i].c_str());
+				result = false;
+			}
+		}
+		else if (!single[i] || !batch[i])
+		{
+			logTestString("Could not load %s\n", names[i].c_str());
+			result = false;
+		}
+		else if (batch[i]->getColorFormat() != ECF_A8R8G8B8
+			|| batch[i]->getDimension() != single[i]->getDimension()
+			|| memcmp(batch[i]->getData(), single[i]->getData(), single[i]->getImageDataSizeInBytes()))
+		{
+			logTestString("Image differs from single load %s\n", names[i].c_str());
+			result = false;
+		}
+	}
+
+	for (u32 i=0; i<single.size(); ++i)
+		if (single[i])
+			single[i]->drop();
+	for (u32 i=0; i<batch.size(); ++i)
+		if (batch[i])
+			batch[i]->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
+bool loadTexturesAtOnce(u32 workerCount)
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2du(160, 120);
+	params.JobWorkerCount = workerCount;
+	IrrlichtDevice *device = createDeviceEx(params);
+
+	if (!device)
+	{
+		logTestString("Unable to create EDT_NULL device\n");
+		return false;
+	}
+
+	IVideoDriver * driver = device->getVideoDriver();
+
+	// one texture is already cached, one is listed twice and one is missing
+	ITexture* cached = driver->getTexture("../media/wall.jpg");
+	const u32 textureCount = driver->getTextureCount();
+	array<path> names;
+	names.push_back("../media/water.jpg");
+	names.push_back("../media/wall.jpg");
+	names.push_back("../media/missing.png");
+	names.push_back("../media/irrlichtlogo2.png");
+	names.push_back("../media/../media/water.jpg");
+	names.push_back("../media/axe.jpg");
+
+	array<ITexture*> textures = driver->getTextures(names);
+
+	bool result = cached && textures.size() == names.size();
+	if (!result)
+		logTestString("Wrong number of textures\n");
+	else
+	{
+		result &= textures[0] && textures[3] && textures[5];
+		result &= textures[1] == cached;
+		result &= textures[2] == 0;
+		result &= textures[4] == textures[0];
+		result &= driver->getTextureCount() == textureCount + 3;
+		for (u32 i=0; i<names.size(); ++i)
+			result &= textures[i] == driver->getTexture(names[i]);
+		if (!result)
+			logTestString("getTextures with %u job workers differs from getTexture\n", workerCount);
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
 bool loadTextures()
 {
 	bool result = true;
 	result &= loadFromFileFolder();
+	result &= loadImagesInFormat(0);
+	result &= loadImagesInFormat(3);
+	result &= loadTexturesAtOnce(0);
+	result &= loadTexturesAtOnce(3);
 	return result;
 }
 
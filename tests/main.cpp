@@ -56,6 +56,7 @@ int main(int argumentCount, char * arguments[])
 	// Now the simple tests without device
 	TEST(testIrrArray);
 	TEST(testIrrMap);
+	TEST(testIrrHashMap);
 	TEST(testIrrList);
 	TEST(exports);
 	TEST(irrCoreEquals);
@@ -87,6 +88,11 @@ int main(int argumentCount, char * arguments[])
 	TEST(meshLoaders);
 	TEST(testTimer);
 	TEST(testCoreutil);
+	TEST(frameStats);
+	TEST(referenceCounting);
+	TEST(jobSystem);
+	TEST(frameArena);
+	TEST(smallObjectPool);
 	// software drivers only
 	TEST(softwareDevice);
 	TEST(b3dAnimation);
@@ -96,9 +102,14 @@ int main(int argumentCount, char * arguments[])
 	TEST(cursorSetVisible);
 	TEST(flyCircleAnimator);
 	TEST(guiDisabledMenu);
+	TEST(guiRetainedMode);
+	TEST(guiTreeView);
 	TEST(makeColorKeyTexture);
 	TEST(md2Animation);
 	TEST(meshTransform);
+	TEST(meshNormals);
+	TEST(meshWelding);
+	TEST(meshSimplification);
 	TEST(skinnedMesh);
 	TEST(testGeometryCreator);
 	TEST(writeImageToFile);
@@ -130,6 +141,8 @@ int main(int argumentCount, char * arguments[])
 	TEST(terrainSceneNode);
 	TEST(lightMaps);
 	TEST(triangleSelector);
+	TEST(q3LevelVisibility);
+	TEST(octreeVisibility);
 	TEST(line2DTest);
 #endif
 
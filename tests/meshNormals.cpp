@@ -0,0 +1,206 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+// a bumpy grid with some degenerated triangles, large enough to be split into jobs
+IMeshBuffer* createGrid(u32 size, video::E_VERTEX_TYPE vertexType, video::E_INDEX_TYPE indexType)
+{
+	CDynamicMeshBuffer* buffer = new CDynamicMeshBuffer(vertexType, indexType);
+	IVertexBuffer& vertices = buffer->getVertexBuffer();
+	IIndexBuffer& indices = buffer->getIndexBuffer();
+
+	vertices.reallocate(size*size);
+	for (u32 z=0; z<size; ++z)
+	{
+		for (u32 x=0; x<size; ++x)
+		{
+			// every 97th vertex sits on its left neighbour
+			const f32 px = ((z*size+x) % 97 == 0 && x) ? (f32)(x-1) : (f32)x;
+			const vector3df pos(px, sinf(px*0.3f) * cosf(z*0.2f) + ((x*7+z*13) % 5) * 0.02f, (f32)z);
+			const vector2df tcoords(px / size, (f32)z / size);
+			if (vertexType == video::EVT_TANGENTS)
+				vertices.push_back(video::S3DVertexTangents(pos, vector3df(0,1,0), video::SColor(255,255,255,255), tcoords));
+			else
+				vertices.push_back(video::S3DVertex(pos, vector3df(0,1,0), video::SColor(255,255,255,255), tcoords));
+		}
+	}
+
+	indices.reallocate((size-1)*(size-1)*6);
+	for (u32 z=0; z<size-1; ++z)
+	{
+		for (u32 x=0; x<size-1; ++x)
+		{
+			const u32 i = z*size+x;
+			indices.push_back(i);
+			indices.push_back(i+size);
+			indices.push_back(i+1);
+			indices.push_back(i+1);
+			indices.push_back(i+size);
+			indices.push_back(i+size+1);
+		}
+	}
+	buffer->recalculateBoundingBox();
+	return buffer;
+}
+
+bool equalVectors(const vector3df& a, const vector3df& b)
+{
+	return a.equals(b, 0.0001f);
+}
+
+// the normals of a meshbuffer calculated with and without worker threads
+bool compareNormals(IMeshManipulator* serial, IMeshManipulator* parallel,
+		u32 size, video::E_INDEX_TYPE indexType, bool angleWeighted)
+{
+	IMeshBuffer* expected = createGrid(size, video::EVT_STANDARD, indexType);
+	IMeshBuffer* buffer = createGrid(size, video::EVT_STANDARD, indexType);
+
+	serial->recalculateNormals(expected, true, angleWeighted);
+	parallel->recalculateNormals(buffer, true, angleWeighted);
+
+	bool result = true;
+	for (u32 i=0; i<buffer->getVertexCount(); ++i)
+	{
+		result &= equalVectors(expected->getNormal(i), buffer->getNormal(i));
+		result &= core::equals(buffer->getNormal(i).getLength(), 1.f, 0.001f);
+	}
+
+	if (!result)
+		logTestString("Normals differ for a grid of size %u\n", size);
+
+	expected->drop();
+	buffer->drop();
+	return result;
+}
+
+// the tangents of a meshbuffer calculated with and without worker threads
+bool compareTangents(IMeshManipulator* serial, IMeshManipulator* parallel,
+		u32 size, video::E_INDEX_TYPE indexType, bool recalculateNormals, bool angleWeighted)
+{
+	IMeshBuffer* expected = createGrid(size, video::EVT_TANGENTS, indexType);
+	IMeshBuffer* buffer = createGrid(size, video::EVT_TANGENTS, indexType);
+
+	serial->recalculateTangents(expected, recalculateNormals, true, angleWeighted);
+	parallel->recalculateTangents(buffer, recalculateNormals, true, angleWeighted);
+
+	const video::S3DVertexTangents* e = (const video::S3DVertexTangents*)expected->getVertices();
+	const video::S3DVertexTangents* v = (const video::S3DVertexTangents*)buffer->getVertices();
+
+	bool result = true;
+	for (u32 i=0; i<buffer->getVertexCount(); ++i)
+	{
+		result &= equalVectors(e[i].Normal, v[i].Normal);
+		result &= equalVectors(e[i].Tangent, v[i].Tangent);
+		result &= equalVectors(e[i].Binormal, v[i].Binormal);
+		result &= core::equals(v[i].Tangent.getLength(), 1.f, 0.001f);
+	}
+
+	if (!result)
+		logTestString("Tangents differ for a grid of size %u\n", size);
+
+	expected->drop();
+	buffer->drop();
+	return result;
+}
+
+// flipSurfaces changes the indices without marking them dirty, the normals must still follow
+bool compareFlippedSurfaces(IMeshManipulator* serial, IMeshManipulator* parallel, video::E_INDEX_TYPE indexType)
+{
+	SMesh* expected = new SMesh();
+	SMesh* mesh = new SMesh();
+	IMeshBuffer* expectedBuffer = createGrid(120, video::EVT_STANDARD, indexType);
+	IMeshBuffer* buffer = createGrid(120, video::EVT_STANDARD, indexType);
+	expected->addMeshBuffer(expectedBuffer);
+	mesh->addMeshBuffer(buffer);
+	expectedBuffer->drop();
+	buffer->drop();
+
+	serial->recalculateNormals(expected, true, true);
+	parallel->recalculateNormals(mesh, true, true);
+	serial->flipSurfaces(expected);
+	parallel->flipSurfaces(mesh);
+	serial->recalculateNormals(expected, true, true);
+	parallel->recalculateNormals(mesh, true, true);
+
+	bool result = true;
+	for (u32 i=0; i<buffer->getVertexCount(); ++i)
+		result &= equalVectors(expectedBuffer->getNormal(i), buffer->getNormal(i));
+
+	if (!result)
+		logTestString("Normals differ after flipping the surfaces\n");
+
+	expected->drop();
+	mesh->drop();
+	return result;
+}
+
+} // end anonymous namespace
+
+// Tests that normals and tangents of large meshbuffers calculated with the
+// job system are the same as those calculated on one thread.
+bool meshNormals(void)
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2d<u32>(160, 120);
+	params.JobWorkerCount = 0;
+	IrrlichtDevice* serialDevice = createDeviceEx(params);
+	params.JobWorkerCount = 3;
+	IrrlichtDevice* parallelDevice = createDeviceEx(params);
+	assert_log(serialDevice && parallelDevice);
+	if (!serialDevice || !parallelDevice)
+		return false;
+
+	bool result = (parallelDevice->getJobSystem()->getWorkerCount() == 3);
+	IMeshManipulator* serial = serialDevice->getSceneManager()->getMeshManipulator();
+	IMeshManipulator* parallel = parallelDevice->getSceneManager()->getMeshManipulator();
+
+	// 16 bit and 32 bit indices, small buffers stay on the calling thread
+	result &= compareNormals(serial, parallel, 120, video::EIT_16BIT, false);
+	result &= compareNormals(serial, parallel, 120, video::EIT_16BIT, true);
+	result &= compareNormals(serial, parallel, 300, video::EIT_32BIT, true);
+	result &= compareNormals(serial, parallel, 20, video::EIT_16BIT, false);
+
+	result &= compareTangents(serial, parallel, 120, video::EIT_16BIT, true, false);
+	result &= compareTangents(serial, parallel, 120, video::EIT_16BIT, false, true);
+	result &= compareTangents(serial, parallel, 300, video::EIT_32BIT, true, true);
+	result &= compareTangents(serial, parallel, 20, video::EIT_16BIT, true, true);
+	result &= compareFlippedSurfaces(serial, parallel, video::EIT_16BIT);
+	result &= compareFlippedSurfaces(serial, parallel, video::EIT_32BIT);
+
+	// a whole mesh converted to tangents
+	IMesh* sphere = serialDevice->getSceneManager()->getGeometryCreator()->createSphereMesh(10.f, 128, 128);
+	IMesh* expected = serial->createMeshWithTangents(sphere, true, true, true);
+	IMesh* tangents = parallel->createMeshWithTangents(sphere, true, true, true);
+	const IMeshBuffer* e = expected->getMeshBuffer(0);
+	const IMeshBuffer* b = tangents->getMeshBuffer(0);
+	result &= (e->getVertexCount() == b->getVertexCount());
+	for (u32 i=0; result && i<b->getVertexCount(); ++i)
+	{
+		result &= equalVectors(((const video::S3DVertexTangents*)e->getVertices())[i].Tangent,
+			((const video::S3DVertexTangents*)b->getVertices())[i].Tangent);
+		result &= equalVectors(e->getNormal(i), b->getNormal(i));
+	}
+	sphere->drop();
+	expected->drop();
+	tangents->drop();
+
+	assert_log(result);
+
+	serialDevice->closeDevice();
+	serialDevice->run();
+	serialDevice->drop();
+	parallelDevice->closeDevice();
+	parallelDevice->run();
+	parallelDevice->drop();
+
+	return result;
+}
@@ -0,0 +1,314 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+u32 getTriangleCount(IMesh* mesh)
+{
+	u32 count = 0;
+	for (u32 b=0; b<mesh->getMeshBufferCount(); ++b)
+		count += mesh->getMeshBuffer(b)->getIndexCount() / 3;
+	return count;
+}
+
+u32 getIndex(const IMeshBuffer* mb, u32 i)
+{
+	return mb->getIndexType() == video::EIT_32BIT ? ((const u32*)mb->getIndices())[i] : mb->getIndices()[i];
+}
+
+bool hasPosition(const IMeshBuffer* mb, const vector3df& pos)
+{
+	for (u32 i=0; i<mb->getVertexCount(); ++i)
+	{
+		if (mb->getPosition(i) == pos)
+			return true;
+	}
+	return false;
+}
+
+// a wavy grid with the left and the right half in two meshbuffers, so they share a border
+SMesh* createGrid(u32 size, f32 height)
+{
+	SMesh* mesh = new SMesh();
+	for (u32 half=0; half<2; ++half)
+	{
+		SMeshBuffer* buffer = new SMeshBuffer();
+		buffer->Material.DiffuseColor = video::SColor(255, half * 255, 0, 0);
+		const u32 first = half * (size / 2);
+		const u32 columns = size / 2 + 1;
+		for (u32 z=0; z<=size; ++z)
+		{
+			for (u32 x=first; x<first+columns; ++x)
+			{
+				const vector3df pos((f32)x, sinf(x * 0.3f) * cosf(z * 0.4f) * height, (f32)z);
+				buffer->Vertices.push_back(video::S3DVertex(pos, vector3df(0,1,0),
+					video::SColor(255,255,255,255), vector2df((f32)x / size, (f32)z / size)));
+			}
+		}
+		for (u32 z=0; z<size; ++z)
+		{
+			for (u32 x=0; x<columns-1; ++x)
+			{
+				const u16 i = (u16)(z*columns + x);
+				buffer->Indices.push_back(i);
+				buffer->Indices.push_back(i+columns);
+				buffer->Indices.push_back(i+1);
+				buffer->Indices.push_back(i+1);
+				buffer->Indices.push_back(i+columns);
+				buffer->Indices.push_back(i+columns+1);
+			}
+		}
+		buffer->recalculateBoundingBox();
+		mesh->addMeshBuffer(buffer);
+		buffer->drop();
+	}
+	mesh->recalculateBoundingBox();
+	return mesh;
+}
+
+// the simplified grid keeps the border between the buffers and the outer
+// border, no triangle is flipped and only old vertices are used
+bool testGrid(IMeshManipulator* manipulator, f32 height, f32 ratio)
+{
+	const u32 size = 40;
+	SMesh* mesh = createGrid(size, height);
+	IMesh* simplified = manipulator->createMeshSimplified(mesh, ratio);
+
+	bool result = (simplified->getMeshBufferCount() == 2);
+	for (u32 b=0; result && b<2; ++b)
+	{
+		const IMeshBuffer* mb = mesh->getMeshBuffer(b);
+		const IMeshBuffer* smb = simplified->getMeshBuffer(b);
+		result &= (smb->getMaterial() == mb->getMaterial());
+		result &= (smb->getIndexCount() < mb->getIndexCount());
+		result &= (smb->getIndexCount() > 0);
+
+		for (u32 i=0; i<smb->getVertexCount(); ++i)
+			result &= hasPosition(mb, smb->getPosition(i));
+
+		// the column shared by both buffers is complete
+		for (u32 z=0; z<=size; ++z)
+			result &= hasPosition(smb, mb->getPosition(z * (size / 2 + 1) + (b == 0 ? size / 2 : 0)));
+
+		f32 area = 0.f;
+		for (u32 i=0; i<smb->getIndexCount(); i+=3)
+		{
+			const vector3df p0 = smb->getPosition(getIndex(smb, i));
+			const vector3df p1 = smb->getPosition(getIndex(smb, i+1));
+			const vector3df p2 = smb->getPosition(getIndex(smb, i+2));
+			const vector3df normal = (p1 - p0).crossProduct(p2 - p0);
+			// some triangles of the wavy grid are vertical
+			result &= (height > 0.f ? normal.Y >= 0.f : normal.Y > 0.f);
+			area += normal.Y * 0.5f;
+		}
+
+		// the projected area stays the same as the border is kept
+		result &= core::equals(area, (f32)(size * size / 2), 0.01f);
+	}
+
+	if (!result)
+		logTestString("Simplifying a grid with height %f failed\n", height);
+
+	simplified->drop();
+	mesh->drop();
+	return result;
+}
+
+u32 getSeamVertexCount(const IMeshBuffer* mb)
+{
+	u32 count = 0;
+	for (u32 i=0; i<mb->getVertexCount(); ++i)
+	{
+		if (core::equals(mb->getTCoords(i).X, 0.f))
+			++count;
+	}
+	return count;
+}
+
+// another vertex at the same position, with other attributes
+bool hasTwin(const IMeshBuffer* mb, u32 v)
+{
+	for (u32 i=0; i<mb->getVertexCount(); ++i)
+	{
+		if (i != v && mb->getPosition(i) == mb->getPosition(v))
+			return true;
+	}
+	return false;
+}
+
+// both flat sides are simplified down to a few triangles, which still meet
+// at the ridge
+bool testRoof(IMeshManipulator* manipulator)
+{
+	const u32 size = 20;
+	SMeshBuffer* buffer = new SMeshBuffer();
+	for (u32 side=0; side<2; ++side)
+	{
+		const vector3df normal(side ? 0.7071f : -0.7071f, 0.7071f, 0.f);
+		const u16 first = (u16)buffer->Vertices.size();
+		for (u32 z=0; z<=size; ++z)
+		{
+			for (u32 x=0; x<=size; ++x)
+			{
+				// the sides go down from the ridge at x=0
+				const f32 px = side ? (f32)x : -(f32)x;
+				const vector3df pos(px, (f32)size - x, (f32)z);
+				buffer->Vertices.push_back(video::S3DVertex(pos, normal,
+					video::SColor(255,255,255,255), vector2df((f32)x / size, (f32)z / size)));
+			}
+		}
+		for (u32 z=0; z<size; ++z)
+		{
+			for (u32 x=0; x<size; ++x)
+			{
+				const u16 i = (u16)(first + z*(size+1) + x);
+				const u16 corners[4] = { i, (u16)(i+size+1), (u16)(i+1), (u16)(i+size+2) };
+				// keep the triangles facing up on both sides
+				buffer->Indices.push_back(corners[0]);
+				buffer->Indices.push_back(side ? corners[1] : corners[2]);
+				buffer->Indices.push_back(side ? corners[2] : corners[1]);
+				buffer->Indices.push_back(corners[2]);
+				buffer->Indices.push_back(side ? corners[1] : corners[3]);
+				buffer->Indices.push_back(side ? corners[3] : corners[1]);
+			}
+		}
+	}
+	buffer->recalculateBoundingBox();
+	SMesh* roof = new SMesh();
+	roof->addMeshBuffer(buffer);
+	buffer->drop();
+	roof->recalculateBoundingBox();
+
+	IMesh* simplified = manipulator->createMeshSimplified(roof, 0.f);
+	const IMeshBuffer* smb = simplified->getMeshBuffer(0);
+	bool result = (getTriangleCount(simplified) <= 8);
+
+	// the ridge has no gap and the projected area stays the same
+	f32 area = 0.f;
+	for (u32 i=0; i<smb->getVertexCount(); ++i)
+	{
+		if (core::equals(smb->getPosition(i).X, 0.f))
+			result &= hasTwin(smb, i);
+	}
+	for (u32 i=0; i<smb->getIndexCount(); i+=3)
+	{
+		const vector3df p0 = smb->getPosition(getIndex(smb, i));
+		const vector3df p1 = smb->getPosition(getIndex(smb, i+1));
+		const vector3df p2 = smb->getPosition(getIndex(smb, i+2));
+		const vector3df normal = (p1 - p0).crossProduct(p2 - p0);
+		result &= (normal.Y > 0.f);
+		area += normal.Y * 0.5f;
+	}
+	result &= core::equals(area, (f32)(2 * size * size), 0.01f);
+
+	if (!result)
+		logTestString("Simplifying a roof left %u triangles, area %f\n", getTriangleCount(simplified), area);
+
+	simplified->drop();
+	roof->drop();
+	return result;
+}
+
+} // end anonymous namespace
+
+// Tests that simplified meshes keep seams, borders and the borders between
+// meshbuffers, and that the node with levels of detail draws the level
+// fitting its size on the screen.
+bool meshSimplification(void)
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	ISceneManager* smgr = device->getSceneManager();
+	IMeshManipulator* manipulator = smgr->getMeshManipulator();
+
+	// a flat grid can be simplified to few triangles, a wavy one partly
+	bool result = testGrid(manipulator, 0.f, 0.3f);
+	result &= testGrid(manipulator, 2.f, 0.3f);
+
+	// a flat grid keeps only the corners and the border between the buffers
+	SMesh* grid = createGrid(40, 0.f);
+	IMesh* flat = manipulator->createMeshSimplified(grid, 0.f);
+	result &= (getTriangleCount(flat) <= 2 * 41 + 4);
+	flat->drop();
+	grid->drop();
+
+	// a sphere has a seam where the texture coordinates wrap
+	IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(10.f, 64, 64);
+	const u32 sphereTriangles = getTriangleCount(sphere);
+	IMesh* simplified = manipulator->createMeshSimplified(sphere, 0.25f);
+	const IMeshBuffer* mb = sphere->getMeshBuffer(0);
+	const IMeshBuffer* smb = simplified->getMeshBuffer(0);
+	result &= (getTriangleCount(simplified) <= sphereTriangles / 4 + 1);
+	result &= (getTriangleCount(simplified) > sphereTriangles / 8);
+	// the seam is simplified on both sides alike, so it stays closed
+	result &= (getSeamVertexCount(smb) < getSeamVertexCount(mb));
+	for (u32 i=0; i<smb->getVertexCount(); ++i)
+	{
+		const f32 u = smb->getTCoords(i).X;
+		if (core::equals(u, 0.f) || core::equals(u, 1.f))
+			result &= hasTwin(smb, i);
+		result &= core::equals(smb->getPosition(i).getLength(), 10.f, 0.01f);
+	}
+	simplified->drop();
+
+	// a roof with a hard edge at its ridge, each side with its own normals
+	result &= testRoof(manipulator);
+
+	// the levels of detail of the sphere
+	IAnimatedMesh* lodMesh = manipulator->createLodMesh(sphere, 4, 0.5f, 0.25f);
+	result &= (lodMesh->getMeshType() == EAMT_LOD);
+	SLodMesh* lods = (SLodMesh*)lodMesh;
+	result &= (lods->Meshes.size() == 4);
+	result &= (lods->Meshes[0] == sphere);
+	for (u32 i=1; i<lods->Meshes.size(); ++i)
+	{
+		result &= (getTriangleCount(lods->Meshes[i]) < getTriangleCount(lods->Meshes[i-1]));
+		result &= (lods->Meshes[i]->getMeshBufferCount() == sphere->getMeshBufferCount());
+	}
+	result &= (lodMesh->getMesh(0, 255) == sphere);
+	result &= (lodMesh->getMesh(0, 0) == lods->Meshes[3]);
+	result &= (lods->getLod(0.2f) == lods->Meshes[1]);
+
+	// the node draws less of the sphere the further away it is
+	IMeshSceneNode* node = smgr->addMeshSceneNode(lodMesh);
+	ICameraSceneNode* camera = smgr->addCameraSceneNode(0, vector3df(0, 0, -30.f), vector3df(0, 0, 0));
+	camera->setFarValue(100000.f);
+	video::IVideoDriver* driver = device->getVideoDriver();
+	const f32 distances[] = { 30.f, 150.f, 300.f, 800.f, 5000.f };
+	const u32 expected[] = { 0, 1, 2, 3, 3 };
+	for (u32 i=0; i<sizeof(distances)/sizeof(distances[0]); ++i)
+	{
+		camera->setPosition(vector3df(0, 0, -distances[i]));
+		driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,0,0,0));
+		smgr->drawAll();
+		driver->endScene();
+		const u32 drawn = driver->getFrameStats().PrimitivesDrawn;
+		if (drawn != getTriangleCount(lods->Meshes[expected[i]]))
+		{
+			logTestString("Drew %u triangles at distance %f\n", drawn, distances[i]);
+			result = false;
+		}
+	}
+	result &= (node->getMesh() == lodMesh);
+
+	lodMesh->drop();
+	sphere->drop();
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
@@ -0,0 +1,157 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+// a grid where every triangle has its own vertices, positions are moved by less than jitter
+IMeshBuffer* createUnsharedGrid(u32 size, f32 jitter, video::E_INDEX_TYPE indexType)
+{
+	CDynamicMeshBuffer* buffer = new CDynamicMeshBuffer(video::EVT_STANDARD, indexType);
+	IVertexBuffer& vertices = buffer->getVertexBuffer();
+	IIndexBuffer& indices = buffer->getIndexBuffer();
+
+	const u32 corners[6][2] = { {0,0}, {0,1}, {1,0}, {1,0}, {0,1}, {1,1} };
+	u32 n = 0;
+	for (u32 z=0; z<size-1; ++z)
+	{
+		for (u32 x=0; x<size-1; ++x)
+		{
+			for (u32 c=0; c<6; ++c)
+			{
+				const u32 px = x + corners[c][0];
+				const u32 pz = z + corners[c][1];
+				const f32 offset = jitter * (((n * 7919) % 13) / 6.f - 1.f);
+				const vector3df pos(px + offset, (f32)((px * 3 + pz) % 4), pz - offset);
+				vertices.push_back(video::S3DVertex(pos, vector3df(0,1,0),
+					video::SColor(255,255,255,255), vector2df((f32)px / size, (f32)pz / size)));
+				indices.push_back(n++);
+			}
+		}
+	}
+
+	// a triangle which is degenerated after welding
+	vertices.push_back(video::S3DVertex(vector3df(0,0,0), vector3df(0,1,0), video::SColor(255,255,255,255), vector2df(0,0)));
+	vertices.push_back(video::S3DVertex(vector3df(0,0,0), vector3df(0,1,0), video::SColor(255,255,255,255), vector2df(0,0)));
+	vertices.push_back(video::S3DVertex(vector3df(0,0,0), vector3df(0,1,0), video::SColor(255,255,255,255), vector2df(0,0)));
+	indices.push_back(n);
+	indices.push_back(n+1);
+	indices.push_back(n+2);
+
+	buffer->recalculateBoundingBox();
+	return buffer;
+}
+
+// welds the vertices by comparing all vertices with each other, each vertex
+// gets the first vertex it is welded to and the count of the kept vertices is returned
+u32 weldAll(const IMeshBuffer* mb, f32 tolerance, array<u32>& kept)
+{
+	const video::S3DVertex* v = (const video::S3DVertex*)mb->getVertices();
+	kept.set_used(mb->getVertexCount());
+	u32 count = 0;
+	for (u32 i=0; i<mb->getVertexCount(); ++i)
+	{
+		kept[i] = i;
+		for (u32 j=0; j<i; ++j)
+		{
+			if (v[i].Pos.equals(v[j].Pos, tolerance) && v[i].Normal.equals(v[j].Normal, tolerance) &&
+				v[i].TCoords.equals(v[j].TCoords) && v[i].Color == v[j].Color)
+			{
+				kept[i] = kept[j];
+				break;
+			}
+		}
+		if (kept[i] == i)
+			++count;
+	}
+	return count;
+}
+
+// the welded buffer has the same triangles, without the degenerated one
+bool compareTriangles(const IMeshBuffer* mb, const IMeshBuffer* welded, const array<u32>& kept)
+{
+	if (welded->getIndexCount() + 3 != mb->getIndexCount())
+		return false;
+
+	for (u32 i=0; i<welded->getIndexCount(); ++i)
+	{
+		const u32 a = mb->getIndexType() == video::EIT_32BIT ? ((const u32*)mb->getIndices())[i] : mb->getIndices()[i];
+		const u32 b = welded->getIndexType() == video::EIT_32BIT ? ((const u32*)welded->getIndices())[i] : welded->getIndices()[i];
+		const u32 k = kept.empty() ? a : kept[a];
+		if (b >= welded->getVertexCount() || !(mb->getPosition(k) == welded->getPosition(b)))
+			return false;
+	}
+	return true;
+}
+
+bool testWelding(IMeshManipulator* manipulator, u32 size, f32 jitter, f32 tolerance,
+		video::E_INDEX_TYPE indexType, bool compareWithAll)
+{
+	IMeshBuffer* mb = createUnsharedGrid(size, jitter, indexType);
+	SMesh* mesh = new SMesh();
+	mesh->addMeshBuffer(mb);
+	mb->drop();
+
+	IMesh* weldedMesh = manipulator->createMeshWelded(mesh, tolerance);
+	bool result = (weldedMesh && weldedMesh->getMeshBufferCount() == 1);
+	if (result)
+	{
+		const IMeshBuffer* welded = weldedMesh->getMeshBuffer(0);
+		array<u32> kept;
+		const u32 expected = compareWithAll ? weldAll(mb, tolerance, kept) : size * size;
+		result &= (welded->getVertexCount() == expected);
+		result &= (welded->getIndexType() == (expected > 65535 ? video::EIT_32BIT : video::EIT_16BIT));
+		result &= compareTriangles(mb, welded, kept);
+		result &= (welded->getBoundingBox() == mb->getBoundingBox());
+
+		if (!result)
+		{
+			logTestString("Welding a grid of size %u gave %u vertices, expected %u\n",
+				size, welded->getVertexCount(), expected);
+		}
+	}
+
+	if (weldedMesh)
+		weldedMesh->drop();
+	mesh->drop();
+	return result;
+}
+
+} // end anonymous namespace
+
+// Tests that createMeshWelded merges the same vertices as comparing all
+// vertices with each other and that it switches to 32 bit indices when needed.
+bool meshWelding(void)
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	IMeshManipulator* manipulator = device->getSceneManager()->getMeshManipulator();
+
+	// exact and with positions moved less than the tolerance
+	bool result = testWelding(manipulator, 30, 0.f, ROUNDING_ERROR_f32, video::EIT_16BIT, true);
+	result &= testWelding(manipulator, 30, 0.004f, 0.01f, video::EIT_16BIT, true);
+	result &= testWelding(manipulator, 30, 0.004f, 0.01f, video::EIT_32BIT, true);
+
+	// positions moved more than the tolerance are partly welded
+	result &= testWelding(manipulator, 20, 0.1f, 0.05f, video::EIT_16BIT, true);
+
+	// too many vertices for 16 bit indices after welding
+	result &= testWelding(manipulator, 300, 0.f, ROUNDING_ERROR_f32, video::EIT_32BIT, false);
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
@@ -0,0 +1,160 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+// draws one frame and returns the primitives drawn in it
+static u32 drawFrame(IrrlichtDevice* device, ICameraSceneNode* camera,
+		const vector3df& position, const vector3df& target)
+{
+	camera->setPosition(position);
+	camera->setTarget(target);
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,0,0,0));
+	device->getSceneManager()->drawAll();
+	driver->endScene();
+
+	return driver->getFrameStats().PrimitivesDrawn;
+}
+
+// draws a view with a mesh node and with an octree node of the same mesh and
+// compares the images, so the visible parts of the tree must be the right ones
+static bool compareWithMeshNode(video::E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice *device = createDevice(driverType, dimension2d<u32>(160, 120));
+	if (!device)
+		return true; // no error if the driver does not exist
+
+	ISceneManager* smgr = device->getSceneManager();
+	video::IVideoDriver* driver = device->getVideoDriver();
+	device->getFileSystem()->addFileArchive("../media/map-20kdm2.pk3");
+	IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+	bool result = (mesh != 0);
+	if (mesh)
+	{
+		ISceneNode* meshNode = smgr->addMeshSceneNode(mesh->getMesh(0));
+		IOctreeSceneNode* octreeNode = smgr->addOctreeSceneNode(mesh->getMesh(0), 0, -1, 256);
+		octreeNode->setPolygonChecks(EOPC_FRUSTUM);
+		ICameraSceneNode* camera = smgr->addCameraSceneNode();
+		const vector3df center = octreeNode->getBoundingBox().getCenter();
+
+		const char* const names[] = { "results/octreeVisibility-mesh.png", "results/octreeVisibility-octree.png" };
+		for (u32 n=0; n<2; ++n)
+		{
+			meshNode->setVisible(n == 0);
+			octreeNode->setVisible(n == 1);
+
+			// the second frame is drawn with unchanged visible parts
+			for (u32 f=0; f<2; ++f)
+				drawFrame(device, camera, center, center + vector3df(100.f, -10.f, 30.f));
+
+			video::IImage* screenshot = driver->createScreenShot(video::ECF_A8R8G8B8);
+			result &= (screenshot != 0);
+			if (screenshot)
+			{
+				driver->writeImageToFile(screenshot, names[n]);
+				screenshot->drop();
+			}
+		}
+		result &= (fuzzyCompareImages(driver, names[0], names[1]) > 99.5f);
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// Tests that the octree node draws the same polygons when the visible parts of
+// the tree did not change and that it draws what a mesh node would draw.
+bool octreeVisibility(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	ISceneManager* smgr = device->getSceneManager();
+	device->getFileSystem()->addFileArchive("../media/map-20kdm2.pk3");
+	IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+	if (!mesh)
+	{
+		logTestString("Could not load the level.\n");
+		device->closeDevice();
+		device->run();
+		device->drop();
+		return false;
+	}
+
+	IOctreeSceneNode* node = smgr->addOctreeSceneNode(mesh->getMesh(0), 0, -1, 256);
+	ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	camera->setFarValue(100000.f);
+
+	u32 allPrimitives = 0;
+	for (u32 b=0; b<node->getMesh()->getMeshBufferCount(); ++b)
+		allPrimitives += node->getMesh()->getMeshBuffer(b)->getIndexCount() / 3;
+
+	const aabbox3df& box = node->getBoundingBox();
+	const vector3df center = box.getCenter();
+	const vector3df outside = center + vector3df(1.f, 2.f, 1.f).normalize() * box.getExtent().getLength() * 4.f;
+
+	// views inside of the level, each one drawn twice so the unchanged
+	// visible parts are drawn again without collecting them
+	array<vector3df> positions;
+	array<vector3df> targets;
+	for (u32 i=0; i<16; ++i)
+	{
+		const f32 angle = i * 0.7f;
+		positions.push_back(center + vector3df(sinf(i * 1.3f), 0.1f, cosf(i * 1.7f)) * box.getExtent() * 0.3f);
+		targets.push_back(positions.getLast() + vector3df(sinf(angle), -0.2f, cosf(angle)) * 100.f);
+	}
+
+	const EOCTREE_POLYGON_CHECKS checks[] = { EOPC_BOX, EOPC_FRUSTUM };
+	array<u32> drawn[2];
+
+	bool result = (allPrimitives > 0);
+	for (u32 c=0; c<2; ++c)
+	{
+		node->setPolygonChecks(checks[c]);
+
+		// from far outside the whole level is drawn
+		result &= (drawFrame(device, camera, outside, center) == allPrimitives);
+
+		u32 inside = 0;
+		for (u32 i=0; i<positions.size(); ++i)
+		{
+			const u32 first = drawFrame(device, camera, positions[i], targets[i]);
+			result &= (drawFrame(device, camera, positions[i], targets[i]) == first);
+			result &= (first <= allPrimitives);
+			inside += first;
+			drawn[c].push_back(first);
+		}
+		result &= (inside < positions.size() * allPrimitives);
+
+		// and all of it again after the parts inside
+		result &= (drawFrame(device, camera, outside, center) == allPrimitives);
+	}
+
+	// the frustum is never less exact than its bounding box
+	for (u32 i=0; i<positions.size(); ++i)
+		result &= (drawn[1][i] <= drawn[0][i]);
+
+	if (!result)
+		logTestString("octreeVisibility failed for a level with %u primitives\n", allPrimitives);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	result &= compareWithMeshNode(video::EDT_BURNINGSVIDEO);
+
+	assert_log(result);
+
+	return result;
+}
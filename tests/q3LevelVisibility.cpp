@@ -0,0 +1,154 @@
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+// draws one frame and returns the primitives drawn in it
+static u32 drawFrame(IrrlichtDevice* device, ICameraSceneNode* camera,
+		const vector3df& position, const vector3df& target)
+{
+	camera->setPosition(position);
+	camera->setTarget(target);
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	driver->beginScene(video::ECBF_COLOR | video::ECBF_DEPTH, video::SColor(255,0,0,0));
+	device->getSceneManager()->drawAll();
+	driver->endScene();
+
+	return driver->getFrameStats().PrimitivesDrawn;
+}
+
+// Tests the bsp tree and the potentially visible sets of a quake3 level and
+// that the level node only draws the faces which can be seen.
+bool q3LevelVisibility(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if (!device)
+		return false;
+
+	ISceneManager* smgr = device->getSceneManager();
+	device->getFileSystem()->addFileArchive("../media/map-20kdm2.pk3");
+	IAnimatedMesh* mesh = smgr->getMesh("20kdm2.bsp");
+	if (!mesh || mesh->getMeshType() != EAMT_BSP)
+	{
+		logTestString("Could not load the level.\n");
+		device->closeDevice();
+		device->run();
+		device->drop();
+		return false;
+	}
+
+	IQ3LevelMesh* level = (IQ3LevelMesh*)mesh;
+	IMesh* geometry = level->getMesh(quake3::E_Q3_MESH_GEOMETRY);
+
+	bool result = (level->getLeafCount() > 0 && level->getFaceCount() > 0);
+
+	// every index of the geometry belongs to exactly one face
+	u32 geometryIndices = 0;
+	for (u32 b=0; b<geometry->getMeshBufferCount(); ++b)
+		geometryIndices += geometry->getMeshBuffer(b)->getIndexCount();
+
+	u32 faceIndices = 0;
+	for (u32 f=0; f<level->getFaceCount(); ++f)
+	{
+		const quake3::SBSPFace& face = level->getFace(f);
+		if (face.MeshBuffer < 0)
+			continue;
+		result &= (face.MeshBuffer < (s32)geometry->getMeshBufferCount());
+		result &= (face.FirstIndex + face.IndexCount <= geometry->getMeshBuffer(face.MeshBuffer)->getIndexCount());
+		result &= (face.IndexCount % 3 == 0);
+		faceIndices += face.IndexCount;
+	}
+	result &= (faceIndices == geometryIndices);
+
+	// the centers of the leafs are found in the tree and every cluster sees itself
+	array<u32> openLeafs;
+	u32 hiddenPairs = 0;
+	for (u32 l=0; l<level->getLeafCount(); ++l)
+	{
+		const quake3::SBSPLeaf& leaf = level->getLeaf(l);
+		if (leaf.Cluster < 0 || !leaf.LeafFaceCount)
+			continue;
+
+		const vector3df center = leaf.BoundingBox.getCenter();
+		const s32 found = level->findLeaf(center);
+		result &= (found >= 0 && level->getLeaf(found).BoundingBox.isPointInside(center));
+		result &= level->isClusterVisible(leaf.Cluster, leaf.Cluster);
+		if (found == (s32)l)
+			openLeafs.push_back(l);
+
+		if (!level->isClusterVisible(leaf.Cluster, level->getLeaf(0).Cluster))
+			++hiddenPairs;
+	}
+	result &= (openLeafs.size() > 0);
+	result &= (hiddenPairs > 0);
+
+	// nothing is culled by the visibility data from outside of the level
+	result &= level->isClusterVisible(-1, 0);
+
+	IMeshSceneNode* node = smgr->addQuake3LevelSceneNode(level);
+	result &= (node && node->getType() == ESNT_Q3LEVEL_SCENE_NODE);
+	result &= (node->getMesh() == geometry);
+	result &= (node->getMaterialCount() == geometry->getMeshBufferCount());
+
+	ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	camera->setFarValue(100000.f);
+
+	// from far outside the whole level is in the frustum and drawn
+	const aabbox3df& box = geometry->getBoundingBox();
+	const vector3df outside = box.getCenter() + vector3df(1.f, 2.f, 1.f).normalize() * box.getExtent().getLength() * 4.f;
+	const u32 allPrimitives = drawFrame(device, camera, outside, box.getCenter());
+	result &= (allPrimitives == geometryIndices / 3);
+
+	// inside the level only parts are drawn
+	const vector3df directions[] = { vector3df(1,0,0), vector3df(-1,0,0), vector3df(0,0,1), vector3df(0,0,-1) };
+	u32 drawnInside = 0;
+	u32 frames = 0;
+	for (u32 l=0; l<openLeafs.size(); l += core::max_(1u, openLeafs.size() / 8))
+	{
+		const vector3df center = level->getLeaf(openLeafs[l]).BoundingBox.getCenter();
+		for (u32 d=0; d<sizeof(directions)/sizeof(directions[0]); ++d)
+		{
+			const u32 drawn = drawFrame(device, camera, center, center + directions[d] * 100.f);
+			result &= (drawn <= allPrimitives);
+			drawnInside += drawn;
+			++frames;
+		}
+	}
+	result &= (drawnInside > 0);
+	result &= (drawnInside < frames * allPrimitives / 2);
+
+	if (!openLeafs.empty())
+	{
+		// drawing the same position again gives the same result
+		const vector3df center = level->getLeaf(openLeafs[0]).BoundingBox.getCenter();
+		const u32 first = drawFrame(device, camera, center, center + directions[0] * 100.f);
+		drawFrame(device, camera, outside, box.getCenter());
+		result &= (drawFrame(device, camera, center, center + directions[0] * 100.f) == first);
+
+		// moving the level moves the visibility with it
+		const vector3df offset(1000.f, 0.f, 0.f);
+		node->setPosition(offset);
+		node->updateAbsolutePosition();
+		result &= (drawFrame(device, camera, center + offset, center + offset + directions[0] * 100.f) == first);
+	}
+
+	if (!result)
+	{
+		logTestString("q3LevelVisibility failed: %u of %u primitives drawn from outside, %u in %u frames inside\n",
+			allPrimitives, geometryIndices / 3, drawnInside, frames);
+	}
+
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
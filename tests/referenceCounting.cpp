@@ -0,0 +1,196 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+#if defined(_IRR_WINDOWS_API_)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+// Counts how often it was deleted
+class CCountedObject : public IReferenceCounted
+{
+public:
+	CCountedObject(u32& deleted) : Deleted(deleted) {}
+	virtual ~CCountedObject() { ++Deleted; }
+
+private:
+	u32& Deleted;
+};
+
+bool testSingleThreaded()
+{
+	u32 deleted = 0;
+	CCountedObject* object = new CCountedObject(deleted);
+
+	bool result = (object->getReferenceCount() == 1);
+	object->grab();
+	object->grab();
+	result &= (object->getReferenceCount() == 3);
+	result &= !object->drop();
+	result &= !object->drop();
+	result &= (object->getReferenceCount() == 1);
+	result &= (deleted == 0);
+	result &= object->drop();
+	result &= (deleted == 1);
+
+	return result;
+}
+
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+
+struct SShareJob
+{
+	const IMesh* const* Meshes;
+	u32 MeshCount;
+	const video::IImage* Image;
+	// handed over by the main thread, dropped by the job
+	const IReferenceCounted* HandOver;
+	bool DeletedObject;
+};
+
+void shareObjects(SShareJob& job)
+{
+	for (u32 round=0; round<2000; ++round)
+	{
+		for (u32 m=0; m<job.MeshCount; ++m)
+		{
+			const IMesh* mesh = job.Meshes[m];
+			mesh->grab();
+			for (u32 b=0; b<mesh->getMeshBufferCount(); ++b)
+			{
+				mesh->getMeshBuffer(b)->grab();
+				mesh->getMeshBuffer(b)->drop();
+			}
+			mesh->drop();
+		}
+		job.Image->grab();
+		job.Image->drop();
+	}
+
+	job.DeletedObject = job.HandOver->drop();
+}
+
+#if defined(_IRR_WINDOWS_API_)
+DWORD WINAPI shareThread(LPVOID data)
+{
+	shareObjects(*static_cast<SShareJob*>(data));
+	return 0;
+}
+#else
+void* shareThread(void* data)
+{
+	shareObjects(*static_cast<SShareJob*>(data));
+	return 0;
+}
+#endif
+
+// Grabs and drops meshes, their buffers and an image from several threads.
+// Each thread also drops one reference of an object, the last one deletes it.
+bool testSharedAcrossThreads(IrrlichtDevice* device)
+{
+	const IGeometryCreator* geom = device->getSceneManager()->getGeometryCreator();
+	IMesh* meshes[3];
+	meshes[0] = geom->createCubeMesh();
+	meshes[1] = geom->createSphereMesh();
+	meshes[2] = geom->createCylinderMesh(5.f, 20.f, 16);
+	const u32 meshCount = 3;
+	video::IImage* image = device->getVideoDriver()->createImage(video::ECF_A8R8G8B8, dimension2d<u32>(8, 8));
+
+	u32 deleted = 0;
+	CCountedObject* handOver = new CCountedObject(deleted);
+
+	const u32 threadCount = 4;
+	SShareJob jobs[threadCount];
+#if defined(_IRR_WINDOWS_API_)
+	HANDLE threads[threadCount];
+#else
+	pthread_t threads[threadCount];
+#endif
+	for (u32 t=0; t<threadCount; ++t)
+	{
+		jobs[t].Meshes = meshes;
+		jobs[t].MeshCount = meshCount;
+		jobs[t].Image = image;
+		jobs[t].HandOver = handOver;
+		jobs[t].DeletedObject = false;
+		handOver->grab();
+#if defined(_IRR_WINDOWS_API_)
+		threads[t] = CreateThread(0, 0, shareThread, &jobs[t], 0, 0);
+#else
+		pthread_create(&threads[t], 0, shareThread, &jobs[t]);
+#endif
+	}
+	// the threads hold the only references now
+	bool result = !handOver->drop();
+
+	u32 deletedByThreads = 0;
+	for (u32 t=0; t<threadCount; ++t)
+	{
+#if defined(_IRR_WINDOWS_API_)
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], 0);
+#endif
+		if (jobs[t].DeletedObject)
+			++deletedByThreads;
+	}
+
+	result &= (deleted == 1);
+	result &= (deletedByThreads == 1);
+
+	for (u32 m=0; m<meshCount; ++m)
+	{
+		result &= (meshes[m]->getReferenceCount() == 1);
+		for (u32 b=0; b<meshes[m]->getMeshBufferCount(); ++b)
+			result &= (meshes[m]->getMeshBuffer(b)->getReferenceCount() == 1);
+		meshes[m]->drop();
+	}
+	result &= (image->getReferenceCount() == 1);
+	image->drop();
+
+	if (!result)
+		logTestString("Shared objects: deleted %u times, by %u threads\n", deleted, deletedByThreads);
+
+	return result;
+}
+
+#endif
+
+} // end anonymous namespace
+
+/** Test grab() and drop(). With _IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_
+also from several threads, that part should run clean with ThreadSanitizer. */
+bool referenceCounting(void)
+{
+	bool result = testSingleThreaded();
+
+#if defined(_IRR_COMPILE_WITH_ATOMIC_REFERENCE_COUNTING_)
+	IrrlichtDevice * device = irr::createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	assert_log(device);
+	if(!device)
+		return false;
+
+	result &= testSharedAcrossThreads(device);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+#else
+	logTestString("Atomic reference counting is not compiled in, only testing a single thread\n");
+#endif
+
+	return result;
+}
@@ -334,6 +334,48 @@ bool stringSerialization(io::IFileSystem * fs)
 	return true;
 }
 
+// Name lookups must stay correct with many attributes, duplicate names and removals
+bool attributeLookup(io::IFileSystem * fs)
+{
+	io::IAttributes* attr = fs->createEmptyAttributes();
+
+	const u32 count = 500;
+	for ( u32 i=0; i < count; ++i )
+		attr->addInt((core::stringc("Int")+core::stringc(i)).c_str(), (s32)i);
+
+	for ( u32 i=0; i < count; ++i )
+	{
+		const core::stringc name = core::stringc("Int")+core::stringc(i);
+		COMPARE(attr->findAttribute(name.c_str()), (s32)i);
+		COMPARE(attr->getAttributeAsInt(name.c_str(), -1), (s32)i);
+	}
+	COMPARE(attr->existsAttribute("Int500"), false);
+	COMPARE(attr->getAttributeAsInt("Int500", -1), -1);
+
+	// a duplicate name still finds the first attribute
+	attr->addInt("Int7", 1000);
+	COMPARE(attr->getAttributeAsInt("Int7"), 7);
+	COMPARE(attr->getAttributeCount(), count+1);
+
+	// setting a string to 0 removes the attribute, the duplicate shows up then
+	attr->setAttribute("Int7", (const c8*)0);
+	COMPARE(attr->getAttributeAsInt("Int7"), 1000);
+	COMPARE(attr->findAttribute("Int8"), 7);
+	COMPARE(attr->getAttributeAsInt("Int499"), 499);
+
+	attr->setAttribute("Int7", (const wchar_t*)0);
+	COMPARE(attr->existsAttribute("Int7"), false);
+
+	attr->clear();
+	COMPARE(attr->existsAttribute("Int1"), false);
+	attr->setAttribute("Int1", 3);
+	COMPARE(attr->getAttributeAsInt("Int1"), 3);
+
+	attr->drop();
+
+	return true;
+}
+
 bool serializeAttributes()
 {
 	bool result = true;
@@ -370,6 +412,12 @@ bool serializeAttributes()
 		logTestString("stringSerialization failed in %s:%d\n", __FILE__, __LINE__ );
 	}
 
+	result &= attributeLookup(fs);
+	if ( !result )
+	{
+		logTestString("attributeLookup failed in %s:%d\n", __FILE__, __LINE__ );
+	}
+
 	device->closeDevice();
 	device->run();
 	device->drop();
@@ -0,0 +1,176 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+#include <string.h>
+
+using namespace irr;
+using namespace core;
+
+namespace
+{
+
+bool testPool()
+{
+	bool result = true;
+
+	irrPool pool(20, 256);
+	result &= (pool.getBlockSize() == 32);
+
+	void* blocks[20];
+	for (u32 i=0; i<20; ++i)
+	{
+		blocks[i] = pool.allocate();
+		result &= ((((size_t)blocks[i]) & 15) == 0);
+		for (u32 k=0; k<i; ++k)
+			result &= (blocks[i] != blocks[k]);
+		memset(blocks[i], (int)i, 32);
+	}
+	result &= (pool.getUsedBlocks() == 20);
+	result &= (pool.getCapacity() >= 20);
+
+	// freed blocks are used again before new chunks are allocated
+	const u32 capacity = pool.getCapacity();
+	pool.deallocate(blocks[5]);
+	pool.deallocate(blocks[7]);
+	result &= (pool.getUsedBlocks() == 18);
+	void* again = pool.allocate();
+	result &= (again == blocks[7] || again == blocks[5]);
+	result &= (pool.getCapacity() == capacity);
+
+	if (!result)
+		logTestString("irrPool failed\n");
+
+	return result;
+}
+
+bool testSmallObjects()
+{
+	bool result = true;
+
+	// all sizes, including those which go to the heap
+	const size_t sizes[] = { 1, 15, 16, 17, 100, SMALL_OBJECT_MAX_SIZE, SMALL_OBJECT_MAX_SIZE+1, 5000 };
+	const u32 count = sizeof(sizes) / sizeof(sizes[0]);
+	void* ptrs[count];
+	for (u32 i=0; i<count; ++i)
+	{
+		ptrs[i] = allocateSmallObject(sizes[i]);
+		result &= (ptrs[i] != 0);
+		memset(ptrs[i], 0xAB, sizes[i]);
+	}
+	for (u32 i=0; i<count; ++i)
+		deallocateSmallObject(ptrs[i], sizes[i]);
+
+	// a freed block of a size class is used for the next object of that class
+	void* a = allocateSmallObject(40);
+	deallocateSmallObject(a, 40);
+	result &= (allocateSmallObject(48) == a);
+	deallocateSmallObject(a, 48);
+
+	// freeing without the size finds the pool of the block
+	void* b = allocateSmallObject(100);
+	deallocateSmallObject(b);
+	result &= (allocateSmallObject(100) == b);
+	deallocateSmallObject(b, 100);
+	deallocateSmallObject(allocateSmallObject(5000));
+
+	if (!result)
+		logTestString("allocateSmallObject failed\n");
+
+	return result;
+}
+
+// a node of the application, created with placement and nothrow new
+class CUserNode : public scene::ISceneNode
+{
+public:
+	CUserNode(scene::ISceneManager* mgr) : scene::ISceneNode(0, mgr) {}
+	virtual void render() IRR_OVERRIDE {}
+	virtual const aabbox3df& getBoundingBox() const IRR_OVERRIDE { return Box; }
+	aabbox3df Box;
+};
+
+// each index allocates and frees a few objects, from all threads at once
+void allocateInParallel(void* data, u32 begin, u32 end)
+{
+	u32* failed = static_cast<u32*>(data);
+	for (u32 i=begin; i<end; ++i)
+	{
+		list<u32> values;
+		for (u32 k=0; k<8; ++k)
+			values.push_back(i+k);
+		u32 sum = 0;
+		for (list<u32>::Iterator it = values.begin(); it != values.end(); ++it)
+			sum += *it;
+		if (sum != 8*i + 28)
+			*failed = 1;
+	}
+}
+
+bool testSceneNodes()
+{
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.WindowSize = dimension2d<u32>(160, 120);
+	params.JobWorkerCount = 3;
+	IrrlichtDevice * device = createDeviceEx(params);
+	assert_log(device);
+	if (!device)
+		return false;
+
+	bool result = true;
+
+	// lists of all threads use the same pools
+	u32 failed = 0;
+	device->getJobSystem()->parallelFor(0, 20000, allocateInParallel, &failed, 100);
+	result &= (failed == 0);
+
+	// placement new uses the memory of the caller, nothrow new the pools
+	scene::ISceneManager* smgr = device->getSceneManager();
+	void* memory = allocateSmallObject(sizeof(CUserNode));
+	CUserNode* placed = new (memory) CUserNode(smgr);
+	result &= ((void*)placed == memory);
+	placed->~CUserNode();
+	deallocateSmallObject(memory, sizeof(CUserNode));
+	CUserNode* nothrowNode = new (std::nothrow) CUserNode(smgr);
+	result &= (nothrowNode != 0);
+	nothrowNode->drop();
+
+	// nodes and animators of different sizes, added and removed again
+	scene::ISceneNode* root = smgr->addEmptySceneNode();
+	for (u32 round=0; round<3; ++round)
+	{
+		for (u32 i=0; i<1000; ++i)
+		{
+			scene::ISceneNode* node = (i & 1) ? smgr->addEmptySceneNode(root) : smgr->addCubeSceneNode(1.f, root);
+			scene::ISceneNodeAnimator* anim = smgr->createRotationAnimator(vector3df(0, (f32)i, 0));
+			node->addAnimator(anim);
+			anim->drop();
+		}
+		result &= (root->getChildren().size() == 1000);
+		smgr->drawAll();
+		root->removeAll();
+		result &= (root->getChildren().empty());
+	}
+
+	if (!result)
+		logTestString("Pooled scene nodes failed\n");
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+} // end anonymous namespace
+
+/** Test the pools for small objects, scene nodes and list elements. */
+bool smallObjectPool(void)
+{
+	bool result = true;
+	result &= testPool();
+	result &= testSmallObjects();
+	result &= testSceneNodes();
+	return result;
+}
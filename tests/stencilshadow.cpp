@@ -49,6 +49,114 @@ static bool stencilShadow(video::E_DRIVER_TYPE driverType)
 	return result;
 }
 
+// test that static shadows are only created again when the light moved
+static bool staticShadow(video::E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice *device = createDevice (driverType, core::dimension2d<u32>(160,120), 16, false, true);
+	if (!device)
+		return true; // No error if device does not exist
+
+	stabilizeScreenBackground(device->getVideoDriver());
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::ICameraSceneNode* cam = smgr->addCameraSceneNodeFPS();
+	cam->setPosition(core::vector3df(-15,60,40));
+	cam->setTarget(core::vector3df(+25,-5,-25));
+
+	smgr->setAmbientLight(video::SColorf(.5f,.5f,.5f));
+	smgr->setShadowColor( video::SColor(255, 50, 0, 50));
+	smgr->addCubeSceneNode(100, 0, -1, core::vector3df(0,50,0), core::vector3df(), core::vector3df(-1,-1,-1));
+
+	scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(smgr->getMesh("../media/ninja.b3d"), 0, -1, core::vector3df(), core::vector3df(0.f, 230.f, 0.f),core::vector3df(5,5,5));
+	node->setMaterialFlag(video::EMF_NORMALIZE_NORMALS, true);
+	node->addShadowVolumeSceneNode(0, -1, true, 200.f)->setStatic(true);
+	node->setAnimationSpeed(0.f);
+
+	scene::IMeshSceneNode* cube2 = smgr->addCubeSceneNode(10, 0, -1, core::vector3df(40,0,0), core::vector3df(), core::vector3df(1,1,2.5f));
+	cube2->getMaterial(0).DiffuseColor = video::SColor(220, 0, 100, 100);
+	cube2->addShadowVolumeSceneNode(0, -1, false, 200.f)->setStatic(true);
+
+	scene::ILightSceneNode* light = smgr->addLightSceneNode(0, core::vector3df(-40,10,20));
+	light->setLightType(video::ELT_POINT);
+	light->setRadius(500.f);
+	light->getLightData().DiffuseColor.set(1,1,1);
+
+	// the same image as with shadows created each frame, after moving the light away and back
+	const core::vector3df positions[] = { core::vector3df(-40,10,20), core::vector3df(20,40,-30), core::vector3df(-40,10,20), core::vector3df(-40,10,20) };
+	for (u32 i=0; i<sizeof(positions)/sizeof(positions[0]); ++i)
+	{
+		light->setPosition(positions[i]);
+		device->getVideoDriver()->beginScene(video::ECBF_ALL, video::SColor(0,0,0,0));
+		smgr->drawAll();
+		device->getVideoDriver()->endScene();
+	}
+
+	bool result = takeScreenshotAndCompareAgainstReference(device->getVideoDriver(), "-stencilShadow.png", 99.91f);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// test shadow meshes with 32 bit indices, the same image as with 16 bit indices
+static bool shadow32BitIndices(video::E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice *device = createDevice (driverType, core::dimension2d<u32>(160,120), 16, false, true);
+	if (!device)
+		return true; // No error if device does not exist
+
+	stabilizeScreenBackground(device->getVideoDriver());
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::ICameraSceneNode* cam = smgr->addCameraSceneNodeFPS();
+	cam->setPosition(core::vector3df(-15,60,40));
+	cam->setTarget(core::vector3df(+25,-5,-25));
+
+	smgr->setAmbientLight(video::SColorf(.5f,.5f,.5f));
+	smgr->setShadowColor( video::SColor(255, 50, 0, 50));
+	smgr->addCubeSceneNode(100, 0, -1, core::vector3df(0,50,0), core::vector3df(), core::vector3df(-1,-1,-1));
+
+	scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(smgr->getMesh("../media/ninja.b3d"), 0, -1, core::vector3df(), core::vector3df(0.f, 230.f, 0.f),core::vector3df(5,5,5));
+	node->setMaterialFlag(video::EMF_NORMALIZE_NORMALS, true);
+	node->addShadowVolumeSceneNode(0, -1, true, 200.f);
+	node->setAnimationSpeed(0.f);
+
+	scene::IMeshSceneNode* cube2 = smgr->addCubeSceneNode(10, 0, -1, core::vector3df(40,0,0), core::vector3df(), core::vector3df(1,1,2.5f));
+	cube2->getMaterial(0).DiffuseColor = video::SColor(220, 0, 100, 100);
+
+	// copy of the cube mesh with 32 bit indices
+	const scene::IMeshBuffer* cubeBuffer = cube2->getMesh()->getMeshBuffer(0);
+	scene::CDynamicMeshBuffer* buffer = new scene::CDynamicMeshBuffer(video::EVT_STANDARD, video::EIT_32BIT);
+	for (u32 i=0; i<cubeBuffer->getVertexCount(); ++i)
+		buffer->getVertexBuffer().push_back(((const video::S3DVertex*)cubeBuffer->getVertices())[i]);
+	for (u32 i=0; i<cubeBuffer->getIndexCount(); ++i)
+		buffer->getIndexBuffer().push_back(cubeBuffer->getIndices()[i]);
+	scene::SMesh* shadowMesh = new scene::SMesh();
+	shadowMesh->addMeshBuffer(buffer);
+	buffer->drop();
+	cube2->addShadowVolumeSceneNode(shadowMesh, -1, false, 200.f);
+	shadowMesh->drop();
+
+	scene::ILightSceneNode* light = smgr->addLightSceneNode(0, core::vector3df(-40,10,20));
+	light->setLightType(video::ELT_POINT);
+	light->setRadius(500.f);
+	light->getLightData().DiffuseColor.set(1,1,1);
+
+	device->getVideoDriver()->beginScene(video::ECBF_ALL, video::SColor(0,0,0,0));
+	smgr->drawAll();
+	device->getVideoDriver()->endScene();
+
+	bool result = takeScreenshotAndCompareAgainstReference(device->getVideoDriver(), "-stencilShadow.png", 99.91f);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
 // test self-shadowing
 static bool selfShadowing(video::E_DRIVER_TYPE driverType)
 {
@@ -98,6 +206,14 @@ bool stencilShadow(void)
 //	passed &= stencilShadow(video::EDT_SOFTWARE);
 	passed &= stencilShadow(video::EDT_BURNINGSVIDEO);	// Note: cube has wrong color, if that gets ever changed just update the test-image.
 
+	passed &= staticShadow(video::EDT_OPENGL);
+	passed &= staticShadow(video::EDT_DIRECT3D9);
+	passed &= staticShadow(video::EDT_BURNINGSVIDEO);
+
+	passed &= shadow32BitIndices(video::EDT_OPENGL);
+	passed &= shadow32BitIndices(video::EDT_DIRECT3D9);
+	passed &= shadow32BitIndices(video::EDT_BURNINGSVIDEO);
+
 	passed &= selfShadowing(video::EDT_OPENGL);
 	passed &= selfShadowing(video::EDT_DIRECT3D9);
 	// no shadows in software renderer
@@ -1,8 +1,227 @@
 #include "testUtils.h"
 
+#if defined(_IRR_WINDOWS_API_)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 using namespace irr;
 using namespace core;
 
+namespace
+{
+
+u32 countSubstrings(const core::stringc& str, const c8* sub)
+{
+	u32 count = 0;
+	s32 pos = str.find(sub);
+	while (pos >= 0)
+	{
+		++count;
+		pos = str.find(sub, pos+1);
+	}
+	return count;
+}
+
+// Test the profiler which works with the nanosecond timer
+bool testProfiler(ITimer* timer)
+{
+	logTestString("Testing profiler.\n");
+	bool success = true;
+
+	const u64 startNs = timer->getRealTimeNanoseconds();
+	IProfiler& profiler = getProfiler();
+	const s32 outer = profiler.add(L"test outer", L"test timer");
+	const s32 inner = profiler.add(L"test inner", L"test timer");
+
+	profiler.startTrace();
+	volatile u32 dummy = 0;
+	for (u32 i=0; i<10; ++i)
+	{
+		profiler.start(outer);
+		for (u32 k=0; k<1000; ++k)
+		{
+			profiler.start(inner);
+			dummy += k;
+			profiler.stop(inner);
+		}
+		profiler.stop(outer);
+	}
+	profiler.stopTrace();
+
+	if (timer->getRealTimeNanoseconds() <= startNs)
+	{
+		logTestString("Nanosecond timer did not progress.\n");
+		success = false;
+	}
+
+	const SProfileData* data = profiler.getProfileDataById(outer);
+	if (!data || data->getCallsCounter() != 10 || data->getTimeSumNanoseconds() == 0
+		|| data->getPercentileTime(0.5f) > data->getPercentileTime(0.99f)
+		|| data->getPercentileTime(0.99f) > data->getLongestTimeNanoseconds())
+	{
+		logTestString("Wrong profile data for outer scope.\n");
+		success = false;
+	}
+	data = profiler.getProfileDataById(inner);
+	if (!data || data->getCallsCounter() != 10000)
+	{
+		logTestString("Wrong profile data for inner scope.\n");
+		success = false;
+	}
+
+	core::stringc trace;
+	profiler.printTrace(trace);
+	if (countSubstrings(trace, "\"name\":\"test outer\"") != 20
+		|| countSubstrings(trace, "\"name\":\"test inner\"") != 20000
+		|| countSubstrings(trace, "\"ph\":\"B\"") != countSubstrings(trace, "\"ph\":\"E\""))
+	{
+		logTestString("Wrong events in trace.\n");
+		success = false;
+	}
+
+	// a small buffer only keeps the last events, the stop without start is dropped
+	profiler.startTrace(3);
+	profiler.start(outer);
+	profiler.stop(outer);
+	profiler.start(inner);
+	profiler.stop(inner);
+	profiler.stopTrace();
+	trace = "";
+	profiler.printTrace(trace);
+	if (countSubstrings(trace, "\"ph\":\"B\"") != 1 || countSubstrings(trace, "\"ph\":\"E\"") != 1)
+	{
+		logTestString("Wrong events in wrapped trace.\n");
+		success = false;
+	}
+
+	u32 groupIndex;
+	if (profiler.findGroupIndex(groupIndex, L"test timer"))
+		profiler.resetGroup(groupIndex);
+
+	logTestString("Testing profiler done. %s\n", success?"Success":"Failure");
+	return success;
+}
+
+// each job profiles its own id, the trace buffer is shared by all threads
+// while the profile data is only collected on the main thread
+struct SProfileJob
+{
+	s32 Id;
+};
+
+void profileInJob(void* data)
+{
+	IProfiler& profiler = getProfiler();
+	const s32 id = static_cast<SProfileJob*>(data)->Id;
+	for (u32 i=0; i<2000; ++i)
+	{
+		profiler.start(id);
+		profiler.stop(id);
+	}
+}
+
+#if defined(_IRR_WINDOWS_API_)
+DWORD WINAPI profileThread(LPVOID data)
+{
+	profileInJob(data);
+	return 0;
+}
+#else
+void* profileThread(void* data)
+{
+	profileInJob(data);
+	return 0;
+}
+#endif
+
+// Profiling on another thread than the main thread is only traced
+bool testProfilerOtherThread()
+{
+	logTestString("Testing profiler on another thread.\n");
+
+	IProfiler& profiler = getProfiler();
+	SProfileJob job;
+	job.Id = profiler.add(L"test thread", L"test threads");
+
+	profiler.startTrace();
+#if defined(_IRR_WINDOWS_API_)
+	HANDLE thread = CreateThread(0, 0, profileThread, &job, 0, 0);
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+#else
+	pthread_t thread;
+	pthread_create(&thread, 0, profileThread, &job);
+	pthread_join(thread, 0);
+#endif
+	profiler.stopTrace();
+
+	core::stringc trace;
+	profiler.printTrace(trace);
+	bool success = countSubstrings(trace, "\"name\":\"test thread\"") == 4000;
+	const SProfileData* data = profiler.getProfileDataById(job.Id);
+	success &= (data && data->getCallsCounter() == 0);
+
+	logTestString("Testing profiler on another thread done. %s\n", success?"Success":"Failure");
+	return success;
+}
+
+// Test tracing from the worker threads of the job system
+bool testProfilerThreads()
+{
+	logTestString("Testing profiler with threads.\n");
+
+	SIrrlichtCreationParameters params;
+	params.DriverType = video::EDT_NULL;
+	params.JobWorkerCount = 3;
+	IrrlichtDevice* device = createDeviceEx(params);
+	if (!device)
+		return false;
+
+	IProfiler& profiler = getProfiler();
+	const u32 jobCount = 4;
+	SProfileJob jobs[jobCount];
+	const wchar_t* names[jobCount] = { L"test job 0", L"test job 1", L"test job 2", L"test job 3" };
+	for (u32 i=0; i<jobCount; ++i)
+		jobs[i].Id = profiler.add(names[i], L"test threads");
+
+	profiler.startTrace();
+	IJobSystem* jobSystem = device->getJobSystem();
+	SJobCounter counter;
+	for (u32 i=0; i<jobCount; ++i)
+		jobSystem->addJob(profileInJob, &jobs[i], &counter);
+	jobSystem->wait(counter);
+	profiler.stopTrace();
+
+	core::stringc trace;
+	profiler.printTrace(trace);
+	bool success = countSubstrings(trace, "\"ph\":\"B\"") == jobCount * 2000
+		&& countSubstrings(trace, "\"ph\":\"E\"") == jobCount * 2000;
+	for (u32 i=0; i<jobCount; ++i)
+	{
+		const core::stringc name = core::stringc("\"name\":\"") + core::stringc(names[i]) + "\"";
+		success &= (countSubstrings(trace, name.c_str()) == 4000);
+		// the main thread runs some jobs while waiting
+		const SProfileData* data = profiler.getProfileDataById(jobs[i].Id);
+		success &= (data && (data->getCallsCounter() == 0 || data->getCallsCounter() == 2000));
+		success &= (data && data->getPercentileTime(0.5f) <= data->getPercentileTime(0.99f));
+	}
+
+	u32 groupIndex;
+	if (profiler.findGroupIndex(groupIndex, L"test threads"))
+		profiler.resetGroup(groupIndex);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	logTestString("Testing profiler with threads done. %s\n", success?"Success":"Failure");
+	return success;
+}
+
+}
+
 // Test the functionality of the Irrlicht timer
 bool testTimer(void)
 {
@@ -58,6 +277,10 @@ bool testTimer(void)
 	logTestString("Real time and date. %d.%d.%d at %d:%d:%d\n", date.Day, date.Month, date.Year, date.Hour, date.Minute, date.Second);
 	logTestString("This is day %d of the year and weekday %d. The current time zone has daylight saving %s\n", date.Yearday, date.Weekday, date.IsDST?"enabled":"disabled");
 
+	success &= testProfiler(timer);
+	success &= testProfilerOtherThread();
+	success &= testProfilerThreads();
+
 	device->closeDevice();
 	device->run();
 	device->drop();